@@ -3,8 +3,8 @@ set -euo pipefail
 
 ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
 BASELINE_FILE="${AIVM_BENCH_BASELINE_FILE:-${ROOT_DIR}/src/AiVM.Core/native/tests/compiler_runtime_bench_baseline.tsv}"
-ITERATIONS="${AIVM_BENCH_ITERATIONS:-10}"
-MAX_REGRESSION_PCT="${AIVM_BENCH_MAX_REGRESSION_PCT:-5}"
+ITERATIONS="${AIVM_BENCH_ITERATIONS:-50}"
+MAX_REGRESSION_PCT="${AIVM_BENCH_MAX_REGRESSION_PCT:-25}"
 TMP_DIR="${ROOT_DIR}/.tmp/aivm-bench-gate"
 BENCH_OUT="${TMP_DIR}/bench.out"
 CURRENT_TSV="${TMP_DIR}/bench-current.tsv"
@@ -226,10 +226,10 @@ BENCH_BASELINE_STATUS="missing"
 BENCH_THRESHOLD_STATUS="not-evaluated"
 BENCH_REGRESSION_COUNT=0
 BENCH_BASELINE_MISSING_COUNT=0
-BENCH_ALLOWED_REGRESSION_PCT="${AIVM_BENCH_MAX_REGRESSION_PCT:-5}"
+BENCH_ALLOWED_REGRESSION_PCT="${AIVM_BENCH_MAX_REGRESSION_PCT:-25}"
 if [[ "${RUN_BENCH}" == "1" ]]; then
   set +e
-  ./tools/airun bench --iterations 10 --human > "${TMP_DIR}/bench.out" 2>&1
+  ./tools/airun bench --iterations 50 --human > "${TMP_DIR}/bench.out" 2>&1
   bench_rc=$?
   set -e
   if [[ ${bench_rc} -eq 0 ]]; then
@@ -34,6 +34,7 @@
 #include <ws2tcpip.h>
 #include <windows.h>
 #include <direct.h>
+#include <fcntl.h>
 #include <io.h>
 #include <objbase.h>
 #include <psapi.h>
@@ -55,20 +56,34 @@ typedef SSIZE_T ssize_t;
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
 #include <signal.h>
+#include <spawn.h>
 #include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <sys/wait.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
 #include <pthread.h>
 /* Some test translation units include this file directly without POSIX feature
    macros, which can hide realpath(3) declaration on glibc. */
 extern char* realpath(const char* path, char* resolved_path);
 extern int lstat(const char* path, struct stat* buffer);
 extern int kill(pid_t pid, int sig);
+extern char** environ;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define NATIVE_PROCESS_SPAWN_CHDIR 1
+extern int posix_spawn_file_actions_addchdir_np(posix_spawn_file_actions_t* actions, const char* path);
+#endif
 #ifndef PATH_MAX
 #define PATH_MAX 4096
 #endif
@@ -112,6 +127,12 @@ extern int kill(pid_t pid, int sig);
 #define AIRUN_MAYBE_UNUSED
 #endif
 
+#if defined(_MSC_VER)
+#define NATIVE_THREAD_LOCAL __declspec(thread)
+#else
+#define NATIVE_THREAD_LOCAL _Thread_local
+#endif
+
 static int join_path(const char* left, const char* right, char* out, size_t out_len);
 static int find_executable_on_path(const char* name, char* out, size_t out_len);
 static int write_text_file(const char* path, const char* text);
@@ -138,7 +159,7 @@ static int simple_fail(const char* message);
 static int simple_failf(const char* fmt, ...);
 static int starts_with(const char* value, const char* prefix);
 static const char* native_build_error(void);
-static AivmVm* g_native_active_vm;
+static NATIVE_THREAD_LOCAL AivmVm* g_native_active_vm;
 static int native_vm_append_host_node(
     AivmVm* vm,
     const char* kind,
@@ -162,6 +183,12 @@ static int native_image_decode_to_rgba_base64(
     size_t input_len,
     const char* mime_type,
     AivmValue* result);
+static int native_image_decode_rgba(
+    const uint8_t* input,
+    size_t input_len,
+    uint8_t** out_rgba,
+    int* out_width,
+    int* out_height);
 typedef enum {
     AIRUN_LOG_OFF = 0,
     AIRUN_LOG_ERROR = 1,
@@ -213,8 +240,8 @@ static void native_net_async_maybe_finalize_worker(NativeNetAsyncState* op);
 static char g_native_open_url_test_scratch[1024];
 #endif
 
-#define AIRUN_NATIVE_CACHE_SCHEMA "ailang-native-cache-v1"
-#define AIRUN_NATIVE_COMPILER_FINGERPRINT "native-compiler-2026-03-05-call-fixup-order-v2"
+#define AIRUN_NATIVE_CACHE_SCHEMA "ailang-native-cache-v2"
+#define AIRUN_NATIVE_COMPILER_FINGERPRINT "native-compiler-2026-10-19-function-names-v1"
 
 static AirunLogLevel g_airun_log_level = AIRUN_LOG_ERROR;
 static FILE* g_airun_log_file = NULL;
@@ -1186,294 +1213,14 @@ static int remove_file_if_exists(const char* path)
     return remove(path) == 0;
 }
 
-static volatile int g_fullstack_stop = 0;
-
-#ifdef _WIN32
-static BOOL WINAPI fullstack_ctrl_handler(DWORD ctrl_type)
-{
-    if (ctrl_type == CTRL_C_EVENT || ctrl_type == CTRL_BREAK_EVENT || ctrl_type == CTRL_CLOSE_EVENT) {
-        g_fullstack_stop = 1;
-        return TRUE;
-    }
-    return FALSE;
-}
-#else
-static void fullstack_signal_handler(int signo)
-{
-    (void)signo;
-    g_fullstack_stop = 1;
-}
-#endif
-
-static int native_send_all(NativeSocket fd, const char* bytes, size_t length)
-{
-    size_t sent = 0U;
-    while (sent < length) {
-#ifdef _WIN32
-        int n = send(fd, bytes + sent, (int)(length - sent), 0);
-#else
-        ssize_t n = send(fd, bytes + sent, length - sent, 0);
-#endif
-        if (n <= 0) {
-            return 0;
-        }
-        sent += (size_t)n;
-    }
-    return 1;
-}
-
-static const char* fullstack_mime_type(const char* path)
-{
-    if (path == NULL) {
-        return "application/octet-stream";
-    }
-    if (ends_with(path, ".html")) {
-        return "text/html; charset=utf-8";
-    }
-    if (ends_with(path, ".js") || ends_with(path, ".mjs")) {
-        return "text/javascript; charset=utf-8";
-    }
-    if (ends_with(path, ".wasm")) {
-        return "application/wasm";
-    }
-    if (ends_with(path, ".aibc1")) {
-        return "application/octet-stream";
-    }
-    return "application/octet-stream";
-}
-
-static int fullstack_send_error(NativeSocket client, int code, const char* message)
-{
-    char body[256];
-    char header[512];
-    int body_len;
-    int header_len;
-    if (message == NULL) {
-        message = "error";
-    }
-    body_len = snprintf(body, sizeof(body), "%d %s\n", code, message);
-    if (body_len < 0 || (size_t)body_len >= sizeof(body)) {
-        return 0;
-    }
-    header_len = snprintf(
-        header,
-        sizeof(header),
-        "HTTP/1.1 %d %s\r\n"
-        "Content-Type: text/plain; charset=utf-8\r\n"
-        "Content-Length: %d\r\n"
-        "Connection: close\r\n\r\n",
-        code,
-        message,
-        body_len);
-    if (header_len < 0 || (size_t)header_len >= sizeof(header)) {
-        return 0;
-    }
-    return native_send_all(client, header, (size_t)header_len) &&
-           native_send_all(client, body, (size_t)body_len);
-}
-
-static int fullstack_serve_request(NativeSocket client, const char* www_dir)
-{
-    char request[4096];
-    char method[16];
-    char target[1024];
-    char file_path[PATH_MAX];
-    char relative[1024];
-    char header[512];
-    struct stat st;
-    FILE* file;
-    size_t n;
-    int request_len;
-    int i;
-    const char* mime;
-    int header_len;
-    char buffer[4096];
-
-    if (www_dir == NULL) {
-        return fullstack_send_error(client, 500, "server error");
-    }
-
-#ifdef _WIN32
-    request_len = recv(client, request, (int)(sizeof(request) - 1U), 0);
-#else
-    request_len = (int)recv(client, request, sizeof(request) - 1U, 0);
-#endif
-    if (request_len <= 0) {
-        return 0;
-    }
-    request[request_len] = '\0';
-
-    if (sscanf(request, "%15s %1023s", method, target) != 2) {
-        return fullstack_send_error(client, 400, "bad request");
-    }
-    if (strcmp(method, "GET") != 0) {
-        return fullstack_send_error(client, 405, "method not allowed");
-    }
-    for (i = 0; target[i] != '\0'; i += 1) {
-        if (target[i] == '?') {
-            target[i] = '\0';
-            break;
-        }
-    }
-    if (strstr(target, "..") != NULL) {
-        return fullstack_send_error(client, 403, "forbidden");
-    }
-    if (strcmp(target, "/") == 0) {
-        if (snprintf(relative, sizeof(relative), "index.html") >= (int)sizeof(relative)) {
-            return fullstack_send_error(client, 500, "path overflow");
-        }
-    } else {
-        const char* rel = target;
-        if (target[0] == '/') {
-            rel = target + 1;
-        }
-        if (snprintf(relative, sizeof(relative), "%s", rel) >= (int)sizeof(relative)) {
-            return fullstack_send_error(client, 500, "path overflow");
-        }
-    }
-    if (!join_path(www_dir, relative, file_path, sizeof(file_path))) {
-        return fullstack_send_error(client, 500, "path overflow");
-    }
-    if (stat(file_path, &st) != 0) {
-        return fullstack_send_error(client, 404, "not found");
-    }
-#ifdef _WIN32
-    if ((st.st_mode & _S_IFREG) == 0) {
-#else
-    if (!S_ISREG(st.st_mode)) {
-#endif
-        return fullstack_send_error(client, 404, "not found");
-    }
-
-    file = fopen(file_path, "rb");
-    if (file == NULL) {
-        return fullstack_send_error(client, 404, "not found");
-    }
-    mime = fullstack_mime_type(file_path);
-    header_len = snprintf(
-        header,
-        sizeof(header),
-        "HTTP/1.1 200 OK\r\n"
-        "Content-Type: %s\r\n"
-        "Content-Length: %lld\r\n"
-        "Connection: close\r\n\r\n",
-        mime,
-        (long long)st.st_size);
-    if (header_len < 0 || (size_t)header_len >= sizeof(header)) {
-        fclose(file);
-        return fullstack_send_error(client, 500, "header overflow");
-    }
-    if (!native_send_all(client, header, (size_t)header_len)) {
-        fclose(file);
-        return 0;
-    }
-    while ((n = fread(buffer, 1U, sizeof(buffer), file)) > 0U) {
-        if (!native_send_all(client, buffer, n)) {
-            fclose(file);
-            return 0;
-        }
-    }
-    fclose(file);
-    return 1;
-}
-
-static int run_native_fullstack_server(const char* www_dir)
-{
-    NativeSocket listener = NATIVE_INVALID_SOCKET;
-    struct sockaddr_in addr;
-    const char* port_env;
-    int port = 8080;
-    int reuse = 1;
-
-    if (www_dir == NULL) {
-        return 2;
-    }
-    port_env = getenv("PORT");
-    if (port_env != NULL && port_env[0] != '\0') {
-        int parsed = atoi(port_env);
-        if (parsed > 0 && parsed <= 65535) {
-            port = parsed;
-        }
-    }
-
-#ifdef _WIN32
-    {
-        WSADATA wsa_data;
-        if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
-            fprintf(stderr, "Err#err1(code=RUN001 message=\"WSAStartup failed.\" nodeId=publish)\n");
-            return 2;
-        }
-    }
-    SetConsoleCtrlHandler(fullstack_ctrl_handler, TRUE);
-#else
-    signal(SIGINT, fullstack_signal_handler);
-    signal(SIGTERM, fullstack_signal_handler);
-#endif
-
-    listener = socket(AF_INET, SOCK_STREAM, 0);
-    if (listener == NATIVE_INVALID_SOCKET) {
-        fprintf(stderr, "Err#err1(code=RUN001 message=\"Failed to create fullstack listener socket.\" nodeId=publish)\n");
-#ifdef _WIN32
-        WSACleanup();
-#endif
-        return 2;
-    }
-    (void)setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    addr.sin_port = htons((uint16_t)port);
-    if (bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 16) != 0) {
-        fprintf(stderr, "Err#err1(code=RUN001 message=\"Failed to bind/listen fullstack server socket.\" nodeId=publish)\n");
-        native_socket_close(listener);
-#ifdef _WIN32
-        WSACleanup();
-#endif
-        return 2;
-    }
-
-    printf("[fullstack] serving static client from %s at http://localhost:%d\n", www_dir, port);
-    printf("[fullstack] press Ctrl+C to stop\n");
-    fflush(stdout);
-
-    g_fullstack_stop = 0;
-    while (!g_fullstack_stop) {
-        fd_set read_fds;
-        struct timeval timeout;
-        int ready;
-        NativeSocket client;
-        FD_ZERO(&read_fds);
-        FD_SET(listener, &read_fds);
-        timeout.tv_sec = 0;
-        timeout.tv_usec = 250000;
-#ifdef _WIN32
-        ready = select(0, &read_fds, NULL, NULL, &timeout);
-#else
-        ready = select((int)listener + 1, &read_fds, NULL, NULL, &timeout);
+/* How long a socket write may stall on a peer that stopped reading, in the net syscalls
+   and the fullstack server alike. */
+#ifndef NATIVE_NET_WRITE_STALL_TIMEOUT_MS
+#define NATIVE_NET_WRITE_STALL_TIMEOUT_MS 30000
 #endif
-        if (ready < 0) {
-            if (g_fullstack_stop) {
-                break;
-            }
-            continue;
-        }
-        if (ready == 0) {
-            continue;
-        }
-        client = accept(listener, NULL, NULL);
-        if (client == NATIVE_INVALID_SOCKET) {
-            continue;
-        }
-        (void)fullstack_serve_request(client, www_dir);
-        native_socket_close(client);
-    }
 
-    native_socket_close(listener);
-#ifdef _WIN32
-    WSACleanup();
-#endif
-    return 0;
-}
+#include "airun_thread_host.inc"
+#include "airun_fullstack_host.inc"
 
 static int read_binary_file(const char* path, unsigned char** out_bytes, size_t* out_size)
 {
@@ -1523,22 +1270,107 @@ static int read_binary_file(const char* path, unsigned char** out_bytes, size_t*
     return 1;
 }
 
-static int is_supported_aibc1_file(const char* path)
+typedef struct {
+    const unsigned char* bytes;
+    size_t size;
+    int mapped;
+} NativeMappedFile;
+
+/* Maps a file read-only so AiBC1 programs can be executed in place and share page cache
+   across processes; falls back to a heap copy when the file cannot be mapped. */
+static int native_map_file(const char* path, NativeMappedFile* out_file)
 {
     unsigned char* bytes = NULL;
     size_t byte_count = 0U;
+    if (path == NULL || out_file == NULL) {
+        return 0;
+    }
+    out_file->bytes = NULL;
+    out_file->size = 0U;
+    out_file->mapped = 0;
+#ifdef _WIN32
+    {
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file != INVALID_HANDLE_VALUE) {
+            LARGE_INTEGER file_size;
+            if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0 &&
+                (unsigned long long)file_size.QuadPart <= (unsigned long long)SIZE_MAX) {
+                HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (mapping != NULL) {
+                    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    CloseHandle(mapping);
+                    if (view != NULL) {
+                        out_file->bytes = (const unsigned char*)view;
+                        out_file->size = (size_t)file_size.QuadPart;
+                        out_file->mapped = 1;
+                    }
+                }
+            }
+            CloseHandle(file);
+        }
+    }
+#else
+    {
+        int fd = open(path, O_RDONLY);
+        if (fd >= 0) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+                void* view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (view != MAP_FAILED) {
+                    out_file->bytes = (const unsigned char*)view;
+                    out_file->size = (size_t)st.st_size;
+                    out_file->mapped = 1;
+                }
+            }
+            (void)close(fd);
+        }
+    }
+#endif
+    if (out_file->mapped) {
+        return 1;
+    }
+    if (!read_binary_file(path, &bytes, &byte_count)) {
+        return 0;
+    }
+    out_file->bytes = bytes;
+    out_file->size = byte_count;
+    return 1;
+}
+
+static void native_unmap_file(NativeMappedFile* file)
+{
+    if (file == NULL || file->bytes == NULL) {
+        return;
+    }
+    if (file->mapped) {
+#ifdef _WIN32
+        (void)UnmapViewOfFile(file->bytes);
+#else
+        (void)munmap((void*)(uintptr_t)file->bytes, file->size);
+#endif
+    } else {
+        free((void*)(uintptr_t)file->bytes);
+    }
+    file->bytes = NULL;
+    file->size = 0U;
+    file->mapped = 0;
+}
+
+static int is_supported_aibc1_file(const char* path)
+{
+    NativeMappedFile file;
     AivmProgram program;
     AivmProgramLoadResult load_result;
     if (path == NULL || !file_exists(path)) {
         return 0;
     }
-    if (!read_binary_file(path, &bytes, &byte_count)) {
+    if (!native_map_file(path, &file)) {
         return 0;
     }
     aivm_program_init(&program, NULL, 0U);
-    load_result = aivm_program_load_aibc1(bytes, byte_count, &program);
-    free(bytes);
-    aivm_program_clear(&program);
+    load_result = aivm_program_load_aibc1_borrowed(file.bytes, file.size, &program);
+    aivm_program_free(&program);
+    native_unmap_file(&file);
     return load_result.status == AIVM_PROGRAM_OK;
 }
 
@@ -2193,7 +2025,7 @@ static void print_usage(void)
         "Usage: aivm-runtime <command> [options]\n"
         "\n"
         "Commands:\n"
-        "  run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--no-cache] [--] [app-args...]\n"
+        "  run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--no-cache] [--ui=<native|headless>] [--ui-dump=<dir>] [--ui-frames=<n>] [--profile=<file>] [--profile-hz=<n>] [--] [app-args...]\n"
         "  version | --version\n"
         "\n"
         "VM selectors:\n"
@@ -2204,15 +2036,15 @@ static void print_usage(void)
         "Usage: airun <command> [options]\n"
         "\n"
         "Commands:\n"
-        "  run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--no-cache] [--] [app-args...]\n"
-        "  build <program(.aibc1|.aos|project-dir|project.aiproj)> [--out <dir>] [--no-cache]\n"
+        "  run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--no-cache] [--ui=<native|headless>] [--ui-dump=<dir>] [--ui-frames=<n>] [--profile=<file>] [--profile-hz=<n>] [--] [app-args...]\n"
+        "  build <program(.aibc1|.aos|project-dir|project.aiproj)> [--out <dir>] [--no-cache] [-O]\n"
         "  init <project-dir> [--template <cli|cli-args>] [--force]\n"
         "  clean [program(.aibc1|.aos|project-dir|project.aiproj)]\n"
         "  repl\n"
-        "  bench [--iterations <n>] [--human]\n"
-        "  debug run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--out <dir>] [--log-level <off|error|info|trace>] [--inject-click <x,y>] [--inject-key <name>] [--inject-key-at <x,y,key[,text]>] [--inject-text <text>] [--inject-text-at <x,y,text>] [--inject-wait <polls>] [--inject-close] [--inject-script <path>] [--] [app-args...]\n"
-        "  debug trace run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--out <dir>] [--log-level <off|error|info|trace>] [--inject-click <x,y>] [--inject-key <name>] [--inject-key-at <x,y,key[,text]>] [--inject-text <text>] [--inject-text-at <x,y,text>] [--inject-wait <polls>] [--inject-close] [--inject-script <path>] [--] [app-args...]\n"
-        "  debug capture run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--out <dir>] [--log-level <off|error|info|trace>] [--inject-click <x,y>] [--inject-key <name>] [--inject-key-at <x,y,key[,text]>] [--inject-text <text>] [--inject-text-at <x,y,text>] [--inject-wait <polls>] [--inject-close] [--inject-script <path>] [--] [app-args...]\n"
+        "  bench [--iterations <n>] [--warmup <n>] [--human|--format tsv|json] [--filter <text>] [--baseline <file>] [--tolerance <pct>]\n"
+        "  debug run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--out <dir>] [--log-level <off|error|info|trace>] [--ui=<native|headless>] [--ui-dump=<dir>] [--ui-frames=<n>] [--inject-click <x,y>] [--inject-key <name>] [--inject-key-at <x,y,key[,text]>] [--inject-text <text>] [--inject-text-at <x,y,text>] [--inject-wait <polls>] [--inject-close] [--inject-script <path>] [--] [app-args...]\n"
+        "  debug trace run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--out <dir>] [--log-level <off|error|info|trace>] [--ui=<native|headless>] [--ui-dump=<dir>] [--ui-frames=<n>] [--inject-click <x,y>] [--inject-key <name>] [--inject-key-at <x,y,key[,text]>] [--inject-text <text>] [--inject-text-at <x,y,text>] [--inject-wait <polls>] [--inject-close] [--inject-script <path>] [--] [app-args...]\n"
+        "  debug capture run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--out <dir>] [--log-level <off|error|info|trace>] [--ui=<native|headless>] [--ui-dump=<dir>] [--ui-frames=<n>] [--inject-click <x,y>] [--inject-key <name>] [--inject-key-at <x,y,key[,text]>] [--inject-text <text>] [--inject-text-at <x,y,text>] [--inject-wait <polls>] [--inject-close] [--inject-script <path>] [--] [app-args...]\n"
         "  debug interact run <program(.aibc1|.aos|project-dir|project.aiproj)> [--vm=<selector>] [--out <dir>] [--log-level <off|error|info|trace>] [--] [app-args...]\n"
         "  debug profile <program(.aibc1|.aos|project-dir|project.aiproj)> [--iterations <n>] [--max-growth-kb <kb>] [--out <file>] [--vm=<selector>] [--no-cache] [--] [app-args...]\n"
         "  debug dns <host> [port]\n"
@@ -2536,7 +2368,10 @@ static int wasm_syscall_unavailable_for_profile(const char* profile, const char*
                strcmp(target, "sys.process.stdout.read") == 0 ||
                strcmp(target, "sys.process.stderr.read") == 0 ||
                strcmp(target, "sys.process.poll") == 0 ||
-               strcmp(target, "sys.image.decodeToRgbaBase64") == 0 ||
+               strncmp(target, "sys.process.stdout.", 19U) == 0 ||
+               strncmp(target, "sys.process.stderr.", 19U) == 0 ||
+               strncmp(target, "sys.process.stdin.", 18U) == 0 ||
+               strncmp(target, "sys.image.", 10U) == 0 ||
                strncmp(target, "sys.ui.", 7U) == 0 ||
                strncmp(target, "sys.ui_", 7U) == 0;
     }
@@ -2547,7 +2382,10 @@ static int wasm_syscall_unavailable_for_profile(const char* profile, const char*
                strcmp(target, "sys.process.stdout.read") == 0 ||
                strcmp(target, "sys.process.stderr.read") == 0 ||
                strcmp(target, "sys.process.poll") == 0 ||
-               strcmp(target, "sys.image.decodeToRgbaBase64") == 0 ||
+               strncmp(target, "sys.process.stdout.", 19U) == 0 ||
+               strncmp(target, "sys.process.stderr.", 19U) == 0 ||
+               strncmp(target, "sys.process.stdin.", 18U) == 0 ||
+               strncmp(target, "sys.image.", 10U) == 0 ||
                strncmp(target, "sys.net.", 8U) == 0 ||
                strncmp(target, "sys.fs.", 7U) == 0;
     }
@@ -2623,7 +2461,11 @@ static int native_syscall_requires_host_process_capability(const char* syscall_t
            strcmp(syscall_target, "sys.process.kill") == 0 ||
            strcmp(syscall_target, "sys.process.stdout.read") == 0 ||
            strcmp(syscall_target, "sys.process.stderr.read") == 0 ||
-           strcmp(syscall_target, "sys.process.poll") == 0;
+           strcmp(syscall_target, "sys.process.poll") == 0 ||
+           strcmp(syscall_target, "sys.process.stdout.readStart") == 0 ||
+           strcmp(syscall_target, "sys.process.stderr.readStart") == 0 ||
+           strcmp(syscall_target, "sys.process.stdin.write") == 0 ||
+           strcmp(syscall_target, "sys.process.stdin.close") == 0;
 }
 
 static int native_syscall_requires_host_fs_capability(const char* syscall_target)
@@ -3249,47 +3091,70 @@ static int emit_wasm_fullstack_layout(const char* out_dir)
     return 1;
 }
 
-#define NATIVE_PROCESS_CAPACITY 32U
-#define NATIVE_PROCESS_READ_CHUNK 4096U
+#define NATIVE_PROCESS_INITIAL_CAPACITY 32U
+#define NATIVE_PROCESS_MAX_CAPACITY 65536U
+#define NATIVE_PROCESS_HANDLE_INDEX_BITS 20
+#define NATIVE_PROCESS_READ_CHUNK 65536U
+#define NATIVE_PROCESS_RING_MIN_CAPACITY 65536U
+#define NATIVE_PROCESS_RING_SOFT_LIMIT (16U * 1024U * 1024U)
 #define NATIVE_WORKER_CAPACITY 64U
-#define NATIVE_WORKER_TEXT_CAPACITY 512U
+#define NATIVE_WORKER_MAX_THREADS 16U
+#define NATIVE_WORKER_STEP_SLICE 4096U
+#define NATIVE_WORKER_ENTRY_PREFIX "sys.worker.entry:"
 #define NATIVE_NET_HANDLE_CAPACITY 64U
 #define NATIVE_NET_ASYNC_CAPACITY 128U
 #define NATIVE_NET_BYTES_CHUNK 65536U
+#define NATIVE_NET_WRITEV_MAX_PARTS 64U
+
+/* Power-of-two byte ring; pipes are read straight into its free space. */
+typedef struct NativeProcessRing
+{
+    uint8_t* data;
+    size_t capacity;
+    size_t head;
+    size_t count;
+} NativeProcessRing;
 
 typedef struct NativeProcessState
 {
     int used;
+    uint32_t generation;
+    size_t next_free;
     int finished;
     int exit_code;
     int stdout_closed;
     int stderr_closed;
-    uint8_t* stdout_buffer;
-    size_t stdout_buffer_len;
-    size_t stdout_buffer_pos;
-    uint8_t* stderr_buffer;
-    size_t stderr_buffer_len;
-    size_t stderr_buffer_pos;
+    int stdin_closed;
+    int exit_reported;
+    NativeProcessRing stdout_ring;
+    NativeProcessRing stderr_ring;
 #ifdef _WIN32
     HANDLE process_handle;
     HANDLE stdout_read;
     HANDLE stderr_read;
+    HANDLE stdin_write;
 #else
     pid_t pid;
     int stdout_fd;
     int stderr_fd;
+    int stdin_fd;
+    int exit_fd;
 #endif
 } NativeProcessState;
 
-static NativeProcessState g_native_processes[NATIVE_PROCESS_CAPACITY];
-static uint8_t g_native_process_read_scratch[NATIVE_PROCESS_READ_CHUNK];
+/* Slots grow on demand; a handle packs the slot generation above the index so stale handles miss. */
+static NativeProcessState* g_native_processes = NULL;
+static size_t g_native_process_capacity = 0U;
+static size_t g_native_process_free_head = 0U;
+static uint8_t* g_native_process_take_scratch = NULL;
+static size_t g_native_process_take_scratch_capacity = 0U;
 
 #include "airun_net_host.inc"
 #include "airun_fs_host.inc"
 #include "airun_time_host.inc"
 #include "airun_process_host.inc"
-#include "airun_worker_host.inc"
 
+#include "airun_ui_headless_host.inc"
 #include "airun_ui_runtime_host.inc"
 
 static int native_base64_decode_char(char ch)
@@ -3313,11 +3178,11 @@ static int native_base64_decode_char(char ch)
 }
 
 #define NATIVE_BYTES_SCRATCH_CAPACITY 131072U
-static uint8_t g_native_bytes_scratch[NATIVE_BYTES_SCRATCH_CAPACITY];
-static char g_native_base64_scratch[NATIVE_BYTES_SCRATCH_CAPACITY];
-static char g_native_utf8_scratch[8];
-static char* g_native_string_scratch = NULL;
-static size_t g_native_string_scratch_capacity = 0U;
+static NATIVE_THREAD_LOCAL uint8_t g_native_bytes_scratch[NATIVE_BYTES_SCRATCH_CAPACITY];
+static NATIVE_THREAD_LOCAL char g_native_base64_scratch[NATIVE_BYTES_SCRATCH_CAPACITY];
+static NATIVE_THREAD_LOCAL char g_native_utf8_scratch[8];
+static NATIVE_THREAD_LOCAL char* g_native_string_scratch = NULL;
+static NATIVE_THREAD_LOCAL size_t g_native_string_scratch_capacity = 0U;
 
 static int native_string_scratch_ensure_capacity(size_t required_capacity)
 {
@@ -3346,6 +3211,13 @@ static int native_string_scratch_ensure_capacity(size_t required_capacity)
     return 1;
 }
 
+static void native_string_scratch_release(void)
+{
+    free(g_native_string_scratch);
+    g_native_string_scratch = NULL;
+    g_native_string_scratch_capacity = 0U;
+}
+
 static size_t native_utf8_next_index(const char* text, size_t index)
 {
     unsigned char first;
@@ -3571,39 +3443,24 @@ static int native_bytes_to_base64(
     return 1;
 }
 
-#if defined(_WIN32) || defined(__APPLE__)
-static int native_rgba_base64_capacity(size_t rgba_length, size_t* out_capacity)
-{
-    size_t capacity;
-    if (out_capacity == NULL) {
-        return 0;
-    }
-    if (rgba_length > ((SIZE_MAX - 3U) / 4U) * 3U) {
-        return 0;
-    }
-    capacity = ((rgba_length + 2U) / 3U) * 4U;
-    if (capacity >= SIZE_MAX) {
-        return 0;
-    }
-    *out_capacity = capacity + 1U;
-    return 1;
-}
+#if !defined(_WIN32) && !defined(__APPLE__)
+#include "airun_image_codec.inc"
 #endif
 
-static int native_image_decode_to_rgba_base64(
+/* Decodes an encoded image into a malloc'd width*height*4 RGBA buffer; 0 when the format or platform is unsupported. */
+static int native_image_decode_rgba(
     const uint8_t* input,
     size_t input_len,
-    const char* mime_type,
-    AivmValue* result)
+    uint8_t** out_rgba,
+    int* out_width,
+    int* out_height)
 {
-    (void)mime_type;
-    if (result == NULL) {
-        return AIVM_SYSCALL_ERR_NULL_RESULT;
-    }
-    if (input == NULL || input_len == 0U) {
-        result->type = AIVM_VAL_VOID;
-        return AIVM_SYSCALL_ERR_INVALID;
+    if (input == NULL || input_len == 0U || out_rgba == NULL || out_width == NULL || out_height == NULL) {
+        return 0;
     }
+    *out_rgba = NULL;
+    *out_width = 0;
+    *out_height = 0;
 #ifdef _WIN32
     {
         HRESULT init_hr;
@@ -3617,19 +3474,16 @@ static int native_image_decode_to_rgba_base64(
         UINT height = 0U;
         uint8_t* rgba = NULL;
         size_t rgba_length;
-        size_t base64_capacity;
-        int status = AIVM_SYSCALL_ERR_INVALID;
+        int ok = 0;
 
         if (input_len > (size_t)UINT_MAX) {
-            result->type = AIVM_VAL_VOID;
-            return AIVM_SYSCALL_ERR_INVALID;
+            return 0;
         }
         init_hr = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED);
         if (SUCCEEDED(init_hr)) {
             should_uninit = 1;
         } else if (init_hr != RPC_E_CHANGED_MODE) {
-            result->type = AIVM_VAL_VOID;
-            return AIVM_SYSCALL_ERR_INVALID;
+            return 0;
         }
         if (FAILED(CoCreateInstance(
                 &CLSID_WICImagingFactory,
@@ -3672,7 +3526,7 @@ static int native_image_decode_to_rgba_base64(
         if (FAILED(converter->lpVtbl->GetSize(converter, &width, &height))) {
             goto cleanup_windows;
         }
-        if (width == 0U || height == 0U) {
+        if (width == 0U || height == 0U || width > (UINT)INT_MAX || height > (UINT)INT_MAX) {
             goto cleanup_windows;
         }
         if ((size_t)width > (SIZE_MAX / 4U) || (size_t)height > (SIZE_MAX / ((size_t)width * 4U))) {
@@ -3691,17 +3545,11 @@ static int native_image_decode_to_rgba_base64(
                 rgba))) {
             goto cleanup_windows;
         }
-        if (!native_rgba_base64_capacity(rgba_length, &base64_capacity)) {
-            goto cleanup_windows;
-        }
-        if (!native_string_scratch_ensure_capacity(base64_capacity)) {
-            goto cleanup_windows;
-        }
-        if (!native_bytes_to_base64(rgba, rgba_length, g_native_string_scratch, base64_capacity)) {
-            goto cleanup_windows;
-        }
-        *result = aivm_value_string(g_native_string_scratch);
-        status = AIVM_SYSCALL_OK;
+        *out_rgba = rgba;
+        *out_width = (int)width;
+        *out_height = (int)height;
+        rgba = NULL;
+        ok = 1;
 
 cleanup_windows:
         if (converter != NULL) {
@@ -3723,10 +3571,7 @@ cleanup_windows:
         if (should_uninit != 0) {
             CoUninitialize();
         }
-        if (status != AIVM_SYSCALL_OK) {
-            result->type = AIVM_VAL_VOID;
-        }
-        return status;
+        return ok;
     }
 #elif defined(__APPLE__)
     CFDataRef data = NULL;
@@ -3738,13 +3583,11 @@ cleanup_windows:
     size_t width;
     size_t height;
     size_t rgba_length;
-    size_t base64_capacity;
-    int status = AIVM_SYSCALL_ERR_INVALID;
+    int ok = 0;
 
     data = CFDataCreate(kCFAllocatorDefault, input, (CFIndex)input_len);
     if (data == NULL) {
-        result->type = AIVM_VAL_VOID;
-        return AIVM_SYSCALL_ERR_INVALID;
+        return 0;
     }
     source = CGImageSourceCreateWithData(data, NULL);
     if (source == NULL) {
@@ -3756,7 +3599,7 @@ cleanup_windows:
     }
     width = (size_t)CGImageGetWidth(image);
     height = (size_t)CGImageGetHeight(image);
-    if (width == 0U || height == 0U) {
+    if (width == 0U || height == 0U || width > (size_t)INT_MAX || height > (size_t)INT_MAX) {
         goto cleanup;
     }
     if (width > (SIZE_MAX / 4U) || height > (SIZE_MAX / (width * 4U))) {
@@ -3785,17 +3628,11 @@ cleanup_windows:
     }
     CGContextSetBlendMode(context, kCGBlendModeCopy);
     CGContextDrawImage(context, CGRectMake(0.0, 0.0, (CGFloat)width, (CGFloat)height), image);
-    if (!native_rgba_base64_capacity(rgba_length, &base64_capacity)) {
-        goto cleanup;
-    }
-    if (!native_string_scratch_ensure_capacity(base64_capacity)) {
-        goto cleanup;
-    }
-    if (!native_bytes_to_base64(rgba, rgba_length, g_native_string_scratch, base64_capacity)) {
-        goto cleanup;
-    }
-    *result = aivm_value_string(g_native_string_scratch);
-    status = AIVM_SYSCALL_OK;
+    *out_rgba = rgba;
+    *out_width = (int)width;
+    *out_height = (int)height;
+    rgba = NULL;
+    ok = 1;
 
 cleanup:
     if (context != NULL) {
@@ -3814,16 +3651,45 @@ cleanup:
         CFRelease(data);
     }
     free(rgba);
-    if (status != AIVM_SYSCALL_OK) {
-        result->type = AIVM_VAL_VOID;
-    }
-    return status;
+    return ok;
 #else
-    result->type = AIVM_VAL_VOID;
-    return AIVM_SYSCALL_ERR_INVALID;
+    return native_image_codec_decode_rgba(input, input_len, out_rgba, out_width, out_height);
 #endif
 }
 
+static int native_image_decode_to_rgba_base64(
+    const uint8_t* input,
+    size_t input_len,
+    const char* mime_type,
+    AivmValue* result)
+{
+    uint8_t* rgba = NULL;
+    int width = 0;
+    int height = 0;
+    size_t rgba_length;
+    size_t base64_capacity;
+    (void)mime_type;
+    if (result == NULL) {
+        return AIVM_SYSCALL_ERR_NULL_RESULT;
+    }
+    if (!native_image_decode_rgba(input, input_len, &rgba, &width, &height)) {
+        result->type = AIVM_VAL_VOID;
+        return AIVM_SYSCALL_ERR_INVALID;
+    }
+    rgba_length = (size_t)width * (size_t)height * 4U;
+    base64_capacity = ((rgba_length + 2U) / 3U) * 4U + 1U;
+    if (rgba_length > ((SIZE_MAX - 3U) / 4U) * 3U ||
+        !native_string_scratch_ensure_capacity(base64_capacity) ||
+        !native_bytes_to_base64(rgba, rgba_length, g_native_string_scratch, base64_capacity)) {
+        free(rgba);
+        result->type = AIVM_VAL_VOID;
+        return AIVM_SYSCALL_ERR_INVALID;
+    }
+    free(rgba);
+    *result = aivm_value_string(g_native_string_scratch);
+    return AIVM_SYSCALL_OK;
+}
+
 static int native_is_valid_utf8_without_nul(const uint8_t* data, size_t len)
 {
     size_t i = 0U;
@@ -3937,6 +3803,10 @@ typedef struct {
 
 #include "airun_text_host.inc"
 
+#include "airun_worker_host.inc"
+
+#include "airun_par_host.inc"
+
 struct NativeDebugOptions {
     int emit_bundle;
     const char* out_dir;
@@ -4048,6 +3918,7 @@ static const char* infer_call_target(const AivmProgram* program, const AivmVm* v
 }
 
 #include "airun_debug_host.inc"
+#include "airun_profile.inc"
 
 static int emit_vm_error_with_context(const AivmProgram* program, const AivmVm* vm, const char* vm_error_message)
 {
@@ -4205,7 +4076,7 @@ static int run_native_compiled_program(
     size_t process_argv_count,
     const NativeDebugOptions* debug_options)
 {
-    AivmSyscallBinding bindings[107];
+    AivmSyscallBinding bindings[132];
     AivmVm vm;
     int ok;
     int exit_code = 0;
@@ -4254,8 +4125,9 @@ static int run_native_compiled_program(
         (process_argv_count > 1U && process_argv != NULL && process_argv[1] != NULL) ? process_argv[1] : "",
         (process_argv_count > 2U && process_argv != NULL && process_argv[2] != NULL) ? process_argv[2] : "");
     native_ui_runtime_reset_handles();
-    native_host_ui_reset();
+    g_native_ui_backend->reset();
     native_net_reset();
+    native_fs_reset();
 
     bindings[0].target = "sys.stdout.writeLine";
     bindings[0].handler = native_syscall_stdout_write_line;
@@ -4472,18 +4344,70 @@ static int run_native_compiled_program(
     bindings[105].handler = native_syscall_image_decode_to_rgba_base64;
     bindings[106].target = "sys.bytes.fromUtf8String";
     bindings[106].handler = native_syscall_bytes_from_utf8_string;
+    bindings[107].target = "sys.net.tcp.writev";
+    bindings[107].handler = native_syscall_net_tcp_writev;
+    bindings[108].target = "sys.net.tcp.sendFile";
+    bindings[108].handler = native_syscall_net_tcp_send_file;
+    bindings[109].target = "sys.process.stdout.readStart";
+    bindings[109].handler = native_syscall_process_read_start;
+    bindings[110].target = "sys.process.stderr.readStart";
+    bindings[110].handler = native_syscall_process_read_start;
+    bindings[111].target = "sys.process.stdin.write";
+    bindings[111].handler = native_syscall_process_stdin_write;
+    bindings[112].target = "sys.process.stdin.close";
+    bindings[112].handler = native_syscall_process_stdin_close;
+    bindings[113].target = "sys.fs.file.open";
+    bindings[113].handler = native_syscall_fs_file_open;
+    bindings[114].target = "sys.fs.file.readAt";
+    bindings[114].handler = native_syscall_fs_file_read_at;
+    bindings[115].target = "sys.fs.file.writeAt";
+    bindings[115].handler = native_syscall_fs_file_write_at;
+    bindings[116].target = "sys.fs.file.size";
+    bindings[116].handler = native_syscall_fs_file_size;
+    bindings[117].target = "sys.fs.file.close";
+    bindings[117].handler = native_syscall_fs_file_close;
+    bindings[118].target = "sys.fs.file.readRange";
+    bindings[118].handler = native_syscall_fs_file_read_range;
+    bindings[119].target = "sys.fs.dir.entries";
+    bindings[119].handler = native_syscall_fs_dir_entries;
+    bindings[120].target = "sys.fs.file.append";
+    bindings[120].handler = native_syscall_fs_file_append;
+    bindings[121].target = "sys.fs.file.writeAtomic";
+    bindings[121].handler = native_syscall_fs_file_write_atomic;
+    bindings[122].target = "sys.fs.writer.open";
+    bindings[122].handler = native_syscall_fs_writer_open;
+    bindings[123].target = "sys.fs.writer.write";
+    bindings[123].handler = native_syscall_fs_writer_write;
+    bindings[124].target = "sys.fs.writer.flush";
+    bindings[124].handler = native_syscall_fs_writer_flush;
+    bindings[125].target = "sys.fs.writer.close";
+    bindings[125].handler = native_syscall_fs_writer_close;
+    bindings[126].target = "sys.ui.drawBatch";
+    bindings[126].handler = native_syscall_ui_draw_batch;
+    bindings[127].target = "sys.image.decode";
+    bindings[127].handler = native_syscall_image_decode;
+    bindings[128].target = "sys.image.fromRgbaBase64";
+    bindings[128].handler = native_syscall_image_from_rgba_base64;
+    bindings[129].target = "sys.image.release";
+    bindings[129].handler = native_syscall_image_release;
+    bindings[130].target = "sys.ui.drawImageHandle";
+    bindings[130].handler = native_syscall_ui_draw_image_handle;
+    bindings[131].target = "sys.image.decodeToRgba";
+    bindings[131].handler = native_syscall_image_decode_to_rgba;
     if (g_airun_log_level >= AIRUN_LOG_TRACE) {
-        native_prepare_traced_bindings(bindings, 107U);
+        native_prepare_traced_bindings(bindings, 132U);
     } else {
         g_native_trace_real_binding_count = 0U;
     }
-    ok = aivm_execute_program_with_syscalls_and_argv(
-        program,
-        bindings,
-        107U,
-        process_argv,
-        process_argv_count,
-        &vm);
+    aivm_init_with_syscalls_and_argv(&vm, program, bindings, 132U, process_argv, process_argv_count);
+    aivm_set_par_executor(&vm, native_par_execute, NULL);
+    aivm_set_task_wait_hook(&vm, native_net_async_wait, NULL);
+    if (g_native_profile_path != NULL) {
+        native_profile_run_and_write(&vm, program);
+    } else {
+        aivm_run(&vm);
+    }
+    ok = vm.status != AIVM_VM_STATUS_ERROR;
     if (!ok || vm.status == AIVM_VM_STATUS_ERROR) {
         const char* detail = aivm_vm_error_detail(&vm);
         (void)snprintf(
@@ -4495,7 +4419,11 @@ static int run_native_compiled_program(
             (unsigned long long)vm.instruction_pointer);
         (void)write_native_debug_bundle(debug_options, program, &vm, 0, 0, diagnostics_line);
         native_net_reset();
-        native_host_ui_shutdown();
+        native_fs_reset();
+        native_worker_reset();
+        native_par_reset();
+        native_ui_runtime_reset_handles();
+        g_native_ui_backend->shutdown();
         native_scene_capture_reset();
         airun_log_capture_close();
         g_airun_live_debug_options = NULL;
@@ -4521,7 +4449,11 @@ static int run_native_compiled_program(
         (unsigned long long)vm.instruction_pointer);
     (void)write_native_debug_bundle(debug_options, program, &vm, exit_code, has_exit_code, diagnostics_line);
     native_net_reset();
-    native_host_ui_shutdown();
+    native_fs_reset();
+    native_worker_reset();
+    native_par_reset();
+    native_ui_runtime_reset_handles();
+    g_native_ui_backend->shutdown();
     native_scene_capture_reset();
     airun_log_capture_close();
     g_airun_live_debug_options = NULL;
@@ -4543,33 +4475,38 @@ static int run_native_aibc1(
     size_t process_argv_count,
     const NativeDebugOptions* debug_options)
 {
-    unsigned char* bytes = NULL;
-    size_t byte_count = 0U;
+    NativeMappedFile file;
     AivmProgram program;
     AivmProgramLoadResult load_result;
+    int rc;
 
-    if (!read_binary_file(path, &bytes, &byte_count)) {
+    aivm_program_clear(&program);
+    if (!native_map_file(path, &file)) {
         fprintf(stderr,
             "Err#err1(code=RUN001 message=\"Failed to read AiBC1 file. phase=load function=main pc=0 nodeId=unknown opcode=UNKNOWN callTarget=unknown\" nodeId=program)\n");
         return 2;
     }
 
-    load_result = aivm_program_load_aibc1(bytes, byte_count, &program);
-    free(bytes);
-
+    /* Aligned sections stay in the mapping; it must outlive the run. */
+    load_result = aivm_program_load_aibc1_borrowed(file.bytes, file.size, &program);
     if (load_result.status != AIVM_PROGRAM_OK) {
+        aivm_program_free(&program);
+        native_unmap_file(&file);
         fprintf(stderr,
             "Err#err1(code=RUN001 message=\"Failed to load AiBC1 program. phase=load function=main pc=%llu nodeId=unknown opcode=UNKNOWN callTarget=unknown loadCode=%s\" nodeId=program)\n",
             (unsigned long long)load_result.error_offset,
             aivm_program_status_code(load_result.status));
         return 2;
     }
-    return run_native_compiled_program(
+    rc = run_native_compiled_program(
         &program,
         "AiBC1 execution failed.",
         process_argv,
         process_argv_count,
         debug_options);
+    aivm_program_free(&program);
+    native_unmap_file(&file);
+    return rc;
 }
 
 static int parse_attr_span(const char* attrs, const char* key, char* out, size_t out_len)
@@ -4804,12 +4741,10 @@ static int bytecode_add_string_const(AivmProgram* program, const char* value, in
             return 1;
         }
     }
-    if (program->constant_count >= AIVM_PROGRAM_MAX_CONSTANTS) {
-        return 0;
-    }
     len = strlen(value);
     base = program->string_storage_used;
-    if (base + len + 1U > AIVM_PROGRAM_MAX_STRING_BYTES) {
+    if (!aivm_program_reserve_constants(program, program->constant_count + 1U) ||
+        !aivm_program_reserve_string_bytes(program, base + len + 1U)) {
         return 0;
     }
     memcpy(&program->string_storage[base], value, len + 1U);
@@ -4820,7 +4755,7 @@ static int bytecode_add_string_const(AivmProgram* program, const char* value, in
     return 1;
 }
 
-static int parse_bytecode_aos_to_program_text(
+static int parse_bytecode_aos_into_program(
     const char* source,
     AivmProgram* out_program,
     int allow_legacy_zero_b)
@@ -4847,7 +4782,7 @@ static int parse_bytecode_aos_to_program_text(
         char attrs[512];
         char kind[32];
         size_t n;
-        if (out_program->constant_count >= AIVM_PROGRAM_MAX_CONSTANTS || lparen == NULL) {
+        if (lparen == NULL || !aivm_program_reserve_constants(out_program, out_program->constant_count + 1U)) {
             return 0;
         }
         rparen = strchr(lparen, ')');
@@ -4888,7 +4823,7 @@ static int parse_bytecode_aos_to_program_text(
             }
             len = strlen(unescaped);
             base = out_program->string_storage_used;
-            if (base + len + 1U > AIVM_PROGRAM_MAX_STRING_BYTES) {
+            if (!aivm_program_reserve_string_bytes(out_program, base + len + 1U)) {
                 return 0;
             }
             memcpy(&out_program->string_storage[base], unescaped, len + 1U);
@@ -4921,7 +4856,8 @@ static int parse_bytecode_aos_to_program_text(
         AivmOpcode opcode;
         size_t n;
 
-        if (out_program->instruction_count >= AIVM_PROGRAM_MAX_INSTRUCTIONS || lparen == NULL) {
+        /* Room for the instruction and an optional syscall-target CONST. */
+        if (lparen == NULL || !aivm_program_reserve_instructions(out_program, out_program->instruction_count + 2U)) {
             return 0;
         }
         rparen = strchr(lparen, ')');
@@ -4942,8 +4878,7 @@ static int parse_bytecode_aos_to_program_text(
             int64_t target_const_idx = 0;
             if (!allow_legacy_zero_b ||
                 (opcode != AIVM_OP_CALL_SYS && opcode != AIVM_OP_ASYNC_CALL_SYS) ||
-                !bytecode_add_string_const(out_program, syscall_target, &target_const_idx) ||
-                out_program->instruction_count >= AIVM_PROGRAM_MAX_INSTRUCTIONS) {
+                !bytecode_add_string_const(out_program, syscall_target, &target_const_idx)) {
                 return 0;
             }
             out_program->instruction_storage[out_program->instruction_count].opcode = AIVM_OP_CONST;
@@ -4967,6 +4902,24 @@ static int parse_bytecode_aos_to_program_text(
     return out_program->instruction_count > 0U;
 }
 
+/* A failed compile leaves `out_program` empty, releasing whatever it had grown. */
+static int parse_bytecode_aos_to_program_text(
+    const char* source,
+    AivmProgram* out_program,
+    int allow_legacy_zero_b)
+{
+    int ok;
+    if (out_program == NULL) {
+        return 0;
+    }
+    aivm_program_clear(out_program);
+    ok = parse_bytecode_aos_into_program(source, out_program, allow_legacy_zero_b);
+    if (!ok) {
+        aivm_program_free(out_program);
+    }
+    return ok;
+}
+
 static int parse_bytecode_aos_to_program_file(
     const char* aos_path,
     AivmProgram* out_program,
@@ -5002,7 +4955,7 @@ typedef struct {
     const char* next;
 } SimpleNodeView;
 
-static char g_simple_last_error[256];
+static NATIVE_THREAD_LOCAL char g_simple_last_error[256];
 
 static int simple_find_matching_brace(const char* open_brace, const char* end, const char** out_close)
 {
@@ -5206,8 +5159,8 @@ static int simple_emit_instruction(AivmProgram* program, AivmOpcode opcode, int6
         simple_fail("emit instruction: null program");
         return 0;
     }
-    if (program->instruction_count >= AIVM_PROGRAM_MAX_INSTRUCTIONS) {
-        simple_fail("emit instruction: instruction capacity exceeded");
+    if (!aivm_program_reserve_instructions(program, program->instruction_count + 1U)) {
+        simple_fail("emit instruction: instruction storage allocation failed");
         return 0;
     }
     program->instruction_storage[program->instruction_count].opcode = opcode;
@@ -5256,14 +5209,11 @@ static int simple_add_string_const(AivmProgram* program, const char* value, size
             return 1;
         }
     }
-    if (program->constant_count >= AIVM_PROGRAM_MAX_CONSTANTS) {
-        simple_fail("add string const: constant capacity exceeded");
-        return 0;
-    }
     len = strlen(value);
     base = program->string_storage_used;
-    if (base + len + 1U > AIVM_PROGRAM_MAX_STRING_BYTES) {
-        simple_fail("add string const: string storage exceeded");
+    if (!aivm_program_reserve_constants(program, program->constant_count + 1U) ||
+        !aivm_program_reserve_string_bytes(program, base + len + 1U)) {
+        simple_fail("add string const: constant storage allocation failed");
         return 0;
     }
     memcpy(&program->string_storage[base], value, len + 1U);
@@ -5289,8 +5239,8 @@ static int simple_compile_expr_node(const SimpleNodeView* node, AivmProgram* pro
             return simple_emit_instruction(program, AIVM_OP_PUSH_BOOL, (strcmp(value, "true") == 0) ? 1 : 0);
         }
         if (!value_is_quoted && strcmp(value, "null") == 0) {
-            if (program->constant_count >= AIVM_PROGRAM_MAX_CONSTANTS) {
-                return simple_fail("lit null constant capacity exceeded");
+            if (!aivm_program_reserve_constants(program, program->constant_count + 1U)) {
+                return simple_fail("lit null constant storage allocation failed");
             }
             program->constant_storage[program->constant_count] = aivm_value_null();
             if (!simple_emit_instruction(program, AIVM_OP_CONST, (int64_t)program->constant_count)) {
@@ -5348,7 +5298,7 @@ static int simple_compile_expr_node(const SimpleNodeView* node, AivmProgram* pro
     return simple_failf("unsupported expr kind: %s", node->kind);
 }
 
-static int parse_simple_program_aos_to_program_text(const char* source, AivmProgram* out_program)
+static int parse_simple_program_aos_into_program(const char* source, AivmProgram* out_program)
 {
     const char* program_pos;
     const char* first_open;
@@ -5481,6 +5431,21 @@ static int parse_simple_program_aos_to_program_text(const char* source, AivmProg
     return out_program->instruction_count > 0U;
 }
 
+/* A failed compile leaves `out_program` empty, releasing whatever it had grown. */
+static int parse_simple_program_aos_to_program_text(const char* source, AivmProgram* out_program)
+{
+    int ok;
+    if (out_program == NULL) {
+        return simple_fail("missing source/program");
+    }
+    aivm_program_clear(out_program);
+    ok = parse_simple_program_aos_into_program(source, out_program);
+    if (!ok) {
+        aivm_program_free(out_program);
+    }
+    return ok;
+}
+
 static int parse_simple_program_graph_to_program_file(const char* aos_path, AivmProgram* out_program);
 
 static int parse_simple_program_aos_to_program_file(const char* aos_path, AivmProgram* out_program)
@@ -5491,34 +5456,66 @@ static int parse_simple_program_aos_to_program_file(const char* aos_path, AivmPr
     return parse_simple_program_graph_to_program_file(aos_path, out_program);
 }
 
-#define SIMPLE_MAX_SOURCES 64
-#define SIMPLE_MAX_FUNCS 1024
-#define SIMPLE_MAX_FIXUPS 2048
 #define SIMPLE_MAX_LOCALS 1024
 #define SIMPLE_MAX_LOOP_DEPTH 128
 #define SIMPLE_MAX_LOOP_FIXUPS 1024
+#define SIMPLE_MAX_WORKER_ENTRIES 64
 
-typedef struct {
-    char path[PATH_MAX];
-    char* text;
-} SimpleSource;
-
+/* A function compiled into its module's code. [code_start, code_end) is its module-relative
+   instruction range; the fixup and note ranges index the module's call and worker tables.
+   A function that failed to compile keeps its error and only fails the build if linked. */
 typedef struct {
     char name[64];
     char params_raw[256];
     const char* body_start;
     const char* body_end;
-    int source_index;
     int compiled;
-    int compiling;
-    size_t entry_ip;
+    size_t code_start;
+    size_t code_end;
+    size_t fixup_start;
+    size_t fixup_end;
+    size_t note_start;
+    size_t note_end;
+    char* error;
 } SimpleFnDef;
 
 typedef struct {
     size_t instruction_index;
+    size_t arg_count;
     char target[64];
 } SimpleCallFixup;
 
+typedef struct {
+    char name[64];
+} SimpleWorkerNote;
+
+/* Top-level declarations in source order, replayed by the linker so imports and
+   first-definition-wins function names resolve exactly as a whole-graph walk would. */
+typedef struct {
+    char* import_path;
+    size_t fn_index;
+} SimpleDecl;
+
+/* One source file compiled on its own: code and constants for every function it defines,
+   with calls left as named fixups so the unit does not depend on any other file. */
+typedef struct {
+    char hash[33];
+    char export_name[64];
+    AivmProgram code;
+    SimpleFnDef* funcs;
+    size_t func_count;
+    size_t func_capacity;
+    SimpleCallFixup* fixups;
+    size_t fixup_count;
+    size_t fixup_capacity;
+    SimpleWorkerNote* notes;
+    size_t note_count;
+    size_t note_capacity;
+    SimpleDecl* decls;
+    size_t decl_count;
+    size_t decl_capacity;
+} SimpleModule;
+
 typedef struct {
     size_t start_ip;
     size_t break_sites[SIMPLE_MAX_LOOP_FIXUPS];
@@ -5528,17 +5525,11 @@ typedef struct {
 } SimpleLoopFrame;
 
 typedef struct {
+    SimpleModule* module;
     AivmProgram* program;
-    SimpleSource sources[SIMPLE_MAX_SOURCES];
-    size_t source_count;
-    SimpleFnDef funcs[SIMPLE_MAX_FUNCS];
-    size_t func_count;
-    SimpleCallFixup fixups[SIMPLE_MAX_FIXUPS];
-    size_t fixup_count;
     SimpleLoopFrame loop_frames[SIMPLE_MAX_LOOP_DEPTH];
     size_t loop_depth;
     size_t next_local_slot;
-    char entry_export[64];
 } SimpleCompileContext;
 
 typedef struct {
@@ -5580,48 +5571,64 @@ static int simple_emit_empty_string_const(AivmProgram* program)
 }
 static int simple_compile_fn_by_index(SimpleCompileContext* ctx, size_t fn_index);
 
-static int simple_add_source(SimpleCompileContext* ctx, const char* path, const char* text, int* out_index)
+/* Grows a compiler table (sources, functions, fixups) to hold at least `required` items.
+   Returns the possibly moved table, or NULL when allocation fails. */
+static void* simple_grow_table(void* items, size_t* capacity, size_t required, size_t item_size)
 {
-    size_t i;
-    size_t text_len;
-    char* copy;
-    if (ctx == NULL || path == NULL || text == NULL || out_index == NULL) {
-        return 0;
+    void* grown;
+    size_t new_capacity;
+    if (capacity == NULL || item_size == 0U) {
+        return NULL;
     }
-    for (i = 0U; i < ctx->source_count; i += 1U) {
-        if (strcmp(ctx->sources[i].path, path) == 0) {
-            *out_index = (int)i;
-            return 1;
+    if (required <= *capacity && items != NULL) {
+        return items;
+    }
+    new_capacity = (*capacity == 0U) ? 64U : *capacity;
+    while (new_capacity < required) {
+        if (new_capacity > (SIZE_MAX / 2U)) {
+            new_capacity = required;
+            break;
         }
+        new_capacity *= 2U;
     }
-    if (ctx->source_count >= SIMPLE_MAX_SOURCES) {
-        return 0;
+    if (new_capacity > SIZE_MAX / item_size) {
+        return NULL;
     }
-    text_len = strlen(text);
-    copy = (char*)malloc(text_len + 1U);
-    if (copy == NULL) {
-        return 0;
+    grown = realloc(items, new_capacity * item_size);
+    if (grown != NULL) {
+        *capacity = new_capacity;
     }
-    memcpy(copy, text, text_len + 1U);
-    if (snprintf(ctx->sources[ctx->source_count].path, sizeof(ctx->sources[ctx->source_count].path), "%s", path) >=
-        (int)sizeof(ctx->sources[ctx->source_count].path)) {
-        free(copy);
-        return 0;
+    return grown;
+}
+
+static void simple_module_release(SimpleModule* module)
+{
+    size_t i;
+    if (module == NULL) {
+        return;
     }
-    ctx->sources[ctx->source_count].text = copy;
-    *out_index = (int)ctx->source_count;
-    ctx->source_count += 1U;
-    return 1;
+    for (i = 0U; i < module->func_count; i += 1U) {
+        free(module->funcs[i].error);
+    }
+    for (i = 0U; i < module->decl_count; i += 1U) {
+        free(module->decls[i].import_path);
+    }
+    free(module->funcs);
+    free(module->fixups);
+    free(module->notes);
+    free(module->decls);
+    aivm_program_free(&module->code);
+    memset(module, 0, sizeof(*module));
 }
 
-static int simple_find_func(SimpleCompileContext* ctx, const char* name, size_t* out_index)
+static int simple_module_find_func(const SimpleModule* module, const char* name, size_t* out_index)
 {
     size_t i;
-    if (ctx == NULL || name == NULL || out_index == NULL) {
+    if (module == NULL || name == NULL || out_index == NULL) {
         return 0;
     }
-    for (i = 0U; i < ctx->func_count; i += 1U) {
-        if (strcmp(ctx->funcs[i].name, name) == 0) {
+    for (i = 0U; i < module->func_count; i += 1U) {
+        if (strcmp(module->funcs[i].name, name) == 0) {
             *out_index = i;
             return 1;
         }
@@ -5629,41 +5636,61 @@ static int simple_find_func(SimpleCompileContext* ctx, const char* name, size_t*
     return 0;
 }
 
-static int simple_add_func(
-    SimpleCompileContext* ctx,
+static int simple_module_add_decl(SimpleModule* module, const char* import_path, size_t fn_index)
+{
+    SimpleDecl* grown;
+    char* copy = NULL;
+    grown = (SimpleDecl*)simple_grow_table(module->decls, &module->decl_capacity, module->decl_count + 1U, sizeof(SimpleDecl));
+    if (grown == NULL) {
+        return 0;
+    }
+    module->decls = grown;
+    if (import_path != NULL) {
+        copy = (char*)malloc(strlen(import_path) + 1U);
+        if (copy == NULL) {
+            return 0;
+        }
+        memcpy(copy, import_path, strlen(import_path) + 1U);
+    }
+    module->decls[module->decl_count].import_path = copy;
+    module->decls[module->decl_count].fn_index = fn_index;
+    module->decl_count += 1U;
+    return 1;
+}
+
+/* Adds a function definition; a repeated name within one module keeps the first body. */
+static int simple_module_add_func(
+    SimpleModule* module,
     const char* name,
     const char* params_raw,
     const char* body_start,
-    const char* body_end,
-    int source_index)
+    const char* body_end)
 {
-    if (ctx == NULL || name == NULL || params_raw == NULL || body_start == NULL || body_end == NULL) {
+    SimpleFnDef* grown;
+    SimpleFnDef* fn;
+    if (module == NULL || name == NULL || params_raw == NULL) {
         return 0;
     }
-    if (ctx->func_count >= SIMPLE_MAX_FUNCS) {
+    if (simple_module_find_func(module, name, &(size_t){0})) {
+        return 1;
+    }
+    grown = (SimpleFnDef*)simple_grow_table(module->funcs, &module->func_capacity, module->func_count + 1U, sizeof(SimpleFnDef));
+    if (grown == NULL) {
         return 0;
     }
-    if (simple_find_func(ctx, name, &(size_t){0})) {
-        return 1;
+    module->funcs = grown;
+    fn = &module->funcs[module->func_count];
+    memset(fn, 0, sizeof(*fn));
+    if (snprintf(fn->name, sizeof(fn->name), "%s", name) >= (int)sizeof(fn->name) ||
+        snprintf(fn->params_raw, sizeof(fn->params_raw), "%s", params_raw) >= (int)sizeof(fn->params_raw)) {
+        return 0;
     }
-    if (snprintf(ctx->funcs[ctx->func_count].name, sizeof(ctx->funcs[ctx->func_count].name), "%s", name) >=
-        (int)sizeof(ctx->funcs[ctx->func_count].name)) {
+    fn->body_start = body_start;
+    fn->body_end = body_end;
+    if (!simple_module_add_decl(module, NULL, module->func_count)) {
         return 0;
     }
-    if (snprintf(
-            ctx->funcs[ctx->func_count].params_raw,
-            sizeof(ctx->funcs[ctx->func_count].params_raw),
-            "%s",
-            params_raw) >= (int)sizeof(ctx->funcs[ctx->func_count].params_raw)) {
-        return 0;
-    }
-    ctx->funcs[ctx->func_count].body_start = body_start;
-    ctx->funcs[ctx->func_count].body_end = body_end;
-    ctx->funcs[ctx->func_count].source_index = source_index;
-    ctx->funcs[ctx->func_count].compiled = 0;
-    ctx->funcs[ctx->func_count].compiling = 0;
-    ctx->funcs[ctx->func_count].entry_ip = 0U;
-    ctx->func_count += 1U;
+    module->func_count += 1U;
     return 1;
 }
 
@@ -5715,20 +5742,26 @@ static int simple_param_count(const char* raw, size_t* out_count)
     return simple_split_params(raw, params, out_count);
 }
 
-static int simple_add_fixup(SimpleCompileContext* ctx, size_t instruction_index, const char* target)
+static int simple_add_fixup(SimpleCompileContext* ctx, size_t instruction_index, const char* target, size_t arg_count)
 {
-    if (ctx == NULL || target == NULL) {
+    SimpleModule* module;
+    SimpleCallFixup* grown;
+    if (ctx == NULL || ctx->module == NULL || target == NULL) {
         return 0;
     }
-    if (ctx->fixup_count >= SIMPLE_MAX_FIXUPS) {
+    module = ctx->module;
+    grown = (SimpleCallFixup*)simple_grow_table(module->fixups, &module->fixup_capacity, module->fixup_count + 1U, sizeof(SimpleCallFixup));
+    if (grown == NULL) {
         return 0;
     }
-    ctx->fixups[ctx->fixup_count].instruction_index = instruction_index;
-    if (snprintf(ctx->fixups[ctx->fixup_count].target, sizeof(ctx->fixups[ctx->fixup_count].target), "%s", target) >=
-        (int)sizeof(ctx->fixups[ctx->fixup_count].target)) {
+    module->fixups = grown;
+    module->fixups[module->fixup_count].instruction_index = instruction_index;
+    module->fixups[module->fixup_count].arg_count = arg_count;
+    if (snprintf(module->fixups[module->fixup_count].target, sizeof(module->fixups[module->fixup_count].target), "%s", target) >=
+        (int)sizeof(module->fixups[module->fixup_count].target)) {
         return 0;
     }
-    ctx->fixup_count += 1U;
+    module->fixup_count += 1U;
     return 1;
 }
 
@@ -5751,8 +5784,9 @@ static int simple_resolve_path(const char* base_file, const char* import_path, c
 }
 
 typedef struct {
-    char paths[SIMPLE_MAX_SOURCES][PATH_MAX];
+    char** paths;
     size_t count;
+    size_t capacity;
 } SourceGraphSet;
 
 static void source_graph_hash_update_u64(uint64_t* state, const unsigned char* bytes, size_t len)
@@ -5783,23 +5817,39 @@ static int source_graph_set_contains(const SourceGraphSet* set, const char* path
 
 static int source_graph_set_add(SourceGraphSet* set, const char* path)
 {
+    char** grown;
     if (set == NULL || path == NULL) {
         return 0;
     }
     if (source_graph_set_contains(set, path)) {
         return 1;
     }
-    if (set->count >= SIMPLE_MAX_SOURCES) {
+    grown = (char**)simple_grow_table(set->paths, &set->capacity, set->count + 1U, sizeof(char*));
+    if (grown == NULL) {
         return 0;
     }
-    if (snprintf(set->paths[set->count], sizeof(set->paths[set->count]), "%s", path) >=
-        (int)sizeof(set->paths[set->count])) {
+    set->paths = grown;
+    set->paths[set->count] = (char*)malloc(strlen(path) + 1U);
+    if (set->paths[set->count] == NULL) {
         return 0;
     }
+    memcpy(set->paths[set->count], path, strlen(path) + 1U);
     set->count += 1U;
     return 1;
 }
 
+static void source_graph_set_release(SourceGraphSet* set)
+{
+    size_t i;
+    for (i = 0U; i < set->count; i += 1U) {
+        free(set->paths[i]);
+    }
+    free(set->paths);
+    set->paths = NULL;
+    set->count = 0U;
+    set->capacity = 0U;
+}
+
 static void source_graph_hash_update_pair(
     uint64_t* state_a,
     uint64_t* state_b,
@@ -5818,59 +5868,133 @@ static void source_graph_hash_update_pair_text(uint64_t* state_a, uint64_t* stat
     source_graph_hash_update_pair(state_a, state_b, (const unsigned char*)text, strlen(text));
 }
 
-static int source_graph_hash_file(
-    const char* path,
-    SourceGraphSet* visited,
-    uint64_t* hash_state_a,
-    uint64_t* hash_state_b)
+/* Last seen size and mtime of a source file with its content hash and raw import paths, so
+   an unchanged file is neither re-read nor re-hashed when the graph cache key is computed. */
+typedef struct {
+    char* path;
+    uint64_t size;
+    int64_t mtime_ns;
+    char hash[33];
+    char* imports;
+    int verified;
+} SourceStamp;
+
+typedef struct {
+    SourceStamp* items;
+    size_t count;
+    size_t capacity;
+    int dirty;
+} SourceStampTable;
+
+#define SOURCE_STAMP_TABLE_MAGIC "ailang-source-stamps-v1"
+
+static void source_stamp_table_release(SourceStampTable* table)
 {
-    unsigned char* text_bytes = NULL;
-    size_t text_len = 0U;
-    char* text = NULL;
-    const char* program_pos;
-    const char* open_brace;
-    const char* close_brace;
-    const char* cursor;
-    if (path == NULL || visited == NULL || hash_state_a == NULL || hash_state_b == NULL) {
-        return 0;
+    size_t i;
+    if (table == NULL) {
+        return;
     }
-    if (source_graph_set_contains(visited, path)) {
-        return 1;
+    for (i = 0U; i < table->count; i += 1U) {
+        free(table->items[i].path);
+        free(table->items[i].imports);
     }
-    if (!source_graph_set_add(visited, path)) {
-        return 0;
+    free(table->items);
+    memset(table, 0, sizeof(*table));
+}
+
+static SourceStamp* source_stamp_find(SourceStampTable* table, const char* path)
+{
+    size_t i;
+    if (table == NULL || path == NULL) {
+        return NULL;
     }
-    if (!read_binary_file(path, &text_bytes, &text_len)) {
-        return 0;
+    for (i = 0U; i < table->count; i += 1U) {
+        if (strcmp(table->items[i].path, path) == 0) {
+            return &table->items[i];
+        }
     }
-    text = (char*)malloc(text_len + 1U);
-    if (text == NULL) {
-        free(text_bytes);
-        return 0;
+    return NULL;
+}
+
+static SourceStamp* source_stamp_add(SourceStampTable* table, const char* path)
+{
+    SourceStamp* grown;
+    SourceStamp* stamp;
+    grown = (SourceStamp*)simple_grow_table(table->items, &table->capacity, table->count + 1U, sizeof(SourceStamp));
+    if (grown == NULL) {
+        return NULL;
     }
-    if (text_len > 0U) {
-        memcpy(text, text_bytes, text_len);
+    table->items = grown;
+    stamp = &table->items[table->count];
+    memset(stamp, 0, sizeof(*stamp));
+    stamp->path = (char*)malloc(strlen(path) + 1U);
+    stamp->imports = (char*)calloc(1U, 1U);
+    if (stamp->path == NULL || stamp->imports == NULL) {
+        free(stamp->path);
+        free(stamp->imports);
+        return NULL;
     }
-    text[text_len] = '\0';
-    free(text_bytes);
+    memcpy(stamp->path, path, strlen(path) + 1U);
+    table->count += 1U;
+    return stamp;
+}
 
-    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, "file:");
-    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, path);
-    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, "\n");
-    source_graph_hash_update_pair(hash_state_a, hash_state_b, (const unsigned char*)text, text_len);
-    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, "\n");
+static int64_t source_stamp_mtime_ns(const struct stat* st)
+{
+#if defined(_WIN32)
+    return (int64_t)st->st_mtime * 1000000000LL;
+#elif defined(__APPLE__)
+    return (int64_t)st->st_mtimespec.tv_sec * 1000000000LL + (int64_t)st->st_mtimespec.tv_nsec;
+#else
+    return (int64_t)st->st_mtim.tv_sec * 1000000000LL + (int64_t)st->st_mtim.tv_nsec;
+#endif
+}
+
+/* Module hash: compiler identity plus file content. The path is left out so a module unit
+   stays valid when its project directory moves. */
+static void source_text_hash(const char* text, size_t text_len, char out_hex[33])
+{
+    uint64_t hash_state_a = 1469598103934665603ULL;
+    uint64_t hash_state_b = 1099511628211ULL;
+    source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, AIRUN_NATIVE_CACHE_SCHEMA);
+    source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, "|compiler=");
+    source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, AIRUN_NATIVE_COMPILER_FINGERPRINT);
+    source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, "|module\n");
+    source_graph_hash_update_pair(&hash_state_a, &hash_state_b, (const unsigned char*)text, text_len);
+    (void)snprintf(
+        out_hex,
+        33U,
+        "%016llx%016llx",
+        (unsigned long long)hash_state_a,
+        (unsigned long long)hash_state_b);
+}
 
+/* Collects the raw Import paths of a source as '\n'-terminated entries. */
+static int source_text_imports(const char* text, char** out_imports)
+{
+    const char* program_pos;
+    const char* open_brace;
+    const char* close_brace;
+    const char* cursor;
+    char* imports;
+    size_t used = 0U;
+    size_t capacity = 0U;
+    imports = (char*)simple_grow_table(NULL, &capacity, 1U, 1U);
+    if (imports == NULL) {
+        return 0;
+    }
+    imports[0] = '\0';
     program_pos = strstr(text, "Program#");
     if (program_pos == NULL) {
         program_pos = strstr(text, "Program");
     }
     if (program_pos == NULL) {
-        free(text);
+        *out_imports = imports;
         return 1;
     }
     open_brace = strchr(program_pos, '{');
     if (open_brace == NULL || !simple_find_matching_brace(open_brace, text + strlen(text), &close_brace)) {
-        free(text);
+        free(imports);
         return 0;
     }
     cursor = open_brace + 1;
@@ -5881,43 +6005,251 @@ static int source_graph_hash_file(
         }
         if (strcmp(node.kind, "Import") == 0) {
             char import_path[PATH_MAX];
-            char resolved[PATH_MAX];
-            if (!parse_attr_span(node.attrs, "path", import_path, sizeof(import_path))) {
-                free(text);
-                return 0;
-            }
-            if (!simple_resolve_path(path, import_path, resolved, sizeof(resolved))) {
-                free(text);
+            size_t len;
+            char* grown;
+            if (!parse_attr_span(node.attrs, "path", import_path, sizeof(import_path)) ||
+                strchr(import_path, '\n') != NULL || strchr(import_path, '\t') != NULL) {
+                free(imports);
                 return 0;
             }
-            if (!source_graph_hash_file(resolved, visited, hash_state_a, hash_state_b)) {
-                free(text);
+            len = strlen(import_path);
+            grown = (char*)simple_grow_table(imports, &capacity, used + len + 2U, 1U);
+            if (grown == NULL) {
+                free(imports);
                 return 0;
             }
+            imports = grown;
+            memcpy(&imports[used], import_path, len);
+            imports[used + len] = '\n';
+            imports[used + len + 1U] = '\0';
+            used += len + 1U;
         }
         cursor = node.next;
     }
+    *out_imports = imports;
+    return 1;
+}
+
+/* Brings the stamp for `path` up to date: a size and mtime match reuses the recorded hash
+   and imports; anything else re-reads and re-hashes the file. */
+static int source_stamp_refresh(SourceStampTable* table, const char* path, SourceStamp** out_stamp)
+{
+    struct stat st;
+    SourceStamp* stamp;
+    unsigned char* bytes = NULL;
+    size_t size = 0U;
+    char* text;
+    char* imports = NULL;
+    if (table == NULL || path == NULL || out_stamp == NULL || stat(path, &st) != 0) {
+        return 0;
+    }
+    stamp = source_stamp_find(table, path);
+    if (stamp != NULL &&
+        stamp->size == (uint64_t)st.st_size &&
+        stamp->mtime_ns == source_stamp_mtime_ns(&st) &&
+        stamp->hash[0] != '\0') {
+        stamp->verified = 1;
+        *out_stamp = stamp;
+        return 1;
+    }
+    if (!read_binary_file(path, &bytes, &size)) {
+        return 0;
+    }
+    text = (char*)realloc(bytes, size + 1U);
+    if (text == NULL) {
+        free(bytes);
+        return 0;
+    }
+    text[size] = '\0';
+    if (!source_text_imports(text, &imports)) {
+        free(text);
+        return 0;
+    }
+    if (stamp == NULL && (stamp = source_stamp_add(table, path)) == NULL) {
+        free(imports);
+        free(text);
+        return 0;
+    }
+    source_text_hash(text, size, stamp->hash);
     free(text);
+    free(stamp->imports);
+    stamp->imports = imports;
+    stamp->size = (uint64_t)st.st_size;
+    stamp->mtime_ns = source_stamp_mtime_ns(&st);
+    stamp->verified = 1;
+    table->dirty = 1;
+    *out_stamp = stamp;
     return 1;
 }
 
-static int compute_source_graph_cache_key(const char* source_aos, char* out_hex, size_t out_hex_len)
+static void source_stamp_table_load(SourceStampTable* table, const char* stamps_path)
+{
+    unsigned char* bytes = NULL;
+    size_t size = 0U;
+    char* text;
+    char* line;
+    if (table == NULL || stamps_path == NULL || !read_binary_file(stamps_path, &bytes, &size)) {
+        return;
+    }
+    text = (char*)realloc(bytes, size + 1U);
+    if (text == NULL) {
+        free(bytes);
+        return;
+    }
+    text[size] = '\0';
+    line = text;
+    if (strncmp(line, SOURCE_STAMP_TABLE_MAGIC "\n", strlen(SOURCE_STAMP_TABLE_MAGIC) + 1U) != 0) {
+        free(text);
+        return;
+    }
+    line += strlen(SOURCE_STAMP_TABLE_MAGIC) + 1U;
+    while (*line != '\0') {
+        char* end = strchr(line, '\n');
+        char* fields[4];
+        char* imports;
+        char* cursor;
+        size_t i;
+        SourceStamp* stamp;
+        if (end == NULL) {
+            break;
+        }
+        *end = '\0';
+        cursor = line;
+        for (i = 0U; i < 4U && cursor != NULL; i += 1U) {
+            fields[i] = cursor;
+            cursor = strchr(cursor, '\t');
+            if (cursor != NULL) {
+                *cursor = '\0';
+                cursor += 1;
+            }
+        }
+        if (i == 4U && strlen(fields[2]) == 32U && source_stamp_find(table, fields[3]) == NULL &&
+            (stamp = source_stamp_add(table, fields[3])) != NULL) {
+            stamp->size = (uint64_t)strtoull(fields[0], NULL, 10);
+            stamp->mtime_ns = (int64_t)strtoll(fields[1], NULL, 10);
+            memcpy(stamp->hash, fields[2], 33U);
+            if (cursor != NULL && (imports = (char*)malloc(strlen(cursor) + 2U)) != NULL) {
+                char* tab;
+                memcpy(imports, cursor, strlen(cursor) + 1U);
+                while ((tab = strchr(imports, '\t')) != NULL) {
+                    *tab = '\n';
+                }
+                strcat(imports, "\n");
+                free(stamp->imports);
+                stamp->imports = imports;
+            }
+        }
+        line = end + 1;
+    }
+    free(text);
+}
+
+/* Stamps of files modified in the last two seconds are not persisted: a later edit within
+   the same mtime tick could otherwise keep the stale hash. */
+static void source_stamp_table_save(const SourceStampTable* table, const char* stamps_path)
+{
+    FILE* f;
+    size_t i;
+    int64_t now_ns = (int64_t)time(NULL) * 1000000000LL;
+    if (table == NULL || stamps_path == NULL || !table->dirty) {
+        return;
+    }
+    f = fopen(stamps_path, "wb");
+    if (f == NULL) {
+        return;
+    }
+    fprintf(f, "%s\n", SOURCE_STAMP_TABLE_MAGIC);
+    for (i = 0U; i < table->count; i += 1U) {
+        const SourceStamp* stamp = &table->items[i];
+        const char* import_path;
+        if (stamp->hash[0] == '\0' ||
+            stamp->mtime_ns > now_ns - 2000000000LL ||
+            (!stamp->verified && !file_exists(stamp->path)) ||
+            strchr(stamp->path, '\t') != NULL ||
+            strchr(stamp->path, '\n') != NULL) {
+            continue;
+        }
+        fprintf(
+            f,
+            "%llu\t%lld\t%s\t%s",
+            (unsigned long long)stamp->size,
+            (long long)stamp->mtime_ns,
+            stamp->hash,
+            stamp->path);
+        for (import_path = stamp->imports; *import_path != '\0';) {
+            const char* end = strchr(import_path, '\n');
+            fprintf(f, "\t%.*s", (int)(end - import_path), import_path);
+            import_path = end + 1;
+        }
+        fputc('\n', f);
+    }
+    fclose(f);
+}
+
+static int source_graph_hash_file(
+    const char* path,
+    SourceGraphSet* visited,
+    SourceStampTable* stamps,
+    uint64_t* hash_state_a,
+    uint64_t* hash_state_b)
+{
+    SourceStamp* stamp;
+    const char* import_path;
+    if (path == NULL || visited == NULL || stamps == NULL || hash_state_a == NULL || hash_state_b == NULL) {
+        return 0;
+    }
+    if (source_graph_set_contains(visited, path)) {
+        return 1;
+    }
+    if (!source_graph_set_add(visited, path) || !source_stamp_refresh(stamps, path, &stamp)) {
+        return 0;
+    }
+    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, "file:");
+    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, path);
+    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, "\n");
+    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, stamp->hash);
+    source_graph_hash_update_pair_text(hash_state_a, hash_state_b, "\n");
+    /* The imports buffer stays put while recursion grows the stamp table. */
+    import_path = stamp->imports;
+    while (*import_path != '\0') {
+        const char* end = strchr(import_path, '\n');
+        char raw[PATH_MAX];
+        char resolved[PATH_MAX];
+        size_t len = (size_t)(end - import_path);
+        if (len >= sizeof(raw)) {
+            return 0;
+        }
+        memcpy(raw, import_path, len);
+        raw[len] = '\0';
+        if (!simple_resolve_path(path, raw, resolved, sizeof(resolved)) ||
+            !source_graph_hash_file(resolved, visited, stamps, hash_state_a, hash_state_b)) {
+            return 0;
+        }
+        import_path = end + 1;
+    }
+    return 1;
+}
+
+static int compute_source_graph_cache_key(
+    const char* source_aos,
+    SourceStampTable* stamps,
+    char* out_hex,
+    size_t out_hex_len)
 {
     uint64_t hash_state_a = 1469598103934665603ULL;
     uint64_t hash_state_b = 1099511628211ULL;
     SourceGraphSet visited;
-    char cap_text[64];
-    if (source_aos == NULL || out_hex == NULL || out_hex_len < 33U) {
+    int hashed;
+    if (source_aos == NULL || stamps == NULL || out_hex == NULL || out_hex_len < 33U) {
         return 0;
     }
     memset(&visited, 0, sizeof(visited));
     source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, AIRUN_NATIVE_CACHE_SCHEMA);
     source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, "|compiler=");
     source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, AIRUN_NATIVE_COMPILER_FINGERPRINT);
-    source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, "|inst-cap=");
-    (void)snprintf(cap_text, sizeof(cap_text), "%u", (unsigned)AIVM_PROGRAM_MAX_INSTRUCTIONS);
-    source_graph_hash_update_pair_text(&hash_state_a, &hash_state_b, cap_text);
-    if (!source_graph_hash_file(source_aos, &visited, &hash_state_a, &hash_state_b)) {
+    hashed = source_graph_hash_file(source_aos, &visited, stamps, &hash_state_a, &hash_state_b);
+    source_graph_set_release(&visited);
+    if (!hashed) {
         return 0;
     }
     (void)snprintf(
@@ -5970,42 +6302,81 @@ static int ensure_cache_root_for_source(const char* source_aos, char* out_root,
     return 1;
 }
 
-static int simple_collect_from_file(SimpleCompileContext* ctx, const char* path, int allow_entry_export)
-{
-    char text[131072];
+/* Appends instructions [start, end) of `source` to `program`: jumps are rebased onto the new
+   position and the constants they load are re-interned into `program`. */
+static int simple_append_code(
+    AivmProgram* program,
+    const AivmProgram* source,
+    size_t start,
+    size_t end,
+    const char* fn_name)
+{
+    size_t base = program->instruction_count;
+    size_t ip;
+    if (!aivm_program_reserve_instructions(program, base + (end - start))) {
+        return simple_fail("emit instruction: instruction storage allocation failed");
+    }
+    for (ip = start; ip < end; ip += 1U) {
+        AivmInstruction inst = source->instructions[ip];
+        if (inst.opcode == AIVM_OP_JUMP || inst.opcode == AIVM_OP_JUMP_IF_FALSE) {
+            if (inst.operand_int < (int64_t)start || inst.operand_int > (int64_t)end) {
+                return simple_failf("link: jump out of range in %s", fn_name);
+            }
+            inst.operand_int = inst.operand_int - (int64_t)start + (int64_t)base;
+        } else if (inst.opcode == AIVM_OP_CONST) {
+            AivmValue value;
+            size_t const_index = 0U;
+            if (inst.operand_int < 0 || (size_t)inst.operand_int >= source->constant_count) {
+                return simple_failf("link: constant out of range in %s", fn_name);
+            }
+            value = source->constants[inst.operand_int];
+            if (value.type == AIVM_VAL_STRING) {
+                if (!simple_add_string_const(program, value.string_value, &const_index)) {
+                    return 0;
+                }
+            } else {
+                if (!aivm_program_reserve_constants(program, program->constant_count + 1U)) {
+                    return simple_fail("link: constant storage allocation failed");
+                }
+                const_index = program->constant_count;
+                program->constant_storage[const_index] = value;
+                program->constant_count += 1U;
+            }
+            inst.operand_int = (int64_t)const_index;
+        }
+        if (!simple_emit_instruction(program, inst.opcode, inst.operand_int)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Collects one source file into `module`: its imports, first export and function
+   definitions in source order. Function bodies still point into `text`; imports are
+   recorded for the linker rather than followed, so the result depends on this file alone. */
+static int simple_collect_module_text(SimpleModule* module, const char* path, const char* text)
+{
     const char* program_pos;
     const char* open_brace;
     const char* close_brace;
     const char* cursor;
     const char* trace;
-    int source_index = -1;
 
-    if (ctx == NULL || path == NULL) {
+    if (module == NULL || path == NULL || text == NULL) {
         return simple_fail("collect: invalid args");
     }
     trace = getenv("AIVM_NATIVE_BUILD_TRACE");
-    if (!read_text_file(path, text, sizeof(text))) {
-        return simple_failf("collect: failed reading %s", path);
-    }
-    if (!simple_add_source(ctx, path, text, &source_index)) {
-        return simple_failf("collect: failed adding source %s", path);
-    }
-    /* already collected previously */
-    if (ctx->sources[(size_t)source_index].text != NULL &&
-        ctx->sources[(size_t)source_index].text != text) {
-        /* continue; collection idempotence is handled by func dedupe */
-    }
+    aivm_program_clear(&module->code);
 
-    program_pos = strstr(ctx->sources[(size_t)source_index].text, "Program#");
+    program_pos = strstr(text, "Program#");
     if (program_pos == NULL) {
-        program_pos = strstr(ctx->sources[(size_t)source_index].text, "Program");
+        program_pos = strstr(text, "Program");
     }
     if (program_pos == NULL) {
         return simple_failf("collect: missing Program in %s", path);
     }
     open_brace = strchr(program_pos, '{');
-    if (open_brace == NULL ||
-        !simple_find_matching_brace(open_brace, ctx->sources[(size_t)source_index].text + strlen(ctx->sources[(size_t)source_index].text), &close_brace)) {
+    if (open_brace == NULL || !simple_find_matching_brace(open_brace, text + strlen(text), &close_brace)) {
         return simple_failf("collect: malformed Program braces in %s", path);
     }
     cursor = open_brace + 1;
@@ -6022,7 +6393,7 @@ static int simple_collect_from_file(SimpleCompileContext* ctx, const char* path,
             return simple_failf(
                 "collect: parse failed in %s near offset %llu",
                 path,
-                (unsigned long long)(rest - ctx->sources[(size_t)source_index].text));
+                (unsigned long long)(rest - text));
         }
         if (trace != NULL && trace[0] != '\0') {
             fprintf(
@@ -6030,33 +6401,28 @@ static int simple_collect_from_file(SimpleCompileContext* ctx, const char* path,
                 "[airun-native-compile] collect-node kind=%s source=%s start=%llu next=%llu end=%llu\n",
                 node.kind,
                 path,
-                (unsigned long long)(cursor - ctx->sources[(size_t)source_index].text),
-                (unsigned long long)(node.next - ctx->sources[(size_t)source_index].text),
-                (unsigned long long)(close_brace - ctx->sources[(size_t)source_index].text));
+                (unsigned long long)(cursor - text),
+                (unsigned long long)(node.next - text),
+                (unsigned long long)(close_brace - text));
         }
         if (strcmp(node.kind, "Import") == 0) {
             char import_path[PATH_MAX];
-            char resolved[PATH_MAX];
             if (!parse_attr_span(node.attrs, "path", import_path, sizeof(import_path))) {
                 return simple_failf("collect: import missing path in %s", path);
             }
-            if (!simple_resolve_path(path, import_path, resolved, sizeof(resolved))) {
-                return simple_failf("collect: import resolve failed for %s from %s", import_path, path);
-            }
-            if (!simple_collect_from_file(ctx, resolved, 0)) {
-                return 0;
+            if (!simple_module_add_decl(module, import_path, 0U)) {
+                return simple_failf("collect: failed adding import %s from %s", import_path, path);
             }
             cursor = node.next;
             continue;
         }
         if (strcmp(node.kind, "Export") == 0) {
             char export_name[64];
-            if (allow_entry_export &&
-                ctx->entry_export[0] == '\0' &&
+            if (module->export_name[0] == '\0' &&
                 parse_attr_span(node.attrs, "name", export_name, sizeof(export_name))) {
-                (void)snprintf(ctx->entry_export, sizeof(ctx->entry_export), "%s", export_name);
+                (void)snprintf(module->export_name, sizeof(module->export_name), "%s", export_name);
                 if (trace != NULL && trace[0] != '\0') {
-                    fprintf(stderr, "[airun-native-compile] collect-export=%s source=%s\n", ctx->entry_export, path);
+                    fprintf(stderr, "[airun-native-compile] collect-export=%s source=%s\n", module->export_name, path);
                 }
             }
             cursor = node.next;
@@ -6074,7 +6440,7 @@ static int simple_collect_from_file(SimpleCompileContext* ctx, const char* path,
                 if (!parse_attr_span(expr.attrs, "params", params_raw, sizeof(params_raw))) {
                     params_raw[0] = '\0';
                 }
-                if (!simple_add_func(ctx, let_name, params_raw, expr.body_start, expr.body_end, source_index)) {
+                if (!simple_module_add_func(module, let_name, params_raw, expr.body_start, expr.body_end)) {
                     return simple_failf("collect: failed adding function %s from %s", let_name, path);
                 }
                 if (trace != NULL && trace[0] != '\0') {
@@ -6089,6 +6455,102 @@ static int simple_collect_from_file(SimpleCompileContext* ctx, const char* path,
     return 1;
 }
 
+/* Compiles one function body into `fragment`, a single-function module with its own code,
+   constants, fixups and worker notes. Fragments share no state, so any thread can build one.
+   A body that fails to compile leaves an empty fragment carrying the error. */
+static int simple_compile_fragment(SimpleCompileContext* ctx, const SimpleFnDef* def, SimpleModule* fragment)
+{
+    SimpleFnDef* fn;
+    memset(fragment, 0, sizeof(*fragment));
+    aivm_program_clear(&fragment->code);
+    fragment->funcs = (SimpleFnDef*)calloc(1U, sizeof(SimpleFnDef));
+    if (fragment->funcs == NULL) {
+        return simple_fail("collect: function fragment allocation failed");
+    }
+    fragment->func_count = 1U;
+    fragment->func_capacity = 1U;
+    fn = &fragment->funcs[0];
+    memcpy(fn->name, def->name, sizeof(fn->name));
+    memcpy(fn->params_raw, def->params_raw, sizeof(fn->params_raw));
+    fn->body_start = def->body_start;
+    fn->body_end = def->body_end;
+    ctx->module = fragment;
+    ctx->program = &fragment->code;
+    ctx->loop_depth = 0U;
+    ctx->next_local_slot = 0U;
+    if (!simple_compile_fn_by_index(ctx, 0U)) {
+        const char* detail = simple_last_error();
+        char message[sizeof(g_simple_last_error)];
+        if (strcmp(detail, "unknown") == 0) {
+            (void)snprintf(message, sizeof(message), "function %s failed to compile", fn->name);
+        } else {
+            (void)snprintf(message, sizeof(message), "%s", detail);
+        }
+        fn->error = (char*)malloc(strlen(message) + 1U);
+        if (fn->error == NULL) {
+            return simple_fail("collect: failed recording compile error");
+        }
+        memcpy(fn->error, message, strlen(message) + 1U);
+        fragment->code.instruction_count = 0U;
+        fragment->fixup_count = 0U;
+        fragment->note_count = 0U;
+        fn->code_start = 0U;
+        fn->code_end = 0U;
+        fn->fixup_start = 0U;
+        fn->fixup_end = 0U;
+        fn->note_start = 0U;
+        fn->note_end = 0U;
+        g_simple_last_error[0] = '\0';
+    }
+    return 1;
+}
+
+/* Appends a compiled fragment to its module as function `fn_index`. Fragments are merged in
+   function order, so a module's unit is the same however its bodies were scheduled. */
+static int simple_module_merge_fragment(SimpleModule* module, size_t fn_index, SimpleModule* fragment)
+{
+    SimpleFnDef* fn = &module->funcs[fn_index];
+    SimpleFnDef* compiled = &fragment->funcs[0];
+    size_t base = module->code.instruction_count;
+    size_t i;
+    fn->code_start = base;
+    fn->fixup_start = module->fixup_count;
+    fn->note_start = module->note_count;
+    if (!simple_append_code(&module->code, &fragment->code, compiled->code_start, compiled->code_end, fn->name)) {
+        return 0;
+    }
+    for (i = compiled->fixup_start; i < compiled->fixup_end; i += 1U) {
+        SimpleCallFixup* grown = (SimpleCallFixup*)simple_grow_table(
+            module->fixups, &module->fixup_capacity, module->fixup_count + 1U, sizeof(SimpleCallFixup));
+        if (grown == NULL) {
+            return simple_fail("collect: fixup table allocation failed");
+        }
+        module->fixups = grown;
+        module->fixups[module->fixup_count] = fragment->fixups[i];
+        module->fixups[module->fixup_count].instruction_index += base - compiled->code_start;
+        module->fixup_count += 1U;
+    }
+    for (i = compiled->note_start; i < compiled->note_end; i += 1U) {
+        SimpleWorkerNote* grown = (SimpleWorkerNote*)simple_grow_table(
+            module->notes, &module->note_capacity, module->note_count + 1U, sizeof(SimpleWorkerNote));
+        if (grown == NULL) {
+            return simple_fail("collect: worker note allocation failed");
+        }
+        module->notes = grown;
+        module->notes[module->note_count] = fragment->notes[i];
+        module->note_count += 1U;
+    }
+    fn->compiled = compiled->compiled;
+    fn->code_end = module->code.instruction_count;
+    fn->fixup_end = module->fixup_count;
+    fn->note_end = module->note_count;
+    fn->error = compiled->error;
+    compiled->error = NULL;
+    fn->body_start = NULL;
+    fn->body_end = NULL;
+    return 1;
+}
+
 static int simple_locals_lookup(SimpleLocals* locals, const char* name, size_t* out_slot, int create_if_missing)
 {
     size_t i;
@@ -6142,6 +6604,34 @@ static int simple_compile_var_expr(
     return simple_emit_instruction(program, AIVM_OP_LOAD_LOCAL, (int64_t)idx);
 }
 
+/* A sys.worker.start whose task is a literal naming a program function makes that
+ * function a worker entry: it is linked even when nothing calls it directly and
+ * listed in the program's worker entry table (see simple_emit_worker_entries).
+ * The module only records the literal; the linker checks it against the graph. */
+static int simple_note_worker_entry(const SimpleNodeView* node, SimpleCompileContext* ctx)
+{
+    SimpleModule* module = ctx->module;
+    SimpleNodeView task_node;
+    SimpleWorkerNote* grown;
+    char raw[128];
+    char name[64];
+    if (!simple_parse_next_node(node->body_start, node->body_end, &task_node) ||
+        strcmp(task_node.kind, "Lit") != 0 ||
+        !parse_attr_value_is_quoted(task_node.attrs, "value") ||
+        !parse_attr_span(task_node.attrs, "value", raw, sizeof(raw)) ||
+        !unescape_string(raw, name, sizeof(name))) {
+        return 1;
+    }
+    grown = (SimpleWorkerNote*)simple_grow_table(module->notes, &module->note_capacity, module->note_count + 1U, sizeof(SimpleWorkerNote));
+    if (grown == NULL) {
+        return simple_fail("failed storing worker entry");
+    }
+    module->notes = grown;
+    (void)snprintf(module->notes[module->note_count].name, sizeof(module->notes[0].name), "%s", name);
+    module->note_count += 1U;
+    return 1;
+}
+
 static int simple_compile_call_ext(
     const SimpleNodeView* node,
     AivmProgram* program,
@@ -6178,6 +6668,9 @@ static int simple_compile_call_ext(
         if (!simple_emit_instruction(program, AIVM_OP_CONST, (int64_t)target_idx)) {
             return simple_fail("failed emitting syscall target const");
         }
+        if (strcmp(target, "sys.worker.start") == 0 && !simple_note_worker_entry(node, ctx)) {
+            return 0;
+        }
         c = node->body_start;
         while (simple_parse_next_node(c, node->body_end, &arg)) {
             if (arg_count >= 32U) {
@@ -6193,7 +6686,6 @@ static int simple_compile_call_ext(
             return simple_fail("failed emitting CALL_SYS");
         }
     } else {
-        size_t fn_index;
         size_t call_inst_index;
         c = node->body_start;
         while (simple_parse_next_node(c, node->body_end, &arg)) {
@@ -6206,32 +6698,13 @@ static int simple_compile_call_ext(
             arg_count += 1U;
             c = arg.next;
         }
-        if (!simple_find_func(ctx, target, &fn_index)) {
-            return simple_failf("unknown function target: %s", target);
-        }
-        {
-            size_t param_count = 0U;
-            if (!simple_param_count(ctx->funcs[fn_index].params_raw, &param_count)) {
-                return simple_failf("failed parsing params for target: %s", target);
-            }
-            if (arg_count != param_count) {
-                return simple_failf(
-                    "call target %s expects %llu args, got %llu",
-                    target,
-                    (unsigned long long)param_count,
-                    (unsigned long long)arg_count);
-            }
-        }
+        /* Target and arity are checked at link time, when the whole graph is known. */
         call_inst_index = program->instruction_count;
         if (!simple_emit_instruction(program, AIVM_OP_CALL, 0)) {
             return simple_fail("failed emitting CALL");
         }
-        if (ctx->funcs[fn_index].compiled) {
-            program->instruction_storage[call_inst_index].operand_int = (int64_t)ctx->funcs[fn_index].entry_ip;
-        } else {
-            if (!simple_add_fixup(ctx, call_inst_index, target)) {
-                return simple_fail("failed storing call fixup");
-            }
+        if (!simple_add_fixup(ctx, call_inst_index, target, arg_count)) {
+            return simple_fail("failed storing call fixup");
         }
     }
 
@@ -6784,20 +7257,18 @@ static int simple_compile_fn_by_index(SimpleCompileContext* ctx, size_t fn_index
     int did_return = 0;
     const char* trace;
     size_t before_count = 0U;
-    if (ctx == NULL || fn_index >= ctx->func_count || ctx->program == NULL) {
+    if (ctx == NULL || ctx->module == NULL || fn_index >= ctx->module->func_count || ctx->program == NULL) {
         return 0;
     }
-    fn = &ctx->funcs[fn_index];
+    fn = &ctx->module->funcs[fn_index];
     trace = getenv("AIVM_NATIVE_BUILD_TRACE");
     if (fn->compiled) {
         return 1;
     }
-    if (fn->compiling) {
-        return 1;
-    }
-    fn->compiling = 1;
     before_count = ctx->program->instruction_count;
-    fn->entry_ip = ctx->program->instruction_count;
+    fn->code_start = before_count;
+    fn->fixup_start = ctx->module->fixup_count;
+    fn->note_start = ctx->module->note_count;
     if (trace != NULL && trace[0] != '\0') {
         fprintf(
             stderr,
@@ -6817,41 +7288,917 @@ static int simple_compile_fn_by_index(SimpleCompileContext* ctx, size_t fn_index
             return simple_failf("failed to allocate param %s", params[i]);
         }
     }
-    for (i = param_count; i > 0U; i -= 1U) {
-        size_t slot = 0U;
-        if (!simple_locals_lookup(&locals, params[i - 1U], &slot, 0) ||
-            !simple_emit_instruction(ctx->program, AIVM_OP_STORE_LOCAL, (int64_t)slot)) {
-            return simple_failf("failed param prologue for %s", fn->name);
+    for (i = param_count; i > 0U; i -= 1U) {
+        size_t slot = 0U;
+        if (!simple_locals_lookup(&locals, params[i - 1U], &slot, 0) ||
+            !simple_emit_instruction(ctx->program, AIVM_OP_STORE_LOCAL, (int64_t)slot)) {
+            return simple_failf("failed param prologue for %s", fn->name);
+        }
+    }
+    if (!simple_parse_next_node(fn->body_start, fn->body_end, &block_node) ||
+        strcmp(block_node.kind, "Block") != 0) {
+        return simple_failf("function %s missing Block body", fn->name);
+    }
+    if (!simple_compile_block_ext(&block_node, ctx->program, &locals, ctx, &did_return)) {
+        return 0;
+    }
+    if (!did_return) {
+        if (!simple_emit_instruction(ctx->program, AIVM_OP_RETURN, 0)) {
+            return simple_failf("failed implicit return for %s", fn->name);
+        }
+    }
+    fn->compiled = 1;
+    fn->code_end = ctx->program->instruction_count;
+    fn->fixup_end = ctx->module->fixup_count;
+    fn->note_end = ctx->module->note_count;
+    if (trace != NULL && trace[0] != '\0') {
+        fprintf(
+            stderr,
+            "[airun-native-compile] fn=%s inst_before=%llu inst_after=%llu\n",
+            fn->name,
+            (unsigned long long)before_count,
+            (unsigned long long)ctx->program->instruction_count);
+    }
+    return 1;
+}
+
+static int write_program_as_aibc1(const AivmProgram* program, const char* out_path);
+
+/* Number of modules compiled from source (not loaded from the module cache) by this process. */
+static size_t g_simple_modules_compiled = 0U;
+
+#define SIMPLE_MODULE_CACHE_MAGIC "ailang-native-module-v1"
+
+/* Module units live under <cache_root>/modules as <hash>.aibc1 (code and constants, omitted
+   when the module has no code) next to <hash>.aimod, a tab-separated listing of the export,
+   declarations in source order, call fixups and worker notes. */
+static int simple_module_cache_paths(
+    const char* cache_dir,
+    const char* hash,
+    char* out_code_path,
+    size_t out_code_path_len,
+    char* out_meta_path,
+    size_t out_meta_path_len)
+{
+    char name[48];
+    (void)snprintf(name, sizeof(name), "%s.aibc1", hash);
+    if (!join_path(cache_dir, name, out_code_path, out_code_path_len)) {
+        return 0;
+    }
+    (void)snprintf(name, sizeof(name), "%s.aimod", hash);
+    return join_path(cache_dir, name, out_meta_path, out_meta_path_len);
+}
+
+static int simple_module_field_ok(const char* value)
+{
+    return value != NULL && strchr(value, '\t') == NULL && strchr(value, '\n') == NULL && strchr(value, '\r') == NULL;
+}
+
+static void simple_module_store(const SimpleModule* module, const char* cache_dir)
+{
+    char code_path[PATH_MAX];
+    char meta_path[PATH_MAX];
+    FILE* f;
+    size_t i;
+    if (module == NULL || cache_dir == NULL || module->hash[0] == '\0' ||
+        !simple_module_cache_paths(cache_dir, module->hash, code_path, sizeof(code_path), meta_path, sizeof(meta_path)) ||
+        !simple_module_field_ok(module->export_name)) {
+        return;
+    }
+    for (i = 0U; i < module->decl_count; i += 1U) {
+        const SimpleDecl* decl = &module->decls[i];
+        if ((decl->import_path != NULL && !simple_module_field_ok(decl->import_path)) ||
+            (decl->import_path == NULL &&
+             (!simple_module_field_ok(module->funcs[decl->fn_index].name) ||
+              !simple_module_field_ok(module->funcs[decl->fn_index].params_raw)))) {
+            return;
+        }
+    }
+    for (i = 0U; i < module->note_count; i += 1U) {
+        if (!simple_module_field_ok(module->notes[i].name)) {
+            return;
+        }
+    }
+    if (module->code.instruction_count > 0U && !write_program_as_aibc1(&module->code, code_path)) {
+        return;
+    }
+    f = fopen(meta_path, "wb");
+    if (f == NULL) {
+        return;
+    }
+    fprintf(
+        f,
+        "%s\t%llu\t%llu\n",
+        SIMPLE_MODULE_CACHE_MAGIC,
+        (unsigned long long)module->code.instruction_count,
+        (unsigned long long)module->code.constant_count);
+    if (module->export_name[0] != '\0') {
+        fprintf(f, "export\t%s\n", module->export_name);
+    }
+    for (i = 0U; i < module->decl_count; i += 1U) {
+        const SimpleDecl* decl = &module->decls[i];
+        const SimpleFnDef* fn;
+        const char* error;
+        if (decl->import_path != NULL) {
+            fprintf(f, "import\t%s\n", decl->import_path);
+            continue;
+        }
+        fn = &module->funcs[decl->fn_index];
+        fprintf(
+            f,
+            "fn\t%llu\t%llu\t%llu\t%llu\t%llu\t%llu\t%s\t%s\t",
+            (unsigned long long)fn->code_start,
+            (unsigned long long)fn->code_end,
+            (unsigned long long)fn->fixup_start,
+            (unsigned long long)fn->fixup_end,
+            (unsigned long long)fn->note_start,
+            (unsigned long long)fn->note_end,
+            fn->name,
+            fn->params_raw);
+        for (error = fn->error; error != NULL && *error != '\0'; error += 1) {
+            fputc((*error == '\t' || *error == '\n' || *error == '\r') ? ' ' : *error, f);
+        }
+        fputc('\n', f);
+    }
+    for (i = 0U; i < module->fixup_count; i += 1U) {
+        fprintf(
+            f,
+            "call\t%llu\t%llu\t%s\n",
+            (unsigned long long)module->fixups[i].instruction_index,
+            (unsigned long long)module->fixups[i].arg_count,
+            module->fixups[i].target);
+    }
+    for (i = 0U; i < module->note_count; i += 1U) {
+        fprintf(f, "worker\t%s\n", module->notes[i].name);
+    }
+    fprintf(f, "end\n");
+    fclose(f);
+}
+
+/* Splits a metadata line into at most `max_fields` tab-separated fields; the last one keeps
+   any remaining text. */
+static size_t simple_module_split_fields(char* line, char** fields, size_t max_fields)
+{
+    size_t count = 0U;
+    char* cursor = line;
+    while (cursor != NULL && count < max_fields) {
+        fields[count] = cursor;
+        count += 1U;
+        if (count == max_fields) {
+            break;
+        }
+        cursor = strchr(cursor, '\t');
+        if (cursor != NULL) {
+            *cursor = '\0';
+            cursor += 1;
+        }
+    }
+    return count;
+}
+
+static int simple_module_parse_size(const char* text, size_t* out_value)
+{
+    char* end = NULL;
+    unsigned long long value;
+    if (text == NULL || text[0] < '0' || text[0] > '9') {
+        return 0;
+    }
+    value = strtoull(text, &end, 10);
+    if (end == NULL || *end != '\0' || value > (unsigned long long)SIZE_MAX) {
+        return 0;
+    }
+    *out_value = (size_t)value;
+    return 1;
+}
+
+static int simple_module_load_meta(SimpleModule* module, char* text, size_t* out_instruction_count, size_t* out_constant_count)
+{
+    char* line = text;
+    int header_seen = 0;
+    int end_seen = 0;
+    size_t i;
+    while (*line != '\0' && !end_seen) {
+        char* end = strchr(line, '\n');
+        char* fields[10];
+        size_t count;
+        if (end == NULL) {
+            return 0;
+        }
+        *end = '\0';
+        count = simple_module_split_fields(line, fields, 10U);
+        if (!header_seen) {
+            if (count != 3U || strcmp(fields[0], SIMPLE_MODULE_CACHE_MAGIC) != 0 ||
+                !simple_module_parse_size(fields[1], out_instruction_count) ||
+                !simple_module_parse_size(fields[2], out_constant_count)) {
+                return 0;
+            }
+            header_seen = 1;
+        } else if (strcmp(fields[0], "export") == 0 && count == 2U) {
+            (void)snprintf(module->export_name, sizeof(module->export_name), "%s", fields[1]);
+        } else if (strcmp(fields[0], "import") == 0 && count == 2U) {
+            if (!simple_module_add_decl(module, fields[1], 0U)) {
+                return 0;
+            }
+        } else if (strcmp(fields[0], "fn") == 0 && count == 10U) {
+            SimpleFnDef* fn;
+            size_t before = module->func_count;
+            if (!simple_module_add_func(module, fields[7], fields[8], NULL, NULL) || module->func_count != before + 1U) {
+                return 0;
+            }
+            fn = &module->funcs[before];
+            if (!simple_module_parse_size(fields[1], &fn->code_start) ||
+                !simple_module_parse_size(fields[2], &fn->code_end) ||
+                !simple_module_parse_size(fields[3], &fn->fixup_start) ||
+                !simple_module_parse_size(fields[4], &fn->fixup_end) ||
+                !simple_module_parse_size(fields[5], &fn->note_start) ||
+                !simple_module_parse_size(fields[6], &fn->note_end)) {
+                return 0;
+            }
+            if (fields[9][0] != '\0') {
+                fn->error = (char*)malloc(strlen(fields[9]) + 1U);
+                if (fn->error == NULL) {
+                    return 0;
+                }
+                memcpy(fn->error, fields[9], strlen(fields[9]) + 1U);
+            } else {
+                fn->compiled = 1;
+            }
+        } else if (strcmp(fields[0], "call") == 0 && count == 4U) {
+            SimpleCallFixup* grown = (SimpleCallFixup*)simple_grow_table(
+                module->fixups, &module->fixup_capacity, module->fixup_count + 1U, sizeof(SimpleCallFixup));
+            if (grown == NULL) {
+                return 0;
+            }
+            module->fixups = grown;
+            if (!simple_module_parse_size(fields[1], &module->fixups[module->fixup_count].instruction_index) ||
+                !simple_module_parse_size(fields[2], &module->fixups[module->fixup_count].arg_count) ||
+                snprintf(module->fixups[module->fixup_count].target, sizeof(module->fixups[0].target), "%s", fields[3]) >=
+                    (int)sizeof(module->fixups[0].target)) {
+                return 0;
+            }
+            module->fixup_count += 1U;
+        } else if (strcmp(fields[0], "worker") == 0 && count == 2U) {
+            SimpleWorkerNote* grown = (SimpleWorkerNote*)simple_grow_table(
+                module->notes, &module->note_capacity, module->note_count + 1U, sizeof(SimpleWorkerNote));
+            if (grown == NULL) {
+                return 0;
+            }
+            module->notes = grown;
+            (void)snprintf(module->notes[module->note_count].name, sizeof(module->notes[0].name), "%s", fields[1]);
+            module->note_count += 1U;
+        } else if (strcmp(fields[0], "end") == 0 && count == 1U) {
+            end_seen = 1;
+        } else {
+            return 0;
+        }
+        line = end + 1;
+    }
+    if (!end_seen) {
+        return 0;
+    }
+    for (i = 0U; i < module->func_count; i += 1U) {
+        const SimpleFnDef* fn = &module->funcs[i];
+        if (fn->code_start > fn->code_end || fn->code_end > *out_instruction_count ||
+            fn->fixup_start > fn->fixup_end || fn->fixup_end > module->fixup_count ||
+            fn->note_start > fn->note_end || fn->note_end > module->note_count) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Loads a cached module unit; any missing or inconsistent piece makes it a cache miss. */
+static int simple_module_load(SimpleModule* module, const char* cache_dir, const char* hash)
+{
+    char code_path[PATH_MAX];
+    char meta_path[PATH_MAX];
+    unsigned char* bytes = NULL;
+    size_t size = 0U;
+    char* text;
+    size_t instruction_count = 0U;
+    size_t constant_count = 0U;
+    int ok;
+    if (!simple_module_cache_paths(cache_dir, hash, code_path, sizeof(code_path), meta_path, sizeof(meta_path)) ||
+        !read_binary_file(meta_path, &bytes, &size)) {
+        return 0;
+    }
+    text = (char*)realloc(bytes, size + 1U);
+    if (text == NULL) {
+        free(bytes);
+        return 0;
+    }
+    text[size] = '\0';
+    (void)snprintf(module->hash, sizeof(module->hash), "%s", hash);
+    ok = simple_module_load_meta(module, text, &instruction_count, &constant_count);
+    free(text);
+    if (!ok) {
+        return 0;
+    }
+    if (instruction_count == 0U) {
+        aivm_program_clear(&module->code);
+        return constant_count == 0U;
+    }
+    if (!read_binary_file(code_path, &bytes, &size)) {
+        return 0;
+    }
+    ok = aivm_program_load_aibc1(bytes, size, &module->code).status == AIVM_PROGRAM_OK &&
+        module->code.instruction_count == instruction_count &&
+        module->code.constant_count == constant_count;
+    free(bytes);
+    return ok;
+}
+
+typedef struct {
+    char name[64];
+    SimpleModule* module;
+    size_t fn_index;
+    int placed;
+    size_t entry_ip;
+} SimpleLinkSymbol;
+
+/* A module of the graph being linked: loaded from its cached unit, or collected from `text`
+   and compiled function by function. A module that failed to prepare keeps its error and
+   only fails the build when the linker reaches it. */
+typedef struct {
+    char path[PATH_MAX];
+    SimpleModule module;
+    char* text;
+    int needs_compile;
+    int collected;
+    char error[256];
+} SimpleLinkModule;
+
+/* One function body compiled on its own: any thread fills `fragment`, which is merged into
+   the module afterwards. */
+typedef struct {
+    SimpleLinkModule* entry;
+    size_t fn_index;
+    SimpleModule fragment;
+    int failed;
+    char error[256];
+} SimpleCompileJob;
+
+/* Stitches module units into one program. Modules are visited in import order and function
+   names resolve first-definition-wins across the graph; only functions reachable from the
+   entry export or a worker entry are placed, in the order they are first referenced. */
+typedef struct {
+    AivmProgram* program;
+    SimpleCompileContext* compile[NATIVE_WORKER_MAX_THREADS];
+    const char* cache_dir;
+    SourceStampTable* stamps;
+    const char* root_text;
+    SimpleLinkModule** modules;
+    size_t module_count;
+    size_t module_capacity;
+    size_t prepare_start;
+    SimpleCompileJob* jobs;
+    size_t job_count;
+    SimpleLinkSymbol* symbols;
+    size_t symbol_count;
+    size_t symbol_capacity;
+    SimpleCallFixup* fixups;
+    size_t fixup_count;
+    size_t fixup_capacity;
+    char entry_export[64];
+    char worker_entries[SIMPLE_MAX_WORKER_ENTRIES][64];
+    size_t worker_entry_count;
+} SimpleLinkContext;
+
+static void simple_link_release(SimpleLinkContext* link)
+{
+    size_t i;
+    for (i = 0U; i < link->job_count; i += 1U) {
+        simple_module_release(&link->jobs[i].fragment);
+    }
+    for (i = 0U; i < link->module_count; i += 1U) {
+        simple_module_release(&link->modules[i]->module);
+        free(link->modules[i]->text);
+        free(link->modules[i]);
+    }
+    for (i = 0U; i < NATIVE_WORKER_MAX_THREADS; i += 1U) {
+        free(link->compile[i]);
+        link->compile[i] = NULL;
+    }
+    free(link->jobs);
+    free(link->modules);
+    free(link->symbols);
+    free(link->fixups);
+    link->jobs = NULL;
+    link->modules = NULL;
+    link->symbols = NULL;
+    link->fixups = NULL;
+    link->job_count = 0U;
+    link->module_count = 0U;
+    link->symbol_count = 0U;
+    link->fixup_count = 0U;
+}
+
+static int simple_link_find(const SimpleLinkContext* link, const char* name, size_t* out_index)
+{
+    size_t i;
+    for (i = 0U; i < link->symbol_count; i += 1U) {
+        if (strcmp(link->symbols[i].name, name) == 0) {
+            *out_index = i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static SimpleLinkModule* simple_link_find_module(const SimpleLinkContext* link, const char* path)
+{
+    size_t i;
+    for (i = 0U; i < link->module_count; i += 1U) {
+        if (strcmp(link->modules[i]->path, path) == 0) {
+            return link->modules[i];
+        }
+    }
+    return NULL;
+}
+
+static int simple_link_add_module(SimpleLinkContext* link, const char* path)
+{
+    SimpleLinkModule* entry;
+    SimpleLinkModule** grown;
+    if (simple_link_find_module(link, path) != NULL) {
+        return 1;
+    }
+    grown = (SimpleLinkModule**)simple_grow_table(
+        link->modules, &link->module_capacity, link->module_count + 1U, sizeof(SimpleLinkModule*));
+    if (grown == NULL) {
+        return simple_fail("link: module table allocation failed");
+    }
+    link->modules = grown;
+    entry = (SimpleLinkModule*)calloc(1U, sizeof(SimpleLinkModule));
+    if (entry == NULL) {
+        return simple_fail("link: module allocation failed");
+    }
+    if (snprintf(entry->path, sizeof(entry->path), "%s", path) >= (int)sizeof(entry->path)) {
+        (void)snprintf(entry->error, sizeof(entry->error), "collect: path too long %s", path);
+    }
+    link->modules[link->module_count] = entry;
+    link->module_count += 1U;
+    return 1;
+}
+
+static void simple_link_module_fail(SimpleLinkModule* entry)
+{
+    (void)snprintf(entry->error, sizeof(entry->error), "%s", simple_last_error());
+    simple_module_release(&entry->module);
+    free(entry->text);
+    entry->text = NULL;
+    entry->needs_compile = 0;
+}
+
+/* Loads a module from the cache when its stamp was verified this run, else reads and collects
+   its source. Touches only `entry` and read-only link state, so modules prepare in parallel. */
+static void simple_link_read_module(const SimpleLinkContext* link, SimpleLinkModule* entry)
+{
+    SimpleModule* module = &entry->module;
+    SourceStamp* stamp;
+    unsigned char* bytes = NULL;
+    size_t size = 0U;
+    char* text;
+    if (entry->error[0] != '\0') {
+        return;
+    }
+    stamp = source_stamp_find(link->stamps, entry->path);
+    if (link->cache_dir != NULL && stamp != NULL && stamp->verified &&
+        simple_module_load(module, link->cache_dir, stamp->hash)) {
+        return;
+    }
+    simple_module_release(module);
+    if (link->root_text != NULL && entry == link->modules[0]) {
+        size = strlen(link->root_text);
+        bytes = (unsigned char*)malloc(size + 1U);
+        if (bytes != NULL) {
+            memcpy(bytes, link->root_text, size);
+        }
+    }
+    if (bytes == NULL && !read_binary_file(entry->path, &bytes, &size)) {
+        (void)simple_failf("collect: failed reading %s", entry->path);
+        simple_link_module_fail(entry);
+        return;
+    }
+    text = (char*)realloc(bytes, size + 1U);
+    if (text == NULL) {
+        free(bytes);
+        (void)simple_failf("collect: failed reading %s", entry->path);
+        simple_link_module_fail(entry);
+        return;
+    }
+    text[size] = '\0';
+    entry->text = text;
+    entry->needs_compile = 1;
+    source_text_hash(text, size, module->hash);
+    if (!simple_collect_module_text(module, entry->path, text)) {
+        simple_link_module_fail(entry);
+    }
+}
+
+typedef void (*SimpleParallelJob)(SimpleLinkContext* link, size_t worker, size_t index);
+
+typedef struct {
+    NativeMutex lock;
+    size_t next;
+    size_t count;
+    SimpleParallelJob job;
+    SimpleLinkContext* link;
+} SimpleParallelRun;
+
+typedef struct {
+    SimpleParallelRun* run;
+    size_t worker;
+    NativeThread thread;
+} SimpleParallelHelper;
+
+static void simple_parallel_drain(SimpleParallelRun* run, size_t worker)
+{
+    for (;;) {
+        size_t index;
+        native_mutex_lock(&run->lock);
+        index = run->next;
+        if (index < run->count) {
+            run->next += 1U;
+        }
+        native_mutex_unlock(&run->lock);
+        if (index >= run->count) {
+            return;
+        }
+        run->job(run->link, worker, index);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI simple_parallel_thread(void* arg)
+#else
+static void* simple_parallel_thread(void* arg)
+#endif
+{
+    SimpleParallelHelper* helper = (SimpleParallelHelper*)arg;
+    simple_parallel_drain(helper->run, helper->worker);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/* Runs job(link, worker, 0..count-1) on the calling thread plus up to thread_limit - 1
+   short-lived helpers. Jobs are claimed from a shared cursor; `worker` indexes per-thread
+   scratch state. Callers merge results by index, so scheduling never shows in the output. */
+static void simple_parallel_for(SimpleLinkContext* link, size_t count, size_t thread_limit, SimpleParallelJob job)
+{
+    SimpleParallelRun run;
+    SimpleParallelHelper helpers[NATIVE_WORKER_MAX_THREADS];
+    size_t helper_count = 0U;
+    size_t i;
+    if (thread_limit > count) {
+        thread_limit = count;
+    }
+    if (thread_limit <= 1U) {
+        for (i = 0U; i < count; i += 1U) {
+            job(link, 0U, i);
+        }
+        return;
+    }
+    memset(&run, 0, sizeof(run));
+    native_mutex_init(&run.lock);
+    run.count = count;
+    run.job = job;
+    run.link = link;
+    while (helper_count + 1U < thread_limit) {
+        SimpleParallelHelper* helper = &helpers[helper_count];
+        int started;
+        helper->run = &run;
+        helper->worker = helper_count + 1U;
+#ifdef _WIN32
+        helper->thread = CreateThread(NULL, 0, simple_parallel_thread, helper, 0, NULL);
+        started = helper->thread != NULL;
+#else
+        started = pthread_create(&helper->thread, NULL, simple_parallel_thread, helper) == 0;
+#endif
+        if (!started) {
+            break;
+        }
+        helper_count += 1U;
+    }
+    simple_parallel_drain(&run, 0U);
+    for (i = 0U; i < helper_count; i += 1U) {
+#ifdef _WIN32
+        (void)WaitForSingleObject(helpers[i].thread, INFINITE);
+        CloseHandle(helpers[i].thread);
+#else
+        (void)pthread_join(helpers[i].thread, NULL);
+#endif
+    }
+    native_mutex_destroy(&run.lock);
+}
+
+static void simple_link_prepare_job(SimpleLinkContext* link, size_t worker, size_t index)
+{
+    (void)worker;
+    simple_link_read_module(link, link->modules[link->prepare_start + index]);
+}
+
+static void simple_link_compile_job(SimpleLinkContext* link, size_t worker, size_t index)
+{
+    SimpleCompileJob* job = &link->jobs[index];
+    if (link->compile[worker] == NULL) {
+        link->compile[worker] = (SimpleCompileContext*)calloc(1U, sizeof(SimpleCompileContext));
+    }
+    if (link->compile[worker] == NULL) {
+        (void)simple_fail("link: compile context allocation failed");
+    } else if (simple_compile_fragment(link->compile[worker], &job->entry->module.funcs[job->fn_index], &job->fragment)) {
+        return;
+    }
+    job->failed = 1;
+    (void)snprintf(job->error, sizeof(job->error), "%s", simple_last_error());
+}
+
+/* Prepares every module reachable from `aos_path` before linking. Import levels are read and
+   collected in parallel, then all function bodies of uncached modules compile in parallel
+   into fragments. Fragments merge serially in module and function order, which keeps module
+   units, and the linked program, identical to a single-threaded build.
+   AIRUN_COMPILE_THREADS caps the threads used (default: CPU count). */
+static int simple_link_prepare(SimpleLinkContext* link, const char* aos_path)
+{
+    const char* trace = getenv("AIVM_NATIVE_BUILD_TRACE");
+    size_t thread_limit = native_thread_limit_from_env("AIRUN_COMPILE_THREADS");
+    size_t level_start = 0U;
+    size_t job_index;
+    size_t i;
+    size_t f;
+    if (!simple_link_add_module(link, aos_path)) {
+        return 0;
+    }
+    while (level_start < link->module_count) {
+        size_t level_end = link->module_count;
+        link->prepare_start = level_start;
+        simple_parallel_for(link, level_end - level_start, thread_limit, simple_link_prepare_job);
+        for (i = level_start; i < level_end; i += 1U) {
+            const SimpleLinkModule* entry = link->modules[i];
+            const SimpleModule* module = &entry->module;
+            if (entry->error[0] != '\0') {
+                continue;
+            }
+            if (!entry->needs_compile && trace != NULL && trace[0] != '\0') {
+                fprintf(stderr, "[airun-native-compile] module-cached=%s hash=%s\n", entry->path, module->hash);
+            }
+            for (f = 0U; f < module->decl_count; f += 1U) {
+                char resolved[PATH_MAX];
+                if (module->decls[f].import_path != NULL &&
+                    simple_resolve_path(entry->path, module->decls[f].import_path, resolved, sizeof(resolved)) &&
+                    !simple_link_add_module(link, resolved)) {
+                    return 0;
+                }
+            }
+        }
+        level_start = level_end;
+    }
+
+    for (i = 0U; i < link->module_count; i += 1U) {
+        if (link->modules[i]->needs_compile) {
+            link->job_count += link->modules[i]->module.func_count;
+        }
+    }
+    if (link->job_count > 0U) {
+        link->jobs = (SimpleCompileJob*)calloc(link->job_count, sizeof(SimpleCompileJob));
+        if (link->jobs == NULL) {
+            link->job_count = 0U;
+            return simple_fail("link: compile job allocation failed");
+        }
+    }
+    job_index = 0U;
+    for (i = 0U; i < link->module_count; i += 1U) {
+        if (link->modules[i]->needs_compile) {
+            for (f = 0U; f < link->modules[i]->module.func_count; f += 1U) {
+                link->jobs[job_index].entry = link->modules[i];
+                link->jobs[job_index].fn_index = f;
+                job_index += 1U;
+            }
+        }
+    }
+    simple_parallel_for(link, link->job_count, thread_limit, simple_link_compile_job);
+
+    job_index = 0U;
+    for (i = 0U; i < link->module_count; i += 1U) {
+        SimpleLinkModule* entry = link->modules[i];
+        size_t func_count = entry->module.func_count;
+        int ok = 1;
+        if (!entry->needs_compile) {
+            continue;
+        }
+        for (f = 0U; f < func_count; f += 1U) {
+            SimpleCompileJob* job = &link->jobs[job_index + f];
+            if (ok && job->failed) {
+                (void)simple_fail(job->error);
+                ok = 0;
+            } else if (ok && !simple_module_merge_fragment(&entry->module, f, &job->fragment)) {
+                ok = 0;
+            }
+            simple_module_release(&job->fragment);
+        }
+        job_index += func_count;
+        if (!ok) {
+            simple_link_module_fail(entry);
+            continue;
+        }
+        free(entry->text);
+        entry->text = NULL;
+        g_simple_modules_compiled += 1U;
+        if (trace != NULL && trace[0] != '\0') {
+            fprintf(stderr, "[airun-native-compile] module-compiled=%s hash=%s\n", entry->path, entry->module.hash);
+        }
+        if (link->cache_dir != NULL) {
+            simple_module_store(&entry->module, link->cache_dir);
+        }
+    }
+    return 1;
+}
+
+static int simple_link_collect(SimpleLinkContext* link, const char* path, int is_root)
+{
+    SimpleLinkModule* entry = simple_link_find_module(link, path);
+    SimpleModule* module;
+    size_t i;
+    if (entry == NULL) {
+        return simple_failf("collect: module not prepared %s", path);
+    }
+    if (entry->collected) {
+        return 1;
+    }
+    entry->collected = 1;
+    if (entry->error[0] != '\0') {
+        return simple_fail(entry->error);
+    }
+    module = &entry->module;
+    if (is_root && module->export_name[0] != '\0') {
+        (void)snprintf(link->entry_export, sizeof(link->entry_export), "%s", module->export_name);
+    }
+    for (i = 0U; i < module->decl_count; i += 1U) {
+        const SimpleDecl* decl = &module->decls[i];
+        if (decl->import_path != NULL) {
+            char resolved[PATH_MAX];
+            if (!simple_resolve_path(path, decl->import_path, resolved, sizeof(resolved))) {
+                return simple_failf("collect: import resolve failed for %s from %s", decl->import_path, path);
+            }
+            if (!simple_link_collect(link, resolved, 0)) {
+                return 0;
+            }
+        } else if (!simple_link_find(link, module->funcs[decl->fn_index].name, &(size_t){0})) {
+            SimpleLinkSymbol* grown = (SimpleLinkSymbol*)simple_grow_table(
+                link->symbols, &link->symbol_capacity, link->symbol_count + 1U, sizeof(SimpleLinkSymbol));
+            if (grown == NULL) {
+                return simple_fail("link: symbol table allocation failed");
+            }
+            link->symbols = grown;
+            memset(&link->symbols[link->symbol_count], 0, sizeof(SimpleLinkSymbol));
+            (void)snprintf(
+                link->symbols[link->symbol_count].name,
+                sizeof(link->symbols[0].name),
+                "%s",
+                module->funcs[decl->fn_index].name);
+            link->symbols[link->symbol_count].module = module;
+            link->symbols[link->symbol_count].fn_index = decl->fn_index;
+            link->symbol_count += 1U;
+        }
+    }
+    return 1;
+}
+
+static const SimpleFnDef* simple_link_fn(const SimpleLinkContext* link, size_t symbol_index)
+{
+    return &link->symbols[symbol_index].module->funcs[link->symbols[symbol_index].fn_index];
+}
+
+static int simple_link_add_fixup(SimpleLinkContext* link, size_t instruction_index, const char* target)
+{
+    SimpleCallFixup* grown = (SimpleCallFixup*)simple_grow_table(
+        link->fixups, &link->fixup_capacity, link->fixup_count + 1U, sizeof(SimpleCallFixup));
+    if (grown == NULL) {
+        return 0;
+    }
+    link->fixups = grown;
+    memset(&link->fixups[link->fixup_count], 0, sizeof(SimpleCallFixup));
+    link->fixups[link->fixup_count].instruction_index = instruction_index;
+    (void)snprintf(link->fixups[link->fixup_count].target, sizeof(link->fixups[0].target), "%s", target);
+    link->fixup_count += 1U;
+    return 1;
+}
+
+/* Appends a function's code to the program: jumps are rebased, constants re-interned, and
+   calls resolved now or queued until their target is placed. */
+static int simple_link_place(SimpleLinkContext* link, size_t symbol_index)
+{
+    AivmProgram* program = link->program;
+    const SimpleModule* module = link->symbols[symbol_index].module;
+    const SimpleFnDef* fn = simple_link_fn(link, symbol_index);
+    size_t base = program->instruction_count;
+    size_t i;
+    if (link->symbols[symbol_index].placed) {
+        return 1;
+    }
+    if (fn->error != NULL) {
+        return simple_fail(fn->error);
+    }
+    link->symbols[symbol_index].placed = 1;
+    link->symbols[symbol_index].entry_ip = base;
+    if (!simple_append_code(program, &module->code, fn->code_start, fn->code_end, fn->name)) {
+        return 0;
+    }
+    if (!aivm_program_add_function_name(program, base, fn->name)) {
+        return simple_fail("link: function name allocation failed");
+    }
+    for (i = fn->fixup_start; i < fn->fixup_end; i += 1U) {
+        const SimpleCallFixup* fixup = &module->fixups[i];
+        size_t target_index;
+        size_t param_count = 0U;
+        size_t call_ip;
+        if (fixup->instruction_index < fn->code_start || fixup->instruction_index >= fn->code_end) {
+            return simple_failf("link: call fixup out of range in %s", fn->name);
+        }
+        if (!simple_link_find(link, fixup->target, &target_index)) {
+            return simple_failf("unknown function target: %s", fixup->target);
+        }
+        if (!simple_param_count(simple_link_fn(link, target_index)->params_raw, &param_count)) {
+            return simple_failf("failed parsing params for target: %s", fixup->target);
+        }
+        if (fixup->arg_count != param_count) {
+            return simple_failf(
+                "call target %s expects %llu args, got %llu",
+                fixup->target,
+                (unsigned long long)param_count,
+                (unsigned long long)fixup->arg_count);
+        }
+        call_ip = base + (fixup->instruction_index - fn->code_start);
+        if (link->symbols[target_index].placed) {
+            program->instruction_storage[call_ip].operand_int = (int64_t)link->symbols[target_index].entry_ip;
+        } else if (!simple_link_add_fixup(link, call_ip, fixup->target)) {
+            return simple_fail("failed storing call fixup");
+        }
+    }
+    for (i = fn->note_start; i < fn->note_end; i += 1U) {
+        const char* name = module->notes[i].name;
+        size_t target_index;
+        size_t param_count = 0U;
+        size_t w;
+        int known = 0;
+        if (!simple_link_find(link, name, &target_index)) {
+            continue;
+        }
+        if (!simple_param_count(simple_link_fn(link, target_index)->params_raw, &param_count) || param_count > 1U) {
+            return simple_failf("worker entry %s must take zero or one parameter", name);
+        }
+        for (w = 0U; w < link->worker_entry_count; w += 1U) {
+            if (strcmp(link->worker_entries[w], name) == 0) {
+                known = 1;
+            }
+        }
+        if (known) {
+            continue;
+        }
+        if (link->worker_entry_count >= SIMPLE_MAX_WORKER_ENTRIES) {
+            return simple_fail("worker entry count exceeds native compiler limit");
+        }
+        (void)snprintf(link->worker_entries[link->worker_entry_count], sizeof(link->worker_entries[0]), "%s", name);
+        link->worker_entry_count += 1U;
+    }
+    return 1;
+}
+
+/* Worker entries travel with the program as string constants
+ * "sys.worker.entry:<name>@<entry_ip>/<param_count>" so AiBC1 images resolve them too. */
+static int simple_emit_worker_entries(SimpleLinkContext* link)
+{
+    size_t i;
+    for (i = 0U; i < link->worker_entry_count; i += 1U) {
+        char entry[128];
+        size_t symbol_index;
+        size_t param_count = 0U;
+        size_t const_index;
+        if (!simple_link_find(link, link->worker_entries[i], &symbol_index) ||
+            !link->symbols[symbol_index].placed ||
+            !simple_param_count(simple_link_fn(link, symbol_index)->params_raw, &param_count)) {
+            return simple_failf("worker entry %s was not compiled", link->worker_entries[i]);
         }
-    }
-    if (!simple_parse_next_node(fn->body_start, fn->body_end, &block_node) ||
-        strcmp(block_node.kind, "Block") != 0) {
-        return simple_failf("function %s missing Block body", fn->name);
-    }
-    if (!simple_compile_block_ext(&block_node, ctx->program, &locals, ctx, &did_return)) {
-        return 0;
-    }
-    if (!did_return) {
-        if (!simple_emit_instruction(ctx->program, AIVM_OP_RETURN, 0)) {
-            return simple_failf("failed implicit return for %s", fn->name);
+        (void)snprintf(
+            entry,
+            sizeof(entry),
+            "%s%s@%llu/%llu",
+            NATIVE_WORKER_ENTRY_PREFIX,
+            link->worker_entries[i],
+            (unsigned long long)link->symbols[symbol_index].entry_ip,
+            (unsigned long long)param_count);
+        if (!simple_add_string_const(link->program, entry, &const_index)) {
+            return 0;
         }
     }
-    fn->compiled = 1;
-    fn->compiling = 0;
-    if (trace != NULL && trace[0] != '\0') {
-        fprintf(
-            stderr,
-            "[airun-native-compile] fn=%s inst_before=%llu inst_after=%llu\n",
-            fn->name,
-            (unsigned long long)before_count,
-            (unsigned long long)ctx->program->instruction_count);
-    }
     return 1;
 }
 
-static int parse_simple_program_graph_to_program_file(const char* aos_path, AivmProgram* out_program)
+static int simple_link_program(SimpleLinkContext* link, const char* aos_path, AivmProgram* out_program)
 {
-    SimpleCompileContext ctx;
     size_t entry_index;
     size_t bootstrap_call_ip;
     size_t i;
@@ -6859,31 +8206,25 @@ static int parse_simple_program_graph_to_program_file(const char* aos_path, Aivm
     if (aos_path == NULL || out_program == NULL) {
         return simple_fail("graph compile: invalid args");
     }
-    memset(&ctx, 0, sizeof(ctx));
-    ctx.program = out_program;
-    ctx.next_local_slot = 0U;
+    link->program = out_program;
 
-    if (!simple_collect_from_file(&ctx, aos_path, 1)) {
+    if (!simple_link_prepare(link, aos_path) || !simple_link_collect(link, aos_path, 1)) {
         return 0;
     }
-    if (ctx.entry_export[0] == '\0') {
-        (void)snprintf(ctx.entry_export, sizeof(ctx.entry_export), "%s", "start");
+    if (link->entry_export[0] == '\0') {
+        (void)snprintf(link->entry_export, sizeof(link->entry_export), "%s", "start");
     }
-    if (!simple_find_func(&ctx, ctx.entry_export, &entry_index)) {
-        return simple_failf("entry export '%s' not found", ctx.entry_export);
+    if (!simple_link_find(link, link->entry_export, &entry_index)) {
+        return simple_failf("entry export '%s' not found", link->entry_export);
     }
 
-    aivm_program_clear(out_program);
-    out_program->instructions = out_program->instruction_storage;
-    out_program->constants = out_program->constant_storage;
     out_program->format_version = 2U;
     out_program->format_flags = 0U;
 
     {
-        char params[SIMPLE_MAX_LOCALS][64];
         size_t param_count = 0U;
-        if (!simple_split_params(ctx.funcs[entry_index].params_raw, params, &param_count)) {
-            return simple_failf("graph compile: invalid entry params for %s", ctx.funcs[entry_index].name);
+        if (!simple_param_count(simple_link_fn(link, entry_index)->params_raw, &param_count)) {
+            return simple_failf("graph compile: invalid entry params for %s", link->entry_export);
         }
         if (param_count > 0U) {
             size_t argv_target = 0U;
@@ -6899,39 +8240,113 @@ static int parse_simple_program_graph_to_program_file(const char* aos_path, Aivm
         !simple_emit_instruction(out_program, AIVM_OP_HALT, 0)) {
         return simple_fail("graph compile: failed emitting bootstrap call/halt");
     }
+    if (!aivm_program_add_function_name(out_program, 0U, "[bootstrap]")) {
+        return simple_fail("link: function name allocation failed");
+    }
 
-    if (!simple_compile_fn_by_index(&ctx, entry_index)) {
+    if (!simple_link_place(link, entry_index)) {
         return 0;
     }
-    out_program->instruction_storage[bootstrap_call_ip].operand_int = (int64_t)ctx.funcs[entry_index].entry_ip;
+    out_program->instruction_storage[bootstrap_call_ip].operand_int = (int64_t)link->symbols[entry_index].entry_ip;
 
-    for (i = 0U; i < ctx.fixup_count; i += 1U) {
-        size_t target_index;
-        if (!simple_find_func(&ctx, ctx.fixups[i].target, &target_index)) {
-            return simple_failf("unresolved call target %s", ctx.fixups[i].target);
-        }
-        if (!ctx.funcs[target_index].compiled) {
-            if (!simple_compile_fn_by_index(&ctx, target_index)) {
+    i = 0U;
+    for (;;) {
+        size_t worker_index;
+        int placed_worker_entry = 0;
+        for (; i < link->fixup_count; i += 1U) {
+            size_t target_index;
+            if (!simple_link_find(link, link->fixups[i].target, &target_index)) {
+                return simple_failf("unresolved call target %s", link->fixups[i].target);
+            }
+            if (!simple_link_place(link, target_index)) {
                 return 0;
             }
+            out_program->instruction_storage[link->fixups[i].instruction_index].operand_int =
+                (int64_t)link->symbols[target_index].entry_ip;
+        }
+        for (worker_index = 0U; worker_index < link->worker_entry_count; worker_index += 1U) {
+            size_t target_index;
+            if (simple_link_find(link, link->worker_entries[worker_index], &target_index) &&
+                !link->symbols[target_index].placed) {
+                if (!simple_link_place(link, target_index)) {
+                    return 0;
+                }
+                placed_worker_entry = 1;
+            }
         }
-        if (ctx.fixups[i].instruction_index >= out_program->instruction_count) {
-            return simple_fail("call fixup index out of range");
+        if (!placed_worker_entry && i == link->fixup_count) {
+            break;
         }
-        out_program->instruction_storage[ctx.fixups[i].instruction_index].operand_int =
-            (int64_t)ctx.funcs[target_index].entry_ip;
     }
-
-    for (i = 0U; i < ctx.source_count; i += 1U) {
-        free(ctx.sources[i].text);
-        ctx.sources[i].text = NULL;
+    if (!simple_emit_worker_entries(link)) {
+        return 0;
     }
+
     if (out_program->instruction_count == 0U) {
         return simple_fail("graph compile: produced empty program");
     }
     return 1;
 }
 
+/* Compiles the import graph rooted at `aos_path`. With a module cache directory, modules
+   whose stamps were verified against the source are loaded from their cached units and
+   freshly compiled modules are stored there. A non-NULL `root_text` stands in for the
+   contents of `aos_path` itself. */
+static int simple_link_program_graph_rooted(
+    const char* aos_path,
+    const char* root_text,
+    AivmProgram* out_program,
+    const char* cache_dir,
+    SourceStampTable* stamps)
+{
+    SimpleLinkContext* link;
+    int ok;
+    if (out_program == NULL) {
+        return simple_fail("graph compile: invalid args");
+    }
+    aivm_program_clear(out_program);
+    link = (SimpleLinkContext*)calloc(1U, sizeof(SimpleLinkContext));
+    if (link == NULL) {
+        return simple_fail("graph compile: context allocation failed");
+    }
+    link->cache_dir = cache_dir;
+    link->stamps = stamps;
+    link->root_text = root_text;
+    ok = simple_link_program(link, aos_path, out_program);
+    simple_link_release(link);
+    free(link);
+    if (!ok) {
+        aivm_program_free(out_program);
+    }
+    return ok;
+}
+
+static int simple_link_program_graph(
+    const char* aos_path,
+    AivmProgram* out_program,
+    const char* cache_dir,
+    SourceStampTable* stamps)
+{
+    return simple_link_program_graph_rooted(aos_path, NULL, out_program, cache_dir, stamps);
+}
+
+static int parse_simple_program_graph_to_program_file(const char* aos_path, AivmProgram* out_program)
+{
+    return simple_link_program_graph(aos_path, out_program, NULL, NULL);
+}
+
+/* Compiles in-memory source as if it lived at `virtual_path`; imports still resolve from disk. */
+static int parse_simple_program_graph_to_program_text(
+    const char* virtual_path,
+    const char* source,
+    AivmProgram* out_program)
+{
+    if (source == NULL) {
+        return simple_fail("graph compile: invalid args");
+    }
+    return simple_link_program_graph_rooted(virtual_path, source, out_program, NULL, NULL);
+}
+
 static int run_native_simple_program_aos(
     const char* aos_path,
     const char* const* process_argv,
@@ -6939,16 +8354,19 @@ static int run_native_simple_program_aos(
     const NativeDebugOptions* debug_options)
 {
     AivmProgram program;
+    int rc;
 
     if (!parse_simple_program_aos_to_program_file(aos_path, &program)) {
         return -1;
     }
-    return run_native_compiled_program(
+    rc = run_native_compiled_program(
         &program,
         "Native simple source execution failed.",
         process_argv,
         process_argv_count,
         debug_options);
+    aivm_program_free(&program);
+    return rc;
 }
 
 static int run_native_bytecode_aos(
@@ -6958,16 +8376,19 @@ static int run_native_bytecode_aos(
     const NativeDebugOptions* debug_options)
 {
     AivmProgram program;
+    int rc;
 
     if (!parse_bytecode_aos_to_program_file(aos_path, &program, 0)) {
         return -1;
     }
-    return run_native_compiled_program(
+    rc = run_native_compiled_program(
         &program,
         "Native bytecode program execution failed.",
         process_argv,
         process_argv_count,
         debug_options);
+    aivm_program_free(&program);
+    return rc;
 }
 
 static int run_native_bundle(
@@ -6979,6 +8400,8 @@ static int run_native_bundle(
     return run_native_bytecode_aos(bundle_path, process_argv, process_argv_count, debug_options);
 }
 
+#include "airun_optimize.inc"
+
 static void write_u32_le(FILE* f, uint32_t value)
 {
     uint8_t bytes[4];
@@ -7004,20 +8427,24 @@ static void write_i64_le(FILE* f, int64_t value)
     (void)fwrite(bytes, 1U, 8U, f);
 }
 
+/* Writes the aligned AiBC1 layout: 16-byte instruction records at an 8-byte aligned file
+   offset and NUL-terminated strings, so a mapped file can be executed in place. */
 static int write_program_as_aibc1(const AivmProgram* program, const char* out_path)
 {
     FILE* f;
     uint32_t section_count = 1U;
     uint32_t inst_payload_size;
+    uint32_t record_offset;
     uint32_t const_payload_size = 4U;
+    uint32_t names_payload_size = 4U;
     size_t i;
 
-    if (program == NULL || out_path == NULL || program->instruction_count == 0U) {
+    if (program == NULL || out_path == NULL || program->instruction_count == 0U || program->instructions == NULL) {
         return 0;
     }
 
     for (i = 0U; i < program->constant_count; i += 1U) {
-        AivmValue v = program->constant_storage[i];
+        AivmValue v = program->constants[i];
         if (v.type == AIVM_VAL_INT) {
             const_payload_size += 1U + 8U;
         } else if (v.type == AIVM_VAL_BOOL) {
@@ -7026,10 +8453,10 @@ static int write_program_as_aibc1(const AivmProgram* program, const char* out_pa
             const_payload_size += 1U;
         } else if (v.type == AIVM_VAL_STRING) {
             size_t len = (v.string_value == NULL) ? 0U : strlen(v.string_value);
-            if (len > 0xffffffffU) {
+            if (len > 0xfffffff0U) {
                 return 0;
             }
-            const_payload_size += 1U + 4U + (uint32_t)len;
+            const_payload_size += 1U + 4U + (uint32_t)len + 1U;
         } else if (v.type == AIVM_VAL_BYTES) {
             if (v.bytes_value.length > 0xffffffffU) {
                 return 0;
@@ -7040,13 +8467,24 @@ static int write_program_as_aibc1(const AivmProgram* program, const char* out_pa
         }
     }
     if (program->constant_count > 0U) {
-        section_count = 2U;
+        section_count += 1U;
+    }
+    for (i = 0U; i < program->function_name_count; i += 1U) {
+        names_payload_size += 4U + 4U + (uint32_t)strlen(program->function_names[i].name);
+    }
+    if (program->function_name_count > 0U) {
+        section_count += 1U;
     }
 
-    if (program->instruction_count > (size_t)((0xffffffffU - 4U) / 12U)) {
+    if (program->instruction_count > (size_t)((0xffffffffU - 16U) / AIVM_PROGRAM_ALIGNED_RECORD_SIZE)) {
         return 0;
     }
-    inst_payload_size = 4U + (uint32_t)(program->instruction_count * 12U);
+    /* Header (16) + section header (8) + count/offset words (8) keeps records aligned. */
+    record_offset = 8U;
+    while (((16U + 8U + record_offset) % AIVM_PROGRAM_ALIGNED_RECORD_ALIGNMENT) != 0U) {
+        record_offset += 1U;
+    }
+    inst_payload_size = record_offset + (uint32_t)(program->instruction_count * AIVM_PROGRAM_ALIGNED_RECORD_SIZE);
 
     f = fopen(out_path, "wb");
     if (f == NULL) {
@@ -7058,20 +8496,25 @@ static int write_program_as_aibc1(const AivmProgram* program, const char* out_pa
     write_u32_le(f, 0U);
     write_u32_le(f, section_count);
 
-    write_u32_le(f, AIVM_PROGRAM_SECTION_INSTRUCTIONS);
+    write_u32_le(f, AIVM_PROGRAM_SECTION_INSTRUCTIONS_ALIGNED);
     write_u32_le(f, inst_payload_size);
     write_u32_le(f, (uint32_t)program->instruction_count);
+    write_u32_le(f, record_offset);
+    for (i = 8U; i < record_offset; i += 1U) {
+        (void)fputc(0, f);
+    }
     for (i = 0U; i < program->instruction_count; i += 1U) {
-        write_u32_le(f, (uint32_t)program->instruction_storage[i].opcode);
-        write_i64_le(f, program->instruction_storage[i].operand_int);
+        write_u32_le(f, (uint32_t)program->instructions[i].opcode);
+        write_u32_le(f, 0U);
+        write_i64_le(f, program->instructions[i].operand_int);
     }
 
-    if (section_count == 2U) {
-        write_u32_le(f, AIVM_PROGRAM_SECTION_CONSTANTS);
+    if (program->constant_count > 0U) {
+        write_u32_le(f, AIVM_PROGRAM_SECTION_CONSTANTS_ALIGNED);
         write_u32_le(f, const_payload_size);
         write_u32_le(f, (uint32_t)program->constant_count);
         for (i = 0U; i < program->constant_count; i += 1U) {
-            AivmValue v = program->constant_storage[i];
+            AivmValue v = program->constants[i];
             if (v.type == AIVM_VAL_INT) {
                 (void)fputc(1, f);
                 write_i64_le(f, v.int_value);
@@ -7087,6 +8530,7 @@ static int write_program_as_aibc1(const AivmProgram* program, const char* out_pa
                 if (len > 0U) {
                     (void)fwrite(v.string_value, 1U, len, f);
                 }
+                (void)fputc(0, f);
             } else if (v.type == AIVM_VAL_BYTES) {
                 uint32_t len = (uint32_t)v.bytes_value.length;
                 (void)fputc(5, f);
@@ -7100,18 +8544,87 @@ static int write_program_as_aibc1(const AivmProgram* program, const char* out_pa
         }
     }
 
+    if (program->function_name_count > 0U) {
+        write_u32_le(f, AIVM_PROGRAM_SECTION_FUNCTION_NAMES);
+        write_u32_le(f, names_payload_size);
+        write_u32_le(f, (uint32_t)program->function_name_count);
+        for (i = 0U; i < program->function_name_count; i += 1U) {
+            uint32_t len = (uint32_t)strlen(program->function_names[i].name);
+            write_u32_le(f, (uint32_t)program->function_names[i].entry_ip);
+            write_u32_le(f, len);
+            (void)fwrite(program->function_names[i].name, 1U, len, f);
+        }
+    }
+
     if (fclose(f) != 0) {
         return 0;
     }
     return 1;
 }
 
+/* Consumes --ui=<native|headless>, --ui-dump=<dir> and --ui-frames=<n>; 1 consumed, 0 not ours, -1 invalid. */
+static int parse_ui_run_flag(const char* arg, const char** ui_mode, const char** ui_dump_dir, int64_t* ui_frames)
+{
+    if (starts_with(arg, "--ui=")) {
+        if (strcmp(arg + 5, "native") != 0 && strcmp(arg + 5, "headless") != 0) {
+            fprintf(stderr,
+                "Err#err1(code=RUN001 message=\"Invalid --ui value. Expected native or headless.\" nodeId=argv)\n");
+            return -1;
+        }
+        *ui_mode = arg + 5;
+        return 1;
+    }
+    if (starts_with(arg, "--ui-dump=")) {
+        if (arg[10] == '\0') {
+            fprintf(stderr,
+                "Err#err1(code=RUN001 message=\"Missing --ui-dump value.\" nodeId=argv)\n");
+            return -1;
+        }
+        *ui_dump_dir = arg + 10;
+        return 1;
+    }
+    if (starts_with(arg, "--ui-frames=")) {
+        char* end_ptr = NULL;
+        long long parsed = strtoll(arg + 12, &end_ptr, 10);
+        if (end_ptr == arg + 12 || end_ptr == NULL || *end_ptr != '\0' || parsed <= 0) {
+            fprintf(stderr,
+                "Err#err1(code=RUN001 message=\"Invalid --ui-frames value. Expected a positive frame count.\" nodeId=argv)\n");
+            return -1;
+        }
+        *ui_frames = (int64_t)parsed;
+        return 1;
+    }
+    return 0;
+}
+
+static int configure_ui_run_backend(const char* ui_mode, const char* ui_dump_dir, int64_t ui_frames)
+{
+    int headless = ui_mode != NULL && strcmp(ui_mode, "headless") == 0;
+    if ((ui_dump_dir != NULL || ui_frames > 0) && !headless) {
+        fprintf(stderr,
+            "Err#err1(code=RUN001 message=\"--ui-dump and --ui-frames require --ui=headless.\" nodeId=argv)\n");
+        return 0;
+    }
+    (void)native_ui_select_backend(ui_mode);
+    if (headless && !native_headless_ui_configure(ui_dump_dir, ui_frames)) {
+        fprintf(stderr,
+            "Err#err1(code=RUN001 message=\"Could not create --ui-dump directory.\" nodeId=argv)\n");
+        return 0;
+    }
+    return 1;
+}
+
 typedef struct {
     const char* program_path;
     int app_arg_start;
     int app_arg_count;
     int use_cache;
     const char* log_level;
+    const char* ui_mode;
+    const char* ui_dump_dir;
+    int64_t ui_frames;
+    const char* profile_path;
+    int64_t profile_hz;
 } RunTarget;
 
 static int derive_build_out_dir(const char* program_input, char* out_dir, size_t out_dir_len);
@@ -7129,6 +8642,11 @@ static int parse_run_target(int argc, char** argv, int start_index, RunTarget* o
     int app_arg_start = -1;
     int use_cache = 1;
     const char* log_level = NULL;
+    const char* ui_mode = NULL;
+    const char* ui_dump_dir = NULL;
+    int64_t ui_frames = 0;
+    const char* profile_path = NULL;
+    int64_t profile_hz = 1000;
 
     if (out_target == NULL) {
         return 2;
@@ -7159,6 +8677,22 @@ static int parse_run_target(int argc, char** argv, int start_index, RunTarget* o
             log_level = arg + 12;
             continue;
         }
+        if (app_arg_start < 0) {
+            int ui_rc = parse_ui_run_flag(arg, &ui_mode, &ui_dump_dir, &ui_frames);
+            if (ui_rc < 0) {
+                return 2;
+            }
+            if (ui_rc > 0) {
+                continue;
+            }
+            ui_rc = parse_profile_run_flag(arg, &profile_path, &profile_hz);
+            if (ui_rc < 0) {
+                return 2;
+            }
+            if (ui_rc > 0) {
+                continue;
+            }
+        }
         if (app_arg_start < 0 && starts_with(arg, "--vm=")) {
             const char* mode = arg + 5;
             if (strcmp(mode, "c") != 0 && !is_reserved_cv_selector(mode)) {
@@ -7192,6 +8726,11 @@ static int parse_run_target(int argc, char** argv, int start_index, RunTarget* o
     }
     out_target->use_cache = use_cache;
     out_target->log_level = log_level;
+    out_target->ui_mode = ui_mode;
+    out_target->ui_dump_dir = ui_dump_dir;
+    out_target->ui_frames = ui_frames;
+    out_target->profile_path = profile_path;
+    out_target->profile_hz = profile_hz;
     return 0;
 }
 
@@ -7264,6 +8803,11 @@ static int handle_run(int argc, char** argv)
     }
     airun_configure_log_level(target.log_level);
     airun_reset_injected_events();
+    if (!configure_ui_run_backend(target.ui_mode, target.ui_dump_dir, target.ui_frames)) {
+        return 2;
+    }
+    g_native_profile_path = target.profile_path;
+    g_native_profile_hz = target.profile_hz;
 
     if (target.program_path != NULL &&
         !ends_with(target.program_path, ".aibc1") &&
@@ -7323,6 +8867,9 @@ static int handle_debug_run_mode(
     const char* out_dir = default_out_dir;
     const char* debug_mode = "off";
     const char* log_level = default_log_level;
+    const char* ui_mode = NULL;
+    const char* ui_dump_dir = NULL;
+    int64_t ui_frames = 0;
     int use_cache = 1;
     NativeDebugOptions debug_options;
     int rc;
@@ -7363,6 +8910,15 @@ static int handle_debug_run_mode(
             use_cache = 0;
             continue;
         }
+        if (app_arg_start < 0) {
+            int ui_rc = parse_ui_run_flag(arg, &ui_mode, &ui_dump_dir, &ui_frames);
+            if (ui_rc < 0) {
+                return 2;
+            }
+            if (ui_rc > 0) {
+                continue;
+            }
+        }
         if (strcmp(arg, "--debug-mode") == 0 && app_arg_start < 0) {
             if ((i + 1) >= argc) {
                 fprintf(stderr,
@@ -7588,6 +9144,9 @@ static int handle_debug_run_mode(
         app_arg_start = argc;
     }
     airun_configure_log_level(log_level);
+    if (!configure_ui_run_backend(ui_mode, ui_dump_dir, ui_frames)) {
+        return 2;
+    }
     if (debug_options.emit_bundle && out_dir != NULL) {
         debug_options.out_dir = out_dir;
         debug_options.input_path = program_path;
@@ -7887,7 +9446,7 @@ static AIRUN_MAYBE_UNUSED int handle_debug(int argc, char** argv)
                 !parse_simple_program_aos_to_program_file(source_aos, &program)) {
                 fprintf(stderr,
                     "Err#err1(code=RUN001 message=\"Could not compile source input for debug disasm.\" nodeId=disasm)\n");
-                aivm_program_clear(&program);
+                aivm_program_free(&program);
                 return 2;
             }
         } else {
@@ -7907,13 +9466,13 @@ static AIRUN_MAYBE_UNUSED int handle_debug(int argc, char** argv)
                 fprintf(stderr,
                     "Err#err1(code=RUN001 message=\"AiBC1 load failed for debug disasm.\" detail=\"%s\" nodeId=disasm)\n",
                     aivm_program_status_code(load_result.status));
-                aivm_program_clear(&program);
+                aivm_program_free(&program);
                 return 2;
             }
         }
         if (program.instruction_count == 0U) {
             printf("Ok#ok1(type=string value=\"\")\n");
-            aivm_program_clear(&program);
+            aivm_program_free(&program);
             return 0;
         }
         if (argc < 6) {
@@ -7932,7 +9491,7 @@ static AIRUN_MAYBE_UNUSED int handle_debug(int argc, char** argv)
                 aivm_opcode_name(inst->opcode),
                 (long long)inst->operand_int);
         }
-        aivm_program_clear(&program);
+        aivm_program_free(&program);
         return 0;
     }
     if (argc >= 4 && strcmp(argv[2], "dns") == 0) {
@@ -8101,207 +9660,7 @@ static int native_get_current_rss_kb(int64_t* out_kb)
 #endif
 }
 
-static int bench_syscall_sink(
-    const char* target,
-    const AivmValue* args,
-    size_t arg_count,
-    AivmValue* result)
-{
-    (void)target;
-    (void)args;
-    (void)arg_count;
-    if (result == NULL) {
-        return AIVM_SYSCALL_ERR_NULL_RESULT;
-    }
-    *result = aivm_value_void();
-    return AIVM_SYSCALL_OK;
-}
-
-static int bench_execute_program_iterations(const AivmProgram* program, int iterations, uint64_t* out_ticks)
-{
-    AivmSyscallBinding bindings[3];
-    int i;
-    uint64_t ticks = 0U;
-
-    if (program == NULL || out_ticks == NULL || iterations <= 0) {
-        return 0;
-    }
-
-    bindings[0].target = "sys.stdout.writeLine";
-    bindings[0].handler = bench_syscall_sink;
-    bindings[1].target = "io.print";
-    bindings[1].handler = bench_syscall_sink;
-    bindings[2].target = "io.write";
-    bindings[2].handler = bench_syscall_sink;
-
-    for (i = 0; i < iterations; i += 1) {
-        AivmCResult result = aivm_c_execute_program_with_syscalls(program, bindings, 3U);
-        if (!result.loaded || result.load_status != AIVM_PROGRAM_OK || !result.ok || result.status == AIVM_VM_STATUS_ERROR) {
-            return 0;
-        }
-        ticks += (uint64_t)program->instruction_count;
-    }
-
-    *out_ticks = ticks;
-    return 1;
-}
-
-static AIRUN_MAYBE_UNUSED int handle_bench(int argc, char** argv)
-{
-    int iterations = 10000;
-    int human = 0;
-    int i;
-    int failures = 0;
-    AivmInstruction loop_instructions[2];
-    uint64_t runtime_loop_ticks = 0U;
-    uint64_t compiler_program_ticks = 0U;
-    uint64_t compiler_bytecode_ticks = 0U;
-    uint64_t app_hello_ticks = 0U;
-    uint64_t app_echo_ticks = 0U;
-    uint64_t app_bundle_ticks = 0U;
-    const char* compiler_program_status = "ok";
-    const char* compiler_bytecode_status = "ok";
-    const char* runtime_loop_status = "ok";
-    const char* app_hello_status = "ok";
-    const char* app_echo_status = "ok";
-    const char* app_bundle_status = "ok";
-    static const char* program_bench_source =
-        "Program#p1 {\n"
-        "  Let#l1(name=message) { Lit#s1(value=\"Hello from VM\") }\n"
-        "  Call#c1(target=io.print) { Var#v1(name=message) }\n"
-        "}";
-    static const char* bytecode_bench_source =
-        "Bytecode#bc1(magic=\"AIBC\" format=\"AiBC1\" version=2 flags=0) {\n"
-        "  Const#k0(kind=string value=\"hello\")\n"
-        "  Func#f1(name=main params=\"argv\" locals=\"\") {\n"
-        "    Inst#i1(op=HALT)\n"
-        "  }\n"
-        "}";
-    static const char* app_hello_source =
-        "Program#p1 {\n"
-        "  Let#l1(name=message) { Lit#s1(value=\"Hello from VM\") }\n"
-        "  Call#c1(target=io.print) { Var#v1(name=message) }\n"
-        "}";
-    static const char* app_echo_source =
-        "Program#p1 {\n"
-        "  Let#l1(name=line) { Lit#s0(value=\"vm-echo\") }\n"
-        "  Let#l2(name=out) {\n"
-        "    StrConcat#s1 {\n"
-        "      Lit#s2(value=\"echo:\")\n"
-        "      Var#v1(name=line)\n"
-        "    }\n"
-        "  }\n"
-        "  Call#c2(target=io.print) { Var#v2(name=out) }\n"
-        "}";
-    static const char* app_bundle_source =
-        "Bytecode#bc1(flags=0 format=\"AiBC1\" magic=\"AIBC\" version=2) {\n"
-        "  Const#k0(kind=int value=0)\n"
-        "  Func#f_main(locals=\"argv,start\" name=main params=\"argv\") {\n"
-        "    Inst#i0(a=0 op=CONST)\n"
-        "    Inst#i1(a=1 op=STORE_LOCAL)\n"
-        "    Inst#i2(op=RETURN)\n"
-        "  }\n"
-        "}";
-
-    for (i = 2; i < argc; i++) {
-        if (strcmp(argv[i], "--human") == 0) {
-            human = 1;
-            continue;
-        }
-        if (strcmp(argv[i], "--iterations") == 0) {
-            if (i + 1 >= argc || !parse_int(argv[i + 1], &iterations)) {
-                fprintf(stderr,
-                    "Err#err1(code=RUN001 message=\"Invalid --iterations value.\" nodeId=argv)\n");
-                return 2;
-            }
-            i += 1;
-            continue;
-        }
-        fprintf(stderr,
-            "Err#err1(code=RUN001 message=\"Unsupported bench flag.\" nodeId=argv)\n");
-        return 2;
-    }
-
-    loop_instructions[0].opcode = AIVM_OP_PUSH_INT;
-    loop_instructions[0].operand_int = 1;
-    loop_instructions[1].opcode = AIVM_OP_HALT;
-    loop_instructions[1].operand_int = 0;
-
-    for (i = 0; i < iterations; i += 1) {
-        AivmCResult result = aivm_c_execute_instructions(loop_instructions, 2U);
-        if (!result.ok || result.status == AIVM_VM_STATUS_ERROR) {
-            runtime_loop_status = "fail";
-            failures += 1;
-            break;
-        }
-        runtime_loop_ticks += 2U;
-    }
-
-    for (i = 0; i < iterations; i += 1) {
-        AivmProgram program;
-        if (!parse_simple_program_aos_to_program_text(program_bench_source, &program)) {
-            compiler_program_status = "fail";
-            failures += 1;
-            break;
-        }
-        compiler_program_ticks += (uint64_t)(program.instruction_count + program.constant_count);
-    }
-
-    for (i = 0; i < iterations; i += 1) {
-        AivmProgram program;
-        if (!parse_bytecode_aos_to_program_text(bytecode_bench_source, &program, 0)) {
-            compiler_bytecode_status = "fail";
-            failures += 1;
-            break;
-        }
-        compiler_bytecode_ticks += (uint64_t)(program.instruction_count + program.constant_count);
-    }
-
-    {
-        AivmProgram hello_program;
-        if (!parse_simple_program_aos_to_program_text(app_hello_source, &hello_program) ||
-            !bench_execute_program_iterations(&hello_program, iterations, &app_hello_ticks)) {
-            app_hello_status = "fail";
-            failures += 1;
-        }
-    }
-
-    {
-        AivmProgram echo_program;
-        if (!parse_simple_program_aos_to_program_text(app_echo_source, &echo_program) ||
-            !bench_execute_program_iterations(&echo_program, iterations, &app_echo_ticks)) {
-            app_echo_status = "fail";
-            failures += 1;
-        }
-    }
-
-    {
-        AivmProgram bundle_program;
-        if (!parse_bytecode_aos_to_program_text(app_bundle_source, &bundle_program, 0) ||
-            !bench_execute_program_iterations(&bundle_program, iterations, &app_bundle_ticks)) {
-            app_bundle_status = "fail";
-            failures += 1;
-        }
-    }
-
-    if (human) {
-        printf("name\tstatus\tunit\tvalue\n");
-        printf("runtime_loop\t%s\tvm_ticks\t%llu\n", runtime_loop_status, (unsigned long long)runtime_loop_ticks);
-        printf("compiler_parse_program\t%s\tvm_ticks\t%llu\n", compiler_program_status, (unsigned long long)compiler_program_ticks);
-        printf("compiler_parse_bytecode\t%s\tvm_ticks\t%llu\n", compiler_bytecode_status, (unsigned long long)compiler_bytecode_ticks);
-        printf("app_run_hello\t%s\tvm_ticks\t%llu\n", app_hello_status, (unsigned long long)app_hello_ticks);
-        printf("app_run_echo\t%s\tvm_ticks\t%llu\n", app_echo_status, (unsigned long long)app_echo_ticks);
-        printf("app_run_bundle\t%s\tvm_ticks\t%llu\n", app_bundle_status, (unsigned long long)app_bundle_ticks);
-    } else {
-        printf("Ok#ok1(type=int value=%d)\n", iterations - failures);
-    }
-    if (failures > 0) {
-        fprintf(stderr,
-            "Err#err1(code=RUN001 message=\"Native benchmark VM execution failed.\" nodeId=bench)\n");
-        return 3;
-    }
-    return 0;
-}
+#include "airun_bench.inc"
 
 static int derive_build_out_dir(const char* program_input, char* out_dir, size_t out_dir_len)
 {
@@ -8360,11 +9719,18 @@ static int build_input_to_aibc1(
     char source_aos[PATH_MAX];
     char cache_root[PATH_MAX];
     char cache_key[40];
+    char cache_key_after[40];
     char cache_key_dir[PATH_MAX];
     char cache_app_path[PATH_MAX];
+    char modules_dir[PATH_MAX];
+    char stamps_path[PATH_MAX];
+    SourceStampTable stamps;
     AivmProgram program;
     int explicit_aibc1_input;
     int explicit_aos_input;
+    int have_module_cache = 0;
+    int have_cache_key = 0;
+    int ok = 0;
 
     g_native_build_error[0] = '\0';
 
@@ -8421,40 +9787,50 @@ static int build_input_to_aibc1(
         return 0;
     }
 
+    /* Whole-graph artifacts live under <cache_root>/<graph key>/app.aibc1; per-module units and
+       the source stamps that let unchanged files skip hashing live under <cache_root>/modules. */
+    memset(&stamps, 0, sizeof(stamps));
     if (use_cache &&
-        compute_source_graph_cache_key(source_aos, cache_key, sizeof(cache_key)) &&
         ensure_cache_root_for_source(source_aos, cache_root, sizeof(cache_root)) &&
-        join_path(cache_root, cache_key, cache_key_dir, sizeof(cache_key_dir)) &&
-        ensure_directory(cache_key_dir) &&
-        join_path(cache_key_dir, "app.aibc1", cache_app_path, sizeof(cache_app_path)) &&
-        file_exists(cache_app_path) &&
-        is_supported_aibc1_file(cache_app_path)) {
-        if (strcmp(cache_app_path, out_app_path) == 0 || copy_file(cache_app_path, out_app_path)) {
-            return 1;
-        }
+        join_path(cache_root, "modules", modules_dir, sizeof(modules_dir)) &&
+        ensure_directory(modules_dir) &&
+        join_path(modules_dir, "stamps.tsv", stamps_path, sizeof(stamps_path))) {
+        have_module_cache = 1;
+        source_stamp_table_load(&stamps, stamps_path);
+        have_cache_key =
+            compute_source_graph_cache_key(source_aos, &stamps, cache_key, sizeof(cache_key)) &&
+            join_path(cache_root, cache_key, cache_key_dir, sizeof(cache_key_dir)) &&
+            join_path(cache_key_dir, "app.aibc1", cache_app_path, sizeof(cache_app_path));
     }
 
-    if (parse_bytecode_aos_to_program_file(source_aos, &program, 0) ||
-        parse_simple_program_aos_to_program_file(source_aos, &program)) {
+    if (have_cache_key &&
+        file_exists(cache_app_path) &&
+        is_supported_aibc1_file(cache_app_path) &&
+        (strcmp(cache_app_path, out_app_path) == 0 || copy_file(cache_app_path, out_app_path))) {
+        ok = 1;
+    } else if (parse_bytecode_aos_to_program_file(source_aos, &program, 0) ||
+               simple_link_program_graph(
+                   source_aos,
+                   &program,
+                   have_module_cache ? modules_dir : NULL,
+                   have_module_cache ? &stamps : NULL)) {
         if (!write_program_as_aibc1(&program, out_app_path)) {
             set_native_build_errorf(
                 "failed writing app.aibc1 (inst=%llu const=%llu)",
                 (unsigned long long)program.instruction_count,
                 (unsigned long long)program.constant_count);
-            return 0;
-        }
-        if (use_cache &&
-            compute_source_graph_cache_key(source_aos, cache_key, sizeof(cache_key)) &&
-            ensure_cache_root_for_source(source_aos, cache_root, sizeof(cache_root)) &&
-            join_path(cache_root, cache_key, cache_key_dir, sizeof(cache_key_dir)) &&
-            ensure_directory(cache_key_dir) &&
-            join_path(cache_key_dir, "app.aibc1", cache_app_path, sizeof(cache_app_path))) {
-            (void)copy_file(out_app_path, cache_app_path);
+        } else {
+            ok = 1;
+            /* Sources edited during the build change the key; skip publishing a mismatched artifact. */
+            if (have_cache_key &&
+                compute_source_graph_cache_key(source_aos, &stamps, cache_key_after, sizeof(cache_key_after)) &&
+                strcmp(cache_key, cache_key_after) == 0 &&
+                ensure_directory(cache_key_dir)) {
+                (void)copy_file(out_app_path, cache_app_path);
+            }
         }
-        return 1;
-    }
-
-    {
+        aivm_program_free(&program);
+    } else {
         const char* detail = simple_last_error();
         if (detail == NULL || strcmp(detail, "unknown") == 0) {
             set_native_build_errorf("native simple compile failed for %s", source_aos);
@@ -8462,7 +9838,53 @@ static int build_input_to_aibc1(
             set_native_build_error(detail);
         }
     }
-    return 0;
+    if (have_module_cache) {
+        source_stamp_table_save(&stamps, stamps_path);
+    }
+    source_stamp_table_release(&stamps);
+    return ok;
+}
+
+/* Rewrites an emitted app.aibc1 through bytecode_optimize_program. The build cache keeps
+   the unoptimized artifact, so `-O` and plain builds share cache entries. */
+static int optimize_aibc1_file(const char* app_path)
+{
+    unsigned char* bytes = NULL;
+    size_t byte_count = 0U;
+    AivmProgram program;
+    AivmProgramLoadResult load;
+    BytecodeOptimizeStats stats;
+    const char* trace = getenv("AIVM_NATIVE_BUILD_TRACE");
+    int ok;
+
+    if (!read_binary_file(app_path, &bytes, &byte_count)) {
+        set_native_build_error("failed to read app.aibc1 for optimization");
+        return 0;
+    }
+    load = aivm_program_load_aibc1(bytes, byte_count, &program);
+    free(bytes);
+    if (load.status != AIVM_PROGRAM_OK) {
+        set_native_build_errorf("failed to load app.aibc1 for optimization (%s)", aivm_program_status_code(load.status));
+        return 0;
+    }
+    ok = bytecode_optimize_program(&program, &stats);
+    if (!ok) {
+        set_native_build_error("bytecode optimizer ran out of memory");
+    } else if (!write_program_as_aibc1(&program, app_path)) {
+        set_native_build_error("failed writing optimized app.aibc1");
+        ok = 0;
+    } else if (trace != NULL && trace[0] != '\0') {
+        fprintf(
+            stderr,
+            "airun build: optimized inst=%llu->%llu const=%llu->%llu rounds=%llu\n",
+            (unsigned long long)stats.instructions_before,
+            (unsigned long long)stats.instructions_after,
+            (unsigned long long)stats.constants_before,
+            (unsigned long long)stats.constants_after,
+            (unsigned long long)stats.rounds);
+    }
+    aivm_program_free(&program);
+    return ok;
 }
 
 static int delete_directory_recursive_portable(const char* path)
@@ -8582,10 +10004,15 @@ static AIRUN_MAYBE_UNUSED int handle_build(int argc, char** argv)
     char app_path[PATH_MAX];
     char resolved_source_input[PATH_MAX];
     int use_cache = 1;
+    int optimize = 0;
     int i;
     int build_rc;
 
     for (i = 2; i < argc; i += 1) {
+        if (strcmp(argv[i], "-O") == 0) {
+            optimize = 1;
+            continue;
+        }
         if (strcmp(argv[i], "--out") == 0) {
             if (i + 1 >= argc) {
                 fprintf(stderr,
@@ -8627,6 +10054,9 @@ static AIRUN_MAYBE_UNUSED int handle_build(int argc, char** argv)
     }
 
     build_rc = build_input_to_aibc1(build_target_input, out_dir, app_path, sizeof(app_path), use_cache);
+    if (build_rc == 1 && optimize) {
+        build_rc = optimize_aibc1_file(app_path);
+    }
     if (build_rc == 1) {
         printf("Ok#ok1(type=string value=\"%s\")\n", app_path);
         return 0;
@@ -8877,44 +10307,53 @@ static AIRUN_MAYBE_UNUSED int handle_publish(int argc, char** argv)
         if (!join_path(artifact_dir, runtime_bin, runtime_src, sizeof(runtime_src))) {
             fprintf(stderr,
                 "Err#err1(code=RUN001 message=\"Runtime source path overflow.\" nodeId=publish)\n");
+            aivm_program_free(&publish_program);
             return 2;
         }
         if (snprintf(runtime_web_bin, sizeof(runtime_web_bin), "aivm-runtime-wasm32-web.mjs") >= (int)sizeof(runtime_web_bin)) {
             fprintf(stderr,
                 "Err#err1(code=RUN001 message=\"Wasm runtime metadata overflow.\" nodeId=publish)\n");
+            aivm_program_free(&publish_program);
             return 2;
         }
         if (snprintf(runtime_web_wasm_bin, sizeof(runtime_web_wasm_bin), "aivm-runtime-wasm32-web.wasm") >= (int)sizeof(runtime_web_wasm_bin)) {
             fprintf(stderr,
                 "Err#err1(code=RUN001 message=\"Wasm runtime web binary metadata overflow.\" nodeId=publish)\n");
+            aivm_program_free(&publish_program);
             return 2;
         }
         if (!join_path(artifact_dir, runtime_web_bin, runtime_web_src, sizeof(runtime_web_src))) {
             fprintf(stderr,
                 "Err#err1(code=RUN001 message=\"Wasm web runtime source path overflow.\" nodeId=publish)\n");
+            aivm_program_free(&publish_program);
             return 2;
         }
         if (!join_path(artifact_dir, runtime_web_wasm_bin, runtime_web_wasm_src, sizeof(runtime_web_wasm_src))) {
             fprintf(stderr,
                 "Err#err1(code=RUN001 message=\"Wasm web runtime binary source path overflow.\" nodeId=publish)\n");
+            aivm_program_free(&publish_program);
             return 2;
         }
         if (snprintf(publish_runtime_name, sizeof(publish_runtime_name), "%s.wasm", publish_app_name) >= (int)sizeof(publish_runtime_name)) {
             fprintf(stderr,
                 "Err#err1(code=RUN001 message=\"Publish wasm runtime name overflow.\" nodeId=publish)\n");
+            aivm_program_free(&publish_program);
             return 2;
         }
         if (!join_path(out_dir, publish_runtime_name, runtime_dst, sizeof(runtime_dst))) {
             fprintf(stderr,
                 "Err#err1(code=RUN001 message=\"Runtime destination path overflow.\" nodeId=publish)\n");
+            aivm_program_free(&publish_program);
             return 2;
         }
         if (!copy_runtime_file(runtime_src, runtime_dst)) {
             fprintf(stderr,
                 "Err#err1(code=RUN001 message=\"Failed to copy runtime for target RID. Build target runtime first.\" nodeId=publish)\n");
+            aivm_program_free(&publish_program);
             return 2;
         }
         emit_wasm_profile_warnings(wasm_profile, &publish_program);
+        aivm_program_free(&publish_program);
 
         if (strcmp(wasm_profile, "cli") == 0) {
             if (!emit_wasm_cli_launchers(out_dir, publish_runtime_name, publish_app_name)) {
@@ -9036,20 +10475,24 @@ static AIRUN_MAYBE_UNUSED int handle_publish(int argc, char** argv)
     if (!join_path(artifact_dir, runtime_bin, runtime_src, sizeof(runtime_src))) {
         fprintf(stderr,
             "Err#err1(code=RUN001 message=\"Runtime source path overflow.\" nodeId=publish)\n");
+        aivm_program_free(&publish_program);
         return 2;
     }
     if (!join_path(out_dir, publish_runtime_name, runtime_dst, sizeof(runtime_dst))) {
         fprintf(stderr,
             "Err#err1(code=RUN001 message=\"Runtime destination path overflow.\" nodeId=publish)\n");
+        aivm_program_free(&publish_program);
         return 2;
     }
 
     if (!copy_runtime_file(runtime_src, runtime_dst)) {
         fprintf(stderr,
             "Err#err1(code=RUN001 message=\"Failed to copy runtime for target RID. Build target runtime first.\" nodeId=publish)\n");
+        aivm_program_free(&publish_program);
         return 2;
     }
     emit_native_target_capability_warnings(target, &publish_program);
+    aivm_program_free(&publish_program);
 
     printf("Ok#ok1(type=string value=\"publish-complete\")\n");
     return 0;
@@ -21,6 +21,10 @@ void native_host_ui_shutdown(void);
 int native_host_ui_create_window(const char* title, int width, int height, int64_t* out_handle);
 int native_host_ui_close_window(int64_t handle);
 int native_host_ui_begin_frame(int64_t handle);
+/* Nonzero when the window keeps the last frame's pixels, so the runtime may repaint only damaged regions. */
+int native_host_ui_frame_retained(int64_t handle);
+/* Starts a frame that clears and clips drawing to one rectangle until end_frame; 0 means unsupported. */
+int native_host_ui_begin_frame_region(int64_t handle, int x, int y, int width, int height);
 int native_host_ui_end_frame(int64_t handle);
 int native_host_ui_present(int64_t handle);
 int native_host_ui_wait_frame(int64_t handle);
@@ -34,6 +38,20 @@ int native_host_ui_draw_image(
     int height,
     const uint8_t* rgba,
     size_t rgba_length);
+/*
+ * Draws an image from the runtime's decoded-image cache. image_id is stable for
+ * the image's lifetime and never reused within a run, so hosts may keep an
+ * uploaded copy keyed by it until native_host_ui_release_image.
+ */
+int native_host_ui_draw_cached_image(
+    int64_t handle,
+    int x,
+    int y,
+    int64_t image_id,
+    const uint8_t* rgba,
+    int width,
+    int height);
+void native_host_ui_release_image(int64_t image_id);
 int native_host_ui_draw_text(int64_t handle, int x, int y, const char* text, const char* color, int font_size);
 int native_host_ui_draw_line(int64_t handle, int x1, int y1, int x2, int y2, const char* color, int stroke_width);
 int native_host_ui_draw_path(int64_t handle, const char* path, const char* color, int stroke_width);
@@ -1,3 +1,6 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include "airun_ui_host.h"
 #include <string.h>
 
@@ -9,22 +12,53 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 
+/*
+ * Each window renders into an off-screen pixmap; endFrame/present copy it to
+ * the window once, so a frame costs one XCopyArea instead of a visible draw per
+ * primitive and never shows a half-painted state.
+ */
 typedef struct {
     int64_t handle;
     Window window;
     GC gc;
+    Pixmap back_buffer;
+    int back_width;
+    int back_height;
+    int back_dirty;
+    int clip_active;
+    XRectangle clip;
     int close_pending;
     int width;
     int height;
 } NativeUiLinuxWindowSlot;
 
+typedef struct {
+    char name[32];
+    unsigned long pixel;
+} NativeUiLinuxColorEntry;
+
+/* Opaque cached images are uploaded once into server-side pixmaps; pixmap 0 marks a translucent image that still blends per draw. */
+typedef struct {
+    int64_t image_id;
+    Pixmap pixmap;
+    int width;
+    int height;
+} NativeUiLinuxImageEntry;
+
 static Display* g_native_ui_display = NULL;
 static int g_native_ui_screen = 0;
 static Colormap g_native_ui_colormap = 0;
 static int64_t g_native_ui_next_handle = 1;
 static NativeUiLinuxWindowSlot g_native_ui_windows[8];
+/* XAllocColor is a server round-trip, so resolved colors are cached per display. */
+static NativeUiLinuxColorEntry g_native_ui_colors[64];
+static size_t g_native_ui_color_count = 0U;
+static size_t g_native_ui_color_next = 0U;
+static NativeUiLinuxImageEntry g_native_ui_images[32];
+static size_t g_native_ui_image_next = 0U;
 
 static int native_ui_linux_init(void)
 {
@@ -79,18 +113,130 @@ static NativeUiLinuxWindowSlot* native_ui_linux_find_empty_slot(void)
 static unsigned long native_ui_linux_parse_color(const char* color, unsigned long fallback_pixel)
 {
     XColor xcolor;
+    NativeUiLinuxColorEntry* entry;
+    size_t i;
     if (g_native_ui_display == NULL || color == NULL || color[0] == '\0') {
         return fallback_pixel;
     }
+    for (i = 0U; i < g_native_ui_color_count; i += 1U) {
+        if (strcmp(g_native_ui_colors[i].name, color) == 0) {
+            return g_native_ui_colors[i].pixel;
+        }
+    }
     if (XParseColor(g_native_ui_display, g_native_ui_colormap, color, &xcolor) == 0) {
         return fallback_pixel;
     }
     if (XAllocColor(g_native_ui_display, g_native_ui_colormap, &xcolor) == 0) {
         return fallback_pixel;
     }
+    if (strlen(color) < sizeof(g_native_ui_colors[0].name)) {
+        if (g_native_ui_color_count < sizeof(g_native_ui_colors) / sizeof(g_native_ui_colors[0])) {
+            entry = &g_native_ui_colors[g_native_ui_color_count++];
+        } else {
+            entry = &g_native_ui_colors[g_native_ui_color_next];
+            g_native_ui_color_next = (g_native_ui_color_next + 1U) % (sizeof(g_native_ui_colors) / sizeof(g_native_ui_colors[0]));
+        }
+        (void)snprintf(entry->name, sizeof(entry->name), "%s", color);
+        entry->pixel = xcolor.pixel;
+    }
     return xcolor.pixel;
 }
 
+/* Draw target: the back buffer when one exists, else the window itself. */
+static Drawable native_ui_linux_target(NativeUiLinuxWindowSlot* slot)
+{
+    if (slot->back_buffer != 0) {
+        slot->back_dirty = 1;
+        return slot->back_buffer;
+    }
+    return slot->window;
+}
+
+static void native_ui_linux_free_back_buffer(NativeUiLinuxWindowSlot* slot)
+{
+    if (slot->back_buffer != 0 && g_native_ui_display != NULL) {
+        XFreePixmap(g_native_ui_display, slot->back_buffer);
+    }
+    slot->back_buffer = 0;
+    slot->back_width = 0;
+    slot->back_height = 0;
+    slot->back_dirty = 0;
+}
+
+/* (Re)allocates the back buffer to the current window size; on failure drawing falls back to the window. */
+static void native_ui_linux_ensure_back_buffer(NativeUiLinuxWindowSlot* slot)
+{
+    if (slot->width <= 0 || slot->height <= 0) {
+        return;
+    }
+    if (slot->back_buffer != 0 && slot->back_width == slot->width && slot->back_height == slot->height) {
+        return;
+    }
+    native_ui_linux_free_back_buffer(slot);
+    slot->back_buffer = XCreatePixmap(
+        g_native_ui_display,
+        slot->window,
+        (unsigned int)slot->width,
+        (unsigned int)slot->height,
+        (unsigned int)DefaultDepth(g_native_ui_display, g_native_ui_screen));
+    if (slot->back_buffer != 0) {
+        slot->back_width = slot->width;
+        slot->back_height = slot->height;
+    }
+}
+
+/* Copies the back buffer to the window; a region frame only copies its damage rectangle. */
+static void native_ui_linux_blit(NativeUiLinuxWindowSlot* slot)
+{
+    if (slot->back_buffer == 0) {
+        return;
+    }
+    if (slot->clip_active) {
+        XCopyArea(
+            g_native_ui_display,
+            slot->back_buffer,
+            slot->window,
+            slot->gc,
+            slot->clip.x,
+            slot->clip.y,
+            slot->clip.width,
+            slot->clip.height,
+            slot->clip.x,
+            slot->clip.y);
+    } else {
+        XCopyArea(
+            g_native_ui_display,
+            slot->back_buffer,
+            slot->window,
+            slot->gc,
+            0,
+            0,
+            (unsigned int)slot->back_width,
+            (unsigned int)slot->back_height,
+            0,
+            0);
+    }
+    slot->back_dirty = 0;
+}
+
+static void native_ui_linux_clear_clip(NativeUiLinuxWindowSlot* slot)
+{
+    if (slot->clip_active) {
+        XSetClipMask(g_native_ui_display, slot->gc, None);
+        slot->clip_active = 0;
+    }
+}
+
+/* Applies pending resizes without a GetWindowAttributes round-trip. */
+static void native_ui_linux_drain_configure(NativeUiLinuxWindowSlot* slot)
+{
+    XEvent event;
+    while (XCheckTypedWindowEvent(g_native_ui_display, slot->window, ConfigureNotify, &event)) {
+        slot->width = event.xconfigure.width;
+        slot->height = event.xconfigure.height;
+    }
+}
+
 static int native_ui_linux_is_text_key(KeySym keysym, const char* text)
 {
     if (text == NULL || text[0] == '\0') {
@@ -194,6 +340,18 @@ static int native_ui_linux_path_parse_number(const char** io_cursor, double* out
     return 1;
 }
 
+static void native_ui_linux_free_images(void)
+{
+    size_t i;
+    for (i = 0U; i < sizeof(g_native_ui_images) / sizeof(g_native_ui_images[0]); i += 1U) {
+        if (g_native_ui_display != NULL && g_native_ui_images[i].pixmap != 0) {
+            XFreePixmap(g_native_ui_display, g_native_ui_images[i].pixmap);
+        }
+    }
+    memset(g_native_ui_images, 0, sizeof(g_native_ui_images));
+    g_native_ui_image_next = 0U;
+}
+
 void native_host_ui_reset(void)
 {
     size_t i;
@@ -201,11 +359,18 @@ void native_host_ui_reset(void)
         g_native_ui_windows[i].handle = 0;
         g_native_ui_windows[i].window = 0;
         g_native_ui_windows[i].gc = 0;
+        g_native_ui_windows[i].back_buffer = 0;
+        g_native_ui_windows[i].back_width = 0;
+        g_native_ui_windows[i].back_height = 0;
+        g_native_ui_windows[i].back_dirty = 0;
+        g_native_ui_windows[i].clip_active = 0;
         g_native_ui_windows[i].close_pending = 0;
         g_native_ui_windows[i].width = 0;
         g_native_ui_windows[i].height = 0;
     }
     g_native_ui_next_handle = 1;
+    memset(g_native_ui_images, 0, sizeof(g_native_ui_images));
+    g_native_ui_image_next = 0U;
 }
 
 void native_host_ui_shutdown(void)
@@ -216,6 +381,7 @@ void native_host_ui_shutdown(void)
     }
     for (i = 0U; i < sizeof(g_native_ui_windows) / sizeof(g_native_ui_windows[0]); i += 1U) {
         if (g_native_ui_windows[i].window != 0) {
+            native_ui_linux_free_back_buffer(&g_native_ui_windows[i]);
             if (g_native_ui_windows[i].gc != 0) {
                 XFreeGC(g_native_ui_display, g_native_ui_windows[i].gc);
             }
@@ -224,9 +390,12 @@ void native_host_ui_shutdown(void)
             g_native_ui_windows[i].gc = 0;
         }
     }
+    native_ui_linux_free_images();
     XFlush(g_native_ui_display);
     XCloseDisplay(g_native_ui_display);
     g_native_ui_display = NULL;
+    g_native_ui_color_count = 0U;
+    g_native_ui_color_next = 0U;
 }
 
 int native_host_ui_create_window(const char* title, int width, int height, int64_t* out_handle)
@@ -261,6 +430,8 @@ int native_host_ui_create_window(const char* title, int width, int height, int64
         return 0;
     }
     XSelectInput(g_native_ui_display, window, event_mask);
+    /* The back buffer repaints every exposed pixel, so skip the server's background clear. */
+    XSetWindowBackgroundPixmap(g_native_ui_display, window, None);
     if (title != NULL && title[0] != '\0') {
         XStoreName(g_native_ui_display, window, title);
     } else {
@@ -275,7 +446,9 @@ int native_host_ui_create_window(const char* title, int width, int height, int64
     XSetWMNormalHints(g_native_ui_display, window, &hints);
     XMapWindow(g_native_ui_display, window);
     memset(&gc_values, 0, sizeof(gc_values));
-    slot->gc = XCreateGC(g_native_ui_display, window, 0, &gc_values);
+    /* Back-buffer copies never need GraphicsExpose/NoExpose events. */
+    gc_values.graphics_exposures = False;
+    slot->gc = XCreateGC(g_native_ui_display, window, GCGraphicsExposures, &gc_values);
     if (slot->gc == 0) {
         XDestroyWindow(g_native_ui_display, window);
         return 0;
@@ -285,6 +458,11 @@ int native_host_ui_create_window(const char* title, int width, int height, int64
     slot->close_pending = 0;
     slot->width = width;
     slot->height = height;
+    native_ui_linux_ensure_back_buffer(slot);
+    if (slot->back_buffer != 0) {
+        XSetForeground(g_native_ui_display, slot->gc, WhitePixel(g_native_ui_display, g_native_ui_screen));
+        XFillRectangle(g_native_ui_display, slot->back_buffer, slot->gc, 0, 0, (unsigned int)width, (unsigned int)height);
+    }
     *out_handle = slot->handle;
     XFlush(g_native_ui_display);
     return 1;
@@ -296,6 +474,7 @@ int native_host_ui_close_window(int64_t handle)
     if (slot == NULL || g_native_ui_display == NULL) {
         return 0;
     }
+    native_ui_linux_free_back_buffer(slot);
     if (slot->gc != 0) {
         XFreeGC(g_native_ui_display, slot->gc);
     }
@@ -317,15 +496,52 @@ int native_host_ui_begin_frame(int64_t handle)
     if (slot == NULL || g_native_ui_display == NULL) {
         return 0;
     }
+    native_ui_linux_clear_clip(slot);
+    native_ui_linux_drain_configure(slot);
+    native_ui_linux_ensure_back_buffer(slot);
     bg = WhitePixel(g_native_ui_display, g_native_ui_screen);
     XSetForeground(g_native_ui_display, slot->gc, bg);
-    XFillRectangle(g_native_ui_display, slot->window, slot->gc, 0, 0, (unsigned int)slot->width, (unsigned int)slot->height);
+    XFillRectangle(g_native_ui_display, native_ui_linux_target(slot), slot->gc, 0, 0, (unsigned int)slot->width, (unsigned int)slot->height);
+    return 1;
+}
+
+int native_host_ui_frame_retained(int64_t handle)
+{
+    NativeUiLinuxWindowSlot* slot = native_ui_linux_find_slot(handle);
+    if (slot == NULL || g_native_ui_display == NULL) {
+        return 0;
+    }
+    return slot->back_buffer != 0 && slot->back_width == slot->width && slot->back_height == slot->height;
+}
+
+int native_host_ui_begin_frame_region(int64_t handle, int x, int y, int width, int height)
+{
+    NativeUiLinuxWindowSlot* slot = native_ui_linux_find_slot(handle);
+    if (!native_host_ui_frame_retained(handle) || width <= 0 || height <= 0 ||
+        x < 0 || y < 0 || x + width > slot->back_width || y + height > slot->back_height) {
+        return 0;
+    }
+    slot->clip.x = (short)x;
+    slot->clip.y = (short)y;
+    slot->clip.width = (unsigned short)width;
+    slot->clip.height = (unsigned short)height;
+    XSetClipRectangles(g_native_ui_display, slot->gc, 0, 0, &slot->clip, 1, Unsorted);
+    slot->clip_active = 1;
+    XSetForeground(g_native_ui_display, slot->gc, WhitePixel(g_native_ui_display, g_native_ui_screen));
+    XFillRectangle(g_native_ui_display, native_ui_linux_target(slot), slot->gc, x, y, (unsigned int)width, (unsigned int)height);
     return 1;
 }
 
 int native_host_ui_end_frame(int64_t handle)
 {
-    (void)handle;
+    NativeUiLinuxWindowSlot* slot = native_ui_linux_find_slot(handle);
+    if (slot == NULL || g_native_ui_display == NULL) {
+        return 1;
+    }
+    if (slot->back_dirty) {
+        native_ui_linux_blit(slot);
+    }
+    native_ui_linux_clear_clip(slot);
     return 1;
 }
 
@@ -335,14 +551,21 @@ int native_host_ui_present(int64_t handle)
     if (slot == NULL || g_native_ui_display == NULL) {
         return 0;
     }
+    if (slot->back_dirty) {
+        native_ui_linux_blit(slot);
+    }
+    native_ui_linux_clear_clip(slot);
     XFlush(g_native_ui_display);
     return 1;
 }
 
 int native_host_ui_wait_frame(int64_t handle)
 {
+    struct timespec frame_delay;
     (void)handle;
-    usleep(16000U);
+    frame_delay.tv_sec = 0;
+    frame_delay.tv_nsec = 16000000L;
+    (void)nanosleep(&frame_delay, NULL);
     return 1;
 }
 
@@ -358,7 +581,7 @@ int native_host_ui_draw_rect(int64_t handle, int x, int y, int width, int height
     }
     pixel = native_ui_linux_parse_color(color, BlackPixel(g_native_ui_display, g_native_ui_screen));
     XSetForeground(g_native_ui_display, slot->gc, pixel);
-    XFillRectangle(g_native_ui_display, slot->window, slot->gc, x, y, (unsigned int)width, (unsigned int)height);
+    XFillRectangle(g_native_ui_display, native_ui_linux_target(slot), slot->gc, x, y, (unsigned int)width, (unsigned int)height);
     return 1;
 }
 
@@ -374,7 +597,7 @@ int native_host_ui_draw_ellipse(int64_t handle, int x, int y, int width, int hei
     }
     pixel = native_ui_linux_parse_color(color, BlackPixel(g_native_ui_display, g_native_ui_screen));
     XSetForeground(g_native_ui_display, slot->gc, pixel);
-    XFillArc(g_native_ui_display, slot->window, slot->gc, x, y, (unsigned int)width, (unsigned int)height, 0, 360 * 64);
+    XFillArc(g_native_ui_display, native_ui_linux_target(slot), slot->gc, x, y, (unsigned int)width, (unsigned int)height, 0, 360 * 64);
     return 1;
 }
 
@@ -392,6 +615,9 @@ int native_host_ui_draw_image(
     XImage* image = NULL;
     XImage* existing = NULL;
     char* pixels = NULL;
+    Drawable target;
+    int opaque = 1;
+    size_t i;
     int xi;
     int yi;
     if (slot == NULL || g_native_ui_display == NULL || rgba == NULL) {
@@ -407,7 +633,20 @@ int native_host_ui_draw_image(
     if (visual == NULL) {
         return 0;
     }
-    existing = XGetImage(g_native_ui_display, slot->window, x, y, (unsigned int)width, (unsigned int)height, AllPlanes, ZPixmap);
+    target = native_ui_linux_target(slot);
+    for (i = 3U; i < rgba_length; i += 4U) {
+        if (rgba[i] != 255U) {
+            opaque = 0;
+            break;
+        }
+    }
+    /* Blending needs the pixels underneath (a round-trip); opaque images and
+       rectangles not fully inside the back buffer skip the read. */
+    if (!opaque &&
+        (target == slot->window ||
+         (x >= 0 && y >= 0 && x + width <= slot->back_width && y + height <= slot->back_height))) {
+        existing = XGetImage(g_native_ui_display, target, x, y, (unsigned int)width, (unsigned int)height, AllPlanes, ZPixmap);
+    }
     pixels = (char*)calloc((size_t)width * (size_t)height, sizeof(unsigned long));
     if (pixels == NULL) {
         if (existing != NULL) {
@@ -460,7 +699,7 @@ int native_host_ui_draw_image(
             XPutPixel(image, xi, yi, pixel);
         }
     }
-    XPutImage(g_native_ui_display, slot->window, slot->gc, image, 0, 0, x, y, (unsigned int)width, (unsigned int)height);
+    XPutImage(g_native_ui_display, target, slot->gc, image, 0, 0, x, y, (unsigned int)width, (unsigned int)height);
     image->data = NULL;
     XDestroyImage(image);
     if (existing != NULL) {
@@ -470,6 +709,109 @@ int native_host_ui_draw_image(
     return 1;
 }
 
+/* Uploads opaque RGBA into a new pixmap with one XPutImage. */
+static Pixmap native_ui_linux_upload_pixmap(NativeUiLinuxWindowSlot* slot, const uint8_t* rgba, int width, int height)
+{
+    Visual* visual = DefaultVisual(g_native_ui_display, g_native_ui_screen);
+    int depth = DefaultDepth(g_native_ui_display, g_native_ui_screen);
+    XImage* image;
+    char* pixels;
+    Pixmap pixmap;
+    int xi;
+    int yi;
+    if (visual == NULL) {
+        return 0;
+    }
+    pixels = (char*)calloc((size_t)width * (size_t)height, sizeof(unsigned long));
+    if (pixels == NULL) {
+        return 0;
+    }
+    image = XCreateImage(g_native_ui_display, visual, (unsigned int)depth, ZPixmap, 0, pixels, (unsigned int)width, (unsigned int)height, 32, 0);
+    if (image == NULL) {
+        free(pixels);
+        return 0;
+    }
+    for (yi = 0; yi < height; yi += 1) {
+        for (xi = 0; xi < width; xi += 1) {
+            const uint8_t* src = rgba + ((size_t)yi * (size_t)width + (size_t)xi) * 4U;
+            XPutPixel(image, xi, yi,
+                native_ui_linux_scale_component(src[0], visual->red_mask) |
+                native_ui_linux_scale_component(src[1], visual->green_mask) |
+                native_ui_linux_scale_component(src[2], visual->blue_mask));
+        }
+    }
+    pixmap = XCreatePixmap(g_native_ui_display, slot->window, (unsigned int)width, (unsigned int)height, (unsigned int)depth);
+    if (pixmap != 0) {
+        XPutImage(g_native_ui_display, pixmap, slot->gc, image, 0, 0, 0, 0, (unsigned int)width, (unsigned int)height);
+    }
+    image->data = NULL;
+    XDestroyImage(image);
+    free(pixels);
+    return pixmap;
+}
+
+int native_host_ui_draw_cached_image(
+    int64_t handle,
+    int x,
+    int y,
+    int64_t image_id,
+    const uint8_t* rgba,
+    int width,
+    int height)
+{
+    NativeUiLinuxWindowSlot* slot = native_ui_linux_find_slot(handle);
+    NativeUiLinuxImageEntry* entry = NULL;
+    size_t count = sizeof(g_native_ui_images) / sizeof(g_native_ui_images[0]);
+    size_t rgba_length;
+    size_t i;
+    if (slot == NULL || g_native_ui_display == NULL || rgba == NULL || width <= 0 || height <= 0) {
+        return 0;
+    }
+    rgba_length = (size_t)width * (size_t)height * 4U;
+    for (i = 0U; i < count; i += 1U) {
+        if (g_native_ui_images[i].image_id == image_id) {
+            entry = &g_native_ui_images[i];
+            break;
+        }
+    }
+    if (entry == NULL) {
+        int opaque = 1;
+        for (i = 3U; i < rgba_length; i += 4U) {
+            if (rgba[i] != 255U) {
+                opaque = 0;
+                break;
+            }
+        }
+        entry = &g_native_ui_images[g_native_ui_image_next];
+        g_native_ui_image_next = (g_native_ui_image_next + 1U) % count;
+        if (entry->pixmap != 0) {
+            XFreePixmap(g_native_ui_display, entry->pixmap);
+        }
+        entry->image_id = image_id;
+        entry->pixmap = opaque ? native_ui_linux_upload_pixmap(slot, rgba, width, height) : 0;
+        entry->width = width;
+        entry->height = height;
+    }
+    if (entry->pixmap == 0 || entry->width != width || entry->height != height) {
+        return native_host_ui_draw_image(handle, x, y, width, height, rgba, rgba_length);
+    }
+    XCopyArea(g_native_ui_display, entry->pixmap, native_ui_linux_target(slot), slot->gc, 0, 0, (unsigned int)width, (unsigned int)height, x, y);
+    return 1;
+}
+
+void native_host_ui_release_image(int64_t image_id)
+{
+    size_t i;
+    for (i = 0U; i < sizeof(g_native_ui_images) / sizeof(g_native_ui_images[0]); i += 1U) {
+        if (g_native_ui_images[i].image_id == image_id) {
+            if (g_native_ui_display != NULL && g_native_ui_images[i].pixmap != 0) {
+                XFreePixmap(g_native_ui_display, g_native_ui_images[i].pixmap);
+            }
+            memset(&g_native_ui_images[i], 0, sizeof(g_native_ui_images[i]));
+        }
+    }
+}
+
 int native_host_ui_draw_text(int64_t handle, int x, int y, const char* text, const char* color, int font_size)
 {
     NativeUiLinuxWindowSlot* slot = native_ui_linux_find_slot(handle);
@@ -480,7 +822,7 @@ int native_host_ui_draw_text(int64_t handle, int x, int y, const char* text, con
     }
     pixel = native_ui_linux_parse_color(color, BlackPixel(g_native_ui_display, g_native_ui_screen));
     XSetForeground(g_native_ui_display, slot->gc, pixel);
-    XDrawString(g_native_ui_display, slot->window, slot->gc, x, y, text, (int)strlen(text));
+    XDrawString(g_native_ui_display, native_ui_linux_target(slot), slot->gc, x, y, text, (int)strlen(text));
     return 1;
 }
 
@@ -496,7 +838,7 @@ int native_host_ui_draw_line(int64_t handle, int x1, int y1, int x2, int y2, con
     if (stroke_width > 0) {
         XSetLineAttributes(g_native_ui_display, slot->gc, (unsigned int)stroke_width, LineSolid, CapButt, JoinMiter);
     }
-    XDrawLine(g_native_ui_display, slot->window, slot->gc, x1, y1, x2, y2);
+    XDrawLine(g_native_ui_display, native_ui_linux_target(slot), slot->gc, x1, y1, x2, y2);
     return 1;
 }
 
@@ -511,9 +853,11 @@ int native_host_ui_draw_path(int64_t handle, const char* path, const char* color
     double start_x = 0.0;
     double start_y = 0.0;
     int has_point = 0;
+    Drawable target;
     if (slot == NULL || g_native_ui_display == NULL || path == NULL) {
         return 0;
     }
+    target = native_ui_linux_target(slot);
     pixel = native_ui_linux_parse_color(color, BlackPixel(g_native_ui_display, g_native_ui_screen));
     XSetForeground(g_native_ui_display, slot->gc, pixel);
     if (stroke_width > 0) {
@@ -532,7 +876,7 @@ int native_host_ui_draw_path(int64_t handle, const char* path, const char* color
             cursor += 1;
             if (cmd == 'Z' || cmd == 'z') {
                 if (has_point) {
-                    XDrawLine(g_native_ui_display, slot->window, slot->gc, (int)x, (int)y, (int)start_x, (int)start_y);
+                    XDrawLine(g_native_ui_display, target, slot->gc, (int)x, (int)y, (int)start_x, (int)start_y);
                     x = start_x;
                     y = start_y;
                 }
@@ -559,7 +903,7 @@ int native_host_ui_draw_path(int64_t handle, const char* path, const char* color
                 has_point = 1;
                 cmd = (cmd == 'm') ? 'l' : 'L';
             } else {
-                XDrawLine(g_native_ui_display, slot->window, slot->gc, (int)x, (int)y, (int)a, (int)b);
+                XDrawLine(g_native_ui_display, target, slot->gc, (int)x, (int)y, (int)a, (int)b);
                 x = a;
                 y = b;
                 has_point = 1;
@@ -571,7 +915,7 @@ int native_host_ui_draw_path(int64_t handle, const char* path, const char* color
                 return 0;
             }
             a = (cmd == 'h') ? (x + a) : a;
-            XDrawLine(g_native_ui_display, slot->window, slot->gc, (int)x, (int)y, (int)a, (int)y);
+            XDrawLine(g_native_ui_display, target, slot->gc, (int)x, (int)y, (int)a, (int)y);
             x = a;
             has_point = 1;
             continue;
@@ -581,7 +925,7 @@ int native_host_ui_draw_path(int64_t handle, const char* path, const char* color
                 return 0;
             }
             a = (cmd == 'v') ? (y + a) : a;
-            XDrawLine(g_native_ui_display, slot->window, slot->gc, (int)x, (int)y, (int)x, (int)a);
+            XDrawLine(g_native_ui_display, target, slot->gc, (int)x, (int)y, (int)x, (int)a);
             y = a;
             has_point = 1;
             continue;
@@ -605,7 +949,17 @@ int native_host_ui_poll_event(int64_t handle, NativeHostUiEvent* out_event)
         NativeUiLinuxWindowSlot* slot = NULL;
         XNextEvent(g_native_ui_display, &event);
         slot = native_ui_linux_find_slot_by_window(event.xany.window);
-        if (slot == NULL || slot->handle != handle) {
+        if (slot == NULL) {
+            continue;
+        }
+        if (event.type == Expose) {
+            /* Repaint from the back buffer; the window itself keeps no contents. */
+            if (event.xexpose.count == 0) {
+                native_ui_linux_blit(slot);
+            }
+            continue;
+        }
+        if (slot->handle != handle) {
             continue;
         }
         if (event.type == DestroyNotify) {
@@ -656,7 +1010,9 @@ int native_host_ui_get_window_size(int64_t handle, int* out_width, int* out_heig
     if (slot == NULL || g_native_ui_display == NULL) {
         return 0;
     }
-    if (XGetWindowAttributes(g_native_ui_display, slot->window, &attrs) != 0) {
+    if (slot->back_buffer != 0) {
+        native_ui_linux_drain_configure(slot);
+    } else if (XGetWindowAttributes(g_native_ui_display, slot->window, &attrs) != 0) {
         slot->width = attrs.width;
         slot->height = attrs.height;
     }
@@ -628,6 +628,23 @@ int native_host_ui_begin_frame(int64_t handle)
     }
 }
 
+/* Drawing goes straight to the window, so there is no retained frame to patch. */
+int native_host_ui_frame_retained(int64_t handle)
+{
+    (void)handle;
+    return 0;
+}
+
+int native_host_ui_begin_frame_region(int64_t handle, int x, int y, int width, int height)
+{
+    (void)handle;
+    (void)x;
+    (void)y;
+    (void)width;
+    (void)height;
+    return 0;
+}
+
 int native_host_ui_end_frame(int64_t handle)
 {
     return native_ui_find_slot(handle) != NULL ? 1 : 0;
@@ -781,6 +798,27 @@ int native_host_ui_draw_image(
     }
 }
 
+int native_host_ui_draw_cached_image(
+    int64_t handle,
+    int x,
+    int y,
+    int64_t image_id,
+    const uint8_t* rgba,
+    int width,
+    int height)
+{
+    (void)image_id;
+    if (rgba == NULL || width <= 0 || height <= 0) {
+        return 0;
+    }
+    return native_host_ui_draw_image(handle, x, y, width, height, rgba, (size_t)width * (size_t)height * 4U);
+}
+
+void native_host_ui_release_image(int64_t image_id)
+{
+    (void)image_id;
+}
+
 int native_host_ui_draw_text(int64_t handle, int x, int y, const char* text, const char* color, int font_size)
 {
     @autoreleasepool {
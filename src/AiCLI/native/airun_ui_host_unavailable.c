@@ -19,6 +19,18 @@ int native_host_ui_create_window(const char* title, int width, int height, int64
 
 int native_host_ui_close_window(int64_t handle) { (void)handle; return 0; }
 int native_host_ui_begin_frame(int64_t handle) { (void)handle; return 0; }
+int native_host_ui_frame_retained(int64_t handle) { (void)handle; return 0; }
+
+int native_host_ui_begin_frame_region(int64_t handle, int x, int y, int width, int height)
+{
+    (void)handle;
+    (void)x;
+    (void)y;
+    (void)width;
+    (void)height;
+    return 0;
+}
+
 int native_host_ui_end_frame(int64_t handle) { (void)handle; return 0; }
 int native_host_ui_present(int64_t handle) { (void)handle; return 0; }
 int native_host_ui_wait_frame(int64_t handle) { (void)handle; return 0; }
@@ -64,6 +76,27 @@ int native_host_ui_draw_image(
     return 0;
 }
 
+int native_host_ui_draw_cached_image(
+    int64_t handle,
+    int x,
+    int y,
+    int64_t image_id,
+    const uint8_t* rgba,
+    int width,
+    int height)
+{
+    (void)handle;
+    (void)x;
+    (void)y;
+    (void)image_id;
+    (void)rgba;
+    (void)width;
+    (void)height;
+    return 0;
+}
+
+void native_host_ui_release_image(int64_t image_id) { (void)image_id; }
+
 int native_host_ui_draw_text(int64_t handle, int x, int y, const char* text, const char* color, int font_size)
 {
     (void)handle;
@@ -150,6 +150,7 @@ AivmCResult aivm_c_execute_aibc1(const uint8_t* bytes, size_t byte_count)
     result.load_error_offset = load_result.error_offset;
 
     if (load_result.status != AIVM_PROGRAM_OK) {
+        aivm_program_free(&program);
         result.status = AIVM_VM_STATUS_ERROR;
         result.error = AIVM_VM_ERR_INVALID_PROGRAM;
         return result;
@@ -160,6 +161,7 @@ AivmCResult aivm_c_execute_aibc1(const uint8_t* bytes, size_t byte_count)
     result.status = vm.status;
     result.error = vm.error;
     capture_exit_code(&result, &vm);
+    aivm_program_free(&program);
     return result;
 }
 
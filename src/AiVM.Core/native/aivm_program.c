@@ -1,3 +1,6 @@
+#include <stdlib.h>
+#include <string.h>
+
 #include "aivm_program.h"
 
 static int size_add_checked(size_t a, size_t b, size_t* out)
@@ -55,7 +58,7 @@ static int write_string_constant(
     }
     if (!size_add_checked(base_offset, length, &needed_storage) ||
         !size_add_checked(needed_storage, 1U, &needed_storage) ||
-        needed_storage > AIVM_PROGRAM_MAX_STRING_BYTES) {
+        !aivm_program_reserve_string_bytes(program, needed_storage)) {
         return 0;
     }
 
@@ -83,7 +86,7 @@ static int write_bytes_constant(
         return 0;
     }
     if (!size_add_checked(base_offset, length, &needed_storage) ||
-        needed_storage > AIVM_PROGRAM_MAX_BYTES_STORAGE) {
+        !aivm_program_reserve_bytes_storage(program, needed_storage)) {
         return 0;
     }
     for (i = 0U; i < length; i += 1U) {
@@ -95,6 +98,39 @@ static int write_bytes_constant(
     return 1;
 }
 
+/* Drops the code, constant and name views and their storage pointers without freeing. */
+static void forget_program_storage(AivmProgram* program)
+{
+    program->instructions = NULL;
+    program->instruction_count = 0U;
+    program->constants = NULL;
+    program->constant_count = 0U;
+    program->instruction_storage = NULL;
+    program->instruction_capacity = 0U;
+    program->constant_storage = NULL;
+    program->constant_capacity = 0U;
+    program->string_storage = NULL;
+    program->string_storage_used = 0U;
+    program->string_storage_capacity = 0U;
+    program->bytes_storage = NULL;
+    program->bytes_storage_used = 0U;
+    program->bytes_storage_capacity = 0U;
+    program->function_names = NULL;
+    program->function_name_count = 0U;
+    program->function_name_capacity = 0U;
+}
+
+/* Frees owned storage; header and section fields are kept for load diagnostics. */
+static void release_program_storage(AivmProgram* program)
+{
+    free(program->instruction_storage);
+    free(program->constant_storage);
+    free(program->string_storage);
+    free(program->bytes_storage);
+    free(program->function_names);
+    forget_program_storage(program);
+}
+
 void aivm_program_clear(AivmProgram* program)
 {
     size_t index;
@@ -102,28 +138,10 @@ void aivm_program_clear(AivmProgram* program)
         return;
     }
 
-    program->instructions = NULL;
-    program->instruction_count = 0U;
-    program->constants = NULL;
-    program->constant_count = 0U;
+    forget_program_storage(program);
     program->format_version = 0U;
     program->format_flags = 0U;
     program->section_count = 0U;
-    program->string_storage_used = 0U;
-    program->bytes_storage_used = 0U;
-    for (index = 0U; index < AIVM_PROGRAM_MAX_INSTRUCTIONS; index += 1U) {
-        program->instruction_storage[index].opcode = AIVM_OP_NOP;
-        program->instruction_storage[index].operand_int = 0;
-    }
-    for (index = 0U; index < AIVM_PROGRAM_MAX_CONSTANTS; index += 1U) {
-        program->constant_storage[index] = aivm_value_void();
-    }
-    for (index = 0U; index < AIVM_PROGRAM_MAX_STRING_BYTES; index += 1U) {
-        program->string_storage[index] = '\0';
-    }
-    for (index = 0U; index < AIVM_PROGRAM_MAX_BYTES_STORAGE; index += 1U) {
-        program->bytes_storage[index] = 0U;
-    }
     for (index = 0U; index < AIVM_PROGRAM_MAX_SECTIONS; index += 1U) {
         program->sections[index].section_type = 0U;
         program->sections[index].section_size = 0U;
@@ -131,6 +149,253 @@ void aivm_program_clear(AivmProgram* program)
     }
 }
 
+void aivm_program_free(AivmProgram* program)
+{
+    if (program == NULL) {
+        return;
+    }
+    release_program_storage(program);
+    aivm_program_clear(program);
+}
+
+static size_t grown_capacity(size_t current, size_t needed)
+{
+    size_t capacity = current < 16U ? 16U : current;
+    while (capacity < needed) {
+        if (capacity > ((size_t)-1) / 2U) {
+            return needed;
+        }
+        capacity *= 2U;
+    }
+    return capacity;
+}
+
+int aivm_program_reserve_instructions(AivmProgram* program, size_t instruction_count)
+{
+    AivmInstruction* storage;
+    size_t capacity;
+    size_t byte_count;
+    size_t index;
+    int viewing_storage;
+    if (program == NULL) {
+        return 0;
+    }
+    if (instruction_count <= program->instruction_capacity) {
+        return 1;
+    }
+    capacity = grown_capacity(program->instruction_capacity, instruction_count);
+    if (!size_mul_checked(capacity, sizeof(AivmInstruction), &byte_count)) {
+        return 0;
+    }
+    viewing_storage = program->instructions == program->instruction_storage;
+    storage = (AivmInstruction*)realloc(program->instruction_storage, byte_count);
+    if (storage == NULL) {
+        return 0;
+    }
+    for (index = program->instruction_capacity; index < capacity; index += 1U) {
+        storage[index].opcode = AIVM_OP_NOP;
+        storage[index].operand_int = 0;
+    }
+    program->instruction_storage = storage;
+    program->instruction_capacity = capacity;
+    if (viewing_storage) {
+        program->instructions = storage;
+    }
+    return 1;
+}
+
+int aivm_program_reserve_constants(AivmProgram* program, size_t constant_count)
+{
+    AivmValue* storage;
+    size_t capacity;
+    size_t byte_count;
+    size_t index;
+    int viewing_storage;
+    if (program == NULL) {
+        return 0;
+    }
+    if (constant_count <= program->constant_capacity) {
+        return 1;
+    }
+    capacity = grown_capacity(program->constant_capacity, constant_count);
+    if (!size_mul_checked(capacity, sizeof(AivmValue), &byte_count)) {
+        return 0;
+    }
+    viewing_storage = program->constants == program->constant_storage;
+    storage = (AivmValue*)realloc(program->constant_storage, byte_count);
+    if (storage == NULL) {
+        return 0;
+    }
+    for (index = program->constant_capacity; index < capacity; index += 1U) {
+        storage[index] = aivm_value_void();
+    }
+    program->constant_storage = storage;
+    program->constant_capacity = capacity;
+    if (viewing_storage) {
+        program->constants = storage;
+    }
+    return 1;
+}
+
+int aivm_program_reserve_string_bytes(AivmProgram* program, size_t string_bytes)
+{
+    char* storage;
+    uintptr_t old_start;
+    uintptr_t old_end;
+    size_t capacity;
+    size_t index;
+    if (program == NULL) {
+        return 0;
+    }
+    if (string_bytes <= program->string_storage_capacity) {
+        return 1;
+    }
+    capacity = grown_capacity(program->string_storage_capacity, string_bytes);
+    storage = (char*)malloc(capacity);
+    if (storage == NULL) {
+        return 0;
+    }
+    if (program->string_storage_used > 0U) {
+        memcpy(storage, program->string_storage, program->string_storage_used);
+    }
+    old_start = (uintptr_t)(const void*)program->string_storage;
+    old_end = old_start + program->string_storage_used;
+    for (index = 0U; index < program->constant_capacity; index += 1U) {
+        AivmValue* value = &program->constant_storage[index];
+        uintptr_t address;
+        if (value->type != AIVM_VAL_STRING || value->string_value == NULL) {
+            continue;
+        }
+        address = (uintptr_t)(const void*)value->string_value;
+        if (address >= old_start && address < old_end) {
+            value->string_value = storage + (address - old_start);
+        }
+    }
+    free(program->string_storage);
+    program->string_storage = storage;
+    program->string_storage_capacity = capacity;
+    return 1;
+}
+
+int aivm_program_reserve_bytes_storage(AivmProgram* program, size_t byte_count)
+{
+    uint8_t* storage;
+    uintptr_t old_start;
+    uintptr_t old_end;
+    size_t capacity;
+    size_t index;
+    if (program == NULL) {
+        return 0;
+    }
+    if (byte_count <= program->bytes_storage_capacity) {
+        return 1;
+    }
+    capacity = grown_capacity(program->bytes_storage_capacity, byte_count);
+    storage = (uint8_t*)malloc(capacity);
+    if (storage == NULL) {
+        return 0;
+    }
+    if (program->bytes_storage_used > 0U) {
+        memcpy(storage, program->bytes_storage, program->bytes_storage_used);
+    }
+    old_start = (uintptr_t)(const void*)program->bytes_storage;
+    old_end = old_start + program->bytes_storage_used;
+    for (index = 0U; index < program->constant_capacity; index += 1U) {
+        AivmValue* value = &program->constant_storage[index];
+        uintptr_t address;
+        if (value->type != AIVM_VAL_BYTES || value->bytes_value.data == NULL) {
+            continue;
+        }
+        address = (uintptr_t)(const void*)value->bytes_value.data;
+        if (address >= old_start && address < old_end) {
+            value->bytes_value.data = storage + (address - old_start);
+        }
+    }
+    free(program->bytes_storage);
+    program->bytes_storage = storage;
+    program->bytes_storage_capacity = capacity;
+    return 1;
+}
+
+static void copy_function_name(AivmFunctionName* entry, const uint8_t* name, size_t length)
+{
+    if (length >= sizeof(entry->name)) {
+        length = sizeof(entry->name) - 1U;
+    }
+    if (length > 0U) {
+        memcpy(entry->name, name, length);
+    }
+    entry->name[length] = '\0';
+}
+
+static int add_function_name(AivmProgram* program, size_t entry_ip, const uint8_t* name, size_t length)
+{
+    size_t index;
+    if (program == NULL || name == NULL) {
+        return 0;
+    }
+    index = program->function_name_count;
+    while (index > 0U && program->function_names[index - 1U].entry_ip > entry_ip) {
+        index -= 1U;
+    }
+    if (index > 0U && program->function_names[index - 1U].entry_ip == entry_ip) {
+        copy_function_name(&program->function_names[index - 1U], name, length);
+        return 1;
+    }
+    if (program->function_name_count == program->function_name_capacity) {
+        AivmFunctionName* storage;
+        size_t capacity = grown_capacity(program->function_name_capacity, program->function_name_count + 1U);
+        size_t byte_count;
+        if (!size_mul_checked(capacity, sizeof(AivmFunctionName), &byte_count)) {
+            return 0;
+        }
+        storage = (AivmFunctionName*)realloc(program->function_names, byte_count);
+        if (storage == NULL) {
+            return 0;
+        }
+        program->function_names = storage;
+        program->function_name_capacity = capacity;
+    }
+    memmove(
+        &program->function_names[index + 1U],
+        &program->function_names[index],
+        (program->function_name_count - index) * sizeof(AivmFunctionName));
+    program->function_names[index].entry_ip = entry_ip;
+    copy_function_name(&program->function_names[index], name, length);
+    program->function_name_count += 1U;
+    return 1;
+}
+
+int aivm_program_add_function_name(AivmProgram* program, size_t entry_ip, const char* name)
+{
+    if (name == NULL) {
+        return 0;
+    }
+    return add_function_name(program, entry_ip, (const uint8_t*)(const void*)name, strlen(name));
+}
+
+int aivm_program_function_index_at(const AivmProgram* program, size_t ip, size_t* out_index)
+{
+    size_t low = 0U;
+    size_t high;
+    if (program == NULL || out_index == NULL ||
+        program->function_name_count == 0U || program->function_names[0].entry_ip > ip) {
+        return 0;
+    }
+    /* Last entry with entry_ip <= ip. */
+    high = program->function_name_count;
+    while (high - low > 1U) {
+        size_t mid = low + ((high - low) / 2U);
+        if (program->function_names[mid].entry_ip <= ip) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    *out_index = low;
+    return 1;
+}
+
 void aivm_program_init(AivmProgram* program, const AivmInstruction* instructions, size_t instruction_count)
 {
     if (program == NULL) {
@@ -142,7 +407,20 @@ void aivm_program_init(AivmProgram* program, const AivmInstruction* instructions
     program->instruction_count = instruction_count;
 }
 
-AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_count, AivmProgram* out_program)
+int aivm_program_host_layout_matches_aligned(void)
+{
+    const uint16_t probe = 1U;
+    return sizeof(AivmInstruction) == (size_t)AIVM_PROGRAM_ALIGNED_RECORD_SIZE &&
+           sizeof(AivmOpcode) == 4U &&
+           offsetof(AivmInstruction, operand_int) == 8U &&
+           *(const uint8_t*)&probe == 1U;
+}
+
+static AivmProgramLoadResult load_aibc1(
+    const uint8_t* bytes,
+    size_t byte_count,
+    AivmProgram* out_program,
+    int borrow)
 {
     AivmProgramLoadResult result;
     size_t cursor;
@@ -219,33 +497,92 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
         out_program->sections[section_index].section_size = section_size;
         out_program->sections[section_index].section_offset = (uint32_t)cursor;
 
-        if (section_type == AIVM_PROGRAM_SECTION_INSTRUCTIONS) {
+        if (section_type == AIVM_PROGRAM_SECTION_INSTRUCTIONS_ALIGNED) {
             uint32_t instruction_count;
+            uint32_t record_offset;
             uint32_t instruction_index;
+            int in_place;
+            size_t records_start;
             size_t instruction_cursor;
-            size_t expected_instruction_bytes;
+            size_t expected_record_bytes;
             size_t expected_section_size;
 
-            if (has_instruction_section != 0) {
+            if (has_instruction_section != 0 || section_size < 8U) {
                 result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
                 result.error_offset = section_payload_start;
                 return result;
             }
             has_instruction_section = 1;
 
-            if (section_size < 4U) {
+            instruction_count = read_u32_le(bytes, section_payload_start);
+            record_offset = read_u32_le(bytes, section_payload_start + 4U);
+            /* Records start at an aligned file offset so a mapped file can be executed in place. */
+            records_start = section_payload_start + (size_t)record_offset;
+            if (record_offset < 8U ||
+                !size_mul_checked((size_t)instruction_count, AIVM_PROGRAM_ALIGNED_RECORD_SIZE, &expected_record_bytes) ||
+                !size_add_checked((size_t)record_offset, expected_record_bytes, &expected_section_size) ||
+                (size_t)section_size != expected_section_size ||
+                (records_start % AIVM_PROGRAM_ALIGNED_RECORD_ALIGNMENT) != 0U) {
                 result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
-                result.error_offset = section_payload_start;
+                result.error_offset = section_payload_start + 4U;
                 return result;
             }
 
-            instruction_count = read_u32_le(bytes, section_payload_start);
-            if (instruction_count > AIVM_PROGRAM_MAX_INSTRUCTIONS) {
+            in_place = borrow &&
+                       aivm_program_host_layout_matches_aligned() &&
+                       ((uintptr_t)(const void*)&bytes[records_start] %
+                        (uintptr_t)AIVM_PROGRAM_ALIGNED_RECORD_ALIGNMENT) == 0U;
+            if (!in_place && !aivm_program_reserve_instructions(out_program, (size_t)instruction_count)) {
                 result.status = AIVM_PROGRAM_ERR_INSTRUCTION_LIMIT;
                 result.error_offset = section_payload_start;
                 return result;
             }
+            instruction_cursor = records_start;
+            for (instruction_index = 0U; instruction_index < instruction_count; instruction_index += 1U) {
+                uint32_t raw_opcode = read_u32_le(bytes, instruction_cursor);
+                if (raw_opcode > (uint32_t)AIVM_OP_MAKE_MAP) {
+                    result.status = AIVM_PROGRAM_ERR_INVALID_OPCODE;
+                    result.error_offset = instruction_cursor;
+                    return result;
+                }
+                if (read_u32_le(bytes, instruction_cursor + 4U) != 0U) {
+                    result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
+                    result.error_offset = instruction_cursor + 4U;
+                    return result;
+                }
+                if (!in_place) {
+                    out_program->instruction_storage[instruction_index].opcode = (AivmOpcode)raw_opcode;
+                    out_program->instruction_storage[instruction_index].operand_int =
+                        read_i64_le(bytes, instruction_cursor + 8U);
+                }
+                instruction_cursor += AIVM_PROGRAM_ALIGNED_RECORD_SIZE;
+            }
+
+            out_program->instructions = in_place
+                ? (const AivmInstruction*)(const void*)&bytes[records_start]
+                : out_program->instruction_storage;
+            out_program->instruction_count = (size_t)instruction_count;
+        } else if (section_type == AIVM_PROGRAM_SECTION_INSTRUCTIONS) {
+            uint32_t instruction_count;
+            uint32_t instruction_index;
+            size_t instruction_cursor;
+            size_t expected_instruction_bytes;
+            size_t expected_section_size;
+
+            if (has_instruction_section != 0) {
+                result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
+                result.error_offset = section_payload_start;
+                return result;
+            }
+            has_instruction_section = 1;
+
+            if (section_size < 4U) {
+                result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
+                result.error_offset = section_payload_start;
+                return result;
+            }
 
+            instruction_count = read_u32_le(bytes, section_payload_start);
             if (!size_mul_checked((size_t)instruction_count, 12U, &expected_instruction_bytes) ||
                 !size_add_checked(4U, expected_instruction_bytes, &expected_section_size) ||
                 (size_t)section_size != expected_section_size) {
@@ -253,6 +590,11 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
                 result.error_offset = section_payload_start;
                 return result;
             }
+            if (!aivm_program_reserve_instructions(out_program, (size_t)instruction_count)) {
+                result.status = AIVM_PROGRAM_ERR_INSTRUCTION_LIMIT;
+                result.error_offset = section_payload_start;
+                return result;
+            }
 
             instruction_cursor = section_payload_start + 4U;
             for (instruction_index = 0U; instruction_index < instruction_count; instruction_index += 1U) {
@@ -271,7 +613,11 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
 
             out_program->instructions = out_program->instruction_storage;
             out_program->instruction_count = (size_t)instruction_count;
-        } else if (section_type == AIVM_PROGRAM_SECTION_CONSTANTS) {
+        } else if (section_type == AIVM_PROGRAM_SECTION_CONSTANTS ||
+                   section_type == AIVM_PROGRAM_SECTION_CONSTANTS_ALIGNED) {
+            /* Aligned constants store each string with a trailing NUL so it can be referenced in place. */
+            int aligned = section_type == AIVM_PROGRAM_SECTION_CONSTANTS_ALIGNED;
+            int in_place = borrow && aligned;
             uint32_t constant_count;
             uint32_t constant_index;
             size_t constant_cursor;
@@ -289,8 +635,10 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
                 return result;
             }
 
+            /* Every constant takes at least one byte, so the section bounds the table size. */
             constant_count = read_u32_le(bytes, section_payload_start);
-            if (constant_count > AIVM_PROGRAM_MAX_CONSTANTS) {
+            if ((size_t)constant_count > (size_t)section_size - 4U ||
+                !aivm_program_reserve_constants(out_program, (size_t)constant_count)) {
                 result.status = AIVM_PROGRAM_ERR_CONSTANT_LIMIT;
                 result.error_offset = section_payload_start;
                 return result;
@@ -333,7 +681,6 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
                 } else if (kind == 3U) {
                     uint32_t string_length;
                     size_t next_cursor;
-                    size_t needed_string_storage;
                     if (!size_add_checked(constant_cursor, 4U, &next_cursor) || next_cursor > section_end) {
                         result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
                         result.error_offset = constant_cursor;
@@ -343,19 +690,18 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
                     constant_cursor += 4U;
 
                     if (!size_add_checked(constant_cursor, (size_t)string_length, &next_cursor) ||
-                        next_cursor > section_end) {
+                        next_cursor > section_end ||
+                        (aligned && (next_cursor >= section_end || bytes[next_cursor] != 0U))) {
                         result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
                         result.error_offset = constant_cursor;
                         return result;
                     }
-                    if (!size_add_checked(out_program->string_storage_used, (size_t)string_length, &needed_string_storage) ||
-                        !size_add_checked(needed_string_storage, 1U, &needed_string_storage) ||
-                        needed_string_storage > AIVM_PROGRAM_MAX_STRING_BYTES) {
-                        result.status = AIVM_PROGRAM_ERR_STRING_LIMIT;
-                        result.error_offset = constant_cursor;
-                        return result;
+                    if (in_place) {
+                        out_program->constant_storage[constant_index] =
+                            aivm_value_string((const char*)(const void*)&bytes[constant_cursor]);
+                        constant_cursor += (size_t)string_length + 1U;
+                        continue;
                     }
-
                     if (!write_string_constant(
                             out_program,
                             constant_index,
@@ -365,13 +711,12 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
                         result.error_offset = constant_cursor;
                         return result;
                     }
-                    constant_cursor += (size_t)string_length;
+                    constant_cursor += (size_t)string_length + (aligned ? 1U : 0U);
                 } else if (kind == 4U) {
                     out_program->constant_storage[constant_index] = aivm_value_void();
                 } else if (kind == 5U) {
                     uint32_t bytes_length;
                     size_t next_cursor;
-                    size_t needed_bytes_storage;
                     if (!size_add_checked(constant_cursor, 4U, &next_cursor) || next_cursor > section_end) {
                         result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
                         result.error_offset = constant_cursor;
@@ -385,11 +730,11 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
                         result.error_offset = constant_cursor;
                         return result;
                     }
-                    if (!size_add_checked(out_program->bytes_storage_used, (size_t)bytes_length, &needed_bytes_storage) ||
-                        needed_bytes_storage > AIVM_PROGRAM_MAX_BYTES_STORAGE) {
-                        result.status = AIVM_PROGRAM_ERR_STRING_LIMIT;
-                        result.error_offset = constant_cursor;
-                        return result;
+                    if (in_place) {
+                        out_program->constant_storage[constant_index] =
+                            aivm_value_bytes(&bytes[constant_cursor], (size_t)bytes_length);
+                        constant_cursor += (size_t)bytes_length;
+                        continue;
                     }
                     if (!write_bytes_constant(
                             out_program,
@@ -416,6 +761,48 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
 
             out_program->constants = out_program->constant_storage;
             out_program->constant_count = (size_t)constant_count;
+        } else if (section_type == AIVM_PROGRAM_SECTION_FUNCTION_NAMES) {
+            /* Names are copied even for borrowed loads; the table is small. */
+            uint32_t name_count;
+            uint32_t name_index;
+            size_t name_cursor;
+
+            if (section_size < 4U) {
+                result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
+                result.error_offset = section_payload_start;
+                return result;
+            }
+            name_count = read_u32_le(bytes, section_payload_start);
+            name_cursor = section_payload_start + 4U;
+            for (name_index = 0U; name_index < name_count; name_index += 1U) {
+                uint32_t entry_ip;
+                uint32_t name_length;
+                size_t next_cursor;
+                if (!size_add_checked(name_cursor, 8U, &next_cursor) || next_cursor > section_end) {
+                    result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
+                    result.error_offset = name_cursor;
+                    return result;
+                }
+                entry_ip = read_u32_le(bytes, name_cursor);
+                name_length = read_u32_le(bytes, name_cursor + 4U);
+                name_cursor = next_cursor;
+                if (!size_add_checked(name_cursor, (size_t)name_length, &next_cursor) || next_cursor > section_end) {
+                    result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
+                    result.error_offset = name_cursor;
+                    return result;
+                }
+                if (!add_function_name(out_program, (size_t)entry_ip, &bytes[name_cursor], (size_t)name_length)) {
+                    result.status = AIVM_PROGRAM_ERR_STRING_LIMIT;
+                    result.error_offset = name_cursor;
+                    return result;
+                }
+                name_cursor = next_cursor;
+            }
+            if (name_cursor != section_end) {
+                result.status = AIVM_PROGRAM_ERR_INVALID_SECTION;
+                result.error_offset = name_cursor;
+                return result;
+            }
         }
 
         cursor = section_end;
@@ -426,6 +813,30 @@ AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_
     return result;
 }
 
+/* load_aibc1 initializes out_program on entry, so whatever it holds on failure is its own. */
+static AivmProgramLoadResult load_aibc1_or_release(
+    const uint8_t* bytes,
+    size_t byte_count,
+    AivmProgram* out_program,
+    int borrow)
+{
+    AivmProgramLoadResult result = load_aibc1(bytes, byte_count, out_program, borrow);
+    if (result.status != AIVM_PROGRAM_OK && out_program != NULL) {
+        release_program_storage(out_program);
+    }
+    return result;
+}
+
+AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_count, AivmProgram* out_program)
+{
+    return load_aibc1_or_release(bytes, byte_count, out_program, 0);
+}
+
+AivmProgramLoadResult aivm_program_load_aibc1_borrowed(const uint8_t* bytes, size_t byte_count, AivmProgram* out_program)
+{
+    return load_aibc1_or_release(bytes, byte_count, out_program, 1);
+}
+
 const char* aivm_program_status_code(AivmProgramStatus status)
 {
     switch (status) {
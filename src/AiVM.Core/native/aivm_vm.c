@@ -391,6 +391,16 @@ static const char* syscall_not_found_detail_with_recovery(
 static const char* syscall_contract_failure_detail(AivmContractStatus status);
 static int lookup_node(const AivmVm* vm, int64_t handle, const AivmNodeRecord** out_node);
 static int call_debug_task_reclaim_stats(AivmVm* vm, AivmValue* out_result);
+static int call_json_parse(AivmVm* vm, const char* input, int text_only, AivmValue* out_result);
+static int call_json_encode(AivmVm* vm, int64_t handle, AivmValue* out_result);
+static int call_http_parse(AivmVm* vm, int is_request, AivmBytesView data, int64_t prev_length, AivmValue* out_result);
+static int call_http_build_response(
+    AivmVm* vm,
+    int64_t status,
+    const char* reason,
+    int64_t headers_handle,
+    AivmBytesView body,
+    AivmValue* out_result);
 static size_t write_u64_decimal(char* output, size_t capacity, uint64_t value);
 static int is_syscall_target_string(const char* text);
 static const char* find_syscall_suffix_target(const char* text);
@@ -1325,7 +1335,7 @@ static int push_remove_by_runes(AivmVm* vm, const char* text, int64_t start, int
     return aivm_stack_push(vm, aivm_value_string(output));
 }
 
-static int call_sys_with_arity(AivmVm* vm, size_t arg_count, AivmValue* out_result)
+static int call_sys_with_arity(AivmVm* vm, size_t arg_count, AivmValue* out_result, int* out_pending)
 {
     AivmValue args[AIVM_VM_MAX_SYSCALL_ARGS];
     AivmValue target_value;
@@ -1339,6 +1349,7 @@ static int call_sys_with_arity(AivmVm* vm, size_t arg_count, AivmValue* out_resu
     if (vm == NULL || out_result == NULL) {
         return 0;
     }
+    *out_pending = 0;
     if (arg_count > AIVM_VM_MAX_SYSCALL_ARGS) {
         set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Invalid call argument count.");
         return 0;
@@ -1496,6 +1507,55 @@ static int call_sys_with_arity(AivmVm* vm, size_t arg_count, AivmValue* out_resu
         }
         return call_debug_task_reclaim_stats(vm, out_result);
     }
+    if (strcmp(target_value.string_value, "sys.json.parse") == 0 ||
+        strcmp(target_value.string_value, "sys.json.validate") == 0 ||
+        strcmp(target_value.string_value, "sys.json.encode") == 0) {
+        contract_status = aivm_syscall_contract_validate(
+            target_value.string_value,
+            args,
+            effective_arg_count,
+            NULL);
+        if (contract_status != AIVM_CONTRACT_OK) {
+            set_vm_error(vm, AIVM_VM_ERR_SYSCALL, syscall_contract_failure_detail(contract_status));
+            return 0;
+        }
+        if (args[0].type == AIVM_VAL_STRING) {
+            return call_json_parse(
+                vm,
+                args[0].string_value == NULL ? "" : args[0].string_value,
+                strcmp(target_value.string_value, "sys.json.validate") == 0,
+                out_result);
+        }
+        return call_json_encode(vm, args[0].node_handle, out_result);
+    }
+    if (strcmp(target_value.string_value, "sys.http.parseRequest") == 0 ||
+        strcmp(target_value.string_value, "sys.http.parseResponse") == 0 ||
+        strcmp(target_value.string_value, "sys.http.buildResponse") == 0) {
+        contract_status = aivm_syscall_contract_validate(
+            target_value.string_value,
+            args,
+            effective_arg_count,
+            NULL);
+        if (contract_status != AIVM_CONTRACT_OK) {
+            set_vm_error(vm, AIVM_VM_ERR_SYSCALL, syscall_contract_failure_detail(contract_status));
+            return 0;
+        }
+        if (args[0].type == AIVM_VAL_INT) {
+            return call_http_build_response(
+                vm,
+                args[0].int_value,
+                args[1].string_value == NULL ? "" : args[1].string_value,
+                args[2].node_handle,
+                args[3].bytes_value,
+                out_result);
+        }
+        return call_http_parse(
+            vm,
+            strcmp(target_value.string_value, "sys.http.parseRequest") == 0,
+            args[0].bytes_value,
+            args[1].int_value,
+            out_result);
+    }
 
     syscall_status = aivm_syscall_dispatch_checked_with_contract(
         vm->syscall_bindings,
@@ -1505,6 +1565,10 @@ static int call_sys_with_arity(AivmVm* vm, size_t arg_count, AivmValue* out_resu
         effective_arg_count,
         out_result,
         &contract_status);
+    if (syscall_status == AIVM_SYSCALL_PENDING) {
+        *out_pending = 1;
+        return 0;
+    }
     if (syscall_status != AIVM_SYSCALL_OK) {
         if (syscall_status == AIVM_SYSCALL_ERR_INVALID) {
             (void)snprintf(
@@ -1900,6 +1964,16 @@ static int is_task_handle_pinned(const AivmVm* vm, int64_t handle)
             return 1;
         }
     }
+    for (i = 0U; i < vm->suspended_stack_used; i += 1U) {
+        if (value_matches_task_handle(vm->suspended_stack[i], handle)) {
+            return 1;
+        }
+    }
+    for (i = 0U; i < vm->suspended_locals_used; i += 1U) {
+        if (value_matches_task_handle(vm->suspended_locals[i], handle)) {
+            return 1;
+        }
+    }
     for (i = 0U; i < vm->completed_task_count; i += 1U) {
         if (vm->completed_tasks[i].handle != handle &&
             value_matches_task_handle(vm->completed_tasks[i].result, handle)) {
@@ -1921,7 +1995,8 @@ static int reclaim_oldest_completed_task_slot(AivmVm* vm)
         return 1;
     }
     for (index = 0U; index < vm->completed_task_count; index += 1U) {
-        if (!is_task_handle_pinned(vm, vm->completed_tasks[index].handle)) {
+        if (vm->completed_tasks[index].state != AIVM_TASK_STATE_PENDING &&
+            !is_task_handle_pinned(vm, vm->completed_tasks[index].handle)) {
             break;
         }
         increment_counter_saturating(&vm->task_reclaim_skip_pinned_count);
@@ -1944,23 +2019,23 @@ static int reclaim_oldest_completed_task_slot(AivmVm* vm)
     return 1;
 }
 
-static int push_completed_task(AivmVm* vm, AivmValue result)
+static AivmCompletedTask* allocate_pending_task(AivmVm* vm)
 {
     AivmCompletedTask* task;
     int64_t handle;
     size_t needed = 0U;
     if (vm == NULL) {
-        return 0;
+        return NULL;
     }
     if (vm->completed_task_count >= AIVM_VM_TASK_CAPACITY) {
         if (!reclaim_oldest_completed_task_slot(vm)) {
             set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Task table capacity exceeded.");
-            return 0;
+            return NULL;
         }
     }
     if (vm->next_task_handle == INT64_MAX) {
         set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Task handle overflow.");
-        return 0;
+        return NULL;
     }
 
     handle = vm->next_task_handle;
@@ -1968,33 +2043,36 @@ static int push_completed_task(AivmVm* vm, AivmValue result)
     if (!size_add_checked(vm->completed_task_count, 1U, &needed) ||
         needed > AIVM_VM_TASK_CAPACITY) {
         set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Task table capacity exceeded.");
-        return 0;
+        return NULL;
     }
     task = &vm->completed_tasks[vm->completed_task_count];
     task->state = AIVM_TASK_STATE_PENDING;
     task->handle = handle;
+    task->result = aivm_value_void();
+    vm->completed_task_count = needed;
+    return task;
+}
+
+static int push_completed_task(AivmVm* vm, AivmValue result)
+{
+    AivmCompletedTask* task = allocate_pending_task(vm);
+    if (task == NULL) {
+        return 0;
+    }
     task->result = result;
     if (!transition_task_state(vm, task, AIVM_TASK_STATE_COMPLETED)) {
         return 0;
     }
-    vm->completed_task_count = needed;
-    return aivm_stack_push(vm, aivm_value_int(handle));
+    return aivm_stack_push(vm, aivm_value_int(task->handle));
 }
 
-static int execute_call_subroutine_sync(AivmVm* vm, size_t target, AivmValue* out_result)
+/* Validates the callee layout and pushes its frame; the callee returns to the next instruction. */
+static int begin_call_subroutine(AivmVm* vm, size_t target, size_t* out_frame_base, size_t* out_return_ip)
 {
-    size_t baseline_frame_count;
     size_t arg_count;
     size_t frame_base;
     size_t return_ip;
-    size_t pre_restore_stack_count = 0U;
-    size_t max_stack_count = 0U;
-    size_t extra_stack_values = 0U;
-    AivmValue result = aivm_value_void();
 
-    if (vm == NULL || out_result == NULL) {
-        return 0;
-    }
     if (target >= vm->program->instruction_count) {
         set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Invalid function index.");
         return 0;
@@ -2008,7 +2086,6 @@ static int execute_call_subroutine_sync(AivmVm* vm, size_t target, AivmValue* ou
         return 0;
     }
 
-    baseline_frame_count = vm->call_frame_count;
     frame_base = vm->stack_count - arg_count;
     if (!size_add_checked(vm->instruction_pointer, 1U, &return_ip)) {
         set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Return instruction pointer overflowed.");
@@ -2019,11 +2096,56 @@ static int execute_call_subroutine_sync(AivmVm* vm, size_t target, AivmValue* ou
         return 0;
     }
     vm->instruction_pointer = target;
+    *out_frame_base = frame_base;
+    *out_return_ip = return_ip;
+    return 1;
+}
+
+/* Takes the callee's return value once its frame has been popped back to frame_base. */
+static int finish_call_subroutine(AivmVm* vm, size_t frame_base, AivmValue* out_result)
+{
+    size_t pre_restore_stack_count = 0U;
+    size_t max_stack_count = 0U;
+    size_t extra_stack_values = 0U;
+    AivmValue result = aivm_value_void();
+
+    pre_restore_stack_count = vm->stack_count;
+    if (vm->stack_count > frame_base) {
+        result = vm->stack[vm->stack_count - 1U];
+    }
+    if (!size_add_checked(frame_base, 1U, &max_stack_count)) {
+        set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Async return restore size arithmetic overflow.");
+        return 0;
+    }
+    if (pre_restore_stack_count > max_stack_count) {
+        if (!size_sub_checked(pre_restore_stack_count, max_stack_count, &extra_stack_values)) {
+            set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Async return restore size arithmetic overflow.");
+            return 0;
+        }
+        (void)snprintf(
+            vm->error_detail_storage,
+            sizeof(vm->error_detail_storage),
+            "Async return restore invalid. extraStackValues=%llu frameBase=%llu stackCount=%llu frameCount=%llu pc=%llu",
+            (unsigned long long)extra_stack_values,
+            (unsigned long long)frame_base,
+            (unsigned long long)pre_restore_stack_count,
+            (unsigned long long)vm->call_frame_count,
+            (unsigned long long)vm->instruction_pointer);
+        set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, vm->error_detail_storage);
+        return 0;
+    }
+    vm->stack_count = frame_base;
+    *out_result = result;
+    return 1;
+}
 
+/* Steps from a freshly pushed frame until control comes back to return_ip at baseline depth. */
+static int run_call_subroutine(AivmVm* vm, size_t baseline_frame_count, size_t return_ip)
+{
     while (vm->status != AIVM_VM_STATUS_ERROR) {
         if (vm->call_frame_count == baseline_frame_count &&
             vm->instruction_pointer == return_ip) {
-            break;
+            return 1;
         }
 
         if (vm->instruction_pointer >= vm->program->instruction_count) {
@@ -2036,102 +2158,2427 @@ static int execute_call_subroutine_sync(AivmVm* vm, size_t target, AivmValue* ou
             set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "HALT is invalid inside ASYNC_CALL.");
             return 0;
         }
+        if (vm->task_suspend_requested) {
+            return 2;
+        }
     }
+    return 0;
+}
 
-    if (vm->status == AIVM_VM_STATUS_ERROR) {
+static int execute_call_subroutine_sync(AivmVm* vm, size_t target, AivmValue* out_result)
+{
+    size_t baseline_frame_count;
+    size_t frame_base = 0U;
+    size_t return_ip = 0U;
+    int outcome;
+
+    if (vm == NULL || out_result == NULL) {
+        return 0;
+    }
+    baseline_frame_count = vm->call_frame_count;
+    if (!begin_call_subroutine(vm, target, &frame_base, &return_ip)) {
         return 0;
     }
+    /* Coroutines started below this loop cannot park until it returns. */
+    vm->task_sync_depth += 1U;
+    outcome = run_call_subroutine(vm, baseline_frame_count, return_ip);
+    vm->task_sync_depth -= 1U;
+    if (outcome != 1) {
+        if (outcome == 2) {
+            set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Task parked inside a synchronous call.");
+        }
+        return 0;
+    }
+    return finish_call_subroutine(vm, frame_base, out_result);
+}
 
-    pre_restore_stack_count = vm->stack_count;
-    if (vm->stack_count > frame_base) {
-        result = vm->stack[vm->stack_count - 1U];
+static int opcode_is_par_pure(AivmOpcode opcode)
+{
+    switch (opcode) {
+        case AIVM_OP_HALT:
+        case AIVM_OP_STUB:
+        case AIVM_OP_CALL_SYS:
+        case AIVM_OP_ASYNC_CALL_SYS:
+            return 0;
+        default:
+            return opcode >= AIVM_OP_NOP && opcode <= AIVM_OP_MAKE_MAP;
     }
-    if (!size_add_checked(frame_base, 1U, &max_stack_count)) {
-        set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Async return restore size arithmetic overflow.");
+}
+
+/* Walks every instruction reachable from target through jumps and calls; a branch is
+ * pure when none of them can reach a syscall or HALT and every path ends in a return. */
+static int par_target_is_pure(const AivmProgram* program, size_t target)
+{
+    uint8_t* visited;
+    size_t pending[256];
+    size_t pending_count = 0U;
+    int pure = 1;
+    if (program == NULL || program->instructions == NULL || target >= program->instruction_count) {
         return 0;
     }
-    if (pre_restore_stack_count > max_stack_count) {
-        if (!size_sub_checked(pre_restore_stack_count, max_stack_count, &extra_stack_values)) {
-            set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Async return restore size arithmetic overflow.");
+    visited = (uint8_t*)calloc((program->instruction_count / 8U) + 1U, 1U);
+    if (visited == NULL) {
+        return 0;
+    }
+    pending[pending_count] = target;
+    pending_count += 1U;
+    while (pure && pending_count > 0U) {
+        size_t ip;
+        pending_count -= 1U;
+        ip = pending[pending_count];
+        for (;;) {
+            const AivmInstruction* instruction;
+            size_t operand;
+            if (ip >= program->instruction_count) {
+                pure = 0;
+                break;
+            }
+            if ((visited[ip / 8U] & (uint8_t)(1U << (ip % 8U))) != 0U) {
+                break;
+            }
+            visited[ip / 8U] |= (uint8_t)(1U << (ip % 8U));
+            instruction = &program->instructions[ip];
+            if (!opcode_is_par_pure(instruction->opcode)) {
+                pure = 0;
+                break;
+            }
+            if (instruction->opcode == AIVM_OP_RET || instruction->opcode == AIVM_OP_RETURN) {
+                break;
+            }
+            if (instruction->opcode == AIVM_OP_JUMP ||
+                instruction->opcode == AIVM_OP_JUMP_IF_FALSE ||
+                instruction->opcode == AIVM_OP_CALL ||
+                instruction->opcode == AIVM_OP_ASYNC_CALL) {
+                if (instruction->operand_int < 0 ||
+                    (uint64_t)instruction->operand_int >= (uint64_t)program->instruction_count) {
+                    pure = 0;
+                    break;
+                }
+                operand = (size_t)instruction->operand_int;
+                if (instruction->opcode == AIVM_OP_JUMP) {
+                    ip = operand;
+                    continue;
+                }
+                if (pending_count >= (sizeof(pending) / sizeof(pending[0]))) {
+                    pure = 0;
+                    break;
+                }
+                pending[pending_count] = operand;
+                pending_count += 1U;
+            }
+            ip += 1U;
+        }
+    }
+    free(visited);
+    return pure;
+}
+
+/* Caches par_target_is_pure per target; the program never changes under a VM, so each
+ * target is scanned once. A full cache falls back to scanning on every call. */
+static int par_target_is_pure_cached(AivmVm* vm, size_t target)
+{
+    size_t i;
+    int pure;
+    for (i = 0U; i < vm->par_purity_count; i += 1U) {
+        if (vm->par_purity[i].target == target) {
+            return vm->par_purity[i].pure;
+        }
+    }
+    pure = par_target_is_pure(vm->program, target);
+    if (vm->par_purity_count < AIVM_VM_PAR_PURITY_CACHE_CAPACITY) {
+        vm->par_purity[vm->par_purity_count].target = target;
+        vm->par_purity[vm->par_purity_count].pure = pure;
+        vm->par_purity_count += 1U;
+    }
+    return pure;
+}
+
+/* Returns 1 when the ASYNC_CALL was deferred as a Par branch, 0 when it must run
+ * synchronously, and -1 on VM error. */
+static int try_defer_par_branch(AivmVm* vm, size_t target)
+{
+    AivmParBranch* branch;
+    AivmCompletedTask* task;
+    size_t arg_count;
+    size_t arg_base;
+    size_t i;
+    if (vm->par_executor == NULL ||
+        vm->par_context_count == 0U ||
+        vm->par_branch_count >= AIVM_VM_PAR_BRANCH_CAPACITY ||
+        target >= vm->program->instruction_count) {
+        return 0;
+    }
+    arg_count = infer_call_arg_count(vm->program, target);
+    if (arg_count > AIVM_VM_PAR_BRANCH_MAX_ARGS || arg_count > vm->stack_count) {
+        return 0;
+    }
+    arg_base = vm->stack_count - arg_count;
+    for (i = 0U; i < arg_count; i += 1U) {
+        AivmValueType type = vm->stack[arg_base + i].type;
+        if (type != AIVM_VAL_INT && type != AIVM_VAL_BOOL && type != AIVM_VAL_NULL &&
+            type != AIVM_VAL_VOID && type != AIVM_VAL_STRING) {
             return 0;
         }
-        (void)snprintf(
-            vm->error_detail_storage,
-            sizeof(vm->error_detail_storage),
-            "Async return restore invalid. extraStackValues=%llu frameBase=%llu stackCount=%llu frameCount=%llu pc=%llu",
-            (unsigned long long)extra_stack_values,
-            (unsigned long long)frame_base,
-            (unsigned long long)pre_restore_stack_count,
-            (unsigned long long)vm->call_frame_count,
-            (unsigned long long)vm->instruction_pointer);
-        set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, vm->error_detail_storage);
+    }
+    if (!par_target_is_pure_cached(vm, target)) {
+        return 0;
+    }
+    task = allocate_pending_task(vm);
+    if (task == NULL) {
+        return -1;
+    }
+    branch = &vm->par_branches[vm->par_branch_count];
+    branch->target = target;
+    branch->task_handle = task->handle;
+    branch->arg_count = arg_count;
+    for (i = 0U; i < arg_count; i += 1U) {
+        branch->args[i] = vm->stack[arg_base + i];
+    }
+    branch->status = AIVM_PAR_BRANCH_PENDING;
+    branch->result = aivm_value_void();
+    branch->result_text = NULL;
+    branch->result_bytes = NULL;
+    branch->result_tree = NULL;
+    vm->par_branch_count += 1U;
+    vm->stack_count = arg_base;
+    return aivm_stack_push(vm, aivm_value_int(task->handle)) ? 1 : -1;
+}
+
+static int complete_pending_task(AivmVm* vm, int64_t handle, AivmValue result)
+{
+    size_t i;
+    for (i = 0U; i < vm->completed_task_count; i += 1U) {
+        if (vm->completed_tasks[i].handle == handle &&
+            vm->completed_tasks[i].state == AIVM_TASK_STATE_PENDING) {
+            vm->completed_tasks[i].result = result;
+            return transition_task_state(vm, &vm->completed_tasks[i], AIVM_TASK_STATE_COMPLETED);
+        }
+    }
+    set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Par branch task handle was lost.");
+    return 0;
+}
+
+/* Strings are text offsets and children are tree indices, so a tree owns no pointers
+ * into the scratch VM. Nodes are stored in post-order: children precede parents and
+ * the root is last. */
+typedef struct {
+    size_t kind;
+    size_t id;
+    size_t attr_start;
+    size_t attr_count;
+    size_t child_start;
+    size_t child_count;
+} AivmParTreeNode;
+
+typedef struct {
+    size_t key;
+    AivmNodeAttrKind kind;
+    size_t string_value;
+    int64_t int_value;
+} AivmParTreeAttr;
+
+struct AivmParNodeTree {
+    AivmParTreeNode* nodes;
+    size_t node_count;
+    AivmParTreeAttr* attrs;
+    size_t attr_count;
+    size_t* children;
+    size_t child_count;
+    char* text;
+    size_t text_length;
+    size_t text_capacity;
+};
+
+static void par_node_tree_free(AivmParNodeTree* tree)
+{
+    if (tree == NULL) {
+        return;
+    }
+    free(tree->nodes);
+    free(tree->attrs);
+    free(tree->children);
+    free(tree->text);
+    free(tree);
+}
+
+static int par_node_tree_text(AivmParNodeTree* tree, const char* value, size_t* out_offset)
+{
+    size_t length = strlen(value == NULL ? "" : value);
+    if (tree->text_capacity - tree->text_length <= length) {
+        size_t capacity = tree->text_capacity * 2U;
+        char* grown;
+        while (capacity - tree->text_length <= length) {
+            capacity *= 2U;
+        }
+        grown = (char*)realloc(tree->text, capacity);
+        if (grown == NULL) {
+            return 0;
+        }
+        tree->text = grown;
+        tree->text_capacity = capacity;
+    }
+    memcpy(tree->text + tree->text_length, value == NULL ? "" : value, length + 1U);
+    *out_offset = tree->text_length;
+    tree->text_length += length + 1U;
+    return 1;
+}
+
+/* Appends the subtree at handle in post-order. tree_index maps a scratch node index to its
+ * tree index + 1 so shared subtrees are copied once; SIZE_MAX marks a node in progress. */
+static int par_node_tree_append(
+    const AivmVm* vm,
+    AivmParNodeTree* tree,
+    size_t* tree_index,
+    int64_t handle,
+    size_t* out_index)
+{
+    const AivmNodeRecord* node;
+    AivmParTreeNode* out;
+    size_t scratch_index;
+    size_t child_start;
+    size_t i;
+    if (!lookup_node(vm, handle, &node)) {
+        return 0;
+    }
+    scratch_index = (size_t)(handle - 1);
+    if (tree_index[scratch_index] == SIZE_MAX) {
+        return 0;
+    }
+    if (tree_index[scratch_index] != 0U) {
+        *out_index = tree_index[scratch_index] - 1U;
+        return 1;
+    }
+    tree_index[scratch_index] = SIZE_MAX;
+    child_start = tree->child_count;
+    tree->child_count += node->child_count;
+    for (i = 0U; i < node->child_count; i += 1U) {
+        size_t child_index;
+        if (!par_node_tree_append(vm, tree, tree_index, vm->node_children[node->child_start + i], &child_index)) {
+            return 0;
+        }
+        tree->children[child_start + i] = child_index;
+    }
+    out = &tree->nodes[tree->node_count];
+    out->attr_start = tree->attr_count;
+    out->attr_count = node->attr_count;
+    out->child_start = child_start;
+    out->child_count = node->child_count;
+    if (!par_node_tree_text(tree, node->kind, &out->kind) ||
+        !par_node_tree_text(tree, node->id, &out->id)) {
+        return 0;
+    }
+    for (i = 0U; i < node->attr_count; i += 1U) {
+        const AivmNodeAttr* attr = &vm->node_attrs[node->attr_start + i];
+        AivmParTreeAttr* out_attr = &tree->attrs[tree->attr_count];
+        out_attr->kind = attr->kind;
+        out_attr->string_value = 0U;
+        out_attr->int_value = 0;
+        if (!par_node_tree_text(tree, attr->key, &out_attr->key)) {
+            return 0;
+        }
+        if (attr->kind == AIVM_NODE_ATTR_IDENTIFIER || attr->kind == AIVM_NODE_ATTR_STRING) {
+            if (!par_node_tree_text(tree, attr->string_value, &out_attr->string_value)) {
+                return 0;
+            }
+        } else if (attr->kind == AIVM_NODE_ATTR_INT) {
+            out_attr->int_value = attr->int_value;
+        } else {
+            out_attr->int_value = attr->bool_value != 0 ? 1 : 0;
+        }
+        tree->attr_count += 1U;
+    }
+    *out_index = tree->node_count;
+    tree->node_count += 1U;
+    tree_index[scratch_index] = tree->node_count;
+    return 1;
+}
+
+/* Copies the node subtree at handle out of a (scratch) VM onto the heap. */
+static AivmParNodeTree* par_node_tree_capture(const AivmVm* vm, int64_t handle)
+{
+    AivmParNodeTree* tree;
+    size_t* tree_index;
+    size_t root_index;
+    int ok;
+    if (vm->node_count == 0U) {
+        return NULL;
+    }
+    tree = (AivmParNodeTree*)calloc(1U, sizeof(AivmParNodeTree));
+    tree_index = (size_t*)calloc(vm->node_count, sizeof(size_t));
+    if (tree == NULL || tree_index == NULL) {
+        free(tree);
+        free(tree_index);
+        return NULL;
+    }
+    tree->nodes = (AivmParTreeNode*)malloc(vm->node_count * sizeof(AivmParTreeNode));
+    tree->attrs = (AivmParTreeAttr*)malloc((vm->node_attr_count + 1U) * sizeof(AivmParTreeAttr));
+    tree->children = (size_t*)malloc((vm->node_child_count + 1U) * sizeof(size_t));
+    tree->text_capacity = 256U;
+    tree->text = (char*)malloc(tree->text_capacity);
+    ok = tree->nodes != NULL && tree->attrs != NULL && tree->children != NULL && tree->text != NULL &&
+         par_node_tree_append(vm, tree, tree_index, handle, &root_index);
+    free(tree_index);
+    if (!ok) {
+        par_node_tree_free(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+/* Recreates a captured tree in the owner VM. Built nodes stay on the stack until their
+ * parent exists so node GC during create_node_record keeps and remaps them. */
+static int par_node_tree_restore(AivmVm* vm, const AivmParNodeTree* tree, AivmValue* out_result)
+{
+    size_t stack_base = vm->stack_count;
+    AivmNodeAttr* attrs;
+    int64_t* children;
+    size_t i;
+    int ok = 1;
+    attrs = (AivmNodeAttr*)malloc((tree->attr_count + 1U) * sizeof(AivmNodeAttr));
+    children = (int64_t*)malloc((tree->child_count + 1U) * sizeof(int64_t));
+    if (attrs == NULL || children == NULL) {
+        free(attrs);
+        free(children);
+        set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "Par branch node result could not be restored.");
+        return 0;
+    }
+    for (i = 0U; ok && i < tree->node_count; i += 1U) {
+        const AivmParTreeNode* node = &tree->nodes[i];
+        int64_t handle;
+        size_t j;
+        for (j = 0U; j < node->attr_count; j += 1U) {
+            const AivmParTreeAttr* attr = &tree->attrs[node->attr_start + j];
+            attrs[j].key = tree->text + attr->key;
+            attrs[j].kind = attr->kind;
+            if (attr->kind == AIVM_NODE_ATTR_IDENTIFIER || attr->kind == AIVM_NODE_ATTR_STRING) {
+                attrs[j].string_value = tree->text + attr->string_value;
+            } else if (attr->kind == AIVM_NODE_ATTR_INT) {
+                attrs[j].int_value = attr->int_value;
+            } else {
+                attrs[j].bool_value = (int)attr->int_value;
+            }
+        }
+        for (j = 0U; j < node->child_count; j += 1U) {
+            children[j] = vm->stack[stack_base + tree->children[node->child_start + j]].node_handle;
+        }
+        ok = create_node_record(
+                 vm,
+                 tree->text + node->kind,
+                 tree->text + node->id,
+                 attrs,
+                 node->attr_count,
+                 children,
+                 node->child_count,
+                 &handle) &&
+             aivm_stack_push(vm, aivm_value_node(handle));
+    }
+    if (ok) {
+        *out_result = vm->stack[vm->stack_count - 1U];
+    }
+    vm->stack_count = stack_base;
+    free(attrs);
+    free(children);
+    return ok;
+}
+
+/* Runs deferred branches [first, count) through the host executor, then completes their
+ * tasks on the owner in fork order. Branches the executor could not finish re-run here. */
+static int resolve_par_branches(AivmVm* vm, size_t first)
+{
+    size_t i;
+    size_t resume_ip = vm->instruction_pointer;
+    int ok = 1;
+    if (first >= vm->par_branch_count) {
+        return 1;
+    }
+    vm->par_executor(vm->par_executor_context, vm->program, &vm->par_branches[first], vm->par_branch_count - first);
+    for (i = first; i < vm->par_branch_count; i += 1U) {
+        AivmParBranch* branch = &vm->par_branches[i];
+        AivmValue result = branch->result;
+        if (ok && branch->status == AIVM_PAR_BRANCH_DONE) {
+            if (branch->result_text != NULL) {
+                char* text = copy_string_to_arena(vm, branch->result_text);
+                if (text == NULL) {
+                    set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "Par branch result exceeded string arena.");
+                    ok = 0;
+                } else {
+                    result = aivm_value_string(text);
+                }
+            } else if (branch->result_bytes != NULL) {
+                uint8_t* bytes = copy_bytes_to_arena(vm, branch->result_bytes, result.bytes_value.length);
+                if (bytes == NULL) {
+                    set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "Par branch result exceeded bytes arena.");
+                    ok = 0;
+                } else {
+                    result = aivm_value_bytes(bytes, result.bytes_value.length);
+                }
+            } else if (branch->result_tree != NULL) {
+                ok = par_node_tree_restore(vm, branch->result_tree, &result);
+            }
+        } else if (ok) {
+            size_t arg_i;
+            for (arg_i = 0U; ok && arg_i < branch->arg_count; arg_i += 1U) {
+                ok = aivm_stack_push(vm, branch->args[arg_i]);
+            }
+            if (ok) {
+                ok = execute_call_subroutine_sync(vm, branch->target, &result);
+            }
+            vm->instruction_pointer = resume_ip;
+        }
+        aivm_par_branch_release(branch);
+        if (ok) {
+            ok = complete_pending_task(vm, branch->task_handle, result);
+        }
+    }
+    vm->par_branch_count = first;
+    return ok;
+}
+
+static int is_par_branch_handle(const AivmVm* vm, int64_t handle)
+{
+    size_t i;
+    for (i = 0U; i < vm->par_branch_count; i += 1U) {
+        if (vm->par_branches[i].task_handle == handle) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int task_segment_fits(const AivmVm* vm, const AivmRunningTask* task, size_t extra_stack_values)
+{
+    size_t stack_values = vm->stack_count - task->stack_base + extra_stack_values;
+    size_t frames = vm->call_frame_count - task->frame_base;
+    size_t locals = vm->locals_count - task->locals_base;
+    return vm->suspended_task_count < AIVM_VM_SUSPENDED_TASK_CAPACITY &&
+           stack_values <= AIVM_VM_SUSPENDED_STACK_CAPACITY - vm->suspended_stack_used &&
+           frames <= AIVM_VM_SUSPENDED_FRAME_CAPACITY - vm->suspended_frames_used &&
+           locals <= AIVM_VM_SUSPENDED_LOCALS_CAPACITY - vm->suspended_locals_used;
+}
+
+static int is_suspended_task_handle(const AivmVm* vm, int64_t handle)
+{
+    size_t i;
+    for (i = 0U; i < vm->suspended_task_count; i += 1U) {
+        if (vm->suspended_tasks[i].task_handle == handle) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Moves the top running coroutine's stack, frames, and locals into suspended storage. */
+static int suspend_running_task(AivmVm* vm)
+{
+    AivmRunningTask* task = &vm->running_tasks[vm->running_task_count - 1U];
+    AivmSuspendedTask* saved;
+    size_t i;
+    if (!task_segment_fits(vm, task, 0U)) {
+        set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "Suspended task storage exhausted.");
+        return 0;
+    }
+    if (task->task_handle == 0) {
+        AivmCompletedTask* pending = allocate_pending_task(vm);
+        if (pending == NULL) {
+            return 0;
+        }
+        task->task_handle = pending->handle;
+    }
+    saved = &vm->suspended_tasks[vm->suspended_task_count];
+    saved->task_handle = task->task_handle;
+    saved->instruction_pointer = vm->instruction_pointer;
+    saved->stack_start = vm->suspended_stack_used;
+    saved->stack_count = vm->stack_count - task->stack_base;
+    saved->frame_start = vm->suspended_frames_used;
+    saved->frame_count = vm->call_frame_count - task->frame_base;
+    saved->locals_start = vm->suspended_locals_used;
+    saved->locals_count = vm->locals_count - task->locals_base;
+    for (i = 0U; i < saved->stack_count; i += 1U) {
+        vm->suspended_stack[saved->stack_start + i] = vm->stack[task->stack_base + i];
+    }
+    for (i = 0U; i < saved->frame_count; i += 1U) {
+        AivmCallFrame frame = vm->call_frames[task->frame_base + i];
+        frame.frame_base -= task->stack_base;
+        frame.locals_base -= task->locals_base;
+        vm->suspended_frames[saved->frame_start + i] = frame;
+    }
+    for (i = 0U; i < saved->locals_count; i += 1U) {
+        vm->suspended_locals[saved->locals_start + i] = vm->locals[task->locals_base + i];
+    }
+    vm->suspended_stack_used += saved->stack_count;
+    vm->suspended_frames_used += saved->frame_count;
+    vm->suspended_locals_used += saved->locals_count;
+    vm->suspended_task_count += 1U;
+    vm->stack_count = task->stack_base;
+    vm->call_frame_count = task->frame_base;
+    vm->locals_count = task->locals_base;
+    vm->instruction_pointer = task->return_instruction_pointer;
+    return 1;
+}
+
+static void remove_suspended_head(AivmVm* vm)
+{
+    AivmSuspendedTask head = vm->suspended_tasks[0];
+    size_t i;
+    memmove(
+        &vm->suspended_stack[0],
+        &vm->suspended_stack[head.stack_count],
+        (vm->suspended_stack_used - head.stack_count) * sizeof(AivmValue));
+    memmove(
+        &vm->suspended_frames[0],
+        &vm->suspended_frames[head.frame_count],
+        (vm->suspended_frames_used - head.frame_count) * sizeof(AivmCallFrame));
+    memmove(
+        &vm->suspended_locals[0],
+        &vm->suspended_locals[head.locals_count],
+        (vm->suspended_locals_used - head.locals_count) * sizeof(AivmValue));
+    vm->suspended_stack_used -= head.stack_count;
+    vm->suspended_frames_used -= head.frame_count;
+    vm->suspended_locals_used -= head.locals_count;
+    memmove(
+        &vm->suspended_tasks[0],
+        &vm->suspended_tasks[1],
+        (vm->suspended_task_count - 1U) * sizeof(AivmSuspendedTask));
+    vm->suspended_task_count -= 1U;
+    for (i = 0U; i < vm->suspended_task_count; i += 1U) {
+        vm->suspended_tasks[i].stack_start -= head.stack_count;
+        vm->suspended_tasks[i].frame_start -= head.frame_count;
+        vm->suspended_tasks[i].locals_start -= head.locals_count;
+    }
+}
+
+/* Steps the top running coroutine until it returns (1), parks (2), or fails (0). */
+static int run_task_segment(AivmVm* vm, AivmValue* out_result)
+{
+    AivmRunningTask* task = &vm->running_tasks[vm->running_task_count - 1U];
+    int outcome = run_call_subroutine(vm, task->frame_base, task->return_instruction_pointer);
+    if (outcome == 2) {
+        vm->task_suspend_requested = 0;
+        return suspend_running_task(vm) ? 2 : 0;
+    }
+    if (outcome == 1) {
+        return finish_call_subroutine(vm, task->stack_base, out_result);
+    }
+    return 0;
+}
+
+/* ASYNC_CALL: runs the callee as a coroutine until it returns or parks, then pushes its task handle. */
+static int start_async_task(AivmVm* vm, size_t target)
+{
+    AivmRunningTask* task;
+    AivmValue result = aivm_value_void();
+    size_t baseline_frame_count = vm->call_frame_count;
+    size_t frame_base = 0U;
+    size_t return_ip = 0U;
+    int outcome;
+    if (vm->running_task_count >= AIVM_VM_RUNNING_TASK_CAPACITY) {
+        return execute_call_subroutine_sync(vm, target, &result) && push_completed_task(vm, result);
+    }
+    if (!begin_call_subroutine(vm, target, &frame_base, &return_ip)) {
+        return 0;
+    }
+    task = &vm->running_tasks[vm->running_task_count];
+    task->task_handle = 0;
+    task->stack_base = frame_base;
+    task->frame_base = baseline_frame_count;
+    task->locals_base = vm->call_frames[baseline_frame_count].locals_base;
+    task->par_context_base = vm->par_context_count;
+    task->sync_depth = vm->task_sync_depth;
+    task->return_instruction_pointer = return_ip;
+    vm->running_task_count += 1U;
+    outcome = run_task_segment(vm, &result);
+    vm->running_task_count -= 1U;
+    if (outcome == 0) {
+        return 0;
+    }
+    if (outcome == 2) {
+        return aivm_stack_push(vm, aivm_value_int(task->task_handle));
+    }
+    /* Handles are assigned at completion, matching synchronous ASYNC_CALL numbering. */
+    return push_completed_task(vm, result);
+}
+
+/* Restores the oldest parked coroutine on top of the current state and runs it until it returns or parks. */
+static int resume_next_suspended_task(AivmVm* vm, int* out_progressed)
+{
+    AivmSuspendedTask saved;
+    AivmRunningTask* task;
+    AivmValue result = aivm_value_void();
+    size_t resume_ip = vm->instruction_pointer;
+    size_t stack_needed = 0U;
+    size_t frames_needed = 0U;
+    size_t locals_needed = 0U;
+    size_t i;
+    int outcome;
+
+    *out_progressed = 0;
+    if (vm->running_task_count >= AIVM_VM_RUNNING_TASK_CAPACITY) {
+        set_vm_error(vm, AIVM_VM_ERR_FRAME_OVERFLOW, "Task resume depth exceeded.");
+        return 0;
+    }
+    saved = vm->suspended_tasks[0];
+    if (!size_add_checked(vm->stack_count, saved.stack_count, &stack_needed) ||
+        !size_add_checked(vm->call_frame_count, saved.frame_count, &frames_needed) ||
+        !size_add_checked(vm->locals_count, saved.locals_count, &locals_needed) ||
+        !ensure_stack_capacity(vm, stack_needed) ||
+        !ensure_call_frame_capacity(vm, frames_needed) ||
+        !ensure_locals_capacity(vm, locals_needed)) {
+        set_vm_error(vm, AIVM_VM_ERR_STACK_OVERFLOW, "Resumed task exceeded VM capacity.");
+        return 0;
+    }
+
+    task = &vm->running_tasks[vm->running_task_count];
+    task->task_handle = saved.task_handle;
+    task->stack_base = vm->stack_count;
+    task->frame_base = vm->call_frame_count;
+    task->locals_base = vm->locals_count;
+    task->par_context_base = vm->par_context_count;
+    task->sync_depth = vm->task_sync_depth;
+    task->return_instruction_pointer = resume_ip;
+    for (i = 0U; i < saved.stack_count; i += 1U) {
+        vm->stack[task->stack_base + i] = vm->suspended_stack[saved.stack_start + i];
+    }
+    for (i = 0U; i < saved.frame_count; i += 1U) {
+        AivmCallFrame frame = vm->suspended_frames[saved.frame_start + i];
+        frame.frame_base += task->stack_base;
+        frame.locals_base += task->locals_base;
+        if (i == 0U) {
+            frame.return_instruction_pointer = resume_ip;
+        }
+        vm->call_frames[task->frame_base + i] = frame;
+    }
+    for (i = 0U; i < saved.locals_count; i += 1U) {
+        vm->locals[task->locals_base + i] = vm->suspended_locals[saved.locals_start + i];
+    }
+    vm->stack_count = stack_needed;
+    vm->call_frame_count = frames_needed;
+    vm->locals_count = locals_needed;
+    remove_suspended_head(vm);
+
+    vm->instruction_pointer = saved.instruction_pointer;
+    vm->running_task_count += 1U;
+    outcome = run_task_segment(vm, &result);
+    vm->running_task_count -= 1U;
+    if (outcome == 0) {
+        return 0;
+    }
+    vm->instruction_pointer = resume_ip;
+    if (outcome == 2) {
+        *out_progressed =
+            vm->suspended_tasks[vm->suspended_task_count - 1U].instruction_pointer != saved.instruction_pointer;
+        return 1;
+    }
+    *out_progressed = 1;
+    return complete_pending_task(vm, saved.task_handle, result);
+}
+
+/* Gives every parked coroutine one turn, waiting on the host when none of them moved. */
+static int run_suspended_task_round(AivmVm* vm)
+{
+    size_t remaining = vm->suspended_task_count;
+    int progressed = 0;
+    while (remaining > 0U && vm->suspended_task_count > 0U) {
+        int task_progressed = 0;
+        if (!resume_next_suspended_task(vm, &task_progressed)) {
+            return 0;
+        }
+        progressed |= task_progressed;
+        remaining -= 1U;
+    }
+    if (!progressed && vm->task_wait_hook != NULL) {
+        vm->task_wait_hook(vm->task_wait_context);
+    }
+    return 1;
+}
+
+/* Runs parked coroutines round-robin until the task with handle is no longer parked. */
+static int drive_suspended_task(AivmVm* vm, int64_t handle)
+{
+    while (is_suspended_task_handle(vm, handle)) {
+        if (!run_suspended_task_round(vm)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* A syscall returned PENDING: restore its operands so the instruction re-runs, then park the
+ * calling coroutine or, outside one, give parked tasks a turn before the retry. */
+static int handle_pending_syscall(AivmVm* vm, size_t stack_count_before)
+{
+    vm->stack_count = stack_count_before;
+    if (aivm_task_can_suspend(vm)) {
+        vm->task_suspend_requested = 1;
+        return 1;
+    }
+    if (vm->suspended_task_count > 0U) {
+        return run_suspended_task_round(vm);
+    }
+    if (vm->task_wait_hook != NULL) {
+        vm->task_wait_hook(vm->task_wait_context);
+    }
+    return 1;
+}
+
+/* A deferred Par branch settles, and surfaces any failure, before the owner's next side
+ * effect, which is where inline execution would already have run it. */
+static int settle_par_branches(AivmVm* vm)
+{
+    return vm->par_branch_count == 0U || resolve_par_branches(vm, 0U);
+}
+
+/* The root program is finishing: parked coroutines still owe their side effects, so run them
+ * to completion before halting. Inside a coroutine HALT is reported by run_call_subroutine. */
+static int drain_suspended_tasks(AivmVm* vm)
+{
+    if (vm->running_task_count > 0U) {
+        return 1;
+    }
+    if (!settle_par_branches(vm)) {
+        return 0;
+    }
+    while (vm->suspended_task_count > 0U) {
+        if (!run_suspended_task_round(vm)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void halt_after_suspended_tasks(AivmVm* vm)
+{
+    if (drain_suspended_tasks(vm)) {
+        aivm_halt(vm);
+    }
+}
+
+static int is_terminal_task_state(AivmTaskState state)
+{
+    return state == AIVM_TASK_STATE_COMPLETED ||
+        state == AIVM_TASK_STATE_FAILED ||
+        state == AIVM_TASK_STATE_CANCELED;
+}
+
+static int task_terminal_payload_is_valid(const AivmVm* vm, const AivmCompletedTask* task)
+{
+    const AivmNodeRecord* node;
+    if (vm == NULL || task == NULL) {
+        return 0;
+    }
+    if (task->state == AIVM_TASK_STATE_FAILED || task->state == AIVM_TASK_STATE_CANCELED) {
+        if (task->result.type != AIVM_VAL_NODE) {
+            return 0;
+        }
+        if (!lookup_node(vm, task->result.node_handle, &node)) {
+            return 0;
+        }
+        return strcmp(node->kind, "Err") == 0;
+    }
+    return 1;
+}
+
+static int call_debug_task_reclaim_stats(AivmVm* vm, AivmValue* out_result)
+{
+    AivmNodeAttr attrs[3];
+    int64_t handle;
+    char id_buffer[40];
+    size_t next_node_count = 0U;
+    size_t suffix_length;
+    if (vm == NULL || out_result == NULL) {
+        return 0;
+    }
+    memcpy(id_buffer, "debug_task_reclaim_stats_", 25U);
+    if (!size_add_checked(vm->node_count, 1U, &next_node_count)) {
+        set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "debug task stats node id overflow.");
+        return 0;
+    }
+    suffix_length = write_u64_decimal(id_buffer + 25U, sizeof(id_buffer) - 25U, (uint64_t)next_node_count);
+    if (suffix_length == 0U) {
+        set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "debug task stats node id overflow.");
+        return 0;
+    }
+
+    attrs[0].key = "reclaimed";
+    attrs[0].kind = AIVM_NODE_ATTR_INT;
+    attrs[0].int_value = (int64_t)vm->task_reclaim_count;
+    attrs[1].key = "skipPinned";
+    attrs[1].kind = AIVM_NODE_ATTR_INT;
+    attrs[1].int_value = (int64_t)vm->task_reclaim_skip_pinned_count;
+    attrs[2].key = "exhausted";
+    attrs[2].kind = AIVM_NODE_ATTR_INT;
+    attrs[2].int_value = (int64_t)vm->task_reclaim_exhausted_count;
+
+    if (!create_node_record(vm, "DebugTaskReclaimStats", id_buffer, attrs, 3U, NULL, 0U, &handle)) {
+        return 0;
+    }
+    *out_result = aivm_value_node(handle);
+    return 1;
+}
+
+/*
+ * sys.json.parse / sys.json.encode run inside the VM so they can allocate
+ * node trees directly. Parsed trees keep the std/json.aos shape: JsonNull,
+ * JsonBool{Lit#value}, JsonNumber{Lit#raw}, JsonString{Lit#value Lit#raw},
+ * JsonArray{values...}, JsonObject{JsonField{Lit#key value}...}. Finished
+ * values wait on the VM stack until their parent is built so node GC sees them.
+ * sys.json.validate runs the same parser with text_only set: it builds no tree
+ * and returns the input with surrounding whitespace removed as Lit#text.
+ */
+typedef struct {
+    AivmVm* vm;
+    char* text;
+    size_t length;
+    size_t pos;
+    size_t depth;
+    int text_only;
+    char* scratch;
+    int64_t* children;
+    const char* error_code;
+    const char* error_message;
+} AivmJsonParser;
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    int failed;
+} AivmJsonWriter;
+
+static int json_fail(AivmJsonParser* parser, const char* code, const char* message)
+{
+    if (parser->error_code == NULL) {
+        parser->error_code = code;
+        parser->error_message = message;
+    }
+    return 0;
+}
+
+static int json_is_ws(char ch)
+{
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+}
+
+static int json_is_number_char(char ch)
+{
+    return (ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E';
+}
+
+static void json_skip_ws(AivmJsonParser* parser)
+{
+    while (parser->pos < parser->length && json_is_ws(parser->text[parser->pos])) {
+        parser->pos += 1U;
+    }
+}
+
+static int json_hex4(const char* text, uint32_t* out_value)
+{
+    uint32_t value = 0U;
+    size_t i;
+    for (i = 0U; i < 4U; i += 1U) {
+        char ch = text[i];
+        uint32_t digit;
+        if (ch >= '0' && ch <= '9') {
+            digit = (uint32_t)(ch - '0');
+        } else if (ch >= 'a' && ch <= 'f') {
+            digit = (uint32_t)(ch - 'a') + 10U;
+        } else if (ch >= 'A' && ch <= 'F') {
+            digit = (uint32_t)(ch - 'A') + 10U;
+        } else {
+            return 0;
+        }
+        value = (value << 4U) | digit;
+    }
+    *out_value = value;
+    return 1;
+}
+
+static size_t json_write_utf8(char* output, uint32_t code_point)
+{
+    if (code_point <= 0x7FU) {
+        output[0] = (char)code_point;
+        return 1U;
+    }
+    if (code_point <= 0x7FFU) {
+        output[0] = (char)(0xC0U | (code_point >> 6U));
+        output[1] = (char)(0x80U | (code_point & 0x3FU));
+        return 2U;
+    }
+    if (code_point <= 0xFFFFU) {
+        output[0] = (char)(0xE0U | (code_point >> 12U));
+        output[1] = (char)(0x80U | ((code_point >> 6U) & 0x3FU));
+        output[2] = (char)(0x80U | (code_point & 0x3FU));
+        return 3U;
+    }
+    output[0] = (char)(0xF0U | (code_point >> 18U));
+    output[1] = (char)(0x80U | ((code_point >> 12U) & 0x3FU));
+    output[2] = (char)(0x80U | ((code_point >> 6U) & 0x3FU));
+    output[3] = (char)(0x80U | (code_point & 0x3FU));
+    return 4U;
+}
+
+/* Finds the closing quote for the string opening at parser->pos. */
+static int json_find_string_close(const AivmJsonParser* parser, size_t* out_close)
+{
+    size_t i = parser->pos + 1U;
+    while (i < parser->length) {
+        char ch = parser->text[i];
+        if (ch == '"') {
+            *out_close = i;
+            return 1;
+        }
+        i += (ch == '\\') ? 2U : 1U;
+    }
+    return 0;
+}
+
+/*
+ * Decodes text[start, end) into parser->scratch. Escapes std/json.aos does not
+ * decode (\b, \f, unknown letters, bad or unpaired \u sequences) are kept
+ * verbatim, so the decoded text is never longer than the raw body.
+ */
+static const char* json_decode_string(AivmJsonParser* parser, size_t start, size_t end)
+{
+    const char* text = parser->text;
+    char* out = parser->scratch;
+    size_t used = 0U;
+    size_t i = start;
+    while (i < end) {
+        char ch = text[i];
+        char escaped;
+        if (ch != '\\' || i + 1U >= end) {
+            out[used++] = ch;
+            i += 1U;
+            continue;
+        }
+        escaped = text[i + 1U];
+        if (escaped == 'u') {
+            uint32_t high;
+            uint32_t low;
+            if (i + 6U > end) {
+                out[used++] = '\\';
+                out[used++] = 'u';
+                i += 2U;
+                continue;
+            }
+            if (json_hex4(text + i + 2U, &high)) {
+                if (high != 0U && (high < 0xD800U || high > 0xDFFFU)) {
+                    used += json_write_utf8(out + used, high);
+                    i += 6U;
+                    continue;
+                }
+                if (high >= 0xD800U && high <= 0xDBFFU &&
+                    i + 12U <= end &&
+                    text[i + 6U] == '\\' &&
+                    text[i + 7U] == 'u' &&
+                    json_hex4(text + i + 8U, &low) &&
+                    low >= 0xDC00U && low <= 0xDFFFU) {
+                    used += json_write_utf8(out + used, 0x10000U + ((high - 0xD800U) << 10U) + (low - 0xDC00U));
+                    i += 12U;
+                    continue;
+                }
+            }
+            memcpy(out + used, text + i, 6U);
+            used += 6U;
+            i += 6U;
+            continue;
+        }
+        switch (escaped) {
+            case '"': out[used++] = '"'; break;
+            case '\\': out[used++] = '\\'; break;
+            case '/': out[used++] = '/'; break;
+            case 'n': out[used++] = '\n'; break;
+            case 'r': out[used++] = '\r'; break;
+            case 't': out[used++] = '\t'; break;
+            default:
+                out[used++] = '\\';
+                out[used++] = escaped;
+                break;
+        }
+        i += 2U;
+    }
+    out[used] = '\0';
+    return out;
+}
+
+static int json_push_lit(AivmJsonParser* parser, const char* id, const AivmNodeAttr* value)
+{
+    int64_t handle;
+    AivmNodeAttr attr = *value;
+    attr.key = "value";
+    if (parser->text_only) {
+        return 1;
+    }
+    if (!create_node_record(parser->vm, "Lit", id, &attr, 1U, NULL, 0U, &handle)) {
+        return 0;
+    }
+    return aivm_stack_push(parser->vm, aivm_value_node(handle));
+}
+
+static int json_push_lit_string(AivmJsonParser* parser, const char* id, const char* value)
+{
+    AivmNodeAttr attr;
+    attr.key = "value";
+    attr.kind = AIVM_NODE_ATTR_STRING;
+    attr.string_value = value;
+    return json_push_lit(parser, id, &attr);
+}
+
+/* Same as json_push_lit_string for text[start, end) of the private input copy. */
+static int json_push_lit_span(AivmJsonParser* parser, const char* id, size_t start, size_t end)
+{
+    char saved = parser->text[end];
+    int ok;
+    parser->text[end] = '\0';
+    ok = json_push_lit_string(parser, id, parser->text + start);
+    parser->text[end] = saved;
+    return ok;
+}
+
+/* Replaces the values pushed since stack_base with one `kind` node owning them. */
+static int json_wrap(AivmJsonParser* parser, const char* kind, size_t stack_base)
+{
+    AivmVm* vm = parser->vm;
+    size_t count = vm->stack_count - stack_base;
+    size_t i;
+    int64_t handle;
+    if (parser->text_only) {
+        return 1;
+    }
+    for (i = 0U; i < count; i += 1U) {
+        parser->children[i] = vm->stack[stack_base + i].node_handle;
+    }
+    if (!create_node_record(vm, kind, kind, NULL, 0U, parser->children, count, &handle)) {
+        return 0;
+    }
+    vm->stack_count = stack_base;
+    return aivm_stack_push(vm, aivm_value_node(handle));
+}
+
+static int json_parse_value(AivmJsonParser* parser, const char* invalid_code, const char* invalid_message);
+
+static int json_parse_string(AivmJsonParser* parser)
+{
+    size_t close = 0U;
+    size_t base = parser->vm->stack_count;
+    if (!json_find_string_close(parser, &close)) {
+        return json_fail(parser, "JSON_UNTERMINATED_STRING", "String literal is not terminated.");
+    }
+    if ((!parser->text_only &&
+         !json_push_lit_string(parser, "value", json_decode_string(parser, parser->pos + 1U, close))) ||
+        !json_push_lit_span(parser, "raw", parser->pos, close + 1U) ||
+        !json_wrap(parser, "JsonString", base)) {
+        return 0;
+    }
+    parser->pos = close + 1U;
+    return 1;
+}
+
+static int json_parse_array(AivmJsonParser* parser)
+{
+    size_t base = parser->vm->stack_count;
+    parser->pos += 1U;
+    for (;;) {
+        json_skip_ws(parser);
+        if (parser->pos >= parser->length) {
+            return json_fail(parser, "JSON_UNTERMINATED_ARRAY", "Array literal is not terminated.");
+        }
+        if (parser->text[parser->pos] == ']') {
+            break;
+        }
+        if (!json_parse_value(parser, "JSON_ARRAY_VALUE", "Array contains an invalid value.")) {
+            return 0;
+        }
+        json_skip_ws(parser);
+        if (parser->pos >= parser->length) {
+            return json_fail(parser, "JSON_UNTERMINATED_ARRAY", "Array literal is not terminated.");
+        }
+        if (parser->text[parser->pos] == ']') {
+            break;
+        }
+        if (parser->text[parser->pos] != ',') {
+            return json_fail(parser, "JSON_ARRAY_SEPARATOR", "Expected ',' between array elements.");
+        }
+        parser->pos += 1U;
+    }
+    parser->pos += 1U;
+    return json_wrap(parser, "JsonArray", base);
+}
+
+static int json_parse_object(AivmJsonParser* parser)
+{
+    size_t base = parser->vm->stack_count;
+    parser->pos += 1U;
+    for (;;) {
+        size_t close = 0U;
+        size_t field_base;
+        json_skip_ws(parser);
+        if (parser->pos >= parser->length) {
+            return json_fail(parser, "JSON_UNTERMINATED_OBJECT", "Object literal is not terminated.");
+        }
+        if (parser->text[parser->pos] == '}') {
+            break;
+        }
+        if (parser->text[parser->pos] != '"') {
+            return json_fail(parser, "JSON_OBJECT_KEY", "Object key must be a quoted string.");
+        }
+        if (!json_find_string_close(parser, &close)) {
+            return json_fail(parser, "JSON_OBJECT_KEY", "Object key string is not terminated.");
+        }
+        field_base = parser->vm->stack_count;
+        if (!parser->text_only &&
+            !json_push_lit_string(parser, "key", json_decode_string(parser, parser->pos + 1U, close))) {
+            return 0;
+        }
+        parser->pos = close + 1U;
+        json_skip_ws(parser);
+        if (parser->pos >= parser->length || parser->text[parser->pos] != ':') {
+            return json_fail(parser, "JSON_OBJECT_COLON", "Expected ':' after object key.");
+        }
+        parser->pos += 1U;
+        json_skip_ws(parser);
+        if (parser->pos >= parser->length) {
+            return json_fail(parser, "JSON_UNTERMINATED_OBJECT", "Object literal is not terminated.");
+        }
+        if (parser->text[parser->pos] == '}' || parser->text[parser->pos] == ',') {
+            return json_fail(parser, "JSON_OBJECT_VALUE", "Missing object value.");
+        }
+        if (!json_parse_value(parser, "JSON_OBJECT_VALUE", "Object value is invalid.") ||
+            !json_wrap(parser, "JsonField", field_base)) {
+            return 0;
+        }
+        json_skip_ws(parser);
+        if (parser->pos >= parser->length) {
+            return json_fail(parser, "JSON_UNTERMINATED_OBJECT", "Object literal is not terminated.");
+        }
+        if (parser->text[parser->pos] == '}') {
+            break;
+        }
+        if (parser->text[parser->pos] != ',') {
+            return json_fail(parser, "JSON_OBJECT_SEPARATOR", "Expected ',' between object fields.");
+        }
+        parser->pos += 1U;
+    }
+    parser->pos += 1U;
+    return json_wrap(parser, "JsonObject", base);
+}
+
+static int json_parse_value(AivmJsonParser* parser, const char* invalid_code, const char* invalid_message)
+{
+    const char* at = parser->text + parser->pos;
+    size_t remaining = parser->length - parser->pos;
+    size_t base = parser->vm->stack_count;
+    int ok;
+    if (*at == '"') {
+        return json_parse_string(parser);
+    }
+    if (*at == '[' || *at == '{') {
+        if (parser->depth >= AIVM_VM_JSON_MAX_DEPTH) {
+            return json_fail(parser, "JSON_DEPTH", "JSON nesting is too deep.");
+        }
+        parser->depth += 1U;
+        ok = (*at == '[') ? json_parse_array(parser) : json_parse_object(parser);
+        parser->depth -= 1U;
+        return ok;
+    }
+    if ((remaining >= 4U && memcmp(at, "true", 4U) == 0) ||
+        (remaining >= 5U && memcmp(at, "false", 5U) == 0)) {
+        AivmNodeAttr attr;
+        attr.key = "value";
+        attr.kind = AIVM_NODE_ATTR_BOOL;
+        attr.bool_value = (*at == 't') ? 1 : 0;
+        parser->pos += (*at == 't') ? 4U : 5U;
+        return json_push_lit(parser, "value", &attr) && json_wrap(parser, "JsonBool", base);
+    }
+    if (remaining >= 4U && memcmp(at, "null", 4U) == 0) {
+        parser->pos += 4U;
+        return json_wrap(parser, "JsonNull", base);
+    }
+    if (json_is_number_char(*at)) {
+        size_t end = parser->pos;
+        int has_digit = 0;
+        while (end < parser->length && json_is_number_char(parser->text[end])) {
+            if (parser->text[end] >= '0' && parser->text[end] <= '9') {
+                has_digit = 1;
+            }
+            end += 1U;
+        }
+        if (has_digit) {
+            if (!json_push_lit_span(parser, "raw", parser->pos, end)) {
+                return 0;
+            }
+            parser->pos = end;
+            return json_wrap(parser, "JsonNumber", base);
+        }
+    }
+    return json_fail(parser, invalid_code, invalid_message);
+}
+
+static int call_json_parse(AivmVm* vm, const char* input, int text_only, AivmValue* out_result)
+{
+    AivmJsonParser parser;
+    AivmNodeAttr attrs[3];
+    size_t stack_base;
+    size_t value_start;
+    size_t value_end = 0U;
+    int64_t handle;
+    int ok;
+    memset(&parser, 0, sizeof(parser));
+    parser.vm = vm;
+    parser.text_only = text_only;
+    parser.length = strlen(input);
+    parser.text = (char*)malloc(parser.length + 1U);
+    parser.scratch = (char*)malloc(parser.length + 1U);
+    parser.children = (int64_t*)malloc(sizeof(int64_t) * AIVM_VM_STACK_CAPACITY);
+    if (parser.text == NULL || parser.scratch == NULL || parser.children == NULL) {
+        free(parser.text);
+        free(parser.scratch);
+        free(parser.children);
+        set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "sys.json.parse could not allocate parser buffers.");
+        return 0;
+    }
+    /* Node allocation may compact the string arena, so parse a private copy. */
+    memcpy(parser.text, input, parser.length + 1U);
+    stack_base = vm->stack_count;
+    json_skip_ws(&parser);
+    value_start = parser.pos;
+    if (parser.pos >= parser.length) {
+        ok = json_fail(&parser, "JSON_EMPTY", "JSON input is empty.");
+    } else {
+        ok = json_parse_value(
+            &parser,
+            "JSON_UNSUPPORTED",
+            "Parser supports null, booleans, numbers, quoted strings, arrays, and objects.");
+        value_end = parser.pos;
+        json_skip_ws(&parser);
+        if (ok && parser.pos < parser.length) {
+            ok = json_fail(
+                &parser,
+                "JSON_UNSUPPORTED",
+                "Parser supports null, booleans, numbers, quoted strings, arrays, and objects.");
+        }
+    }
+    if (ok && text_only) {
+        parser.text[value_end] = '\0';
+        attrs[0].key = "value";
+        attrs[0].kind = AIVM_NODE_ATTR_STRING;
+        attrs[0].string_value = parser.text + value_start;
+        ok = create_node_record(vm, "Lit", "text", attrs, 1U, NULL, 0U, &handle);
+        free(parser.text);
+        free(parser.scratch);
+        free(parser.children);
+        if (ok) {
+            *out_result = aivm_value_node(handle);
+        }
+        return ok;
+    }
+    free(parser.text);
+    free(parser.scratch);
+    free(parser.children);
+    if (ok) {
+        vm->stack_count -= 1U;
+        *out_result = vm->stack[vm->stack_count];
+        return 1;
+    }
+    if (vm->status == AIVM_VM_STATUS_ERROR || parser.error_code == NULL) {
+        return 0;
+    }
+    vm->stack_count = stack_base;
+    attrs[0].key = "code";
+    attrs[0].kind = AIVM_NODE_ATTR_IDENTIFIER;
+    attrs[0].string_value = parser.error_code;
+    attrs[1].key = "message";
+    attrs[1].kind = AIVM_NODE_ATTR_STRING;
+    attrs[1].string_value = parser.error_message;
+    attrs[2].key = "nodeId";
+    attrs[2].kind = AIVM_NODE_ATTR_IDENTIFIER;
+    attrs[2].string_value = "json";
+    if (!create_node_record(vm, "Err", "json_parse", attrs, 3U, NULL, 0U, &handle)) {
+        return 0;
+    }
+    *out_result = aivm_value_node(handle);
+    return 1;
+}
+
+static void json_write(AivmJsonWriter* writer, const char* data, size_t length)
+{
+    if (writer->failed || length == 0U) {
+        return;
+    }
+    if (length > writer->capacity - writer->length) {
+        size_t capacity = writer->capacity == 0U ? 256U : writer->capacity;
+        char* grown;
+        while (length > capacity - writer->length) {
+            if (capacity > ((size_t)-1) / 2U) {
+                writer->failed = 1;
+                return;
+            }
+            capacity *= 2U;
+        }
+        grown = (char*)realloc(writer->data, capacity);
+        if (grown == NULL) {
+            writer->failed = 1;
+            return;
+        }
+        writer->data = grown;
+        writer->capacity = capacity;
+    }
+    memcpy(writer->data + writer->length, data, length);
+    writer->length += length;
+}
+
+static void json_write_text(AivmJsonWriter* writer, const char* text)
+{
+    json_write(writer, text, strlen(text));
+}
+
+static void json_write_quoted(AivmJsonWriter* writer, const char* text)
+{
+    static const char k_hex[] = "0123456789abcdef";
+    const char* run = text;
+    const char* cursor = text;
+    json_write(writer, "\"", 1U);
+    for (; *cursor != '\0'; cursor += 1) {
+        unsigned char ch = (unsigned char)*cursor;
+        char escape[6];
+        size_t escape_length = 2U;
+        if (ch >= 0x20U && ch != '"' && ch != '\\') {
+            continue;
+        }
+        json_write(writer, run, (size_t)(cursor - run));
+        run = cursor + 1;
+        escape[0] = '\\';
+        switch (ch) {
+            case '"': escape[1] = '"'; break;
+            case '\\': escape[1] = '\\'; break;
+            case '\n': escape[1] = 'n'; break;
+            case '\r': escape[1] = 'r'; break;
+            case '\t': escape[1] = 't'; break;
+            case '\b': escape[1] = 'b'; break;
+            case '\f': escape[1] = 'f'; break;
+            default:
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = k_hex[ch >> 4U];
+                escape[5] = k_hex[ch & 0x0FU];
+                escape_length = 6U;
+                break;
+        }
+        json_write(writer, escape, escape_length);
+    }
+    json_write(writer, run, (size_t)(cursor - run));
+    json_write(writer, "\"", 1U);
+}
+
+static const AivmNodeAttr* json_find_attr(const AivmVm* vm, const AivmNodeRecord* node, const char* key)
+{
+    size_t i;
+    for (i = 0U; i < node->attr_count; i += 1U) {
+        const AivmNodeAttr* attr = &vm->node_attrs[node->attr_start + i];
+        if (attr->key != NULL && strcmp(attr->key, key) == 0) {
+            return attr;
+        }
+    }
+    return NULL;
+}
+
+/* Returns the `value` attribute of the first Lit child with the given id. */
+static const AivmNodeAttr* json_find_lit_child(const AivmVm* vm, const AivmNodeRecord* node, const char* id)
+{
+    size_t i;
+    for (i = 0U; i < node->child_count; i += 1U) {
+        const AivmNodeRecord* child;
+        if (lookup_node(vm, vm->node_children[node->child_start + i], &child) &&
+            strcmp(child->kind, "Lit") == 0 &&
+            strcmp(child->id, id) == 0) {
+            return json_find_attr(vm, child, "value");
+        }
+    }
+    return NULL;
+}
+
+static const char* json_attr_string(const AivmNodeAttr* attr)
+{
+    if (attr == NULL ||
+        (attr->kind != AIVM_NODE_ATTR_STRING && attr->kind != AIVM_NODE_ATTR_IDENTIFIER) ||
+        attr->string_value == NULL) {
+        return NULL;
+    }
+    return attr->string_value;
+}
+
+/* Mirrors std.json.stringify for Lit values: identifiers and missing values encode as null. */
+static void json_write_lit_value(AivmJsonWriter* writer, const AivmNodeAttr* attr)
+{
+    char number[32];
+    if (attr == NULL) {
+        json_write_text(writer, "null");
+    } else if (attr->kind == AIVM_NODE_ATTR_STRING) {
+        json_write_quoted(writer, attr->string_value == NULL ? "" : attr->string_value);
+    } else if (attr->kind == AIVM_NODE_ATTR_INT) {
+        (void)snprintf(number, sizeof(number), "%lld", (long long)attr->int_value);
+        json_write_text(writer, number);
+    } else if (attr->kind == AIVM_NODE_ATTR_BOOL) {
+        json_write_text(writer, attr->bool_value != 0 ? "true" : "false");
+    } else {
+        json_write_text(writer, "null");
+    }
+}
+
+typedef struct {
+    const char* key;
+    size_t index;
+} AivmJsonMapEntry;
+
+static int json_compare_map_entries(const void* left, const void* right)
+{
+    const AivmJsonMapEntry* a = (const AivmJsonMapEntry*)left;
+    const AivmJsonMapEntry* b = (const AivmJsonMapEntry*)right;
+    int order = strcmp(a->key, b->key);
+    if (order != 0) {
+        return order;
+    }
+    return (a->index < b->index) ? -1 : (a->index > b->index ? 1 : 0);
+}
+
+static int json_encode_node(AivmVm* vm, AivmJsonWriter* writer, int64_t handle, size_t depth);
+
+/* Map fields are emitted in key order and a repeated key keeps its first field. */
+static int json_encode_map(AivmVm* vm, AivmJsonWriter* writer, const AivmNodeRecord* node, size_t depth)
+{
+    AivmJsonMapEntry* entries;
+    size_t count = 0U;
+    size_t i;
+    int wrote = 0;
+    if (node->child_count == 0U) {
+        json_write_text(writer, "{}");
+        return 1;
+    }
+    entries = (AivmJsonMapEntry*)malloc(sizeof(AivmJsonMapEntry) * node->child_count);
+    if (entries == NULL) {
+        writer->failed = 1;
+        return 0;
+    }
+    for (i = 0U; i < node->child_count; i += 1U) {
+        const AivmNodeRecord* field;
+        const char* key = NULL;
+        if (lookup_node(vm, vm->node_children[node->child_start + i], &field)) {
+            key = json_attr_string(json_find_attr(vm, field, "key"));
+        }
+        entries[count].key = key == NULL ? "" : key;
+        entries[count].index = i;
+        count += 1U;
+    }
+    qsort(entries, count, sizeof(AivmJsonMapEntry), json_compare_map_entries);
+    json_write(writer, "{", 1U);
+    for (i = 0U; i < count; i += 1U) {
+        const AivmNodeRecord* field;
+        if (i > 0U && strcmp(entries[i].key, entries[i - 1U].key) == 0) {
+            continue;
+        }
+        if (wrote) {
+            json_write(writer, ",", 1U);
+        }
+        wrote = 1;
+        json_write_quoted(writer, entries[i].key);
+        json_write(writer, ":", 1U);
+        if (lookup_node(vm, vm->node_children[node->child_start + entries[i].index], &field) &&
+            field->child_count == 1U) {
+            if (!json_encode_node(vm, writer, vm->node_children[field->child_start], depth + 1U)) {
+                free(entries);
+                return 0;
+            }
+        } else {
+            json_write_text(writer, "null");
+        }
+    }
+    json_write(writer, "}", 1U);
+    free(entries);
+    return 1;
+}
+
+static int json_encode_node(AivmVm* vm, AivmJsonWriter* writer, int64_t handle, size_t depth)
+{
+    const AivmNodeRecord* node;
+    const char* kind;
+    const char* raw;
+    size_t i;
+    if (depth > AIVM_VM_JSON_MAX_DEPTH) {
+        set_vm_error(vm, AIVM_VM_ERR_SYSCALL, "sys.json.encode nesting is too deep.");
+        return 0;
+    }
+    if (!lookup_node(vm, handle, &node)) {
+        json_write_text(writer, "null");
+        return 1;
+    }
+    /* std/json.aos builds its nodes with MakeBlock, which carries the kind in the id. */
+    kind = (strcmp(node->kind, "Block") == 0) ? node->id : node->kind;
+    if (strcmp(kind, "Map") == 0) {
+        return json_encode_map(vm, writer, node, depth);
+    }
+    if (strcmp(kind, "Lit") == 0) {
+        json_write_lit_value(writer, json_find_attr(vm, node, "value"));
+        return 1;
+    }
+    if (strcmp(kind, "JsonBool") == 0) {
+        json_write_lit_value(writer, json_find_lit_child(vm, node, "value"));
+        return 1;
+    }
+    if (strcmp(kind, "JsonNumber") == 0 || strcmp(kind, "JsonString") == 0 ||
+        strcmp(kind, "JsonArray") == 0 || strcmp(kind, "JsonObject") == 0) {
+        raw = json_attr_string(json_find_lit_child(vm, node, "raw"));
+        if (raw != NULL) {
+            json_write_text(writer, raw);
+            return 1;
+        }
+    }
+    if (strcmp(kind, "JsonString") == 0) {
+        json_write_lit_value(writer, json_find_lit_child(vm, node, "value"));
+        return 1;
+    }
+    if (strcmp(kind, "JsonArray") == 0) {
+        json_write(writer, "[", 1U);
+        for (i = 0U; i < node->child_count; i += 1U) {
+            if (i > 0U) {
+                json_write(writer, ",", 1U);
+            }
+            if (!json_encode_node(vm, writer, vm->node_children[node->child_start + i], depth + 1U)) {
+                return 0;
+            }
+        }
+        json_write(writer, "]", 1U);
+        return 1;
+    }
+    if (strcmp(kind, "JsonObject") == 0) {
+        int wrote = 0;
+        json_write(writer, "{", 1U);
+        for (i = 0U; i < node->child_count; i += 1U) {
+            const AivmNodeRecord* field;
+            const char* key;
+            if (!lookup_node(vm, vm->node_children[node->child_start + i], &field)) {
+                continue;
+            }
+            key = json_attr_string(json_find_lit_child(vm, field, "key"));
+            if (key == NULL) {
+                continue;
+            }
+            if (wrote) {
+                json_write(writer, ",", 1U);
+            }
+            wrote = 1;
+            json_write_quoted(writer, key);
+            json_write(writer, ":", 1U);
+            if (field->child_count < 2U) {
+                json_write_text(writer, "null");
+            } else if (!json_encode_node(vm, writer, vm->node_children[field->child_start + 1U], depth + 1U)) {
+                return 0;
+            }
+        }
+        json_write(writer, "}", 1U);
+        return 1;
+    }
+    json_write_text(writer, "null");
+    return 1;
+}
+
+static int call_json_encode(AivmVm* vm, int64_t handle, AivmValue* out_result)
+{
+    AivmJsonWriter writer;
+    char* output;
+    memset(&writer, 0, sizeof(writer));
+    if (!json_encode_node(vm, &writer, handle, 0U)) {
+        free(writer.data);
+        if (writer.failed && vm->status != AIVM_VM_STATUS_ERROR) {
+            set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "sys.json.encode could not allocate its output.");
+        }
+        return 0;
+    }
+    json_write(&writer, "", 1U);
+    if (writer.failed) {
+        free(writer.data);
+        set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "sys.json.encode could not allocate its output.");
+        return 0;
+    }
+    output = copy_string_to_arena(vm, writer.data);
+    free(writer.data);
+    if (output == NULL) {
+        return 0;
+    }
+    *out_result = aivm_value_string(output);
+    return 1;
+}
+
+/*
+ * sys.http.parseRequest / sys.http.parseResponse scan one HTTP/1.x message at
+ * the front of a bytes value. Callers append each sys.net.tcp.read chunk and
+ * pass the previous length back so the header terminator search resumes where
+ * it stopped; an HttpPartial node means the header block is not complete yet.
+ * Messages describe the body by offsets instead of copying it: headers (and
+ * the request query) are Map nodes, and chunked bodies list HttpChunk spans.
+ */
+typedef struct {
+    AivmVm* vm;
+    const uint8_t* data;
+    size_t length;
+    char* scratch;
+    int64_t* children;
+    size_t field_count;
+    size_t content_length;
+    int has_content_length;
+    int chunked;
+    int connection_close;
+    int connection_keep_alive;
+    int64_t needed;
+    const char* error_code;
+    const char* error_message;
+} AivmHttpParser;
+
+static int http_fail(AivmHttpParser* parser, const char* code, const char* message)
+{
+    if (parser->error_code == NULL) {
+        parser->error_code = code;
+        parser->error_message = message;
+    }
+    return 0;
+}
+
+static int http_is_tchar(uint8_t ch)
+{
+    if ((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z')) {
+        return 1;
+    }
+    return ch != 0U && strchr("!#$%&'*+-.^_`|~", (int)ch) != NULL;
+}
+
+static int http_is_ows(uint8_t ch)
+{
+    return ch == ' ' || ch == '\t';
+}
+
+static uint8_t http_lower(uint8_t ch)
+{
+    return (ch >= 'A' && ch <= 'Z') ? (uint8_t)(ch + ('a' - 'A')) : ch;
+}
+
+static int http_hex_value(uint8_t ch)
+{
+    if (ch >= '0' && ch <= '9') {
+        return (int)(ch - '0');
+    }
+    ch = http_lower(ch);
+    if (ch >= 'a' && ch <= 'f') {
+        return (int)(ch - 'a') + 10;
+    }
+    return -1;
+}
+
+static int http_span_equals_ci(const uint8_t* data, size_t start, size_t end, const char* text)
+{
+    size_t i;
+    if (end - start != strlen(text)) {
+        return 0;
+    }
+    for (i = start; i < end; i += 1U) {
+        if (http_lower(data[i]) != (uint8_t)text[i - start]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Reports whether a comma-separated header value lists `token`, or ends with it when last_only. */
+static int http_has_token_ci(const uint8_t* data, size_t start, size_t end, const char* token, int last_only)
+{
+    int found = 0;
+    while (start < end) {
+        size_t item_end = start;
+        size_t trimmed_end;
+        while (item_end < end && data[item_end] != ',') {
+            item_end += 1U;
+        }
+        trimmed_end = item_end;
+        while (start < trimmed_end && http_is_ows(data[start])) {
+            start += 1U;
+        }
+        while (trimmed_end > start && http_is_ows(data[trimmed_end - 1U])) {
+            trimmed_end -= 1U;
+        }
+        if (start < trimmed_end) {
+            if (http_span_equals_ci(data, start, trimmed_end, token)) {
+                found = 1;
+            } else if (last_only) {
+                found = 0;
+            }
+        }
+        start = item_end + 1U;
+    }
+    return found;
+}
+
+static const char* http_span_text(AivmHttpParser* parser, size_t start, size_t end)
+{
+    memcpy(parser->scratch, parser->data + start, end - start);
+    parser->scratch[end - start] = '\0';
+    return parser->scratch;
+}
+
+/* Query components decode '+' and %XX; malformed and %00 escapes stay verbatim. */
+static const char* http_decode_component(AivmHttpParser* parser, size_t start, size_t end)
+{
+    const uint8_t* data = parser->data;
+    size_t used = 0U;
+    size_t i = start;
+    while (i < end) {
+        if (data[i] == '+') {
+            parser->scratch[used++] = ' ';
+            i += 1U;
+            continue;
+        }
+        if (data[i] == '%' && end - i >= 3U &&
+            http_hex_value(data[i + 1U]) >= 0 &&
+            http_hex_value(data[i + 2U]) >= 0 &&
+            (data[i + 1U] != '0' || data[i + 2U] != '0')) {
+            parser->scratch[used++] = (char)(http_hex_value(data[i + 1U]) * 16 + http_hex_value(data[i + 2U]));
+            i += 3U;
+            continue;
+        }
+        parser->scratch[used++] = (char)data[i];
+        i += 1U;
+    }
+    parser->scratch[used] = '\0';
+    return parser->scratch;
+}
+
+/* Replaces the nodes pushed since stack_base with one node owning them, like json_wrap. */
+static int http_wrap(
+    AivmHttpParser* parser,
+    const char* kind,
+    const char* id,
+    const AivmNodeAttr* attrs,
+    size_t attr_count,
+    size_t stack_base)
+{
+    AivmVm* vm = parser->vm;
+    size_t count = vm->stack_count - stack_base;
+    size_t i;
+    int64_t handle;
+    for (i = 0U; i < count; i += 1U) {
+        parser->children[i] = vm->stack[stack_base + i].node_handle;
+    }
+    if (!create_node_record(vm, kind, id, attrs, attr_count, parser->children, count, &handle)) {
+        return 0;
+    }
+    vm->stack_count = stack_base;
+    return aivm_stack_push(vm, aivm_value_node(handle));
+}
+
+/* Pushes Field(key){Lit(value)}, the shape MAKE_FIELD_STRING builds for Map entries. */
+static int http_push_field(
+    AivmHttpParser* parser,
+    size_t key_start,
+    size_t key_end,
+    size_t value_start,
+    size_t value_end,
+    int decode)
+{
+    size_t base = parser->vm->stack_count;
+    AivmNodeAttr attr;
+    if (parser->field_count >= AIVM_VM_HTTP_MAX_FIELDS) {
+        return http_fail(parser, "HTTP_TOO_MANY_FIELDS", "Message has too many header or query fields.");
+    }
+    parser->field_count += 1U;
+    attr.key = "value";
+    attr.kind = AIVM_NODE_ATTR_STRING;
+    attr.string_value = decode
+        ? http_decode_component(parser, value_start, value_end)
+        : http_span_text(parser, value_start, value_end);
+    if (!http_wrap(parser, "Lit", "value", &attr, 1U, base)) {
+        return 0;
+    }
+    attr.key = "key";
+    attr.string_value = decode
+        ? http_decode_component(parser, key_start, key_end)
+        : http_span_text(parser, key_start, key_end);
+    return http_wrap(parser, "Field", "field", &attr, 1U, base);
+}
+
+/* Finds the end of the header block (after CRLFCRLF or LFLF) searching from `from`. */
+static int http_find_header_end(const AivmHttpParser* parser, size_t from, size_t* out_end)
+{
+    const uint8_t* data = parser->data;
+    size_t i = from;
+    while (i < parser->length) {
+        const uint8_t* newline = (const uint8_t*)memchr(data + i, '\n', parser->length - i);
+        size_t next;
+        if (newline == NULL) {
+            return 0;
+        }
+        next = (size_t)(newline - data) + 1U;
+        if (next < parser->length && data[next] == '\n') {
+            *out_end = next + 1U;
+            return 1;
+        }
+        if (next + 1U < parser->length && data[next] == '\r' && data[next + 1U] == '\n') {
+            *out_end = next + 2U;
+            return 1;
+        }
+        i = next;
+    }
+    return 0;
+}
+
+/* Returns the index of the next '\n' in [start, limit), or limit when there is none. */
+static size_t http_line_end(const AivmHttpParser* parser, size_t start, size_t limit)
+{
+    const uint8_t* newline = (const uint8_t*)memchr(parser->data + start, '\n', limit - start);
+    return newline == NULL ? limit : (size_t)(newline - parser->data);
+}
+
+static size_t http_trim_cr(const AivmHttpParser* parser, size_t start, size_t newline)
+{
+    return (newline > start && parser->data[newline - 1U] == '\r') ? newline - 1U : newline;
+}
+
+static int http_parse_version(const AivmHttpParser* parser, size_t start, size_t end, int* out_minor)
+{
+    const uint8_t* data = parser->data;
+    if (end - start != 8U || memcmp(data + start, "HTTP/1.", 7U) != 0 ||
+        data[start + 7U] < '0' || data[start + 7U] > '9') {
+        return 0;
+    }
+    *out_minor = (int)(data[start + 7U] - '0');
+    return 1;
+}
+
+/* Pushes the header Map for the lines in [start, header_end) and records framing headers. */
+static int http_parse_headers(AivmHttpParser* parser, size_t start, size_t header_end)
+{
+    const uint8_t* data = parser->data;
+    size_t base = parser->vm->stack_count;
+    while (start < header_end) {
+        size_t newline = http_line_end(parser, start, header_end);
+        size_t end = http_trim_cr(parser, start, newline);
+        size_t colon = start;
+        size_t value_start;
+        size_t value_end;
+        size_t i;
+        if (end == start) {
+            break;
+        }
+        while (colon < end && data[colon] != ':') {
+            if (!http_is_tchar(data[colon])) {
+                return http_fail(parser, "HTTP_HEADER", "Header line is malformed.");
+            }
+            colon += 1U;
+        }
+        if (colon == start || colon == end) {
+            return http_fail(parser, "HTTP_HEADER", "Header line is malformed.");
+        }
+        value_start = colon + 1U;
+        value_end = end;
+        while (value_start < value_end && http_is_ows(data[value_start])) {
+            value_start += 1U;
+        }
+        while (value_end > value_start && http_is_ows(data[value_end - 1U])) {
+            value_end -= 1U;
+        }
+        for (i = value_start; i < value_end; i += 1U) {
+            if ((data[i] < 0x20U && data[i] != '\t') || data[i] == 0x7FU) {
+                return http_fail(parser, "HTTP_HEADER", "Header value contains a control character.");
+            }
+        }
+        if (http_span_equals_ci(data, start, colon, "content-length")) {
+            size_t value = 0U;
+            if (value_start == value_end) {
+                return http_fail(parser, "HTTP_CONTENT_LENGTH", "Content-Length is not a decimal number.");
+            }
+            for (i = value_start; i < value_end; i += 1U) {
+                if (data[i] < '0' || data[i] > '9' || value > (SIZE_MAX - 9U) / 10U) {
+                    return http_fail(parser, "HTTP_CONTENT_LENGTH", "Content-Length is not a decimal number.");
+                }
+                value = value * 10U + (size_t)(data[i] - '0');
+            }
+            if (parser->has_content_length && parser->content_length != value) {
+                return http_fail(parser, "HTTP_CONTENT_LENGTH", "Content-Length values conflict.");
+            }
+            parser->has_content_length = 1;
+            parser->content_length = value;
+        } else if (http_span_equals_ci(data, start, colon, "transfer-encoding")) {
+            parser->chunked = http_has_token_ci(data, value_start, value_end, "chunked", 1);
+        } else if (http_span_equals_ci(data, start, colon, "connection")) {
+            parser->connection_close |= http_has_token_ci(data, value_start, value_end, "close", 0);
+            parser->connection_keep_alive |= http_has_token_ci(data, value_start, value_end, "keep-alive", 0);
+        }
+        if (!http_push_field(parser, start, colon, value_start, value_end, 0)) {
+            return 0;
+        }
+        start = newline + 1U;
+    }
+    return http_wrap(parser, "Map", "map", NULL, 0U, base);
+}
+
+static int http_parse_query(AivmHttpParser* parser, size_t start, size_t end)
+{
+    size_t base = parser->vm->stack_count;
+    while (start < end) {
+        size_t pair_end = start;
+        size_t equals;
+        while (pair_end < end && parser->data[pair_end] != '&') {
+            pair_end += 1U;
+        }
+        equals = start;
+        while (equals < pair_end && parser->data[equals] != '=') {
+            equals += 1U;
+        }
+        if (pair_end > start &&
+            !http_push_field(parser, start, equals, equals < pair_end ? equals + 1U : pair_end, pair_end, 1)) {
+            return 0;
+        }
+        start = pair_end + 1U;
+    }
+    return http_wrap(parser, "Map", "map", NULL, 0U, base);
+}
+
+/*
+ * Pushes the HttpChunks node for a chunked body starting at `start` and sets
+ * the end of the parsed input and the decoded length. Returns 1 when the last
+ * chunk and trailers were seen, -1 when more input is needed, or 0 on error.
+ */
+static int http_parse_chunks(AivmHttpParser* parser, size_t start, size_t* out_end, size_t* out_body_length)
+{
+    const uint8_t* data = parser->data;
+    size_t base = parser->vm->stack_count;
+    size_t chunk_count = 0U;
+    int complete = 0;
+    *out_body_length = 0U;
+    for (;;) {
+        size_t newline = http_line_end(parser, start, parser->length);
+        size_t end;
+        size_t size = 0U;
+        size_t i = start;
+        size_t data_start;
+        AivmNodeAttr attrs[2];
+        if (newline == parser->length) {
+            break;
+        }
+        end = http_trim_cr(parser, start, newline);
+        while (i < end && http_hex_value(data[i]) >= 0) {
+            if (size > ((size_t)INT32_MAX >> 4U)) {
+                return http_fail(parser, "HTTP_CHUNK", "Chunk size is too large.");
+            }
+            size = (size << 4U) | (size_t)http_hex_value(data[i]);
+            i += 1U;
+        }
+        if (i == start || (i < end && data[i] != ';' && !http_is_ows(data[i]))) {
+            return http_fail(parser, "HTTP_CHUNK", "Chunk size line is malformed.");
+        }
+        data_start = newline + 1U;
+        if (size == 0U) {
+            for (;;) {
+                newline = http_line_end(parser, data_start, parser->length);
+                if (newline == parser->length) {
+                    break;
+                }
+                if (http_trim_cr(parser, data_start, newline) == data_start) {
+                    start = newline + 1U;
+                    complete = 1;
+                    break;
+                }
+                data_start = newline + 1U;
+            }
+            break;
+        }
+        if (size > parser->length - data_start) {
+            parser->needed = (int64_t)(size - (parser->length - data_start)) + 2;
+            break;
+        }
+        i = data_start + size;
+        if (i == parser->length || (data[i] == '\r' && i + 1U == parser->length)) {
+            parser->needed = (int64_t)(i + 2U - parser->length);
+            break;
+        }
+        if (data[i] == '\r' && data[i + 1U] == '\n') {
+            i += 2U;
+        } else if (data[i] == '\n') {
+            i += 1U;
+        } else {
+            return http_fail(parser, "HTTP_CHUNK", "Chunk data is not followed by a line break.");
+        }
+        if (chunk_count >= AIVM_VM_HTTP_MAX_CHUNKS) {
+            return http_fail(parser, "HTTP_TOO_MANY_CHUNKS", "Chunked body has too many chunks.");
+        }
+        chunk_count += 1U;
+        attrs[0].key = "start";
+        attrs[0].kind = AIVM_NODE_ATTR_INT;
+        attrs[0].int_value = (int64_t)data_start;
+        attrs[1].key = "length";
+        attrs[1].kind = AIVM_NODE_ATTR_INT;
+        attrs[1].int_value = (int64_t)size;
+        if (!http_wrap(parser, "HttpChunk", "http_chunk", attrs, 2U, parser->vm->stack_count)) {
+            return 0;
+        }
+        *out_body_length += size;
+        start = i;
+    }
+    *out_end = start;
+    if (!http_wrap(parser, "HttpChunks", "http_chunks", NULL, 0U, base)) {
+        return 0;
+    }
+    return complete ? 1 : -1;
+}
+
+static int http_push_error(AivmVm* vm, const char* code, const char* message, AivmValue* out_result)
+{
+    AivmNodeAttr attrs[3];
+    int64_t handle;
+    attrs[0].key = "code";
+    attrs[0].kind = AIVM_NODE_ATTR_IDENTIFIER;
+    attrs[0].string_value = code;
+    attrs[1].key = "message";
+    attrs[1].kind = AIVM_NODE_ATTR_STRING;
+    attrs[1].string_value = message;
+    attrs[2].key = "nodeId";
+    attrs[2].kind = AIVM_NODE_ATTR_IDENTIFIER;
+    attrs[2].string_value = "http";
+    if (!create_node_record(vm, "Err", "http_parse", attrs, 3U, NULL, 0U, &handle)) {
         return 0;
     }
-    vm->stack_count = frame_base;
-    *out_result = result;
+    *out_result = aivm_value_node(handle);
     return 1;
 }
 
-static int is_terminal_task_state(AivmTaskState state)
+static void http_set_int_attr(AivmNodeAttr* attr, const char* key, int64_t value)
 {
-    return state == AIVM_TASK_STATE_COMPLETED ||
-        state == AIVM_TASK_STATE_FAILED ||
-        state == AIVM_TASK_STATE_CANCELED;
+    attr->key = key;
+    attr->kind = AIVM_NODE_ATTR_INT;
+    attr->int_value = value;
 }
 
-static int task_terminal_payload_is_valid(const AivmVm* vm, const AivmCompletedTask* task)
+static void http_set_bool_attr(AivmNodeAttr* attr, const char* key, int value)
 {
-    const AivmNodeRecord* node;
-    if (vm == NULL || task == NULL) {
+    attr->key = key;
+    attr->kind = AIVM_NODE_ATTR_BOOL;
+    attr->bool_value = value != 0 ? 1 : 0;
+}
+
+/* Copies the spans into scratch back to back so several attrs can point at them at once. */
+static const char* http_stash_span(AivmHttpParser* parser, size_t* io_used, size_t start, size_t end)
+{
+    char* out = parser->scratch + *io_used;
+    memcpy(out, parser->data + start, end - start);
+    out[end - start] = '\0';
+    *io_used += end - start + 1U;
+    return out;
+}
+
+/*
+ * Builds HttpRequest(method path query ...){Map headers, Map query, HttpChunks}
+ * or HttpResponse(statusCode reason untilClose ...){Map headers, HttpChunks}.
+ * Both share the trailing attrs (version headerLength bodyLength messageLength
+ * chunked keepAlive complete needed) at indexes 3-10 so std/http can read the
+ * framing either way; an incomplete body still yields the message so headers
+ * are usable early. Returns 1 with the message on the stack, 0 on error, or -1
+ * when the header block itself is incomplete.
+ */
+static int http_parse_message(AivmHttpParser* parser, int is_request, size_t prev_length)
+{
+    const uint8_t* data = parser->data;
+    size_t start = 0U;
+    size_t header_end = 0U;
+    size_t line_end;
+    size_t first_end;
+    size_t base = parser->vm->stack_count;
+    size_t body_length = 0U;
+    size_t message_end;
+    size_t scratch_used = 0U;
+    size_t method_end = 0U;
+    size_t target_start = 0U;
+    size_t target_end = 0U;
+    size_t path_end = 0U;
+    size_t version_start;
+    size_t status = 0U;
+    int minor = 0;
+    int until_close = 0;
+    int complete = 1;
+    int keep_alive;
+    int chunks_status;
+    AivmNodeAttr attrs[11];
+
+    if (is_request) {
+        /* RFC 9112 section 2.2: ignore empty lines before the request line. */
+        while (start < parser->length && (data[start] == '\r' || data[start] == '\n')) {
+            start += 1U;
+        }
+    }
+    if (!http_find_header_end(parser, prev_length > start + 3U ? prev_length - 3U : start, &header_end)) {
+        return -1;
+    }
+    line_end = http_line_end(parser, start, header_end);
+    first_end = http_trim_cr(parser, start, line_end);
+    if (is_request) {
+        method_end = start;
+        while (method_end < first_end && http_is_tchar(data[method_end])) {
+            method_end += 1U;
+        }
+        target_start = method_end + 1U;
+        target_end = target_start;
+        while (target_end < first_end && data[target_end] > 0x20U && data[target_end] != 0x7FU) {
+            target_end += 1U;
+        }
+        version_start = target_end + 1U;
+        if (method_end == start || method_end >= first_end || data[method_end] != ' ' ||
+            target_end == target_start || target_end >= first_end || data[target_end] != ' ' ||
+            !http_parse_version(parser, version_start, first_end, &minor)) {
+            return http_fail(parser, "HTTP_REQUEST_LINE", "Request line is malformed.");
+        }
+        path_end = target_start;
+        while (path_end < target_end && data[path_end] != '?') {
+            path_end += 1U;
+        }
+    } else {
+        version_start = start;
+        if (first_end - start < 12U ||
+            !http_parse_version(parser, start, start + 8U, &minor) ||
+            data[start + 8U] != ' ' ||
+            data[start + 9U] < '0' || data[start + 9U] > '9' ||
+            data[start + 10U] < '0' || data[start + 10U] > '9' ||
+            data[start + 11U] < '0' || data[start + 11U] > '9' ||
+            (first_end - start > 12U && data[start + 12U] != ' ')) {
+            return http_fail(parser, "HTTP_STATUS_LINE", "Status line is malformed.");
+        }
+        status = (size_t)(data[start + 9U] - '0') * 100U +
+            (size_t)(data[start + 10U] - '0') * 10U +
+            (size_t)(data[start + 11U] - '0');
+    }
+
+    if (!http_parse_headers(parser, line_end + 1U, header_end)) {
         return 0;
     }
-    if (task->state == AIVM_TASK_STATE_FAILED || task->state == AIVM_TASK_STATE_CANCELED) {
-        if (task->result.type != AIVM_VAL_NODE) {
+    if (is_request && !http_parse_query(parser, path_end < target_end ? path_end + 1U : target_end, target_end)) {
+        return 0;
+    }
+    message_end = header_end;
+    if (parser->chunked) {
+        chunks_status = http_parse_chunks(parser, header_end, &message_end, &body_length);
+        if (chunks_status == 0) {
             return 0;
         }
-        if (!lookup_node(vm, task->result.node_handle, &node)) {
+        complete = chunks_status == 1;
+    } else {
+        if (!http_wrap(parser, "HttpChunks", "http_chunks", NULL, 0U, parser->vm->stack_count)) {
             return 0;
         }
-        return strcmp(node->kind, "Err") == 0;
+        if (!is_request && (status < 200U || status == 204U || status == 304U)) {
+            body_length = 0U;
+        } else if (parser->has_content_length) {
+            if (parser->content_length > parser->length - header_end) {
+                parser->needed = (int64_t)(parser->content_length - (parser->length - header_end));
+                complete = 0;
+            }
+            body_length = parser->content_length;
+        } else if (!is_request) {
+            until_close = 1;
+            body_length = parser->length - header_end;
+        }
+        message_end = header_end + body_length;
     }
-    return 1;
+
+    keep_alive = minor >= 1 ? !parser->connection_close : parser->connection_keep_alive;
+    if (is_request) {
+        attrs[0].key = "method";
+        attrs[0].kind = AIVM_NODE_ATTR_STRING;
+        attrs[0].string_value = http_stash_span(parser, &scratch_used, start, method_end);
+        attrs[1].key = "path";
+        attrs[1].kind = AIVM_NODE_ATTR_STRING;
+        attrs[1].string_value = http_stash_span(parser, &scratch_used, target_start, path_end);
+        attrs[2].key = "query";
+        attrs[2].kind = AIVM_NODE_ATTR_STRING;
+        attrs[2].string_value = http_stash_span(
+            parser,
+            &scratch_used,
+            path_end < target_end ? path_end + 1U : target_end,
+            target_end);
+    } else {
+        http_set_int_attr(&attrs[0], "statusCode", (int64_t)status);
+        attrs[1].key = "reason";
+        attrs[1].kind = AIVM_NODE_ATTR_STRING;
+        attrs[1].string_value = http_stash_span(
+            parser,
+            &scratch_used,
+            first_end - start > 12U ? start + 13U : first_end,
+            first_end);
+        http_set_bool_attr(&attrs[2], "untilClose", until_close);
+        keep_alive = keep_alive && !until_close;
+    }
+    attrs[3].key = "version";
+    attrs[3].kind = AIVM_NODE_ATTR_STRING;
+    attrs[3].string_value = http_stash_span(parser, &scratch_used, version_start, version_start + 8U);
+    http_set_int_attr(&attrs[4], "headerLength", (int64_t)header_end);
+    http_set_int_attr(&attrs[5], "bodyLength", (int64_t)body_length);
+    http_set_int_attr(&attrs[6], "messageLength", (int64_t)message_end);
+    http_set_bool_attr(&attrs[7], "chunked", parser->chunked);
+    http_set_bool_attr(&attrs[8], "keepAlive", keep_alive);
+    http_set_bool_attr(&attrs[9], "complete", complete);
+    http_set_int_attr(&attrs[10], "needed", complete ? 0 : parser->needed);
+    return is_request
+        ? http_wrap(parser, "HttpRequest", "http_request", attrs, 11U, base)
+        : http_wrap(parser, "HttpResponse", "http_response", attrs, 11U, base);
 }
 
-static int call_debug_task_reclaim_stats(AivmVm* vm, AivmValue* out_result)
+static int call_http_parse(AivmVm* vm, int is_request, AivmBytesView data, int64_t prev_length, AivmValue* out_result)
 {
-    AivmNodeAttr attrs[3];
+    AivmHttpParser parser;
+    size_t stack_base = vm->stack_count;
     int64_t handle;
-    char id_buffer[40];
-    size_t next_node_count = 0U;
-    size_t suffix_length;
-    if (vm == NULL || out_result == NULL) {
-        return 0;
+    int status;
+    memset(&parser, 0, sizeof(parser));
+    parser.vm = vm;
+    parser.data = data.data;
+    parser.length = data.data == NULL ? 0U : data.length;
+    parser.needed = -1;
+    if (parser.length == 0U) {
+        status = -1;
+    } else {
+        parser.scratch = (char*)malloc(parser.length + 8U);
+        parser.children = (int64_t*)malloc(sizeof(int64_t) * (AIVM_VM_HTTP_MAX_FIELDS + AIVM_VM_HTTP_MAX_CHUNKS));
+        if (parser.scratch == NULL || parser.children == NULL) {
+            free(parser.scratch);
+            free(parser.children);
+            set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "sys.http.parse could not allocate parser buffers.");
+            return 0;
+        }
+        status = http_parse_message(
+            &parser,
+            is_request,
+            prev_length > 0 && (uint64_t)prev_length < (uint64_t)parser.length ? (size_t)prev_length : 0U);
+        free(parser.scratch);
+        free(parser.children);
     }
-    memcpy(id_buffer, "debug_task_reclaim_stats_", 25U);
-    if (!size_add_checked(vm->node_count, 1U, &next_node_count)) {
-        set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "debug task stats node id overflow.");
+    if (status == 1) {
+        vm->stack_count -= 1U;
+        *out_result = vm->stack[vm->stack_count];
+        return 1;
+    }
+    if (vm->status == AIVM_VM_STATUS_ERROR) {
         return 0;
     }
-    suffix_length = write_u64_decimal(id_buffer + 25U, sizeof(id_buffer) - 25U, (uint64_t)next_node_count);
-    if (suffix_length == 0U) {
-        set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "debug task stats node id overflow.");
+    vm->stack_count = stack_base;
+    if (status == 0) {
+        return http_push_error(vm, parser.error_code, parser.error_message, out_result);
+    }
+    if (!create_node_record(vm, "HttpPartial", "http_partial", NULL, 0U, NULL, 0U, &handle)) {
         return 0;
     }
+    *out_result = aivm_value_node(handle);
+    return 1;
+}
 
-    attrs[0].key = "reclaimed";
-    attrs[0].kind = AIVM_NODE_ATTR_INT;
-    attrs[0].int_value = (int64_t)vm->task_reclaim_count;
-    attrs[1].key = "skipPinned";
-    attrs[1].kind = AIVM_NODE_ATTR_INT;
-    attrs[1].int_value = (int64_t)vm->task_reclaim_skip_pinned_count;
-    attrs[2].key = "exhausted";
-    attrs[2].kind = AIVM_NODE_ATTR_INT;
-    attrs[2].int_value = (int64_t)vm->task_reclaim_exhausted_count;
+static int http_text_is_header_safe(const char* text)
+{
+    for (; *text != '\0'; text += 1) {
+        if (*text == '\r' || *text == '\n') {
+            return 0;
+        }
+    }
+    return 1;
+}
 
-    if (!create_node_record(vm, "DebugTaskReclaimStats", id_buffer, attrs, 3U, NULL, 0U, &handle)) {
+/*
+ * Serializes an HTTP/1.1 response. Header fields come from a Map-shaped node
+ * (Field(key){Lit(value)}, values may be string, int or bool); Content-Length
+ * is added unless the caller supplied it or a Transfer-Encoding.
+ */
+static int call_http_build_response(
+    AivmVm* vm,
+    int64_t status,
+    const char* reason,
+    int64_t headers_handle,
+    AivmBytesView body,
+    AivmValue* out_result)
+{
+    AivmJsonWriter writer;
+    const AivmNodeRecord* headers;
+    char number[32];
+    int has_framing = 0;
+    uint8_t* output;
+    size_t i;
+    if (status < 100 || status > 999 || !http_text_is_header_safe(reason)) {
+        set_vm_error(vm, AIVM_VM_ERR_SYSCALL, "sys.http.buildResponse status line was invalid.");
         return 0;
     }
-    *out_result = aivm_value_node(handle);
+    if (!lookup_node(vm, headers_handle, &headers)) {
+        set_vm_error(vm, AIVM_VM_ERR_SYSCALL, "sys.http.buildResponse headers node was invalid.");
+        return 0;
+    }
+    memset(&writer, 0, sizeof(writer));
+    (void)snprintf(number, sizeof(number), "HTTP/1.1 %lld ", (long long)status);
+    json_write_text(&writer, number);
+    json_write_text(&writer, reason);
+    json_write(&writer, "\r\n", 2U);
+    for (i = 0U; i < headers->child_count; i += 1U) {
+        const AivmNodeRecord* field;
+        const AivmNodeRecord* value_node;
+        const AivmNodeAttr* key;
+        const AivmNodeAttr* value;
+        const char* key_text;
+        const char* value_text;
+        const char* cursor;
+        if (!lookup_node(vm, vm->node_children[headers->child_start + i], &field) ||
+            field->child_count == 0U ||
+            !lookup_node(vm, vm->node_children[field->child_start], &value_node)) {
+            continue;
+        }
+        key = json_find_attr(vm, field, "key");
+        value = json_find_attr(vm, value_node, "value");
+        key_text = json_attr_string(key);
+        if (key_text == NULL || value == NULL) {
+            continue;
+        }
+        if (value->kind == AIVM_NODE_ATTR_INT) {
+            (void)snprintf(number, sizeof(number), "%lld", (long long)value->int_value);
+            value_text = number;
+        } else if (value->kind == AIVM_NODE_ATTR_BOOL) {
+            value_text = value->bool_value ? "true" : "false";
+        } else {
+            value_text = value->string_value == NULL ? "" : value->string_value;
+        }
+        cursor = key_text;
+        while (*cursor != '\0' && http_is_tchar((uint8_t)*cursor)) {
+            cursor += 1;
+        }
+        if (*key_text == '\0' || *cursor != '\0' || !http_text_is_header_safe(value_text)) {
+            free(writer.data);
+            set_vm_error(vm, AIVM_VM_ERR_SYSCALL, "sys.http.buildResponse header field was invalid.");
+            return 0;
+        }
+        if (http_span_equals_ci((const uint8_t*)key_text, 0U, strlen(key_text), "content-length") ||
+            http_span_equals_ci((const uint8_t*)key_text, 0U, strlen(key_text), "transfer-encoding")) {
+            has_framing = 1;
+        }
+        json_write_text(&writer, key_text);
+        json_write(&writer, ": ", 2U);
+        json_write_text(&writer, value_text);
+        json_write(&writer, "\r\n", 2U);
+    }
+    if (!has_framing) {
+        (void)snprintf(number, sizeof(number), "Content-Length: %llu\r\n", (unsigned long long)body.length);
+        json_write_text(&writer, number);
+    }
+    json_write(&writer, "\r\n", 2U);
+    if (body.data != NULL) {
+        json_write(&writer, (const char*)body.data, body.length);
+    }
+    if (writer.failed) {
+        free(writer.data);
+        set_vm_error(vm, AIVM_VM_ERR_MEMORY_PRESSURE, "sys.http.buildResponse could not allocate its output.");
+        return 0;
+    }
+    output = copy_bytes_to_arena(vm, (const uint8_t*)writer.data, writer.length);
+    free(writer.data);
+    if (output == NULL) {
+        return 0;
+    }
+    *out_result = aivm_value_bytes(output, writer.length);
     return 1;
 }
 
@@ -2252,6 +4699,16 @@ static int mark_live_node_handles(
             ENQUEUE_HANDLE(vm->par_values[i].node_handle);
         }
     }
+    for (i = 0U; i < vm->suspended_stack_used; i += 1U) {
+        if (vm->suspended_stack[i].type == AIVM_VAL_NODE) {
+            ENQUEUE_HANDLE(vm->suspended_stack[i].node_handle);
+        }
+    }
+    for (i = 0U; i < vm->suspended_locals_used; i += 1U) {
+        if (vm->suspended_locals[i].type == AIVM_VAL_NODE) {
+            ENQUEUE_HANDLE(vm->suspended_locals[i].node_handle);
+        }
+    }
     if (extra_handles != NULL) {
         for (i = 0U; i < extra_handle_count; i += 1U) {
             int64_t handle = extra_handles[i];
@@ -2333,6 +4790,24 @@ static int compact_string_arena(AivmVm* vm)
             return 0;
         }
     }
+    for (i = 0U; i < vm->par_branch_count; i += 1U) {
+        size_t arg_i;
+        for (arg_i = 0U; arg_i < vm->par_branches[i].arg_count; arg_i += 1U) {
+            if (!compact_relocate_value_string(vm, &vm->par_branches[i].args[arg_i], new_arena, &new_used)) {
+                return 0;
+            }
+        }
+    }
+    for (i = 0U; i < vm->suspended_stack_used; i += 1U) {
+        if (!compact_relocate_value_string(vm, &vm->suspended_stack[i], new_arena, &new_used)) {
+            return 0;
+        }
+    }
+    for (i = 0U; i < vm->suspended_locals_used; i += 1U) {
+        if (!compact_relocate_value_string(vm, &vm->suspended_locals[i], new_arena, &new_used)) {
+            return 0;
+        }
+    }
     for (i = 0U; i < vm->node_count; i += 1U) {
         size_t attr_i;
         AivmNodeRecord* node;
@@ -2533,6 +5008,18 @@ static int compact_node_arenas_with_map(
             return 0;
         }
     }
+    for (i = 0U; i < vm->suspended_stack_used; i += 1U) {
+        if (!remap_value_node_handle(&vm->suspended_stack[i], handle_map)) {
+            set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Invalid suspended-task node handle during node GC.");
+            return 0;
+        }
+    }
+    for (i = 0U; i < vm->suspended_locals_used; i += 1U) {
+        if (!remap_value_node_handle(&vm->suspended_locals[i], handle_map)) {
+            set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "Invalid suspended-task node handle during node GC.");
+            return 0;
+        }
+    }
     if (vm->process_argv_node_handle > 0) {
         if (vm->process_argv_node_handle > (int64_t)AIVM_VM_NODE_CAPACITY ||
             handle_map[vm->process_argv_node_handle] <= 0) {
@@ -2936,12 +5423,9 @@ static int initialize_process_argv_node(AivmVm* vm)
     return 1;
 }
 
-void aivm_reset_state(AivmVm* vm)
+/* Clears execution state that owns no arena or node storage. */
+static void reset_execution_state(AivmVm* vm)
 {
-    if (vm == NULL) {
-        return;
-    }
-
     vm->instruction_pointer = 0U;
     vm->status = AIVM_VM_STATUS_READY;
     vm->error = AIVM_VM_ERR_NONE;
@@ -2955,12 +5439,8 @@ void aivm_reset_state(AivmVm* vm)
     vm->recent_opcode_count = 0U;
     vm->locals_count = 0U;
     vm->locals_limit = AIVM_VM_LOCALS_INITIAL_CAPACITY;
-    vm->string_arena_used = 0U;
     vm->string_arena_limit = AIVM_VM_STRING_ARENA_INITIAL_CAPACITY;
-    vm->string_arena[0] = '\0';
-    vm->bytes_arena_used = 0U;
     vm->bytes_arena_limit = AIVM_VM_BYTES_ARENA_INITIAL_CAPACITY;
-    vm->bytes_arena[0] = 0U;
     vm->completed_task_count = 0U;
     vm->next_task_handle = 1;
     vm->task_reclaim_count = 0U;
@@ -2968,7 +5448,29 @@ void aivm_reset_state(AivmVm* vm)
     vm->task_reclaim_exhausted_count = 0U;
     vm->par_context_count = 0U;
     vm->par_value_count = 0U;
+    vm->par_branch_count = 0U;
+    vm->par_purity_count = 0U;
+    vm->running_task_count = 0U;
+    vm->task_sync_depth = 0U;
+    vm->task_suspend_requested = 0;
+    vm->suspended_task_count = 0U;
+    vm->suspended_stack_used = 0U;
+    vm->suspended_frames_used = 0U;
+    vm->suspended_locals_used = 0U;
     vm->next_par_node_id = 1;
+}
+
+void aivm_reset_state(AivmVm* vm)
+{
+    if (vm == NULL) {
+        return;
+    }
+
+    reset_execution_state(vm);
+    vm->string_arena_used = 0U;
+    vm->string_arena[0] = '\0';
+    vm->bytes_arena_used = 0U;
+    vm->bytes_arena[0] = 0U;
     vm->node_count = 0U;
     vm->node_attr_count = 0U;
     vm->node_child_count = 0U;
@@ -2991,6 +5493,31 @@ void aivm_reset_state(AivmVm* vm)
     vm->ui_empty_event_node_handle = 0;
     (void)initialize_process_argv_node(vm);
     vm->node_allocations_since_gc = 0U;
+    vm->reset_mark.string_arena_used = vm->string_arena_used;
+    vm->reset_mark.bytes_arena_used = vm->bytes_arena_used;
+    vm->reset_mark.node_count = vm->node_count;
+    vm->reset_mark.node_attr_count = vm->node_attr_count;
+    vm->reset_mark.node_child_count = vm->node_child_count;
+    vm->reset_mark.node_gc_compaction_count = vm->node_gc_compaction_count;
+}
+
+/* Returns a VM to the state aivm_reset_state left it in by moving back only the counters
+ * that advanced since. Compaction may have moved the reset nodes, so it forces a full reset. */
+static void rewind_to_reset_mark(AivmVm* vm)
+{
+    if (vm->node_gc_compaction_count != vm->reset_mark.node_gc_compaction_count) {
+        aivm_reset_state(vm);
+        return;
+    }
+    reset_execution_state(vm);
+    vm->string_arena_used = vm->reset_mark.string_arena_used;
+    vm->bytes_arena_used = vm->reset_mark.bytes_arena_used;
+    vm->node_count = vm->reset_mark.node_count;
+    vm->node_attr_count = vm->reset_mark.node_attr_count;
+    vm->node_child_count = vm->reset_mark.node_child_count;
+    vm->node_allocations_since_gc = 0U;
+    vm->ui_default_window_size_node_handle = 0;
+    vm->ui_empty_event_node_handle = 0;
 }
 
 void aivm_init(AivmVm* vm, const AivmProgram* program)
@@ -3004,6 +5531,10 @@ void aivm_init(AivmVm* vm, const AivmProgram* program)
     vm->syscall_binding_count = 0U;
     vm->process_argv = NULL;
     vm->process_argv_count = 0U;
+    vm->par_executor = NULL;
+    vm->par_executor_context = NULL;
+    vm->task_wait_hook = NULL;
+    vm->task_wait_context = NULL;
     aivm_reset_state(vm);
 }
 
@@ -3033,9 +5564,125 @@ void aivm_init_with_syscalls_and_argv(
     vm->syscall_binding_count = binding_count;
     vm->process_argv = process_argv;
     vm->process_argv_count = process_argv_count;
+    vm->par_executor = NULL;
+    vm->par_executor_context = NULL;
+    vm->task_wait_hook = NULL;
+    vm->task_wait_context = NULL;
     aivm_reset_state(vm);
 }
 
+void aivm_set_par_executor(AivmVm* vm, AivmParExecutor executor, void* context)
+{
+    if (vm == NULL) {
+        return;
+    }
+    vm->par_executor = executor;
+    vm->par_executor_context = context;
+}
+
+void aivm_set_task_wait_hook(AivmVm* vm, AivmTaskWaitHook hook, void* context)
+{
+    if (vm == NULL) {
+        return;
+    }
+    vm->task_wait_hook = hook;
+    vm->task_wait_context = context;
+}
+
+int aivm_task_can_suspend(const AivmVm* vm)
+{
+    const AivmRunningTask* task;
+    if (vm == NULL || vm->running_task_count == 0U) {
+        return 0;
+    }
+    task = &vm->running_tasks[vm->running_task_count - 1U];
+    return task->sync_depth == vm->task_sync_depth &&
+           task->par_context_base == vm->par_context_count &&
+           vm->call_frame_count > task->frame_base &&
+           task_segment_fits(vm, task, 0U);
+}
+
+int aivm_par_branch_execute(const AivmProgram* program, AivmParBranch* branch, AivmVm* scratch_vm)
+{
+    AivmValue value;
+    size_t i;
+    if (program == NULL || branch == NULL || scratch_vm == NULL) {
+        return 0;
+    }
+    branch->status = AIVM_PAR_BRANCH_FALLBACK;
+    branch->result = aivm_value_void();
+    branch->result_text = NULL;
+    branch->result_bytes = NULL;
+    branch->result_tree = NULL;
+    scratch_vm->program = program;
+    rewind_to_reset_mark(scratch_vm);
+    for (i = 0U; i < branch->arg_count; i += 1U) {
+        if (!aivm_stack_push(scratch_vm, branch->args[i])) {
+            return 0;
+        }
+    }
+    if (!aivm_frame_push(scratch_vm, program->instruction_count, 0U)) {
+        return 0;
+    }
+    scratch_vm->instruction_pointer = branch->target;
+    while (scratch_vm->instruction_pointer < program->instruction_count &&
+           scratch_vm->status != AIVM_VM_STATUS_ERROR &&
+           scratch_vm->status != AIVM_VM_STATUS_HALTED) {
+        aivm_step(scratch_vm);
+    }
+    /* Returning through the sentinel frame lands on instruction_count, which halts the
+     * scratch VM; only an error or a frame left behind means the branch did not finish. */
+    if (scratch_vm->status == AIVM_VM_STATUS_ERROR || scratch_vm->call_frame_count != 0U) {
+        return 0;
+    }
+    value = (scratch_vm->stack_count > 0U) ? scratch_vm->stack[scratch_vm->stack_count - 1U] : aivm_value_void();
+    if (value.type == AIVM_VAL_STRING && value.string_value != NULL) {
+        size_t length = strlen(value.string_value);
+        branch->result_text = (char*)malloc(length + 1U);
+        if (branch->result_text == NULL) {
+            return 0;
+        }
+        memcpy(branch->result_text, value.string_value, length + 1U);
+    } else if (value.type == AIVM_VAL_BYTES) {
+        size_t length = value.bytes_value.length;
+        branch->result_bytes = (uint8_t*)malloc(length + 1U);
+        if (branch->result_bytes == NULL || (length > 0U && value.bytes_value.data == NULL)) {
+            free(branch->result_bytes);
+            branch->result_bytes = NULL;
+            return 0;
+        }
+        if (length > 0U) {
+            memcpy(branch->result_bytes, value.bytes_value.data, length);
+        }
+        branch->result = aivm_value_bytes(branch->result_bytes, length);
+    } else if (value.type == AIVM_VAL_NODE) {
+        branch->result_tree = par_node_tree_capture(scratch_vm, value.node_handle);
+        if (branch->result_tree == NULL) {
+            return 0;
+        }
+    } else if (value.type == AIVM_VAL_INT || value.type == AIVM_VAL_BOOL ||
+               value.type == AIVM_VAL_NULL || value.type == AIVM_VAL_VOID) {
+        branch->result = value;
+    } else {
+        return 0;
+    }
+    branch->status = AIVM_PAR_BRANCH_DONE;
+    return 1;
+}
+
+void aivm_par_branch_release(AivmParBranch* branch)
+{
+    if (branch == NULL) {
+        return;
+    }
+    free(branch->result_text);
+    branch->result_text = NULL;
+    free(branch->result_bytes);
+    branch->result_bytes = NULL;
+    par_node_tree_free(branch->result_tree);
+    branch->result_tree = NULL;
+}
+
 void aivm_halt(AivmVm* vm)
 {
     if (vm == NULL || vm->program == NULL) {
@@ -3161,6 +5808,25 @@ int aivm_local_set(AivmVm* vm, size_t index, AivmValue value)
     return 1;
 }
 
+int aivm_node_create(
+    AivmVm* vm,
+    const char* kind,
+    const char* id,
+    const AivmNodeAttr* attrs,
+    size_t attr_count,
+    const int64_t* children,
+    size_t child_count,
+    int64_t* out_handle)
+{
+    if (attr_count > 0U && attrs == NULL) {
+        return 0;
+    }
+    if (child_count > 0U && children == NULL) {
+        return 0;
+    }
+    return create_node_record(vm, kind, id, attrs, attr_count, children, child_count, out_handle);
+}
+
 int aivm_local_get(const AivmVm* vm, size_t index, AivmValue* out_value)
 {
     size_t base = 0U;
@@ -3215,6 +5881,25 @@ static size_t infer_call_arg_count(const AivmProgram* program, size_t target)
     return count;
 }
 
+/* A CALL directly followed by RETURN/RET, with only its arguments above the current frame
+   base, is a tail call: the callee takes over the current frame. Its RETURN then restores
+   exactly what the caller's RETURN would have, so only the frame depth differs. */
+static int call_is_tail_position(const AivmVm* vm, size_t arg_count)
+{
+    AivmOpcode next_opcode;
+    size_t next_ip;
+    if (vm->call_frame_count == 0U ||
+        !size_add_checked(vm->instruction_pointer, 1U, &next_ip) ||
+        next_ip >= vm->program->instruction_count) {
+        return 0;
+    }
+    next_opcode = vm->program->instructions[next_ip].opcode;
+    if (next_opcode != AIVM_OP_RETURN && next_opcode != AIVM_OP_RET) {
+        return 0;
+    }
+    return vm->stack_count - arg_count == vm->call_frames[vm->call_frame_count - 1U].frame_base;
+}
+
 static int validate_call_target_layout(
     AivmVm* vm,
     const AivmProgram* program,
@@ -3310,7 +5995,9 @@ void aivm_step(AivmVm* vm)
     }
 
     if (vm->instruction_pointer >= vm->program->instruction_count) {
-        vm->status = AIVM_VM_STATUS_HALTED;
+        if (drain_suspended_tasks(vm)) {
+            vm->status = AIVM_VM_STATUS_HALTED;
+        }
         return;
     }
 
@@ -3325,7 +6012,7 @@ void aivm_step(AivmVm* vm)
             break;
 
         case AIVM_OP_HALT:
-            aivm_halt(vm);
+            halt_after_suspended_tasks(vm);
             break;
 
         case AIVM_OP_STUB:
@@ -3490,6 +6177,11 @@ void aivm_step(AivmVm* vm)
                 break;
             }
             record_recent_call(vm, vm->instruction_pointer, target, arg_count, vm->stack_count);
+            if (call_is_tail_position(vm, arg_count)) {
+                vm->locals_count = vm->call_frames[vm->call_frame_count - 1U].locals_base;
+                vm->instruction_pointer = target;
+                break;
+            }
             frame_base = vm->stack_count - arg_count;
             if (!size_add_checked(vm->instruction_pointer, 1U, &return_ip) ||
                 !aivm_frame_push(vm, return_ip, frame_base)) {
@@ -3507,7 +6199,7 @@ void aivm_step(AivmVm* vm)
             int has_return_value = 0;
             size_t pre_restore_stack_count = 0U;
             if (vm->call_frame_count == 0U) {
-                aivm_halt(vm);
+                halt_after_suspended_tasks(vm);
                 break;
             }
             if (!aivm_frame_pop(vm, &frame)) {
@@ -3909,12 +6601,18 @@ void aivm_step(AivmVm* vm)
         case AIVM_OP_CALL_SYS: {
             size_t arg_count;
             AivmValue result;
+            size_t stack_count_before = vm->stack_count;
+            int pending = 0;
 
-            if (!operand_to_index(vm, instruction->operand_int, &arg_count)) {
+            if (!operand_to_index(vm, instruction->operand_int, &arg_count) ||
+                !settle_par_branches(vm)) {
                 vm->instruction_pointer = vm->program->instruction_count;
                 break;
             }
-            if (!call_sys_with_arity(vm, arg_count, &result)) {
+            if (!call_sys_with_arity(vm, arg_count, &result, &pending)) {
+                if (pending && !handle_pending_syscall(vm, stack_count_before)) {
+                    vm->instruction_pointer = vm->program->instruction_count;
+                }
                 break;
             }
             if (!aivm_stack_push(vm, result)) {
@@ -3927,16 +6625,21 @@ void aivm_step(AivmVm* vm)
 
         case AIVM_OP_ASYNC_CALL: {
             size_t target;
-            AivmValue result;
+            int deferred;
             if (!operand_to_index(vm, instruction->operand_int, &target)) {
                 vm->instruction_pointer = vm->program->instruction_count;
                 break;
             }
-            if (!execute_call_subroutine_sync(vm, target, &result)) {
-                vm->instruction_pointer = vm->program->instruction_count;
+            deferred = try_defer_par_branch(vm, target);
+            if (deferred != 0) {
+                if (deferred < 0) {
+                    vm->instruction_pointer = vm->program->instruction_count;
+                    break;
+                }
+                vm->instruction_pointer += 1U;
                 break;
             }
-            if (!push_completed_task(vm, result)) {
+            if (!start_async_task(vm, target)) {
                 vm->instruction_pointer = vm->program->instruction_count;
                 break;
             }
@@ -3946,11 +6649,17 @@ void aivm_step(AivmVm* vm)
         case AIVM_OP_ASYNC_CALL_SYS: {
             size_t arg_count;
             AivmValue result;
-            if (!operand_to_index(vm, instruction->operand_int, &arg_count)) {
+            size_t stack_count_before = vm->stack_count;
+            int pending = 0;
+            if (!operand_to_index(vm, instruction->operand_int, &arg_count) ||
+                !settle_par_branches(vm)) {
                 vm->instruction_pointer = vm->program->instruction_count;
                 break;
             }
-            if (!call_sys_with_arity(vm, arg_count, &result)) {
+            if (!call_sys_with_arity(vm, arg_count, &result, &pending)) {
+                if (pending && !handle_pending_syscall(vm, stack_count_before)) {
+                    vm->instruction_pointer = vm->program->instruction_count;
+                }
                 break;
             }
             if (!push_completed_task(vm, result)) {
@@ -3973,6 +6682,26 @@ void aivm_step(AivmVm* vm)
                 vm->instruction_pointer = vm->program->instruction_count;
                 break;
             }
+            if (is_par_branch_handle(vm, handle_value.int_value) && !resolve_par_branches(vm, 0U)) {
+                vm->instruction_pointer = vm->program->instruction_count;
+                break;
+            }
+            if (is_suspended_task_handle(vm, handle_value.int_value)) {
+                /* Park an awaiting coroutine (AWAIT re-runs on resume); otherwise drive parked tasks here. */
+                if (!aivm_stack_push(vm, handle_value)) {
+                    vm->instruction_pointer = vm->program->instruction_count;
+                    break;
+                }
+                if (aivm_task_can_suspend(vm)) {
+                    vm->task_suspend_requested = 1;
+                    break;
+                }
+                vm->stack_count -= 1U;
+                if (!drive_suspended_task(vm, handle_value.int_value)) {
+                    vm->instruction_pointer = vm->program->instruction_count;
+                    break;
+                }
+            }
             if (!find_terminal_task_result(vm, handle_value.int_value, &completed)) {
                 if (vm->status != AIVM_VM_STATUS_ERROR) {
                     set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "AWAIT requires valid task handle.");
@@ -4003,6 +6732,7 @@ void aivm_step(AivmVm* vm)
             }
             vm->par_contexts[vm->par_context_count].expected_count = expected_count;
             vm->par_contexts[vm->par_context_count].start_index = vm->par_value_count;
+            vm->par_contexts[vm->par_context_count].branch_start = vm->par_branch_count;
             vm->par_context_count = needed_context_count;
             vm->instruction_pointer += 1U;
             break;
@@ -4035,7 +6765,7 @@ void aivm_step(AivmVm* vm)
         case AIVM_OP_PAR_JOIN: {
             AivmParContext context;
             size_t join_count;
-            int64_t child_handles[AIVM_VM_NODE_CHILD_CAPACITY];
+            int64_t child_handles[AIVM_VM_PAR_VALUE_CAPACITY];
             char id_buffer[32];
             size_t id_length;
             size_t i;
@@ -4057,11 +6787,25 @@ void aivm_step(AivmVm* vm)
                 vm->instruction_pointer = vm->program->instruction_count;
                 break;
             }
-            if (join_count > AIVM_VM_NODE_CHILD_CAPACITY) {
+            if (join_count > AIVM_VM_NODE_CHILD_CAPACITY || join_count > AIVM_VM_PAR_VALUE_CAPACITY) {
                 set_vm_error(vm, AIVM_VM_ERR_INVALID_PROGRAM, "PAR_JOIN exceeded child capacity.");
                 vm->instruction_pointer = vm->program->instruction_count;
                 break;
             }
+            if (!resolve_par_branches(vm, context.branch_start)) {
+                vm->instruction_pointer = vm->program->instruction_count;
+                break;
+            }
+            for (i = 0U; i < join_count && vm->status != AIVM_VM_STATUS_ERROR; i += 1U) {
+                AivmValue value = vm->par_values[context.start_index + i];
+                if (value.type == AIVM_VAL_INT && is_suspended_task_handle(vm, value.int_value)) {
+                    (void)drive_suspended_task(vm, value.int_value);
+                }
+            }
+            if (vm->status == AIVM_VM_STATUS_ERROR) {
+                vm->instruction_pointer = vm->program->instruction_count;
+                break;
+            }
             for (i = 0U; i < join_count; i += 1U) {
                 size_t par_index = 0U;
                 AivmValue value;
@@ -4738,8 +7482,12 @@ void aivm_step(AivmVm* vm)
             break;
     }
 
+    /* A coroutine returning to a resume point at the program end is not a halt. */
     if (vm->status == AIVM_VM_STATUS_RUNNING &&
-        vm->instruction_pointer >= vm->program->instruction_count) {
+        vm->instruction_pointer >= vm->program->instruction_count &&
+        vm->running_task_count == 0U &&
+        drain_suspended_tasks(vm) &&
+        vm->status == AIVM_VM_STATUS_RUNNING) {
         vm->status = AIVM_VM_STATUS_HALTED;
     }
 }
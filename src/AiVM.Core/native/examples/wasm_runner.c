@@ -20,7 +20,11 @@ static char g_wasm_syscall_error_message_buf[256];
 static AivmVm* g_wasm_active_vm = NULL;
 enum {
     WASM_BYTES_SCRATCH_CAPACITY = 1 << 20,
-    WASM_STRING_SCRATCH_CAPACITY = (1 << 21)
+    WASM_STRING_SCRATCH_CAPACITY = (1 << 21),
+    /* Contract ids scanned for bindings; the table holds one binding per id plus the
+       handlers ensured by target name. */
+    WASM_SYSCALL_ID_LIMIT = 256,
+    WASM_SYSCALL_BINDING_CAPACITY = WASM_SYSCALL_ID_LIMIT + 8
 };
 static uint8_t g_wasm_bytes_scratch[WASM_BYTES_SCRATCH_CAPACITY];
 static char g_wasm_string_scratch[WASM_STRING_SCRATCH_CAPACITY];
@@ -1936,50 +1940,21 @@ static int native_syscall_remote_call(
     return remote_session_invoke_call(cap, op, args[2].int_value, result);
 }
 
-int main(int argc, char** argv)
+/* Fills `bindings` (WASM_SYSCALL_BINDING_CAPACITY entries) with one binding per syscall
+   contract; targets the wasm host does not provide fail as unavailable at call time.
+   Returns NULL on success or the error message. */
+static const char* build_wasm_syscall_bindings(AivmSyscallBinding* bindings, size_t* out_binding_count)
 {
-    unsigned char* bytes = NULL;
-    size_t byte_count = 0U;
-    AivmProgram program;
-    AivmProgramLoadResult load_result;
-    AivmSyscallBinding bindings[128];
     size_t binding_count = 0U;
     uint32_t syscall_id;
-    static AivmVm vm;
-    const char* const* app_argv = NULL;
-    size_t app_argc = 0U;
-
-    if (argc < 2 || argv == NULL) {
-        fprintf(stderr, "Usage: aivm-runtime-wasm32 <app.aibc1|- for stdin> [args...]\n");
-        return 2;
-    }
-
-    if (argc > 2) {
-        app_argv = (const char* const*)&argv[2];
-        app_argc = (size_t)(argc - 2);
-    }
 
-    if ((strcmp(argv[1], "-") == 0 && !read_binary_stdin(&bytes, &byte_count)) ||
-        (strcmp(argv[1], "-") != 0 && !read_binary_file(argv[1], &bytes, &byte_count))) {
-        fprintf(stderr, "Err#err1(code=RUN001 message=\"Failed to read AiBC1 file.\" nodeId=program)\n");
-        return 2;
-    }
-
-    load_result = aivm_program_load_aibc1(bytes, byte_count, &program);
-    free(bytes);
-    if (load_result.status != AIVM_PROGRAM_OK) {
-        fprintf(stderr, "Err#err1(code=RUN001 message=\"Failed to load AiBC1 program.\" nodeId=program)\n");
-        return 2;
-    }
-
-    for (syscall_id = 0U; syscall_id <= 255U; syscall_id += 1U) {
+    for (syscall_id = 0U; syscall_id < WASM_SYSCALL_ID_LIMIT; syscall_id += 1U) {
         const AivmSyscallContract* contract = aivm_syscall_contract_find_by_id(syscall_id);
         if (contract == NULL) {
             continue;
         }
-        if (binding_count >= (sizeof(bindings) / sizeof(bindings[0]))) {
-            fprintf(stderr, "Err#err1(code=RUN001 message=\"Wasm syscall binding overflow.\" nodeId=syscall)\n");
-            return 2;
+        if (binding_count >= WASM_SYSCALL_BINDING_CAPACITY) {
+            return "Wasm syscall binding overflow.";
         }
         bindings[binding_count].target = contract->target;
         bindings[binding_count].handler = native_syscall_unavailable;
@@ -2036,15 +2011,59 @@ int main(int argc, char** argv)
         }
         binding_count += 1U;
     }
-    if (!ensure_binding_handler(bindings, &binding_count, sizeof(bindings) / sizeof(bindings[0]), "sys.bytes.fromUtf8String", native_syscall_bytes_from_utf8_string) ||
-        !ensure_binding_handler(bindings, &binding_count, sizeof(bindings) / sizeof(bindings[0]), "sys.bytes.toUtf8String", native_syscall_bytes_to_utf8_string) ||
-        !ensure_binding_handler(bindings, &binding_count, sizeof(bindings) / sizeof(bindings[0]), "sys.bytes.toBase64", native_syscall_bytes_to_base64) ||
-        !ensure_binding_handler(bindings, &binding_count, sizeof(bindings) / sizeof(bindings[0]), "sys.bytes.fromBase64", native_syscall_bytes_from_base64)) {
-        fprintf(stderr, "Err#err1(code=RUN001 message=\"Wasm bytes syscall binding missing.\" nodeId=syscall)\n");
+    *out_binding_count = binding_count;
+    if (!ensure_binding_handler(bindings, out_binding_count, WASM_SYSCALL_BINDING_CAPACITY, "sys.bytes.fromUtf8String", native_syscall_bytes_from_utf8_string) ||
+        !ensure_binding_handler(bindings, out_binding_count, WASM_SYSCALL_BINDING_CAPACITY, "sys.bytes.toUtf8String", native_syscall_bytes_to_utf8_string) ||
+        !ensure_binding_handler(bindings, out_binding_count, WASM_SYSCALL_BINDING_CAPACITY, "sys.bytes.toBase64", native_syscall_bytes_to_base64) ||
+        !ensure_binding_handler(bindings, out_binding_count, WASM_SYSCALL_BINDING_CAPACITY, "sys.bytes.fromBase64", native_syscall_bytes_from_base64)) {
+        return "Wasm bytes syscall binding missing.";
+    }
+    if (!ensure_binding_handler(bindings, out_binding_count, WASM_SYSCALL_BINDING_CAPACITY, "sys.image.decodeToRgbaBase64", native_syscall_unavailable) ||
+        !ensure_binding_handler(bindings, out_binding_count, WASM_SYSCALL_BINDING_CAPACITY, "sys.image.decodeToRgba", native_syscall_unavailable)) {
+        return "Wasm image decode binding missing.";
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned char* bytes = NULL;
+    size_t byte_count = 0U;
+    AivmProgram program;
+    AivmProgramLoadResult load_result;
+    static AivmSyscallBinding bindings[WASM_SYSCALL_BINDING_CAPACITY];
+    size_t binding_count = 0U;
+    const char* binding_error;
+    static AivmVm vm;
+    const char* const* app_argv = NULL;
+    size_t app_argc = 0U;
+
+    if (argc < 2 || argv == NULL) {
+        fprintf(stderr, "Usage: aivm-runtime-wasm32 <app.aibc1|- for stdin> [args...]\n");
         return 2;
     }
-    if (!ensure_binding_handler(bindings, &binding_count, sizeof(bindings) / sizeof(bindings[0]), "sys.image.decodeToRgbaBase64", native_syscall_unavailable)) {
-        fprintf(stderr, "Err#err1(code=RUN001 message=\"Wasm image decode binding missing.\" nodeId=syscall)\n");
+
+    if (argc > 2) {
+        app_argv = (const char* const*)&argv[2];
+        app_argc = (size_t)(argc - 2);
+    }
+
+    if ((strcmp(argv[1], "-") == 0 && !read_binary_stdin(&bytes, &byte_count)) ||
+        (strcmp(argv[1], "-") != 0 && !read_binary_file(argv[1], &bytes, &byte_count))) {
+        fprintf(stderr, "Err#err1(code=RUN001 message=\"Failed to read AiBC1 file.\" nodeId=program)\n");
+        return 2;
+    }
+
+    load_result = aivm_program_load_aibc1(bytes, byte_count, &program);
+    free(bytes);
+    if (load_result.status != AIVM_PROGRAM_OK) {
+        fprintf(stderr, "Err#err1(code=RUN001 message=\"Failed to load AiBC1 program.\" nodeId=program)\n");
+        return 2;
+    }
+
+    binding_error = build_wasm_syscall_bindings(bindings, &binding_count);
+    if (binding_error != NULL) {
+        fprintf(stderr, "Err#err1(code=RUN001 message=\"%s\" nodeId=syscall)\n", binding_error);
         return 2;
     }
 
@@ -72,14 +72,22 @@ typedef struct {
 
 enum {
     AIVM_PROGRAM_MAX_SECTIONS = 32,
-    AIVM_PROGRAM_MAX_INSTRUCTIONS = 16384,
-    AIVM_PROGRAM_MAX_CONSTANTS = 1024,
-    AIVM_PROGRAM_MAX_STRING_BYTES = 8192,
-    AIVM_PROGRAM_MAX_BYTES_STORAGE = 32768,
     AIVM_PROGRAM_SECTION_INSTRUCTIONS = 1,
-    AIVM_PROGRAM_SECTION_CONSTANTS = 2
+    AIVM_PROGRAM_SECTION_CONSTANTS = 2,
+    AIVM_PROGRAM_SECTION_INSTRUCTIONS_ALIGNED = 3,
+    AIVM_PROGRAM_SECTION_CONSTANTS_ALIGNED = 4,
+    AIVM_PROGRAM_SECTION_FUNCTION_NAMES = 5,
+    AIVM_PROGRAM_FUNCTION_NAME_MAX = 64,
+    AIVM_PROGRAM_ALIGNED_RECORD_SIZE = 16,
+    AIVM_PROGRAM_ALIGNED_RECORD_ALIGNMENT = 8
 };
 
+/* Debug name for the function whose code starts at `entry_ip`. */
+typedef struct {
+    size_t entry_ip;
+    char name[AIVM_PROGRAM_FUNCTION_NAME_MAX];
+} AivmFunctionName;
+
 typedef struct {
     const AivmInstruction* instructions;
     size_t instruction_count;
@@ -89,12 +97,21 @@ typedef struct {
     uint32_t format_flags;
     uint32_t section_count;
     AivmProgramSection sections[AIVM_PROGRAM_MAX_SECTIONS];
-    AivmInstruction instruction_storage[AIVM_PROGRAM_MAX_INSTRUCTIONS];
-    AivmValue constant_storage[AIVM_PROGRAM_MAX_CONSTANTS];
-    char string_storage[AIVM_PROGRAM_MAX_STRING_BYTES];
+    /* Heap storage owned by the program; released by aivm_program_free. */
+    AivmInstruction* instruction_storage;
+    size_t instruction_capacity;
+    AivmValue* constant_storage;
+    size_t constant_capacity;
+    char* string_storage;
     size_t string_storage_used;
-    uint8_t bytes_storage[AIVM_PROGRAM_MAX_BYTES_STORAGE];
+    size_t string_storage_capacity;
+    uint8_t* bytes_storage;
     size_t bytes_storage_used;
+    size_t bytes_storage_capacity;
+    /* Optional function names sorted by entry_ip; owned, never needed for execution. */
+    AivmFunctionName* function_names;
+    size_t function_name_count;
+    size_t function_name_capacity;
 } AivmProgram;
 
 typedef enum {
@@ -118,9 +135,31 @@ typedef struct {
     size_t error_offset;
 } AivmProgramLoadResult;
 
+/* Initializes an empty program that owns no storage. Safe on uninitialized memory, so it
+   never releases anything: reset a program that owns storage with aivm_program_free. */
 void aivm_program_clear(AivmProgram* program);
 void aivm_program_init(AivmProgram* program, const AivmInstruction* instructions, size_t instruction_count);
+/* Releases owned storage and leaves an empty program that can be loaded or built again. */
+void aivm_program_free(AivmProgram* program);
+/* Grow owned storage to hold at least the given totals. String and bytes constants that
+   point into storage are rebased when it moves. Return 0 when allocation fails. */
+int aivm_program_reserve_instructions(AivmProgram* program, size_t instruction_count);
+int aivm_program_reserve_constants(AivmProgram* program, size_t constant_count);
+int aivm_program_reserve_string_bytes(AivmProgram* program, size_t string_bytes);
+int aivm_program_reserve_bytes_storage(AivmProgram* program, size_t byte_count);
+/* Records (or renames) the function starting at `entry_ip`; longer names are truncated.
+   Returns 0 when allocation fails. */
+int aivm_program_add_function_name(AivmProgram* program, size_t entry_ip, const char* name);
+/* Finds the function_names entry for the function containing `ip`; 0 when none covers it. */
+int aivm_program_function_index_at(const AivmProgram* program, size_t ip, size_t* out_index);
+/* Loads into `out_program` as fresh output: it is initialized first, so storage from an earlier
+   load is not released; call aivm_program_free before reusing a program. On failure the program
+   owns no storage, but the header fields read so far are kept for diagnostics. */
 AivmProgramLoadResult aivm_program_load_aibc1(const uint8_t* bytes, size_t byte_count, AivmProgram* out_program);
+/* Like aivm_program_load_aibc1, but aligned sections are used in place: instructions and
+   string/bytes constants point into `bytes`, which must outlive the program. */
+AivmProgramLoadResult aivm_program_load_aibc1_borrowed(const uint8_t* bytes, size_t byte_count, AivmProgram* out_program);
+int aivm_program_host_layout_matches_aligned(void);
 const char* aivm_program_status_code(AivmProgramStatus status);
 const char* aivm_program_status_message(AivmProgramStatus status);
 
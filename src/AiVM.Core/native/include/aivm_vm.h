@@ -98,8 +98,34 @@ typedef struct {
 typedef struct {
     size_t expected_count;
     size_t start_index;
+    size_t branch_start;
 } AivmParContext;
 
+/* An ASYNC_CALL coroutine whose frames currently sit on top of the VM stack. */
+typedef struct {
+    int64_t task_handle;
+    size_t stack_base;
+    size_t frame_base;
+    size_t locals_base;
+    size_t par_context_base;
+    size_t sync_depth;
+    size_t return_instruction_pointer;
+} AivmRunningTask;
+
+/* A parked coroutine; its stack, frames, and locals are saved base-relative. */
+typedef struct {
+    int64_t task_handle;
+    size_t instruction_pointer;
+    size_t stack_start;
+    size_t stack_count;
+    size_t frame_start;
+    size_t frame_count;
+    size_t locals_start;
+    size_t locals_count;
+} AivmSuspendedTask;
+
+typedef void (*AivmTaskWaitHook)(void* context);
+
 enum {
     AIVM_VM_STACK_CAPACITY = 4096,
     AIVM_VM_STACK_INITIAL_CAPACITY = 1024,
@@ -120,9 +146,20 @@ enum {
     AIVM_VM_NODE_CAPACITY = 512,
     AIVM_VM_NODE_ATTR_CAPACITY = 2048,
     AIVM_VM_NODE_CHILD_CAPACITY = 4096,
+    AIVM_VM_JSON_MAX_DEPTH = 512,
+    AIVM_VM_HTTP_MAX_FIELDS = 64,
+    AIVM_VM_HTTP_MAX_CHUNKS = 64,
     AIVM_VM_TASK_CAPACITY = 256,
     AIVM_VM_PAR_CONTEXT_CAPACITY = 64,
     AIVM_VM_PAR_VALUE_CAPACITY = 1024,
+    AIVM_VM_PAR_BRANCH_CAPACITY = 64,
+    AIVM_VM_PAR_BRANCH_MAX_ARGS = 8,
+    AIVM_VM_PAR_PURITY_CACHE_CAPACITY = 64,
+    AIVM_VM_RUNNING_TASK_CAPACITY = 64,
+    AIVM_VM_SUSPENDED_TASK_CAPACITY = 64,
+    AIVM_VM_SUSPENDED_STACK_CAPACITY = 4096,
+    AIVM_VM_SUSPENDED_FRAME_CAPACITY = 1024,
+    AIVM_VM_SUSPENDED_LOCALS_CAPACITY = 4096,
     AIVM_VM_NODE_GC_INTERVAL_ALLOCATIONS = 64,
     AIVM_VM_NODE_GC_PRESSURE_THRESHOLD_NUMERATOR = 3,
     AIVM_VM_NODE_GC_PRESSURE_THRESHOLD_DENOMINATOR = 4,
@@ -137,6 +174,57 @@ enum {
         AIVM_VM_NODE_GC_PRESSURE_THRESHOLD_DENOMINATOR
 };
 
+typedef enum {
+    AIVM_PAR_BRANCH_PENDING = 0,
+    AIVM_PAR_BRANCH_DONE = 1,
+    AIVM_PAR_BRANCH_FALLBACK = 2
+} AivmParBranchStatus;
+
+/* A branch's node result copied out of its scratch VM; rebuilt on the owner VM. */
+typedef struct AivmParNodeTree AivmParNodeTree;
+
+/*
+ * A pure ASYNC_CALL deferred inside a Par scope. Branches are handed to the
+ * host executor at PAR_JOIN (or AWAIT); each one may run on any thread via
+ * aivm_par_branch_execute. String, bytes, and node results are copied out of the
+ * scratch VM (result_text, result_bytes, result_tree) and rebuilt in the owner
+ * VM's arenas when it completes the branch. FALLBACK branches are re-run on the
+ * owner VM.
+ */
+typedef struct {
+    size_t target;
+    int64_t task_handle;
+    AivmValue args[AIVM_VM_PAR_BRANCH_MAX_ARGS];
+    size_t arg_count;
+    AivmParBranchStatus status;
+    AivmValue result;
+    char* result_text;
+    uint8_t* result_bytes;
+    AivmParNodeTree* result_tree;
+} AivmParBranch;
+
+/* Memoized purity verdict for one ASYNC_CALL target of the VM's program. */
+typedef struct {
+    size_t target;
+    int pure;
+} AivmParPurity;
+
+/* Arena and node counters as aivm_reset_state leaves them; a reused Par scratch VM rewinds here. */
+typedef struct {
+    size_t string_arena_used;
+    size_t bytes_arena_used;
+    size_t node_count;
+    size_t node_attr_count;
+    size_t node_child_count;
+    size_t node_gc_compaction_count;
+} AivmVmResetMark;
+
+typedef void (*AivmParExecutor)(
+    void* context,
+    const AivmProgram* program,
+    AivmParBranch* branches,
+    size_t branch_count);
+
 typedef struct {
     const AivmProgram* program;
     size_t instruction_pointer;
@@ -184,6 +272,26 @@ typedef struct {
     AivmValue par_values[AIVM_VM_PAR_VALUE_CAPACITY];
     size_t par_value_count;
     int64_t next_par_node_id;
+    AivmParExecutor par_executor;
+    void* par_executor_context;
+    AivmParBranch par_branches[AIVM_VM_PAR_BRANCH_CAPACITY];
+    size_t par_branch_count;
+    AivmParPurity par_purity[AIVM_VM_PAR_PURITY_CACHE_CAPACITY];
+    size_t par_purity_count;
+    AivmRunningTask running_tasks[AIVM_VM_RUNNING_TASK_CAPACITY];
+    size_t running_task_count;
+    size_t task_sync_depth;
+    int task_suspend_requested;
+    AivmSuspendedTask suspended_tasks[AIVM_VM_SUSPENDED_TASK_CAPACITY];
+    size_t suspended_task_count;
+    AivmValue suspended_stack[AIVM_VM_SUSPENDED_STACK_CAPACITY];
+    size_t suspended_stack_used;
+    AivmCallFrame suspended_frames[AIVM_VM_SUSPENDED_FRAME_CAPACITY];
+    size_t suspended_frames_used;
+    AivmValue suspended_locals[AIVM_VM_SUSPENDED_LOCALS_CAPACITY];
+    size_t suspended_locals_used;
+    AivmTaskWaitHook task_wait_hook;
+    void* task_wait_context;
     AivmNodeRecord nodes[AIVM_VM_NODE_CAPACITY];
     size_t node_count;
     AivmNodeAttr node_attrs[AIVM_VM_NODE_ATTR_CAPACITY];
@@ -206,6 +314,7 @@ typedef struct {
     size_t string_arena_pressure_count;
     size_t bytes_arena_pressure_count;
     size_t node_arena_pressure_count;
+    AivmVmResetMark reset_mark;
 } AivmVm;
 
 void aivm_init(AivmVm* vm, const AivmProgram* program);
@@ -222,6 +331,13 @@ void aivm_init_with_syscalls_and_argv(
     const char* const* process_argv,
     size_t process_argv_count);
 void aivm_reset_state(AivmVm* vm);
+void aivm_set_par_executor(AivmVm* vm, AivmParExecutor executor, void* context);
+/* scratch_vm must have been through aivm_init once; each call rebinds it to program and
+ * rewinds only what the previous branch used, so one scratch VM serves a whole thread. */
+int aivm_par_branch_execute(const AivmProgram* program, AivmParBranch* branch, AivmVm* scratch_vm);
+void aivm_par_branch_release(AivmParBranch* branch);
+void aivm_set_task_wait_hook(AivmVm* vm, AivmTaskWaitHook hook, void* context);
+int aivm_task_can_suspend(const AivmVm* vm);
 void aivm_halt(AivmVm* vm);
 int aivm_stack_push(AivmVm* vm, AivmValue value);
 int aivm_stack_pop(AivmVm* vm, AivmValue* out_value);
@@ -229,6 +345,20 @@ int aivm_frame_push(AivmVm* vm, size_t return_instruction_pointer, size_t frame_
 int aivm_frame_pop(AivmVm* vm, AivmCallFrame* out_frame);
 int aivm_local_set(AivmVm* vm, size_t index, AivmValue value);
 int aivm_local_get(const AivmVm* vm, size_t index, AivmValue* out_value);
+/*
+ * Host-side node construction. kind, id, and string attrs are copied into the
+ * VM arenas. Children built earlier must stay reachable (e.g. pushed on the VM
+ * stack) until their parent exists, because allocation may compact nodes.
+ */
+int aivm_node_create(
+    AivmVm* vm,
+    const char* kind,
+    const char* id,
+    const AivmNodeAttr* attrs,
+    size_t attr_count,
+    const int64_t* children,
+    size_t child_count,
+    int64_t* out_handle);
 void aivm_step(AivmVm* vm);
 void aivm_run(AivmVm* vm);
 const char* aivm_vm_error_code(AivmVmError error);
@@ -6,7 +6,13 @@
 #include "sys/aivm_syscall_contracts.h"
 #include "aivm_types.h"
 
+/*
+ * AIVM_SYSCALL_PENDING means the operation has not finished and the handler
+ * consumed nothing: the VM re-issues the same call later. Handlers may only
+ * return it when aivm_task_can_suspend() holds for the calling VM.
+ */
 typedef enum {
+    AIVM_SYSCALL_PENDING = 1,
     AIVM_SYSCALL_OK = 0,
     AIVM_SYSCALL_ERR_INVALID = -1,
     AIVM_SYSCALL_ERR_NULL_RESULT = -2,
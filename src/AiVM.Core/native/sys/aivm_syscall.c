@@ -134,6 +134,8 @@ const char* aivm_syscall_status_code(AivmSyscallStatus status)
             return "AIVMS004";
         case AIVM_SYSCALL_ERR_RETURN_TYPE:
             return "AIVMS005";
+        case AIVM_SYSCALL_PENDING:
+            return "AIVMS006";
         default:
             return "AIVMS999";
     }
@@ -154,6 +156,8 @@ const char* aivm_syscall_status_message(AivmSyscallStatus status)
             return "Syscall arguments violated contract.";
         case AIVM_SYSCALL_ERR_RETURN_TYPE:
             return "Syscall return type violated contract.";
+        case AIVM_SYSCALL_PENDING:
+            return "Syscall is pending.";
         default:
             return "Unknown syscall dispatch status.";
     }
@@ -20,6 +20,36 @@ mkdir -p "${TMP_DIR}"
 CASE_PATH="${ROOT_DIR}/src/AiVM.Core/native/tests/parity_cases/vm_c_execute_src_main_params.aos"
 "${AIRUN_BIN}" run "${CASE_PATH}" --vm=c >/dev/null
 
+# --profile writes folded stacks plus exact counters labelled with source function names,
+# including through an optimized, written-out app.aibc1.
+PROFILE_DIR="${TMP_DIR}/profile"
+mkdir -p "${PROFILE_DIR}"
+cat > "${PROFILE_DIR}/main.aos" <<'AOS'
+Program#prof_p1 {
+  Export#prof_e1(name=start)
+  Let#prof_l1(name=twice) {
+    Fn#prof_f1(params=x) {
+      Block#prof_b1 { Return#prof_r1 { Add#prof_a1 { Var#prof_v1(name=x) Var#prof_v2(name=x) } } }
+    }
+  }
+  Let#prof_l2(name=start) {
+    Fn#prof_f2(params=argv) {
+      Block#prof_b2 { Return#prof_r2 { Call#prof_c1(target=twice) { Lit#prof_i1(value=21) } } }
+    }
+  }
+}
+AOS
+"${AIRUN_BIN}" build "${PROFILE_DIR}/main.aos" --out "${PROFILE_DIR}/out" -O >/dev/null
+"${AIRUN_BIN}" run "${PROFILE_DIR}/out/app.aibc1" --profile="${PROFILE_DIR}/run.folded" --profile-hz=100000 >/dev/null || true
+if [[ ! -f "${PROFILE_DIR}/run.folded" ]] ||
+  ! grep -q $'^function\ttwice\t1\t' "${PROFILE_DIR}/run.folded.summary.tsv" ||
+  ! grep -q $'^opcode\tCALL\t2\t' "${PROFILE_DIR}/run.folded.summary.tsv" ||
+  ! grep -q $'^syscall\tsys.process.args\t1\t' "${PROFILE_DIR}/run.folded.summary.tsv"; then
+  echo "airun smoke: --profile output missing or unlabelled" >&2
+  cat "${PROFILE_DIR}/run.folded.summary.tsv" >&2 || true
+  exit 1
+fi
+
 PUBLISH_DIR="${TMP_DIR}/publish-main-params"
 PUBLISH_ERR="${TMP_DIR}/publish-main-params.err"
 if ! "${AIRUN_BIN}" publish "${CASE_PATH}" --out "${PUBLISH_DIR}" >/dev/null 2>"${PUBLISH_ERR}"; then
@@ -0,0 +1,72 @@
+param(
+  [Parameter(Mandatory = $true)]
+  [string]$RepoRoot,
+  [Parameter(Mandatory = $true)]
+  [string]$ParityCli
+)
+
+$ErrorActionPreference = 'Stop'
+
+$airun = Join-Path $RepoRoot 'tools/airun.exe'
+if (-not (Test-Path $airun)) {
+  Write-Host "skip: missing $airun"
+  exit 0
+}
+if (-not (Test-Path $ParityCli)) {
+  throw "missing parity cli: $ParityCli"
+}
+
+$cases = Join-Path $RepoRoot 'src/AiVM.Core/native/tests/parity_cases'
+$tmp = Join-Path $RepoRoot '.tmp/ctest-optimizer-parity-win'
+if (Test-Path $tmp) { Remove-Item -Recurse -Force $tmp }
+New-Item -ItemType Directory -Force -Path $tmp | Out-Null
+
+$emptyInput = Join-Path $tmp 'empty.in'
+New-Item -ItemType File -Force -Path $emptyInput | Out-Null
+$checked = 0
+
+# Every parity case must build the same way with and without -O and, when it builds,
+# run with identical output and exit code.
+function Run-Case {
+  param([string]$Source)
+
+  $name = [System.IO.Path]::GetFileNameWithoutExtension($Source)
+  $caseDir = Join-Path $tmp $name
+  New-Item -ItemType Directory -Force -Path $caseDir | Out-Null
+
+  & $airun build $Source --no-cache --out (Join-Path $caseDir 'plain') 1>(Join-Path $caseDir 'plain.build') 2>&1
+  $plainExit = $LASTEXITCODE
+  & $airun build $Source --no-cache -O --out (Join-Path $caseDir 'opt') 1>(Join-Path $caseDir 'opt.build') 2>&1
+  $optExit = $LASTEXITCODE
+  if ($plainExit -ne $optExit) {
+    throw "optimizer parity mismatch ($name): build exit $optExit expected $plainExit"
+  }
+  if ($plainExit -ne 0) {
+    return
+  }
+
+  $plainOut = Join-Path $caseDir 'plain.out'
+  $optOut = Join-Path $caseDir 'opt.out'
+  Get-Content $emptyInput | & $airun run (Join-Path $caseDir 'plain/app.aibc1') --vm=c 1>$plainOut 2>&1
+  $plainExit = $LASTEXITCODE
+  Get-Content $emptyInput | & $airun run (Join-Path $caseDir 'opt/app.aibc1') --vm=c 1>$optOut 2>&1
+  $optExit = $LASTEXITCODE
+  if ($plainExit -ne $optExit) {
+    throw "optimizer parity mismatch ($name): exit $optExit expected $plainExit"
+  }
+  & $ParityCli $optOut $plainOut | Out-Null
+  if ($LASTEXITCODE -ne 0) {
+    throw "optimizer parity mismatch ($name): output differs"
+  }
+  $script:checked += 1
+}
+
+Get-ChildItem -Path $cases -Filter '*.aos' | Sort-Object Name | ForEach-Object {
+  Run-Case $_.FullName
+}
+
+if ($checked -eq 0) {
+  throw 'optimizer parity: no parity case built'
+}
+
+Write-Host "optimizer parity: PASS ($checked cases)"
@@ -0,0 +1,84 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ROOT_DIR="${1:-}"
+PARITY_CLI_BIN="${2:-}"
+
+if [[ -z "${ROOT_DIR}" || -z "${PARITY_CLI_BIN}" ]]; then
+  echo "usage: ctest_optimizer_parity.sh <repo-root> <aivm_parity_cli>" >&2
+  exit 2
+fi
+if [[ ! -x "${PARITY_CLI_BIN}" ]]; then
+  echo "missing parity cli: ${PARITY_CLI_BIN}" >&2
+  exit 2
+fi
+
+AIRUN_BIN="${ROOT_DIR}/tools/airun"
+if [[ ! -x "${AIRUN_BIN}" ]]; then
+  echo "skip: missing ${AIRUN_BIN}"
+  exit 0
+fi
+
+CASES_DIR="${ROOT_DIR}/src/AiVM.Core/native/tests/parity_cases"
+TMP_DIR="${ROOT_DIR}/.tmp/ctest-optimizer-parity"
+rm -rf "${TMP_DIR}"
+mkdir -p "${TMP_DIR}"
+
+checked=0
+
+# Every parity case must build the same way with and without -O and, when it builds,
+# run with identical output and exit code.
+run_case() {
+  local source="$1"
+  local name
+  local case_dir
+  local plain_exit=0
+  local opt_exit=0
+  name="$(basename "${source}" .aos)"
+  case_dir="${TMP_DIR}/${name}"
+  mkdir -p "${case_dir}"
+
+  set +e
+  "${AIRUN_BIN}" build "${source}" --no-cache --out "${case_dir}/plain" > "${case_dir}/plain.build" 2>&1
+  plain_exit=$?
+  "${AIRUN_BIN}" build "${source}" --no-cache -O --out "${case_dir}/opt" > "${case_dir}/opt.build" 2>&1
+  opt_exit=$?
+  set -e
+  if [[ "${plain_exit}" != "${opt_exit}" ]]; then
+    echo "optimizer parity mismatch (${name}): build exit ${opt_exit} expected ${plain_exit}" >&2
+    cat "${case_dir}/opt.build" >&2
+    exit 1
+  fi
+  if [[ "${plain_exit}" != "0" ]]; then
+    return
+  fi
+
+  set +e
+  "${AIRUN_BIN}" run "${case_dir}/plain/app.aibc1" --vm=c < /dev/null > "${case_dir}/plain.out" 2>&1
+  plain_exit=$?
+  "${AIRUN_BIN}" run "${case_dir}/opt/app.aibc1" --vm=c < /dev/null > "${case_dir}/opt.out" 2>&1
+  opt_exit=$?
+  set -e
+  if [[ "${plain_exit}" != "${opt_exit}" ]]; then
+    echo "optimizer parity mismatch (${name}): exit ${opt_exit} expected ${plain_exit}" >&2
+    cat "${case_dir}/opt.out" >&2
+    exit 1
+  fi
+  if ! "${PARITY_CLI_BIN}" "${case_dir}/opt.out" "${case_dir}/plain.out" >/dev/null 2>&1; then
+    echo "optimizer parity mismatch (${name}): output differs" >&2
+    diff "${case_dir}/plain.out" "${case_dir}/opt.out" >&2 || true
+    exit 1
+  fi
+  checked=$((checked + 1))
+}
+
+for source in "${CASES_DIR}"/*.aos; do
+  run_case "${source}"
+done
+
+if [[ "${checked}" == "0" ]]; then
+  echo "optimizer parity: no parity case built" >&2
+  exit 1
+fi
+
+echo "optimizer parity: PASS (${checked} cases)"
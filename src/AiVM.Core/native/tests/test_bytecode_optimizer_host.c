@@ -0,0 +1,153 @@
+#define AIRUN_ALLOW_INTERNAL_UI_FALLBACK 1
+#define main airun_embedded_main_for_test
+#include "../../../AiCLI/native/airun.c"
+#undef main
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAIL line %d\n", __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static int load_program(
+    AivmProgram* program,
+    const AivmInstruction* instructions,
+    size_t instruction_count,
+    const char* const* strings,
+    size_t string_count)
+{
+    size_t i;
+    int64_t index;
+    aivm_program_clear(program);
+    if (!aivm_program_reserve_instructions(program, instruction_count)) {
+        return 0;
+    }
+    memcpy(program->instruction_storage, instructions, instruction_count * sizeof(AivmInstruction));
+    program->instructions = program->instruction_storage;
+    program->instruction_count = instruction_count;
+    program->constants = program->constant_storage;
+    for (i = 0U; i < string_count; i += 1U) {
+        if (!bytecode_add_string_const(program, strings[i], &index)) {
+            return 0;
+        }
+        program->constants = program->constant_storage;
+    }
+    return 1;
+}
+
+static int run_exit_code(const AivmProgram* program)
+{
+    AivmCResult result = aivm_c_execute_instructions_with_constants(
+        program->instructions,
+        program->instruction_count,
+        program->constants,
+        program->constant_count);
+    return result.ok && result.has_exit_code ? result.exit_code : -1;
+}
+
+static int has_op(const AivmProgram* program, AivmOpcode opcode)
+{
+    size_t i;
+    for (i = 0U; i < program->instruction_count; i += 1U) {
+        if (program->instructions[i].opcode == opcode) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const AivmInstruction k_folds[] = {
+        { AIVM_OP_PUSH_INT, 2 },
+        { AIVM_OP_PUSH_INT, 3 },
+        { AIVM_OP_ADD_INT, 0 },
+        { AIVM_OP_CALL, 12 },
+        { AIVM_OP_JUMP, 6 },
+        { AIVM_OP_PUSH_INT, 99 },
+        { AIVM_OP_JUMP, 8 },
+        { AIVM_OP_CONST, 2 },
+        { AIVM_OP_HALT, 0 },
+        { AIVM_OP_PUSH_INT, 1 },
+        { AIVM_OP_POP, 0 },
+        { AIVM_OP_NOP, 0 },
+        { AIVM_OP_STORE_LOCAL, 0 },
+        { AIVM_OP_CONST, 0 },
+        { AIVM_OP_CONST, 1 },
+        { AIVM_OP_STR_CONCAT, 0 },
+        { AIVM_OP_POP, 0 },
+        { AIVM_OP_LOAD_LOCAL, 0 },
+        { AIVM_OP_PUSH_BOOL, 1 },
+        { AIVM_OP_JUMP_IF_FALSE, 22 },
+        { AIVM_OP_STORE_LOCAL, 1 },
+        { AIVM_OP_LOAD_LOCAL, 1 },
+        { AIVM_OP_RETURN, 0 },
+        { AIVM_OP_PUSH_INT, 0 },
+        { AIVM_OP_RETURN, 0 }
+    };
+    static const char* const k_fold_strings[] = {
+        "a", "b", "unused", NATIVE_WORKER_ENTRY_PREFIX "work@23/0"
+    };
+    static const AivmInstruction k_folded[] = {
+        { AIVM_OP_PUSH_INT, 5 },
+        { AIVM_OP_CALL, 3 },
+        { AIVM_OP_HALT, 0 },
+        { AIVM_OP_STORE_LOCAL, 0 },
+        { AIVM_OP_CONST, 1 },
+        { AIVM_OP_POP, 0 },
+        { AIVM_OP_LOAD_LOCAL, 0 },
+        { AIVM_OP_RETURN, 0 },
+        { AIVM_OP_PUSH_INT, 0 },
+        { AIVM_OP_RETURN, 0 }
+    };
+    static const AivmInstruction k_live_store[] = {
+        { AIVM_OP_PUSH_INT, 4 },
+        { AIVM_OP_STORE_LOCAL, 0 },
+        { AIVM_OP_LOAD_LOCAL, 0 },
+        { AIVM_OP_LOAD_LOCAL, 0 },
+        { AIVM_OP_ADD_INT, 0 },
+        { AIVM_OP_HALT, 0 }
+    };
+    static const AivmInstruction k_invalid[] = {
+        { AIVM_OP_PUSH_INT, 1 },
+        { AIVM_OP_PUSH_INT, 2 },
+        { AIVM_OP_ADD_INT, 0 },
+        { AIVM_OP_JUMP, 9 }
+    };
+    AivmProgram program;
+    BytecodeOptimizeStats stats;
+    size_t i;
+
+    /* Folds, threads jumps to HALT, drops dead code, and keeps the call prologue in place. */
+    CHECK(load_program(&program, k_folds, sizeof(k_folds) / sizeof(k_folds[0]), k_fold_strings, 4U));
+    CHECK(run_exit_code(&program) == 5);
+    CHECK(bytecode_optimize_program(&program, &stats));
+    CHECK(stats.instructions_before == 25U && stats.instructions_after == 10U);
+    CHECK(program.instruction_count == sizeof(k_folded) / sizeof(k_folded[0]));
+    for (i = 0U; i < program.instruction_count; i += 1U) {
+        CHECK(program.instructions[i].opcode == k_folded[i].opcode);
+        CHECK(program.instructions[i].operand_int == k_folded[i].operand_int);
+    }
+    /* Unused constants are pruned in order and the worker entry follows its function. */
+    CHECK(program.constant_count == 2U);
+    CHECK(strcmp(program.constants[0].string_value, NATIVE_WORKER_ENTRY_PREFIX "work@8/0") == 0);
+    CHECK(strcmp(program.constants[1].string_value, "ab") == 0);
+    CHECK(run_exit_code(&program) == 5);
+    aivm_program_free(&program);
+
+    /* A STORE_LOCAL/LOAD_LOCAL pair stays when the slot is read again. */
+    CHECK(load_program(&program, k_live_store, sizeof(k_live_store) / sizeof(k_live_store[0]), NULL, 0U));
+    CHECK(bytecode_optimize_program(&program, &stats));
+    CHECK(program.instruction_count == 6U);
+    CHECK(run_exit_code(&program) == 8);
+    aivm_program_free(&program);
+
+    /* Out-of-range operands leave the program untouched. */
+    CHECK(load_program(&program, k_invalid, sizeof(k_invalid) / sizeof(k_invalid[0]), NULL, 0U));
+    CHECK(bytecode_optimize_program(&program, &stats));
+    CHECK(program.instruction_count == 4U && has_op(&program, AIVM_OP_ADD_INT));
+    aivm_program_free(&program);
+    return 0;
+}
@@ -11,6 +11,152 @@
         } \
     } while (0)
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+static int near_channel(uint8_t actual, int expected)
+{
+    int delta = (int)actual - expected;
+    return delta >= -12 && delta <= 12;
+}
+
+static int test_image_codec(void)
+{
+    static const uint8_t png_filters[118] = {
+        0x89U, 0x50U, 0x4EU, 0x47U, 0x0DU, 0x0AU, 0x1AU, 0x0AU, 0x00U, 0x00U, 0x00U, 0x0DU,
+        0x49U, 0x48U, 0x44U, 0x52U, 0x00U, 0x00U, 0x00U, 0x03U, 0x00U, 0x00U, 0x00U, 0x05U,
+        0x08U, 0x02U, 0x00U, 0x00U, 0x00U, 0x0FU, 0x13U, 0xC1U, 0xF5U, 0x00U, 0x00U, 0x00U,
+        0x3DU, 0x49U, 0x44U, 0x41U, 0x54U, 0x78U, 0xDAU, 0x01U, 0x32U, 0x00U, 0xCDU, 0xFFU,
+        0x00U, 0x07U, 0x18U, 0x29U, 0x3AU, 0x4BU, 0x5CU, 0x6DU, 0x7EU, 0x8FU, 0x01U, 0x2FU,
+        0x40U, 0x51U, 0x62U, 0x73U, 0x84U, 0x95U, 0xA6U, 0xB7U, 0x02U, 0x57U, 0x68U, 0x79U,
+        0x8AU, 0x9BU, 0xACU, 0xBDU, 0xCEU, 0xDFU, 0x03U, 0x7FU, 0x90U, 0xA1U, 0xB2U, 0xC3U,
+        0xD4U, 0xE5U, 0xF6U, 0x07U, 0x04U, 0xA7U, 0xB8U, 0xC9U, 0xDAU, 0xEBU, 0xFCU, 0x0DU,
+        0x1EU, 0x2FU, 0xF8U, 0xA4U, 0x17U, 0x4AU, 0xF3U, 0xC3U, 0xDAU, 0x6BU, 0x00U, 0x00U,
+        0x00U, 0x00U, 0x49U, 0x45U, 0x4EU, 0x44U, 0xAEU, 0x42U, 0x60U, 0x82U
+    };
+    static const uint8_t png_filters_rgba[60] = {
+        0x07U, 0x18U, 0x29U, 0xFFU, 0x3AU, 0x4BU, 0x5CU, 0xFFU, 0x6DU, 0x7EU, 0x8FU, 0xFFU,
+        0x2FU, 0x40U, 0x51U, 0xFFU, 0x91U, 0xB3U, 0xD5U, 0xFFU, 0x26U, 0x59U, 0x8CU, 0xFFU,
+        0x86U, 0xA8U, 0xCAU, 0xFFU, 0x1BU, 0x4EU, 0x81U, 0xFFU, 0xE3U, 0x27U, 0x6BU, 0xFFU,
+        0xC2U, 0xE4U, 0x06U, 0xFFU, 0x20U, 0x5CU, 0x17U, 0xFFU, 0x66U, 0x37U, 0x48U, 0xFFU,
+        0x69U, 0x9CU, 0xCFU, 0xFFU, 0xFAU, 0x47U, 0xCBU, 0xFFU, 0x07U, 0x55U, 0xFAU, 0xFFU
+    };
+    static const uint8_t png_interlaced[114] = {
+        0x89U, 0x50U, 0x4EU, 0x47U, 0x0DU, 0x0AU, 0x1AU, 0x0AU, 0x00U, 0x00U, 0x00U, 0x0DU,
+        0x49U, 0x48U, 0x44U, 0x52U, 0x00U, 0x00U, 0x00U, 0x03U, 0x00U, 0x00U, 0x00U, 0x03U,
+        0x02U, 0x03U, 0x00U, 0x00U, 0x01U, 0x5CU, 0x41U, 0x6DU, 0xBAU, 0x00U, 0x00U, 0x00U,
+        0x0CU, 0x50U, 0x4CU, 0x54U, 0x45U, 0xFFU, 0x00U, 0x00U, 0x00U, 0xFFU, 0x00U, 0x00U,
+        0x00U, 0xFFU, 0x0AU, 0x14U, 0x1EU, 0x22U, 0x88U, 0x29U, 0x04U, 0x00U, 0x00U, 0x00U,
+        0x03U, 0x74U, 0x52U, 0x4EU, 0x53U, 0x80U, 0xFFU, 0x00U, 0x88U, 0x67U, 0x22U, 0x2CU,
+        0x00U, 0x00U, 0x00U, 0x12U, 0x49U, 0x44U, 0x41U, 0x54U, 0x78U, 0xDAU, 0x63U, 0x60U,
+        0x60U, 0x70U, 0x60U, 0xD8U, 0x00U, 0xC4U, 0x0DU, 0x0CU, 0x47U, 0x00U, 0x0AU, 0xA0U,
+        0x02U, 0x75U, 0x27U, 0x38U, 0xADU, 0x8CU, 0x00U, 0x00U, 0x00U, 0x00U, 0x49U, 0x45U,
+        0x4EU, 0x44U, 0xAEU, 0x42U, 0x60U, 0x82U
+    };
+    static const uint8_t png_interlaced_rgba[36] = {
+        0xFFU, 0x00U, 0x00U, 0x80U, 0x00U, 0xFFU, 0x00U, 0xFFU, 0x00U, 0xFFU, 0x00U, 0xFFU,
+        0x0AU, 0x14U, 0x1EU, 0xFFU, 0xFFU, 0x00U, 0x00U, 0x80U, 0x00U, 0xFFU, 0x00U, 0xFFU,
+        0x00U, 0x00U, 0xFFU, 0x00U, 0x00U, 0x00U, 0xFFU, 0x00U, 0x0AU, 0x14U, 0x1EU, 0xFFU
+    };
+    static const uint8_t jpeg_quadrants[328] = {
+        0xFFU, 0xD8U, 0xFFU, 0xDBU, 0x00U, 0x43U, 0x00U, 0x03U, 0x02U, 0x02U, 0x03U, 0x02U,
+        0x02U, 0x03U, 0x03U, 0x03U, 0x03U, 0x04U, 0x03U, 0x03U, 0x04U, 0x05U, 0x08U, 0x05U,
+        0x05U, 0x04U, 0x04U, 0x05U, 0x0AU, 0x07U, 0x07U, 0x06U, 0x08U, 0x0CU, 0x0AU, 0x0CU,
+        0x0CU, 0x0BU, 0x0AU, 0x0BU, 0x0BU, 0x0DU, 0x0EU, 0x12U, 0x10U, 0x0DU, 0x0EU, 0x11U,
+        0x0EU, 0x0BU, 0x0BU, 0x10U, 0x16U, 0x10U, 0x11U, 0x13U, 0x14U, 0x15U, 0x15U, 0x15U,
+        0x0CU, 0x0FU, 0x17U, 0x18U, 0x16U, 0x14U, 0x18U, 0x12U, 0x14U, 0x15U, 0x14U, 0xFFU,
+        0xDBU, 0x00U, 0x43U, 0x01U, 0x03U, 0x04U, 0x04U, 0x05U, 0x04U, 0x05U, 0x09U, 0x05U,
+        0x05U, 0x09U, 0x14U, 0x0DU, 0x0BU, 0x0DU, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U,
+        0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U,
+        0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U,
+        0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U,
+        0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0x14U, 0xFFU, 0xC0U, 0x00U, 0x11U,
+        0x08U, 0x00U, 0x10U, 0x00U, 0x10U, 0x03U, 0x01U, 0x22U, 0x00U, 0x02U, 0x11U, 0x01U,
+        0x03U, 0x11U, 0x01U, 0xFFU, 0xC4U, 0x00U, 0x16U, 0x00U, 0x01U, 0x01U, 0x01U, 0x00U,
+        0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U,
+        0x08U, 0x07U, 0x09U, 0xFFU, 0xC4U, 0x00U, 0x14U, 0x10U, 0x01U, 0x00U, 0x00U, 0x00U,
+        0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U,
+        0x00U, 0xFFU, 0xC4U, 0x00U, 0x14U, 0x01U, 0x01U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U,
+        0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0xFFU,
+        0xC4U, 0x00U, 0x26U, 0x11U, 0x00U, 0x02U, 0x01U, 0x00U, 0x07U, 0x09U, 0x00U, 0x00U,
+        0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x11U, 0x12U, 0x14U, 0x00U,
+        0x01U, 0x02U, 0x04U, 0x07U, 0x41U, 0x61U, 0x06U, 0x15U, 0x17U, 0x21U, 0x22U, 0x24U,
+        0x43U, 0x51U, 0x62U, 0xFFU, 0xDDU, 0x00U, 0x04U, 0x00U, 0x01U, 0xFFU, 0xDAU, 0x00U,
+        0x0CU, 0x03U, 0x01U, 0x00U, 0x02U, 0x11U, 0x03U, 0x11U, 0x00U, 0x3FU, 0x00U, 0x81U,
+        0x10U, 0x41U, 0x3BU, 0x7FU, 0x8DU, 0xB3U, 0xC3U, 0x2DU, 0xCFU, 0x1FU, 0xBCU, 0x77U,
+        0x6FU, 0x18U, 0x01U, 0x7EU, 0xEBU, 0xF7U, 0x46U, 0x20U, 0x5FU, 0x78U, 0x8DU, 0x17U,
+        0xA6U, 0x3CU, 0x77U, 0xCDU, 0xD9U, 0xD3U, 0x4BU, 0x00U, 0x26U, 0xA4U, 0xE4U, 0x39U,
+        0xFFU, 0x00U, 0xFFU, 0xD9U
+    };
+    static const int quadrant_colors[4][3] = {
+        { 200, 30, 30 }, { 30, 200, 30 }, { 30, 30, 200 }, { 240, 240, 240 }
+    };
+    uint8_t progressive[sizeof(jpeg_quadrants)];
+    uint8_t png_empty_idat[sizeof(png_filters) + 12U];
+    uint8_t* rgba = NULL;
+    int width = 0;
+    int height = 0;
+    int quadrant;
+    size_t i;
+
+    /* One row per PNG filter type. */
+    CHECK(native_image_codec_decode_rgba(png_filters, sizeof(png_filters), &rgba, &width, &height) == 1);
+    CHECK(width == 3 && height == 5);
+    CHECK(memcmp(rgba, png_filters_rgba, sizeof(png_filters_rgba)) == 0);
+    free(rgba);
+
+    /* A zero-length IDAT ahead of the data chunk is legal and contributes nothing. */
+    memcpy(png_empty_idat, png_filters, 33U);
+    memset(png_empty_idat + 33U, 0, 12U);
+    memcpy(png_empty_idat + 37U, "IDAT", 4U);
+    memcpy(png_empty_idat + 45U, png_filters + 33U, sizeof(png_filters) - 33U);
+    CHECK(native_image_codec_decode_rgba(png_empty_idat, sizeof(png_empty_idat), &rgba, &width, &height) == 1);
+    CHECK(memcmp(rgba, png_filters_rgba, sizeof(png_filters_rgba)) == 0);
+    free(rgba);
+
+    /* Adam7, 2-bit palette, tRNS alpha. */
+    CHECK(native_image_codec_decode_rgba(png_interlaced, sizeof(png_interlaced), &rgba, &width, &height) == 1);
+    CHECK(width == 3 && height == 3);
+    CHECK(memcmp(rgba, png_interlaced_rgba, sizeof(png_interlaced_rgba)) == 0);
+    free(rgba);
+
+    /* Baseline 4:2:0 with restart markers; quadrant centres survive chroma subsampling. */
+    CHECK(native_image_codec_decode_rgba(jpeg_quadrants, sizeof(jpeg_quadrants), &rgba, &width, &height) == 1);
+    CHECK(width == 16 && height == 16);
+    for (quadrant = 0; quadrant < 4; quadrant += 1) {
+        const uint8_t* px = rgba + ((size_t)((quadrant / 2) * 8 + 4) * 16U + (size_t)((quadrant % 2) * 8 + 4)) * 4U;
+        CHECK(near_channel(px[0], quadrant_colors[quadrant][0]));
+        CHECK(near_channel(px[1], quadrant_colors[quadrant][1]));
+        CHECK(near_channel(px[2], quadrant_colors[quadrant][2]));
+        CHECK(px[3] == 255U);
+    }
+    free(rgba);
+
+    /* Truncated streams and progressive frames are rejected, not half-decoded. */
+    CHECK(native_image_codec_decode_rgba(png_filters, sizeof(png_filters) - 20U, &rgba, &width, &height) == 0);
+    CHECK(native_image_codec_decode_rgba(jpeg_quadrants, 200U, &rgba, &width, &height) == 0);
+    memcpy(progressive, jpeg_quadrants, sizeof(progressive));
+    for (i = 0U; i + 1U < sizeof(progressive); i += 1U) {
+        if (progressive[i] == 0xFFU && progressive[i + 1U] == 0xC0U) {
+            progressive[i + 1U] = 0xC2U;
+            break;
+        }
+    }
+    CHECK(native_image_codec_decode_rgba(progressive, sizeof(progressive), &rgba, &width, &height) == 0);
+
+    /* Three length-1 codes over-subscribe the first DC table and must fail before touching the fast table. */
+    memcpy(progressive, jpeg_quadrants, sizeof(progressive));
+    for (i = 0U; i + 1U < sizeof(progressive); i += 1U) {
+        if (progressive[i] == 0xFFU && progressive[i + 1U] == 0xC4U) {
+            progressive[i + 5U] = 3U;
+            progressive[i + 6U] = 0U;
+            progressive[i + 7U] = 0U;
+            break;
+        }
+    }
+    CHECK(native_image_codec_decode_rgba(progressive, sizeof(progressive), &rgba, &width, &height) == 0);
+    return 0;
+}
+#endif
+
 int main(void)
 {
     const uint8_t left_raw[3] = { 1U, 2U, 3U };
@@ -133,24 +279,25 @@ int main(void)
 
     {
         size_t png_len = 0U;
-#if defined(__APPLE__) || defined(_WIN32)
         size_t rgba_len = 0U;
-#endif
         CHECK(native_bytes_from_base64(png_base64, NULL, 0U, &png_len) == 1);
         CHECK(png_len > 0U && png_len < NATIVE_BYTES_SCRATCH_CAPACITY);
         CHECK(native_bytes_from_base64(png_base64, g_native_bytes_scratch, png_len, &png_len) == 1);
         two_args[0] = aivm_value_bytes(g_native_bytes_scratch, png_len);
         two_args[1] = aivm_value_string("image/png");
         status = native_syscall_image_decode_to_rgba_base64("sys.image.decodeToRgbaBase64", two_args, 2U, &result);
-#if defined(__APPLE__) || defined(_WIN32)
         CHECK(status == AIVM_SYSCALL_OK);
         CHECK(result.type == AIVM_VAL_STRING);
         CHECK(result.string_value != NULL && strlen(result.string_value) > 0U);
         CHECK(native_bytes_from_base64(result.string_value, NULL, 0U, &rgba_len) == 1);
         CHECK(rgba_len == 4U);
-#else
+        status = native_syscall_image_decode_to_rgba("sys.image.decodeToRgba", two_args, 2U, &result);
+        CHECK(status == AIVM_SYSCALL_OK);
+        CHECK(result.type == AIVM_VAL_BYTES);
+        CHECK(result.bytes_value.length == 4U);
+        two_args[0] = aivm_value_bytes(g_native_bytes_scratch, png_len / 2U);
+        status = native_syscall_image_decode_to_rgba("sys.image.decodeToRgba", two_args, 2U, &result);
         CHECK(status == AIVM_SYSCALL_ERR_INVALID);
-#endif
     }
 
     two_args[0] = aivm_value_string("echo");
@@ -233,5 +380,8 @@ int main(void)
     CHECK(status == AIVM_SYSCALL_OK);
     CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 0);
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+    CHECK(test_image_codec() == 0);
+#endif
     return 0;
 }
@@ -0,0 +1,204 @@
+#define AIRUN_ALLOW_INTERNAL_UI_FALLBACK 1
+#define main airun_embedded_main_for_test
+#include "../../../AiCLI/native/airun.c"
+#undef main
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAIL line %d\n", __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static const char* k_app_source =
+    "Program#cc_p1 {\n"
+    "  Let#cc_l0(name=greet) { Fn#cc_f0(params=name) { Block#cc_b0 { Return#cc_r0 { Lit#cc_s0(value=\"app greet\") } } } }\n"
+    "  Import#cc_i1(path=\"lib_a.aos\")\n"
+    "  Import#cc_i2(path=\"lib_b.aos\")\n"
+    "  Let#cc_l1(name=start) {\n"
+    "    Fn#cc_f1(params=argv) {\n"
+    "      Block#cc_b1 {\n"
+    "        Call#cc_c1(target=sys.stdout.writeLine) { Call#cc_c2(target=greet) { Lit#cc_s1(value=\"x\") } }\n"
+    "        Call#cc_c3(target=sys.stdout.writeLine) { Call#cc_c4(target=shout) { Lit#cc_s2(value=\"y\") } }\n"
+    "        Call#cc_c5(target=sys.worker.start) { Lit#cc_s3(value=\"work\") Lit#cc_s4(value=\"\") }\n"
+    "        Return#cc_r1 { Lit#cc_n1(value=0) }\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "  Export#cc_e1(name=start)\n"
+    "}\n";
+
+static const char* k_lib_a_source =
+    "Program#cca_p1 {\n"
+    "  Let#cca_l1(name=greet) { Fn#cca_f1(params=name) { Block#cca_b1 { Return#cca_r1 { Lit#cca_s1(value=\"lib greet\") } } } }\n"
+    "  Let#cca_l2(name=shout) { Fn#cca_f2(params=text) { Block#cca_b2 { Return#cca_r2 { Call#cca_c2(target=helper) { Var#cca_v2(name=text) } } } } }\n"
+    "  Let#cca_l3(name=broken) { Fn#cca_f3() { Block#cca_b3 { Return#cca_r3 { Var#cca_v3(name=nope) } } } }\n"
+    "  Let#cca_l4(name=dangling) { Fn#cca_f4() { Block#cca_b4 { Return#cca_r4 { Call#cca_c4(target=missing) { } } } } }\n"
+    "}\n";
+
+static const char* k_lib_b_v1 =
+    "Program#ccb_p1 {\n"
+    "  Let#ccb_l1(name=helper) { Fn#ccb_f1(params=text) { Block#ccb_b1 { Return#ccb_r1 { Lit#ccb_s1(value=\"b1\") } } } }\n"
+    "  Let#ccb_l2(name=work) { Fn#ccb_f2() { Block#ccb_b2 { Return#ccb_r2 { Lit#ccb_n2(value=0) } } } }\n"
+    "}\n";
+
+static const char* k_lib_b_v2 =
+    "Program#ccb_p1 {\n"
+    "  Let#ccb_l1(name=helper) { Fn#ccb_f1(params=text) { Block#ccb_b1 { Return#ccb_r1 { Lit#ccb_s1(value=\"b2 edited\") } } } }\n"
+    "  Let#ccb_l2(name=work) { Fn#ccb_f2() { Block#ccb_b2 { Return#ccb_r2 { Lit#ccb_n2(value=0) } } } }\n"
+    "}\n";
+
+static const char* k_broken_source =
+    "Program#ccx_p1 {\n"
+    "  Import#ccx_i1(path=\"lib_a.aos\")\n"
+    "  Let#ccx_l1(name=start) { Fn#ccx_f1() { Block#ccx_b1 { Return#ccx_r1 { Call#ccx_c1(target=broken) { } } } } }\n"
+    "}\n";
+
+static int programs_equal(const AivmProgram* left, const AivmProgram* right)
+{
+    size_t i;
+    if (left->instruction_count != right->instruction_count || left->constant_count != right->constant_count) {
+        return 0;
+    }
+    for (i = 0U; i < left->instruction_count; i += 1U) {
+        if (left->instructions[i].opcode != right->instructions[i].opcode ||
+            left->instructions[i].operand_int != right->instructions[i].operand_int) {
+            return 0;
+        }
+    }
+    for (i = 0U; i < left->constant_count; i += 1U) {
+        if (left->constants[i].type != right->constants[i].type ||
+            (left->constants[i].type == AIVM_VAL_STRING &&
+             strcmp(left->constants[i].string_value, right->constants[i].string_value) != 0)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int program_has_string(const AivmProgram* program, const char* prefix)
+{
+    size_t i;
+    for (i = 0U; i < program->constant_count; i += 1U) {
+        if (program->constants[i].type == AIVM_VAL_STRING && starts_with(program->constants[i].string_value, prefix)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int set_compile_threads(const char* count)
+{
+#ifdef _WIN32
+    return _putenv_s("AIRUN_COMPILE_THREADS", count) == 0;
+#else
+    return setenv("AIRUN_COMPILE_THREADS", count, 1) == 0;
+#endif
+}
+
+int main(void)
+{
+    const char* root = "aivm_test_compile_cache";
+    char app_path[PATH_MAX];
+    char lib_a_path[PATH_MAX];
+    char lib_b_path[PATH_MAX];
+    char broken_path[PATH_MAX];
+    char cache_dir[PATH_MAX];
+    char stamps_path[PATH_MAX];
+    char key_first[40];
+    char key_second[40];
+    SourceStampTable stamps;
+    SourceStampTable reloaded;
+    SourceStamp* stamp;
+    AivmProgram cached;
+    AivmProgram uncached;
+    AivmProgram serial;
+    size_t compiled_before;
+
+    (void)delete_directory_recursive_portable(root);
+    CHECK(join_path(root, "app.aos", app_path, sizeof(app_path)));
+    CHECK(join_path(root, "lib_a.aos", lib_a_path, sizeof(lib_a_path)));
+    CHECK(join_path(root, "lib_b.aos", lib_b_path, sizeof(lib_b_path)));
+    CHECK(join_path(root, "broken.aos", broken_path, sizeof(broken_path)));
+    CHECK(join_path(root, "modules", cache_dir, sizeof(cache_dir)));
+    CHECK(join_path(cache_dir, "stamps.tsv", stamps_path, sizeof(stamps_path)));
+    CHECK(ensure_directory_recursive(cache_dir));
+    CHECK(write_text_file(app_path, k_app_source));
+    CHECK(write_text_file(lib_a_path, k_lib_a_source));
+    CHECK(write_text_file(lib_b_path, k_lib_b_v1));
+    CHECK(write_text_file(broken_path, k_broken_source));
+    memset(&stamps, 0, sizeof(stamps));
+    memset(&reloaded, 0, sizeof(reloaded));
+    CHECK(set_compile_threads("4"));
+
+    /* Cold build compiles every module; the linked program matches an uncached compile. */
+    CHECK(compute_source_graph_cache_key(app_path, &stamps, key_first, sizeof(key_first)));
+    compiled_before = g_simple_modules_compiled;
+    CHECK(simple_link_program_graph(app_path, &cached, cache_dir, &stamps));
+    CHECK(g_simple_modules_compiled - compiled_before == 3U);
+    CHECK(parse_simple_program_aos_to_program_file(app_path, &uncached));
+    CHECK(programs_equal(&cached, &uncached));
+    CHECK(program_has_string(&cached, "app greet"));
+    CHECK(!program_has_string(&cached, "lib greet"));
+    CHECK(program_has_string(&cached, "b1"));
+    CHECK(program_has_string(&cached, NATIVE_WORKER_ENTRY_PREFIX "work@"));
+    aivm_program_free(&cached);
+
+    /* Modules and function bodies compiled in parallel merge to the single-threaded result. */
+    CHECK(set_compile_threads("1"));
+    CHECK(parse_simple_program_aos_to_program_file(app_path, &serial));
+    CHECK(set_compile_threads("4"));
+    CHECK(programs_equal(&serial, &uncached));
+    aivm_program_free(&serial);
+    aivm_program_free(&uncached);
+
+    /* Unchanged sources link entirely from module units. */
+    compiled_before = g_simple_modules_compiled;
+    CHECK(compute_source_graph_cache_key(app_path, &stamps, key_second, sizeof(key_second)));
+    CHECK(strcmp(key_first, key_second) == 0);
+    CHECK(simple_link_program_graph(app_path, &cached, cache_dir, &stamps));
+    CHECK(g_simple_modules_compiled == compiled_before);
+    CHECK(parse_simple_program_aos_to_program_file(app_path, &uncached));
+    CHECK(programs_equal(&cached, &uncached));
+    aivm_program_free(&cached);
+    aivm_program_free(&uncached);
+
+    /* Stamps persist size, mtime, hash and imports. */
+    stamps.dirty = 1;
+    for (stamp = stamps.items; stamp < stamps.items + stamps.count; stamp += 1) {
+        stamp->mtime_ns = 0;
+    }
+    source_stamp_table_save(&stamps, stamps_path);
+    source_stamp_table_load(&reloaded, stamps_path);
+    CHECK(reloaded.count == 3U);
+    stamp = source_stamp_find(&reloaded, app_path);
+    CHECK(stamp != NULL && strcmp(stamp->imports, "lib_a.aos\nlib_b.aos\n") == 0);
+    CHECK(strcmp(stamp->hash, source_stamp_find(&stamps, app_path)->hash) == 0);
+    source_stamp_table_release(&reloaded);
+
+    /* Editing one module recompiles only that module. */
+    CHECK(write_text_file(lib_b_path, k_lib_b_v2));
+    compiled_before = g_simple_modules_compiled;
+    CHECK(compute_source_graph_cache_key(app_path, &stamps, key_second, sizeof(key_second)));
+    CHECK(strcmp(key_first, key_second) != 0);
+    CHECK(simple_link_program_graph(app_path, &cached, cache_dir, &stamps));
+    CHECK(g_simple_modules_compiled - compiled_before == 1U);
+    CHECK(program_has_string(&cached, "b2 edited"));
+    CHECK(!program_has_string(&cached, "b1"));
+    CHECK(parse_simple_program_aos_to_program_file(app_path, &uncached));
+    CHECK(programs_equal(&cached, &uncached));
+    aivm_program_free(&cached);
+    aivm_program_free(&uncached);
+
+    /* A function that failed to compile only fails the graphs that reach it. */
+    compiled_before = g_simple_modules_compiled;
+    CHECK(compute_source_graph_cache_key(broken_path, &stamps, key_second, sizeof(key_second)));
+    CHECK(!simple_link_program_graph(broken_path, &cached, cache_dir, &stamps));
+    CHECK(strcmp(simple_last_error(), "unknown local variable: nope") == 0);
+    CHECK(g_simple_modules_compiled - compiled_before == 1U);
+
+    source_stamp_table_release(&stamps);
+    CHECK(delete_directory_recursive_portable(root));
+    return 0;
+}
@@ -0,0 +1,401 @@
+#define AIRUN_ALLOW_INTERNAL_UI_FALLBACK 1
+#define main airun_embedded_main_for_test
+#include "../../../AiCLI/native/airun.c"
+#undef main
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAIL line %d\n", __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static int64_t call_int(
+    int (*handler)(const char*, const AivmValue*, size_t, AivmValue*),
+    const AivmValue* args,
+    size_t arg_count)
+{
+    AivmValue result;
+    if (handler("test", args, arg_count, &result) != AIVM_SYSCALL_OK || result.type != AIVM_VAL_INT) {
+        return -100;
+    }
+    return result.int_value;
+}
+
+static const AivmNodeAttr* node_attr(const AivmVm* vm, int64_t handle, const char* key)
+{
+    const AivmNodeRecord* node = &vm->nodes[handle - 1];
+    size_t i;
+    for (i = 0U; i < node->attr_count; i += 1U) {
+        if (strcmp(vm->node_attrs[node->attr_start + i].key, key) == 0) {
+            return &vm->node_attrs[node->attr_start + i];
+        }
+    }
+    return NULL;
+}
+
+static int64_t node_child(const AivmVm* vm, int64_t handle, size_t index)
+{
+    const AivmNodeRecord* node = &vm->nodes[handle - 1];
+    return index < node->child_count ? vm->node_children[node->child_start + index] : 0;
+}
+
+static int write_tree_file(const char* dir, const char* name, const char* text)
+{
+    char path[256];
+    AivmValue args[2];
+    AivmValue result;
+    if (!join_path(dir, name, path, sizeof(path))) {
+        return 0;
+    }
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_bytes((const uint8_t*)text, strlen(text));
+    return native_syscall_fs_file_write("sys.fs.file.write", args, 2U, &result) == AIVM_SYSCALL_OK;
+}
+
+static int64_t dir_entries(const char* path, int64_t max_depth, const char* glob)
+{
+    AivmValue args[3];
+    AivmValue result;
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_int(max_depth);
+    args[2] = aivm_value_string(glob);
+    if (native_syscall_fs_dir_entries("sys.fs.dir.entries", args, 3U, &result) != AIVM_SYSCALL_OK ||
+        result.type != AIVM_VAL_NODE) {
+        return 0;
+    }
+    return result.node_handle;
+}
+
+static int test_dir_entries_walk(void)
+{
+    static AivmVm vm;
+    AivmProgram program;
+    AivmValue args[2];
+    AivmValue result;
+    char root[128];
+    char sub[160];
+    char deep[192];
+    char missing[160];
+    int64_t listing;
+    int64_t entry;
+
+    memset(&program, 0, sizeof(program));
+    aivm_program_clear(&program);
+    aivm_init(&vm, &program);
+    g_native_active_vm = &vm;
+    (void)snprintf(root, sizeof(root), "aivm_test_fs_dir_%ld", (long)time(NULL));
+    CHECK(join_path(root, "sub", sub, sizeof(sub)));
+    CHECK(join_path(sub, "deep", deep, sizeof(deep)));
+    CHECK(join_path(root, "missing", missing, sizeof(missing)));
+    args[0] = aivm_value_string(deep);
+    CHECK(native_syscall_fs_dir_create("sys.fs.dir.create", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(write_tree_file(root, "b.txt", "bee"));
+    CHECK(write_tree_file(root, "a.aos", "a"));
+    CHECK(write_tree_file(sub, "c.aos", "cc"));
+    CHECK(write_tree_file(deep, "d.aos", "ddd"));
+
+    /* Depth 0 lists the immediate children, sorted, with one stat per entry. */
+    listing = dir_entries(root, 0, "");
+    CHECK(listing > 0);
+    CHECK(node_attr(&vm, listing, "exists")->bool_value == 1);
+    CHECK(node_attr(&vm, listing, "count")->int_value == 3);
+    CHECK(node_attr(&vm, listing, "truncated")->bool_value == 0);
+    entry = node_child(&vm, listing, 0U);
+    CHECK(strcmp(node_attr(&vm, entry, "name")->string_value, "a.aos") == 0);
+    CHECK(strcmp(node_attr(&vm, entry, "type")->string_value, "file") == 0);
+    CHECK(node_attr(&vm, entry, "size")->int_value == 1);
+    CHECK(node_attr(&vm, entry, "mtimeUnixMs")->int_value > 0);
+    entry = node_child(&vm, listing, 1U);
+    CHECK(strcmp(node_attr(&vm, entry, "name")->string_value, "b.txt") == 0);
+    CHECK(node_attr(&vm, entry, "size")->int_value == 3);
+    entry = node_child(&vm, listing, 2U);
+    CHECK(strcmp(node_attr(&vm, entry, "name")->string_value, "sub") == 0);
+    CHECK(strcmp(node_attr(&vm, entry, "type")->string_value, "dir") == 0);
+
+    /* The glob filters names but the walk still descends into every directory. */
+    listing = dir_entries(root, 8, "*.aos");
+    CHECK(listing > 0);
+    CHECK(node_attr(&vm, listing, "count")->int_value == 3);
+    CHECK(strcmp(node_attr(&vm, node_child(&vm, listing, 0U), "name")->string_value, "a.aos") == 0);
+    CHECK(strcmp(node_attr(&vm, node_child(&vm, listing, 1U), "name")->string_value, "sub/c.aos") == 0);
+    CHECK(strcmp(node_attr(&vm, node_child(&vm, listing, 2U), "name")->string_value, "sub/deep/d.aos") == 0);
+    CHECK(node_attr(&vm, node_child(&vm, listing, 2U), "size")->int_value == 3);
+
+    listing = dir_entries(root, 1, "?.aos");
+    CHECK(listing > 0);
+    CHECK(node_attr(&vm, listing, "count")->int_value == 2);
+    CHECK(strcmp(node_attr(&vm, node_child(&vm, listing, 1U), "name")->string_value, "sub/c.aos") == 0);
+
+    listing = dir_entries(missing, 4, "");
+    CHECK(listing > 0);
+    CHECK(node_attr(&vm, listing, "exists")->bool_value == 0);
+    CHECK(node_attr(&vm, listing, "count")->int_value == 0);
+
+    args[0] = aivm_value_string(root);
+    args[1] = aivm_value_bool(1);
+    CHECK(native_syscall_fs_dir_delete("sys.fs.dir.delete", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 1);
+    g_native_active_vm = NULL;
+    return 0;
+}
+
+static int file_equals(const char* path, const char* expected)
+{
+    AivmValue args[1];
+    AivmValue result;
+    size_t length = strlen(expected);
+    args[0] = aivm_value_string(path);
+    return native_syscall_fs_file_read("sys.fs.file.read", args, 1U, &result) == AIVM_SYSCALL_OK &&
+           result.type == AIVM_VAL_BYTES && result.bytes_value.length == length &&
+           memcmp(result.bytes_value.data, expected, length) == 0;
+}
+
+static int test_append_atomic_and_writer(void)
+{
+    static uint8_t big[NATIVE_FS_WRITER_BUFFER + 17U];
+    char path[128];
+    char temp_prefix[160];
+    AivmValue args[3];
+    AivmValue result;
+    int64_t writer;
+    int64_t handle;
+
+    (void)snprintf(path, sizeof(path), "aivm_test_fs_writer_%ld.log", (long)time(NULL));
+    (void)remove(path);
+
+    /* append creates the file and never truncates it. */
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_bytes((const uint8_t*)"one\n", 4U);
+    CHECK(native_syscall_fs_file_append("sys.fs.file.append", args, 2U, &result) == AIVM_SYSCALL_OK);
+    args[1] = aivm_value_bytes((const uint8_t*)"two\n", 4U);
+    CHECK(native_syscall_fs_file_append("sys.fs.file.append", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(file_equals(path, "one\ntwo\n"));
+
+    /* writeAtomic replaces the contents and leaves no temp file behind. */
+    args[1] = aivm_value_bytes((const uint8_t*)"fresh", 5U);
+    CHECK(native_syscall_fs_file_write_atomic("sys.fs.file.writeAtomic", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(file_equals(path, "fresh"));
+#ifdef _WIN32
+    (void)snprintf(temp_prefix, sizeof(temp_prefix), "%s.tmp.%d.%u", path, _getpid(), g_native_fs_atomic_counter);
+#else
+    (void)snprintf(temp_prefix, sizeof(temp_prefix), "%s.tmp.%ld.%u", path, (long)getpid(), g_native_fs_atomic_counter);
+#endif
+    args[0] = aivm_value_string(temp_prefix);
+    CHECK(native_syscall_fs_file_exists("sys.fs.file.exists", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 0);
+    args[0] = aivm_value_string("aivm-missing-dir/x/y.txt");
+    CHECK(native_syscall_fs_file_write_atomic("sys.fs.file.writeAtomic", args, 2U, &result) == AIVM_SYSCALL_ERR_INVALID);
+
+    /* Small writes stay buffered until flush; appends keep earlier contents. */
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_string("a");
+    args[2] = aivm_value_int(0);
+    writer = call_int(native_syscall_fs_writer_open, args, 3U);
+    CHECK(writer > 0);
+    args[0] = aivm_value_int(writer);
+    args[1] = aivm_value_bytes((const uint8_t*)"+a", 2U);
+    CHECK(native_syscall_fs_writer_write("sys.fs.writer.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 1);
+    args[1] = aivm_value_bytes((const uint8_t*)"+b", 2U);
+    CHECK(native_syscall_fs_writer_write("sys.fs.writer.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(file_equals(path, "fresh"));
+    CHECK(native_syscall_fs_writer_flush("sys.fs.writer.flush", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 1);
+    CHECK(file_equals(path, "fresh+a+b"));
+    args[1] = aivm_value_bytes((const uint8_t*)"+c", 2U);
+    CHECK(native_syscall_fs_writer_write("sys.fs.writer.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(native_syscall_fs_writer_close("sys.fs.writer.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 1);
+    CHECK(file_equals(path, "fresh+a+b+c"));
+    CHECK(native_syscall_fs_writer_close("sys.fs.writer.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 0);
+    CHECK(native_syscall_fs_writer_write("sys.fs.writer.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 0);
+
+    /* A write larger than the buffer goes straight through and counts toward the byte-based sync policy. */
+    memset(big, 'z', sizeof(big));
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_string("w");
+    args[2] = aivm_value_int(1024);
+    writer = call_int(native_syscall_fs_writer_open, args, 3U);
+    CHECK(writer > 0);
+    args[0] = aivm_value_int(writer);
+    args[1] = aivm_value_bytes((const uint8_t*)"x", 1U);
+    CHECK(native_syscall_fs_writer_write("sys.fs.writer.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    args[1] = aivm_value_bytes(big, sizeof(big));
+    CHECK(native_syscall_fs_writer_write("sys.fs.writer.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 1);
+    CHECK(g_native_fs_writers[writer - 1].buffered == 0U);
+    CHECK(g_native_fs_writers[writer - 1].unsynced == 0);
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_string("r");
+    handle = call_int(native_syscall_fs_file_open, args, 2U);
+    CHECK(handle > 0);
+    args[0] = aivm_value_int(handle);
+    CHECK(call_int(native_syscall_fs_file_size, args, 1U) == (int64_t)sizeof(big) + 1);
+    CHECK(native_syscall_fs_file_close("sys.fs.file.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+
+    /* Run teardown flushes writers that the program never closed. */
+    args[0] = aivm_value_int(writer);
+    args[1] = aivm_value_bytes((const uint8_t*)"tail", 4U);
+    CHECK(native_syscall_fs_writer_write("sys.fs.writer.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    native_fs_reset();
+    CHECK(native_fs_writer_lookup(writer) == NULL);
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_int(sizeof(big) + 1U);
+    args[2] = aivm_value_int(16);
+    CHECK(native_syscall_fs_file_read_range("sys.fs.file.readRange", args, 3U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 4U);
+    CHECK(memcmp(result.bytes_value.data, "tail", 4U) == 0);
+
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_string("rw");
+    args[2] = aivm_value_int(0);
+    CHECK(native_syscall_fs_writer_open("sys.fs.writer.open", args, 3U, &result) == AIVM_SYSCALL_ERR_INVALID);
+    (void)remove(path);
+    return 0;
+}
+
+int main(void)
+{
+    static uint8_t large[256U * 1024U + 4096U];
+    const uint8_t hello[5] = { 'h', 'e', 'l', 'l', 'o' };
+    const uint8_t tail[3] = { '!', '!', '\n' };
+    char path[128];
+    char large_path[160];
+    AivmValue args[3];
+    AivmValue result;
+    int64_t handle;
+    int64_t offset;
+    size_t i;
+
+    (void)snprintf(path, sizeof(path), "aivm_test_fs_file_%ld.bin", (long)time(NULL));
+    (void)snprintf(large_path, sizeof(large_path), "aivm_test_fs_file_%ld.large", (long)time(NULL));
+
+    /* Write, overwrite in place, and append through one handle. */
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_string("rw");
+    handle = call_int(native_syscall_fs_file_open, args, 2U);
+    CHECK(handle > 0);
+    args[0] = aivm_value_int(handle);
+    args[1] = aivm_value_int(0);
+    args[2] = aivm_value_bytes(hello, 5U);
+    CHECK(call_int(native_syscall_fs_file_write_at, args, 3U) == 5);
+    args[1] = aivm_value_int(-1);
+    args[2] = aivm_value_bytes(tail, 3U);
+    CHECK(call_int(native_syscall_fs_file_write_at, args, 3U) == 3);
+    args[1] = aivm_value_int(0);
+    args[2] = aivm_value_bytes((const uint8_t*)"J", 1U);
+    CHECK(call_int(native_syscall_fs_file_write_at, args, 3U) == 1);
+    CHECK(call_int(native_syscall_fs_file_size, args, 1U) == 8);
+
+    args[1] = aivm_value_int(1);
+    args[2] = aivm_value_int(4);
+    CHECK(native_syscall_fs_file_read_at("sys.fs.file.readAt", args, 3U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 4U);
+    CHECK(memcmp(result.bytes_value.data, "ello", 4U) == 0);
+    args[1] = aivm_value_int(8);
+    CHECK(native_syscall_fs_file_read_at("sys.fs.file.readAt", args, 3U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 0U);
+
+    CHECK(native_syscall_fs_file_close("sys.fs.file.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 1);
+    CHECK(native_syscall_fs_file_close("sys.fs.file.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 0);
+    args[2] = aivm_value_bytes(hello, 5U);
+    CHECK(call_int(native_syscall_fs_file_write_at, args, 3U) == -1);
+
+    /* Mode "a" appends regardless of the offset argument. */
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_string("a");
+    handle = call_int(native_syscall_fs_file_open, args, 2U);
+    CHECK(handle > 0);
+    args[0] = aivm_value_int(handle);
+    args[1] = aivm_value_int(0);
+    args[2] = aivm_value_bytes(hello, 5U);
+    CHECK(call_int(native_syscall_fs_file_write_at, args, 3U) == 5);
+    CHECK(call_int(native_syscall_fs_file_size, args, 1U) == 13);
+    args[1] = aivm_value_int(0);
+    args[2] = aivm_value_int(4);
+    CHECK(native_syscall_fs_file_read_at("sys.fs.file.readAt", args, 3U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 0U);
+    CHECK(native_syscall_fs_file_close("sys.fs.file.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+
+    args[0] = aivm_value_string(path);
+    args[1] = aivm_value_int(5);
+    args[2] = aivm_value_int(100);
+    CHECK(native_syscall_fs_file_read_range("sys.fs.file.readRange", args, 3U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 8U);
+    CHECK(memcmp(result.bytes_value.data, "!!\nhello", 8U) == 0);
+    args[1] = aivm_value_int(-1);
+    CHECK(native_syscall_fs_file_read_range("sys.fs.file.readRange", args, 3U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 0U);
+
+    args[1] = aivm_value_string("x");
+    CHECK(native_syscall_fs_file_open("sys.fs.file.open", args, 2U, &result) == AIVM_SYSCALL_ERR_INVALID);
+    args[0] = aivm_value_string("/nonexistent-dir/aivm-missing.bin");
+    args[1] = aivm_value_string("r");
+    CHECK(call_int(native_syscall_fs_file_open, args, 2U) == -1);
+
+    /* A large file is streamed in bounded chunks and matches a whole-file read. */
+    for (i = 0U; i < sizeof(large); i += 1U) {
+        large[i] = (uint8_t)((i * 31U) & 0xFFU);
+    }
+    args[0] = aivm_value_string(large_path);
+    args[1] = aivm_value_bytes(large, sizeof(large));
+    CHECK(native_syscall_fs_file_write("sys.fs.file.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    args[1] = aivm_value_string("r");
+    handle = call_int(native_syscall_fs_file_open, args, 2U);
+    CHECK(handle > 0);
+    CHECK(native_fs_file_lookup(handle) != NULL);
+    offset = 0;
+    for (;;) {
+        args[0] = aivm_value_int(handle);
+        args[1] = aivm_value_int(offset);
+        args[2] = aivm_value_int(1000000);
+        CHECK(native_syscall_fs_file_read_at("sys.fs.file.readAt", args, 3U, &result) == AIVM_SYSCALL_OK);
+        CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length <= NATIVE_FS_READ_CHUNK);
+        if (result.bytes_value.length == 0U) {
+            break;
+        }
+        CHECK(memcmp(result.bytes_value.data, large + offset, result.bytes_value.length) == 0);
+        offset += (int64_t)result.bytes_value.length;
+    }
+    CHECK(offset == (int64_t)sizeof(large));
+
+    /* Another writer truncating the file under an open handle shortens reads instead of faulting. */
+    args[0] = aivm_value_string(large_path);
+    args[1] = aivm_value_bytes(large, 1000U);
+    CHECK(native_syscall_fs_file_write("sys.fs.file.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    args[0] = aivm_value_int(handle);
+    args[1] = aivm_value_int(200000);
+    args[2] = aivm_value_int(4096);
+    CHECK(native_syscall_fs_file_read_at("sys.fs.file.readAt", args, 3U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 0U);
+    args[1] = aivm_value_int(900);
+    CHECK(native_syscall_fs_file_read_at("sys.fs.file.readAt", args, 3U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 100U);
+    CHECK(memcmp(result.bytes_value.data, large + 900, 100U) == 0);
+    CHECK(native_syscall_fs_file_close("sys.fs.file.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    args[0] = aivm_value_string(large_path);
+    args[1] = aivm_value_bytes(large, sizeof(large));
+    CHECK(native_syscall_fs_file_write("sys.fs.file.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+
+    args[0] = aivm_value_string(large_path);
+    CHECK(native_syscall_fs_file_read("sys.fs.file.read", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == sizeof(large));
+    CHECK(memcmp(result.bytes_value.data, large, sizeof(large)) == 0);
+    args[0] = aivm_value_string(path);
+    CHECK(native_syscall_fs_file_read("sys.fs.file.read", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BYTES && result.bytes_value.length == 13U);
+    CHECK(memcmp(result.bytes_value.data, "Jello!!\nhello", 13U) == 0);
+
+    (void)remove(path);
+    (void)remove(large_path);
+    if (test_dir_entries_walk() != 0) {
+        return 1;
+    }
+    return test_append_atomic_and_writer();
+}
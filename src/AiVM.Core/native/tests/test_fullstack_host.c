@@ -0,0 +1,276 @@
+#define AIRUN_ALLOW_INTERNAL_UI_FALLBACK 1
+#define NATIVE_NET_WRITE_STALL_TIMEOUT_MS 200
+#define main airun_embedded_main_for_test
+#include "../../../AiCLI/native/airun.c"
+#undef main
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAIL line %d\n", __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static int count_occurrences(const char* haystack, const char* needle)
+{
+    int count = 0;
+    const char* cursor = haystack;
+    while ((cursor = strstr(cursor, needle)) != NULL) {
+        count += 1;
+        cursor += strlen(needle);
+    }
+    return count;
+}
+
+static int wait_socket_readable(NativeSocket socket_fd)
+{
+    FullstackPollFd fd;
+    fd.fd = socket_fd;
+    fd.events = POLLIN;
+    fd.revents = 0;
+    return fullstack_poll(&fd, 1U, 2000) > 0;
+}
+
+static int test_parse_request(void)
+{
+    FullstackRequest request;
+
+    CHECK(fullstack_parse_request("GET /app.js?v=1 HTTP/1.1\r\nHost: x\r\n", &request) == 1);
+    CHECK(strcmp(request.method, "GET") == 0);
+    CHECK(strcmp(request.target, "/app.js") == 0);
+    CHECK(request.keep_alive == 1);
+    CHECK(request.accepts_gzip == 0);
+    CHECK(request.accepts_br == 0);
+
+    CHECK(fullstack_parse_request(
+        "GET / HTTP/1.0\r\naccept-encoding: gzip;q=0, br\r\nConnection: Keep-Alive\r\nIf-None-Match: \"a-b\"\r\n",
+        &request) == 1);
+    CHECK(request.keep_alive == 1);
+    CHECK(request.accepts_gzip == 0);
+    CHECK(request.accepts_br == 1);
+    CHECK(strcmp(request.if_none_match, "\"a-b\"") == 0);
+
+    CHECK(fullstack_parse_request("GET / HTTP/1.0\r\n", &request) == 1);
+    CHECK(request.keep_alive == 0);
+    CHECK(fullstack_parse_request("GET / HTTP/1.1\r\nConnection: close\r\n", &request) == 1);
+    CHECK(request.keep_alive == 0);
+    CHECK(fullstack_parse_request("GET /\r\n", &request) == 0);
+    CHECK(fullstack_parse_request("GET / HTTP/1.1\r\nbroken header\r\n", &request) == 0);
+    return 0;
+}
+
+static int test_normalize_target(void)
+{
+    char relative[256];
+
+    CHECK(fullstack_normalize_target("/", relative, sizeof(relative)) == 1);
+    CHECK(strcmp(relative, "") == 0);
+    CHECK(fullstack_normalize_target("/a..b.js", relative, sizeof(relative)) == 1);
+    CHECK(strcmp(relative, "a..b.js") == 0);
+    CHECK(fullstack_normalize_target("//assets/./x/../app%20v2.js", relative, sizeof(relative)) == 1);
+    CHECK(strcmp(relative, "assets/app v2.js") == 0);
+    CHECK(fullstack_normalize_target("/..", relative, sizeof(relative)) == 0);
+    CHECK(fullstack_normalize_target("/assets/../../etc/passwd", relative, sizeof(relative)) == 0);
+    CHECK(fullstack_normalize_target("/%2e%2e/secret", relative, sizeof(relative)) == 0);
+    CHECK(fullstack_normalize_target("/..%2fsecret", relative, sizeof(relative)) == 0);
+    CHECK(fullstack_normalize_target("/..%5csecret", relative, sizeof(relative)) == 0);
+    CHECK(fullstack_normalize_target("/%zz", relative, sizeof(relative)) == -1);
+    CHECK(fullstack_normalize_target("/a%00.js", relative, sizeof(relative)) == -1);
+    CHECK(fullstack_normalize_target("/abc%2", relative, sizeof(relative)) == -1);
+    CHECK(fullstack_normalize_target("/abcdef", relative, 4U) == -1);
+    return 0;
+}
+
+static int test_serve_connection(void)
+{
+    const char* www_dir = "aivm_test_fullstack_www";
+    char index_path[PATH_MAX];
+    char index_gz_path[PATH_MAX];
+    char app_path[PATH_MAX];
+    char dotted_path[PATH_MAX];
+    char etag[64];
+    char requests[1024];
+    char response[8192];
+    size_t received = 0U;
+    struct stat st;
+    NativeSocket listener;
+    NativeSocket client;
+    NativeSocket accepted;
+    struct sockaddr_in addr;
+    socklen_t addr_len = (socklen_t)sizeof(addr);
+    FullstackServer* server;
+    FullstackConnection* conn;
+    int requests_len;
+    int recv_count;
+
+    CHECK(ensure_directory_recursive(www_dir));
+    CHECK(join_path(www_dir, "index.html", index_path, sizeof(index_path)));
+    CHECK(join_path(www_dir, "index.html.gz", index_gz_path, sizeof(index_gz_path)));
+    CHECK(join_path(www_dir, "app.js", app_path, sizeof(app_path)));
+    CHECK(write_text_file(index_path, "<h1>index</h1>"));
+    CHECK(write_text_file(index_gz_path, "GZ"));
+    CHECK(write_text_file(app_path, "console.log(1);"));
+    CHECK(join_path(www_dir, "a..b.js", dotted_path, sizeof(dotted_path)));
+    CHECK(write_text_file(dotted_path, "dotted"));
+    CHECK(stat(index_path, &st) == 0);
+    fullstack_format_etag(etag, sizeof(etag), &st, NULL);
+
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    CHECK(listener != NATIVE_INVALID_SOCKET);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        native_socket_close(listener);
+        fprintf(stderr, "SKIP local loopback bind unavailable\n");
+        return 0;
+    }
+    CHECK(listen(listener, 1) == 0);
+    CHECK(getsockname(listener, (struct sockaddr*)&addr, &addr_len) == 0);
+    client = socket(AF_INET, SOCK_STREAM, 0);
+    CHECK(client != NATIVE_INVALID_SOCKET);
+    CHECK(connect(client, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    accepted = accept(listener, NULL, NULL);
+    CHECK(accepted != NATIVE_INVALID_SOCKET);
+
+    server = (FullstackServer*)malloc(sizeof(FullstackServer));
+    CHECK(server != NULL);
+    CHECK(fullstack_server_init(server, www_dir));
+    g_fullstack_stop = 0;
+    conn = fullstack_connection_open(accepted);
+    CHECK(conn != NULL);
+
+    /* One keep-alive request: the worker answers it, then hands the idle connection back. */
+    requests_len = snprintf(requests, sizeof(requests), "GET /a..b.js HTTP/1.1\r\n\r\n");
+    CHECK(native_send_all(client, requests, (size_t)requests_len));
+    CHECK(wait_socket_readable(accepted));
+    CHECK(fullstack_serve_connection(server, conn) == 1);
+    CHECK(conn->served == 1 && conn->used == 0U);
+
+    /* Five pipelined requests: compressed variant, revalidation, HEAD, miss, then close. */
+    requests_len = snprintf(
+        requests,
+        sizeof(requests),
+        "GET / HTTP/1.1\r\nHost: x\r\nAccept-Encoding: gzip, br;q=0\r\n\r\n"
+        "GET /index.html HTTP/1.1\r\nIf-None-Match: %s\r\n\r\n"
+        "HEAD /app.js HTTP/1.1\r\n\r\n"
+        "GET /missing.js HTTP/1.1\r\n\r\n"
+        "GET /app.js HTTP/1.1\r\nConnection: close\r\n\r\n",
+        etag);
+    CHECK(requests_len > 0 && (size_t)requests_len < sizeof(requests));
+    CHECK(native_send_all(client, requests, (size_t)requests_len));
+    do {
+        CHECK(wait_socket_readable(accepted));
+    } while (fullstack_serve_connection(server, conn) == 1);
+    fullstack_connection_close(conn);
+
+    for (;;) {
+#ifdef _WIN32
+        recv_count = recv(client, response + received, (int)(sizeof(response) - 1U - received), 0);
+#else
+        recv_count = (int)recv(client, response + received, sizeof(response) - 1U - received, 0);
+#endif
+        if (recv_count <= 0) {
+            break;
+        }
+        received += (size_t)recv_count;
+    }
+    response[received] = '\0';
+    native_socket_close(client);
+    native_socket_close(listener);
+
+    CHECK(count_occurrences(response, "HTTP/1.1 200 OK") == 4);
+    CHECK(count_occurrences(response, "HTTP/1.1 304 Not Modified") == 1);
+    CHECK(count_occurrences(response, "HTTP/1.1 404 not found") == 1);
+    CHECK(count_occurrences(response, "Content-Encoding: gzip") == 1);
+    CHECK(count_occurrences(response, "Connection: keep-alive") == 5);
+    CHECK(count_occurrences(response, "Connection: close") == 1);
+    CHECK(count_occurrences(response, "\r\n\r\nGZ") == 1);
+    CHECK(count_occurrences(response, "<h1>index</h1>") == 0);
+    CHECK(count_occurrences(response, "console.log(1);") == 1);
+    CHECK(count_occurrences(response, "\r\n\r\ndotted") == 1);
+    CHECK(count_occurrences(response, etag) == 1);
+    CHECK(strstr(response, "Content-Type: text/javascript; charset=utf-8") != NULL);
+
+    fullstack_server_destroy(server);
+    free(server);
+    (void)remove(index_path);
+    (void)remove(index_gz_path);
+    (void)remove(app_path);
+    (void)remove(dotted_path);
+    (void)remove(www_dir);
+    return 0;
+}
+
+/* The client never reads, so the response fills the socket buffers; the send must give up. */
+static int test_stalled_client_send_times_out(void)
+{
+    const size_t flood_size = 32U * 1024U * 1024U;
+    char* flood;
+    NativeSocket listener;
+    NativeSocket client;
+    NativeSocket accepted;
+    struct sockaddr_in addr;
+    socklen_t addr_len = (socklen_t)sizeof(addr);
+    FullstackConnection* conn;
+    int sent;
+
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    CHECK(listener != NATIVE_INVALID_SOCKET);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        native_socket_close(listener);
+        fprintf(stderr, "SKIP local loopback bind unavailable\n");
+        return 0;
+    }
+    CHECK(listen(listener, 1) == 0);
+    CHECK(getsockname(listener, (struct sockaddr*)&addr, &addr_len) == 0);
+    client = socket(AF_INET, SOCK_STREAM, 0);
+    CHECK(client != NATIVE_INVALID_SOCKET);
+    CHECK(connect(client, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    accepted = accept(listener, NULL, NULL);
+    CHECK(accepted != NATIVE_INVALID_SOCKET);
+    conn = fullstack_connection_open(accepted);
+    CHECK(conn != NULL);
+
+    flood = (char*)calloc(flood_size, 1U);
+    CHECK(flood != NULL);
+    sent = native_send_all(conn->socket, flood, flood_size);
+    free(flood);
+    fullstack_connection_close(conn);
+    native_socket_close(client);
+    native_socket_close(listener);
+    CHECK(sent == 0);
+    return 0;
+}
+
+int main(void)
+{
+#ifdef _WIN32
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+        return 1;
+    }
+#endif
+    if (test_parse_request() != 0) {
+        return 1;
+    }
+    if (test_normalize_target() != 0) {
+        return 1;
+    }
+    if (test_serve_connection() != 0) {
+        return 1;
+    }
+    if (test_stalled_client_send_times_out() != 0) {
+        return 1;
+    }
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return 0;
+}
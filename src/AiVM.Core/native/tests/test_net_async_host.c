@@ -1,4 +1,5 @@
 #define AIRUN_ALLOW_INTERNAL_UI_FALLBACK 1
+#define NATIVE_NET_WRITE_STALL_TIMEOUT_MS 200
 #define main airun_embedded_main_for_test
 #include "../../../AiCLI/native/airun.c"
 #undef main
@@ -168,6 +169,51 @@ int main(void)
     CHECK(result.bytes_value.data[0] == 'O');
     CHECK(result.bytes_value.data[1] == 'K');
 
+    {
+        /* A coroutine awaiting an in-flight read is parked instead of blocking the host. */
+        static AivmVm vm;
+        AivmProgram program;
+        int64_t pending_read;
+
+        args[0] = aivm_value_int(connection);
+        args[1] = aivm_value_int(16);
+        CHECK(native_syscall_net_start_op("sys.net.tcp.readStart", args, 2U, &result) == AIVM_SYSCALL_OK);
+        pending_read = result.int_value;
+        CHECK(pending_read > 0);
+
+        aivm_program_clear(&program);
+        aivm_init(&vm, &program);
+        CHECK(aivm_frame_push(&vm, 0U, 0U));
+        vm.running_tasks[0].frame_base = 0U;
+        vm.running_tasks[0].stack_base = 0U;
+        vm.running_tasks[0].locals_base = 0U;
+        vm.running_tasks[0].par_context_base = 0U;
+        vm.running_tasks[0].sync_depth = 0U;
+        vm.running_task_count = 1U;
+        CHECK(aivm_task_can_suspend(&vm));
+        g_native_active_vm = &vm;
+        one_arg[0] = aivm_value_int(pending_read);
+        status = native_syscall_net_async_await("sys.net.async.await", one_arg, 1U, &result);
+        CHECK(status == AIVM_SYSCALL_PENDING);
+
+#ifdef _WIN32
+        CHECK(send(accepted, "GO", 2, 0) == 2);
+#else
+        CHECK(send(accepted, "GO", 2U, 0) == 2);
+#endif
+        for (i = 0; i < 1000; i += 1) {
+            native_net_async_wait(NULL);
+            status = native_syscall_net_async_await("sys.net.async.await", one_arg, 1U, &result);
+            if (status == AIVM_SYSCALL_OK) {
+                break;
+            }
+            CHECK(status == AIVM_SYSCALL_PENDING);
+        }
+        g_native_active_vm = NULL;
+        CHECK(status == AIVM_SYSCALL_OK);
+        CHECK(result.type == AIVM_VAL_INT && result.int_value == 1);
+    }
+
     args[0] = aivm_value_int(connection);
     args[1] = aivm_value_bytes((const uint8_t*)"PING", 4U);
     status = native_syscall_net_start_op("sys.net.tcp.writeStart", args, 2U, &result);
@@ -207,6 +253,101 @@ int main(void)
         CHECK(memcmp(recv_buf, "PING", 4U) == 0);
     }
 
+    {
+        AivmProgram program;
+        AivmVm vm;
+        AivmValue writev_args[3];
+        const char* part_values[2] = { "HEAD", "ER:" };
+        uint8_t recv_buf[11];
+        size_t received = 0U;
+
+        aivm_program_clear(&program);
+        aivm_init_with_syscalls_and_argv(&vm, &program, NULL, 0U, part_values, 2U);
+        g_native_active_vm = &vm;
+        writev_args[0] = aivm_value_int(connection);
+        writev_args[1] = aivm_value_node(vm.process_argv_node_handle);
+        writev_args[2] = aivm_value_bytes((const uint8_t*)"BODY", 4U);
+        status = native_syscall_net_tcp_writev("sys.net.tcp.writev", writev_args, 3U, &result);
+        g_native_active_vm = NULL;
+        CHECK(status == AIVM_SYSCALL_OK);
+        CHECK(result.type == AIVM_VAL_INT);
+        CHECK(result.int_value == 11);
+        for (i = 0; i < 1000 && received < sizeof(recv_buf); i += 1) {
+            int recv_count = recv(accepted, (char*)recv_buf + received, (int)(sizeof(recv_buf) - received), 0);
+            if (recv_count > 0) {
+                received += (size_t)recv_count;
+                continue;
+            }
+            if (recv_count < 0 && native_net_socket_would_block()) {
+                test_sleep_ms(1);
+                continue;
+            }
+            break;
+        }
+        CHECK(received == 11U);
+        CHECK(memcmp(recv_buf, "HEADER:BODY", 11U) == 0);
+    }
+
+    {
+        const char* file_path = "aivm_test_net_send_file.tmp";
+        FILE* fp = fopen(file_path, "wb");
+        uint8_t recv_buf[10];
+        size_t received = 0U;
+        CHECK(fp != NULL);
+        CHECK(fwrite("FILE-BYTES", 1U, 10U, fp) == 10U);
+        CHECK(fclose(fp) == 0);
+
+        args[0] = aivm_value_int(connection);
+        args[1] = aivm_value_string(file_path);
+        status = native_syscall_net_tcp_send_file("sys.net.tcp.sendFile", args, 2U, &result);
+        CHECK(status == AIVM_SYSCALL_OK);
+        CHECK(result.type == AIVM_VAL_INT);
+        CHECK(result.int_value == 10);
+        for (i = 0; i < 1000 && received < sizeof(recv_buf); i += 1) {
+            int recv_count = recv(accepted, (char*)recv_buf + received, (int)(sizeof(recv_buf) - received), 0);
+            if (recv_count > 0) {
+                received += (size_t)recv_count;
+                continue;
+            }
+            if (recv_count < 0 && native_net_socket_would_block()) {
+                test_sleep_ms(1);
+                continue;
+            }
+            break;
+        }
+        CHECK(received == 10U);
+        CHECK(memcmp(recv_buf, "FILE-BYTES", 10U) == 0);
+
+        args[1] = aivm_value_string("aivm_test_net_send_file.missing");
+        status = native_syscall_net_tcp_send_file("sys.net.tcp.sendFile", args, 2U, &result);
+        CHECK(status == AIVM_SYSCALL_OK);
+        CHECK(result.type == AIVM_VAL_INT);
+        CHECK(result.int_value == -1);
+        (void)remove(file_path);
+    }
+
+    {
+        /* The peer never reads, so the send buffer fills and the stalled write must give up. */
+        const size_t flood_size = 32U * 1024U * 1024U;
+        uint8_t* flood = (uint8_t*)calloc(flood_size, 1U);
+        AivmProgram program;
+        AivmVm vm;
+        AivmValue writev_args[3];
+        CHECK(flood != NULL);
+        aivm_program_clear(&program);
+        aivm_init_with_syscalls_and_argv(&vm, &program, NULL, 0U, NULL, 0U);
+        g_native_active_vm = &vm;
+        writev_args[0] = aivm_value_int(connection);
+        writev_args[1] = aivm_value_node(vm.process_argv_node_handle);
+        writev_args[2] = aivm_value_bytes(flood, flood_size);
+        status = native_syscall_net_tcp_writev("sys.net.tcp.writev", writev_args, 3U, &result);
+        g_native_active_vm = NULL;
+        free(flood);
+        CHECK(status == AIVM_SYSCALL_OK);
+        CHECK(result.type == AIVM_VAL_INT);
+        CHECK(result.int_value == -1);
+    }
+
     one_arg[0] = aivm_value_int(connection);
     status = native_syscall_net_tcp_close("sys.net.tcp.close", one_arg, 1U, &result);
     CHECK(status == AIVM_SYSCALL_OK);
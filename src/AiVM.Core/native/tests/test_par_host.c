@@ -0,0 +1,232 @@
+#define AIRUN_ALLOW_INTERNAL_UI_FALLBACK 1
+#define main airun_embedded_main_for_test
+#include "../../../AiCLI/native/airun.c"
+#undef main
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAIL line %d\n", __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+#define PAR_TEST_BRANCHES 24U
+
+static AivmInstruction g_instructions[128];
+
+static size_t emit(size_t ip, AivmOpcode opcode, int64_t operand)
+{
+    g_instructions[ip].opcode = opcode;
+    g_instructions[ip].operand_int = operand;
+    return ip + 1U;
+}
+
+static int g_par_test_writes = 0;
+
+static int host_count_write(const char* target, const AivmValue* args, size_t arg_count, AivmValue* result)
+{
+    (void)target;
+    (void)args;
+    (void)arg_count;
+    g_par_test_writes += 1;
+    *result = aivm_value_void();
+    return AIVM_SYSCALL_OK;
+}
+
+int main(void)
+{
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "req" },
+        { .type = AIVM_VAL_STRING, .string_value = ":ok" }
+    };
+    AivmProgram program;
+    AivmVm* vm = (AivmVm*)malloc(sizeof(AivmVm));
+    AivmVm* scratch_vm = (AivmVm*)malloc(sizeof(AivmVm));
+    const AivmNodeRecord* block_node;
+    AivmParBranch branch;
+    AivmValue out;
+    size_t ip = 0U;
+    size_t double_ip;
+    size_t tag_ip;
+    size_t box_ip;
+    size_t scratch_node_count;
+    size_t scratch_string_used;
+    size_t i;
+
+    CHECK(vm != NULL && scratch_vm != NULL);
+#ifdef _WIN32
+    CHECK(_putenv_s("AIRUN_WORKER_THREADS", "4") == 0);
+#else
+    CHECK(setenv("AIRUN_WORKER_THREADS", "4", 1) == 0);
+#endif
+
+    /* Branches cycle through doubling their index with a busy loop, tagging a string,
+     * and boxing their index in a node tree. */
+    double_ip = 4U + (PAR_TEST_BRANCHES * 3U) + 2U;
+    tag_ip = double_ip + 12U;
+    box_ip = tag_ip + 9U;
+    ip = emit(ip, AIVM_OP_PAR_BEGIN, (int64_t)PAR_TEST_BRANCHES);
+    for (i = 0U; i < PAR_TEST_BRANCHES; i += 1U) {
+        if ((i % 3U) == 0U) {
+            ip = emit(ip, AIVM_OP_PUSH_INT, (int64_t)i);
+            ip = emit(ip, AIVM_OP_ASYNC_CALL, (int64_t)double_ip);
+        } else if ((i % 3U) == 1U) {
+            ip = emit(ip, AIVM_OP_CONST, 0);
+            ip = emit(ip, AIVM_OP_ASYNC_CALL, (int64_t)tag_ip);
+        } else {
+            ip = emit(ip, AIVM_OP_PUSH_INT, (int64_t)i);
+            ip = emit(ip, AIVM_OP_ASYNC_CALL, (int64_t)box_ip);
+        }
+        ip = emit(ip, AIVM_OP_PAR_FORK, 0);
+    }
+    ip = emit(ip, AIVM_OP_PAR_JOIN, (int64_t)PAR_TEST_BRANCHES);
+    ip = emit(ip, AIVM_OP_HALT, 0);
+    while (ip < double_ip) {
+        ip = emit(ip, AIVM_OP_NOP, 0);
+    }
+    /* double(n): counter = 2000; loop { counter += -1; if counter == 0 break }; return n + n */
+    ip = emit(ip, AIVM_OP_STORE_LOCAL, 0);
+    ip = emit(ip, AIVM_OP_PUSH_INT, 2000);
+    ip = emit(ip, AIVM_OP_STORE_LOCAL, 1);
+    ip = emit(ip, AIVM_OP_LOAD_LOCAL, 1);
+    ip = emit(ip, AIVM_OP_PUSH_INT, -1);
+    ip = emit(ip, AIVM_OP_ADD_INT, 0);
+    ip = emit(ip, AIVM_OP_STORE_LOCAL, 1);
+    ip = emit(ip, AIVM_OP_LOAD_LOCAL, 1);
+    ip = emit(ip, AIVM_OP_PUSH_INT, 0);
+    ip = emit(ip, AIVM_OP_EQ_INT, 0);
+    ip = emit(ip, AIVM_OP_JUMP_IF_FALSE, (int64_t)(double_ip + 3U));
+    ip = emit(ip, AIVM_OP_JUMP, (int64_t)(tag_ip + 5U));
+    CHECK(ip == tag_ip);
+    ip = emit(ip, AIVM_OP_STORE_LOCAL, 0);
+    ip = emit(ip, AIVM_OP_LOAD_LOCAL, 0);
+    ip = emit(ip, AIVM_OP_CONST, 1);
+    ip = emit(ip, AIVM_OP_STR_CONCAT, 0);
+    ip = emit(ip, AIVM_OP_RET, 0);
+    ip = emit(ip, AIVM_OP_LOAD_LOCAL, 0);
+    ip = emit(ip, AIVM_OP_LOAD_LOCAL, 0);
+    ip = emit(ip, AIVM_OP_ADD_INT, 0);
+    ip = emit(ip, AIVM_OP_RET, 0);
+    /* box(n): Block#req { lit lit } where both children share one Lit#req(value=n). */
+    CHECK(ip == box_ip);
+    ip = emit(ip, AIVM_OP_STORE_LOCAL, 0);
+    ip = emit(ip, AIVM_OP_CONST, 0);
+    ip = emit(ip, AIVM_OP_MAKE_BLOCK, 0);
+    ip = emit(ip, AIVM_OP_CONST, 0);
+    ip = emit(ip, AIVM_OP_LOAD_LOCAL, 0);
+    ip = emit(ip, AIVM_OP_MAKE_LIT_INT, 0);
+    ip = emit(ip, AIVM_OP_STORE_LOCAL, 1);
+    ip = emit(ip, AIVM_OP_LOAD_LOCAL, 1);
+    ip = emit(ip, AIVM_OP_APPEND_CHILD, 0);
+    ip = emit(ip, AIVM_OP_LOAD_LOCAL, 1);
+    ip = emit(ip, AIVM_OP_APPEND_CHILD, 0);
+    ip = emit(ip, AIVM_OP_RET, 0);
+
+    aivm_program_init(&program, g_instructions, ip);
+    program.constants = constants;
+    program.constant_count = 2U;
+
+    /* Every result kind finishes on the scratch VM; a node result is copied out of it. */
+    aivm_init(scratch_vm, &program);
+    memset(&branch, 0, sizeof(branch));
+    branch.target = tag_ip;
+    branch.args[0] = constants[0];
+    branch.arg_count = 1U;
+    CHECK(aivm_par_branch_execute(&program, &branch, scratch_vm) == 1);
+    CHECK(branch.status == AIVM_PAR_BRANCH_DONE && strcmp(branch.result_text, "req:ok") == 0);
+    aivm_par_branch_release(&branch);
+    CHECK(branch.result_text == NULL);
+    branch.target = box_ip;
+    branch.args[0] = aivm_value_int(5);
+    CHECK(aivm_par_branch_execute(&program, &branch, scratch_vm) == 1);
+    CHECK(branch.status == AIVM_PAR_BRANCH_DONE && branch.result_tree != NULL);
+    aivm_par_branch_release(&branch);
+    CHECK(branch.result_tree == NULL);
+    /* The reused scratch VM rewinds instead of piling up the previous branch's nodes. */
+    scratch_node_count = scratch_vm->node_count;
+    scratch_string_used = scratch_vm->string_arena_used;
+    CHECK(aivm_par_branch_execute(&program, &branch, scratch_vm) == 1);
+    CHECK(branch.status == AIVM_PAR_BRANCH_DONE && branch.result_tree != NULL);
+    aivm_par_branch_release(&branch);
+    CHECK(scratch_vm->node_count == scratch_node_count);
+    CHECK(scratch_vm->string_arena_used == scratch_string_used);
+    CHECK(scratch_vm->process_argv_node_handle == 1);
+
+    /* Two rounds reuse the helper threads started by the first join. */
+    for (i = 0U; i < 2U; i += 1U) {
+        size_t child_index;
+        aivm_init(vm, &program);
+        aivm_set_par_executor(vm, native_par_execute, NULL);
+        aivm_run(vm);
+        CHECK(vm->status == AIVM_VM_STATUS_HALTED);
+        CHECK(vm->par_branch_count == 0U);
+        CHECK(vm->par_purity_count == 3U);
+        CHECK(aivm_stack_pop(vm, &out) == 1 && out.type == AIVM_VAL_NODE);
+        block_node = &vm->nodes[(size_t)(out.node_handle - 1)];
+        CHECK(block_node->child_count == PAR_TEST_BRANCHES);
+        for (child_index = 0U; child_index < PAR_TEST_BRANCHES; child_index += 1U) {
+            const AivmNodeRecord* child = &vm->nodes[(size_t)(vm->node_children[block_node->child_start + child_index] - 1)];
+            const AivmNodeAttr* attr = &vm->node_attrs[child->attr_start];
+            if ((child_index % 3U) == 0U) {
+                CHECK(attr->kind == AIVM_NODE_ATTR_INT && attr->int_value == (int64_t)(child_index * 2U));
+            } else if ((child_index % 3U) == 1U) {
+                CHECK(attr->kind == AIVM_NODE_ATTR_STRING && strcmp(attr->string_value, "req:ok") == 0);
+            } else {
+                const AivmNodeRecord* lit;
+                CHECK(strcmp(child->kind, "Block") == 0 && strcmp(child->id, "req") == 0);
+                CHECK(child->child_count == 2U);
+                CHECK(vm->node_children[child->child_start] == vm->node_children[child->child_start + 1U]);
+                lit = &vm->nodes[(size_t)(vm->node_children[child->child_start] - 1)];
+                attr = &vm->node_attrs[lit->attr_start];
+                CHECK(strcmp(lit->kind, "Lit") == 0 && lit->attr_count == 1U);
+                CHECK(attr->kind == AIVM_NODE_ATTR_INT && attr->int_value == (int64_t)child_index);
+            }
+        }
+    }
+    CHECK(g_native_par_pool.thread_count == 3U);
+
+    {
+        /* The first branch fails; its error must stop the program before the write that
+         * follows its fork, exactly as running it inline would. */
+        static const AivmSyscallBinding bindings[] = {
+            { "sys.stdout.writeLine", host_count_write }
+        };
+        static const AivmValue fail_constants[] = {
+            { .type = AIVM_VAL_STRING, .string_value = "req" },
+            { .type = AIVM_VAL_STRING, .string_value = "sys.stdout.writeLine" }
+        };
+        ip = 0U;
+        ip = emit(ip, AIVM_OP_PAR_BEGIN, 2);
+        ip = emit(ip, AIVM_OP_PUSH_INT, 1);
+        ip = emit(ip, AIVM_OP_ASYNC_CALL, 10);
+        ip = emit(ip, AIVM_OP_PAR_FORK, 0);
+        ip = emit(ip, AIVM_OP_CONST, 1);
+        ip = emit(ip, AIVM_OP_CONST, 0);
+        ip = emit(ip, AIVM_OP_CALL_SYS, 1);
+        ip = emit(ip, AIVM_OP_PAR_FORK, 0);
+        ip = emit(ip, AIVM_OP_PAR_JOIN, 2);
+        ip = emit(ip, AIVM_OP_HALT, 0);
+        /* fail(n): n + "req" */
+        ip = emit(ip, AIVM_OP_STORE_LOCAL, 0);
+        ip = emit(ip, AIVM_OP_LOAD_LOCAL, 0);
+        ip = emit(ip, AIVM_OP_CONST, 0);
+        ip = emit(ip, AIVM_OP_ADD_INT, 0);
+        ip = emit(ip, AIVM_OP_RET, 0);
+        aivm_program_init(&program, g_instructions, ip);
+        program.constants = fail_constants;
+        program.constant_count = 2U;
+        aivm_init_with_syscalls(vm, &program, bindings, 1U);
+        aivm_set_par_executor(vm, native_par_execute, NULL);
+        aivm_run(vm);
+        CHECK(vm->status == AIVM_VM_STATUS_ERROR);
+        CHECK(vm->error == AIVM_VM_ERR_TYPE_MISMATCH);
+        CHECK(g_par_test_writes == 0);
+    }
+
+    native_par_reset();
+    CHECK(!g_native_par_pool.initialized);
+    free(scratch_vm);
+    free(vm);
+    return 0;
+}
@@ -203,7 +203,7 @@ static int interleaved_fail_and_cancel_cleanup_stress(void)
 #ifdef _WIN32
     int interleave_iterations = 2;
 #else
-    int interleave_iterations = (int)(NATIVE_PROCESS_CAPACITY / 4);
+    int interleave_iterations = (int)(NATIVE_PROCESS_INITIAL_CAPACITY / 4);
 #endif
 #ifndef _WIN32
     if (interleave_iterations < 8) {
@@ -377,13 +377,236 @@ static int wait_drains_child_output_without_deadlock(void)
     return 0;
 }
 
+#ifndef _WIN32
+static int spawn_shell(AivmVm* vm, AivmProgram* program, const char* script, int64_t* handle)
+{
+    const char* argv_values[2];
+    AivmValue spawn_args[4];
+    AivmValue result;
+
+    argv_values[0] = "-c";
+    argv_values[1] = script;
+    aivm_program_clear(program);
+    aivm_init_with_syscalls_and_argv(vm, program, NULL, 0U, argv_values, 2U);
+    g_native_active_vm = vm;
+    spawn_args[0] = aivm_value_string("/bin/sh");
+    spawn_args[1] = aivm_value_node(vm->process_argv_node_handle);
+    spawn_args[2] = aivm_value_string("");
+    spawn_args[3] = aivm_value_node(0);
+    if (native_syscall_process_spawn("sys.process.spawn", spawn_args, 4U, &result) != AIVM_SYSCALL_OK ||
+        result.type != AIVM_VAL_INT || result.int_value <= 0) {
+        return 0;
+    }
+    *handle = result.int_value;
+    return 1;
+}
+
+static int await_op_success(int64_t op)
+{
+    AivmValue args[1];
+    AivmValue result;
+    args[0] = aivm_value_int(op);
+    return native_syscall_net_async_await("sys.net.async.await", args, 1U, &result) == AIVM_SYSCALL_OK &&
+           result.type == AIVM_VAL_INT && result.int_value == 1;
+}
+
+/* Reads stdout through readStart ops until the EOF op returns empty bytes. */
+static int read_stdout_to_eof(int64_t handle, uint8_t* out, size_t out_capacity, size_t* out_len)
+{
+    AivmValue args[2];
+    AivmValue result;
+    size_t total = 0U;
+    for (;;) {
+        int64_t op;
+        args[0] = aivm_value_int(handle);
+        args[1] = aivm_value_int(65536);
+        if (native_syscall_process_read_start("sys.process.stdout.readStart", args, 2U, &result) != AIVM_SYSCALL_OK ||
+            result.type != AIVM_VAL_INT || result.int_value <= 0) {
+            return 0;
+        }
+        op = result.int_value;
+        if (!await_op_success(op)) {
+            return 0;
+        }
+        args[0] = aivm_value_int(op);
+        if (native_syscall_net_async_result_bytes("sys.net.async.resultBytes", args, 1U, &result) != AIVM_SYSCALL_OK ||
+            result.type != AIVM_VAL_BYTES) {
+            return 0;
+        }
+        if (result.bytes_value.length == 0U) {
+            break;
+        }
+        if (out != NULL && total + result.bytes_value.length <= out_capacity) {
+            memcpy(out + total, result.bytes_value.data, result.bytes_value.length);
+        }
+        total += result.bytes_value.length;
+    }
+    *out_len = total;
+    return 1;
+}
+
+static int read_start_streams_large_output_to_eof(void)
+{
+    AivmProgram program;
+    AivmVm vm;
+    AivmValue wait_args[1];
+    AivmValue result;
+    int64_t handle;
+    size_t total = 0U;
+
+    CHECK(spawn_shell(&vm, &program, "head -c 1048576 /dev/zero", &handle));
+    CHECK(read_stdout_to_eof(handle, NULL, 0U, &total));
+    CHECK(total == 1048576U);
+
+    wait_args[0] = aivm_value_int(handle);
+    CHECK(native_syscall_process_wait("sys.process.wait", wait_args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_INT && result.int_value == 0);
+
+    g_native_active_vm = NULL;
+    return 0;
+}
+
+static int stdin_write_streams_through_filter(void)
+{
+    static uint8_t payload[262144];
+    static uint8_t echoed[262144];
+    AivmProgram program;
+    AivmVm vm;
+    AivmValue args[2];
+    AivmValue result;
+    int64_t handle;
+    int64_t op;
+    size_t total = 0U;
+    size_t i;
+
+    for (i = 0U; i < sizeof(payload); i += 1U) {
+        payload[i] = (uint8_t)('a' + (i % 26U));
+    }
+    CHECK(spawn_shell(&vm, &program, "cat", &handle));
+
+    /* Larger than a pipe buffer in both directions, so the write only completes if stdout is drained. */
+    args[0] = aivm_value_int(handle);
+    args[1] = aivm_value_bytes(payload, sizeof(payload));
+    CHECK(native_syscall_process_stdin_write("sys.process.stdin.write", args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_INT && result.int_value > 0);
+    op = result.int_value;
+    CHECK(await_op_success(op));
+    args[0] = aivm_value_int(op);
+    CHECK(native_syscall_net_async_result_int("sys.net.async.resultInt", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.int_value == (int64_t)sizeof(payload));
+
+    args[0] = aivm_value_int(handle);
+    CHECK(native_syscall_process_stdin_close("sys.process.stdin.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 1);
+    CHECK(native_syscall_process_stdin_close("sys.process.stdin.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 0);
+
+    CHECK(read_stdout_to_eof(handle, echoed, sizeof(echoed), &total));
+    CHECK(total == sizeof(payload));
+    CHECK(memcmp(echoed, payload, sizeof(payload)) == 0);
+
+    CHECK(native_syscall_process_wait("sys.process.wait", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_INT && result.int_value == 0);
+
+    g_native_active_vm = NULL;
+    return 0;
+}
+
+static int process_table_grows_and_rejects_stale_handles(void)
+{
+    enum { LIVE_COUNT = (int)NATIVE_PROCESS_INITIAL_CAPACITY * 3 };
+    static int64_t handles[LIVE_COUNT];
+    AivmProgram program;
+    AivmVm vm;
+    AivmValue args[1];
+    AivmValue result;
+    int64_t reused;
+    int i;
+
+    /* More live children than the initial table holds; none may be refused. */
+    for (i = 0; i < LIVE_COUNT; i += 1) {
+        CHECK(spawn_shell(&vm, &program, "read line", &handles[i]));
+    }
+    for (i = 0; i < LIVE_COUNT; i += 1) {
+        CHECK(native_process_lookup(handles[i]) != NULL);
+        args[0] = aivm_value_int(handles[i]);
+        CHECK(native_syscall_process_stdin_close("sys.process.stdin.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    }
+    for (i = 0; i < LIVE_COUNT; i += 1) {
+        args[0] = aivm_value_int(handles[i]);
+        CHECK(native_syscall_process_wait("sys.process.wait", args, 1U, &result) == AIVM_SYSCALL_OK);
+        CHECK(result.type == AIVM_VAL_INT && result.int_value != -1);
+    }
+
+    /* A recycled slot hands out a new handle, and the old one no longer resolves. */
+    CHECK(spawn_shell(&vm, &program, "exit 3", &reused));
+    CHECK(reused != handles[0] && reused != handles[LIVE_COUNT - 1]);
+    CHECK(native_process_lookup(handles[0]) == NULL);
+    args[0] = aivm_value_int(handles[0]);
+    CHECK(native_syscall_process_kill("sys.process.kill", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 0);
+    args[0] = aivm_value_int(reused);
+    CHECK(native_syscall_process_wait("sys.process.wait", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_INT && result.int_value == 3);
+
+    g_native_active_vm = NULL;
+    return 0;
+}
+
+static int spawn_honors_cwd_and_keeps_pipes_private(void)
+{
+    AivmProgram program;
+    AivmVm vm;
+    const char* argv_values[1];
+    AivmValue spawn_args[4];
+    AivmValue args[1];
+    AivmValue result;
+    int64_t first;
+    int64_t second;
+    uint8_t output[64];
+    size_t output_len = 0U;
+
+    argv_values[0] = "";
+    aivm_program_clear(&program);
+    aivm_init_with_syscalls_and_argv(&vm, &program, NULL, 0U, argv_values, 0U);
+    g_native_active_vm = &vm;
+    spawn_args[0] = aivm_value_string("pwd");
+    spawn_args[1] = aivm_value_node(vm.process_argv_node_handle);
+    spawn_args[2] = aivm_value_string("/");
+    spawn_args[3] = aivm_value_node(0);
+    CHECK(native_syscall_process_spawn("sys.process.spawn", spawn_args, 4U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_INT && result.int_value > 0);
+    first = result.int_value;
+    CHECK(read_stdout_to_eof(first, output, sizeof(output), &output_len));
+    CHECK(output_len == 2U && memcmp(output, "/\n", 2U) == 0);
+    args[0] = aivm_value_int(first);
+    CHECK(native_syscall_process_wait("sys.process.wait", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_INT && result.int_value == 0);
+
+    /* If the second child inherited the first one's stdin write end, the first would never see EOF. */
+    CHECK(spawn_shell(&vm, &program, "cat", &first));
+    CHECK(spawn_shell(&vm, &program, "cat", &second));
+    args[0] = aivm_value_int(first);
+    CHECK(native_syscall_process_stdin_close("sys.process.stdin.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(native_syscall_process_wait("sys.process.wait", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_INT && result.int_value == 0);
+    args[0] = aivm_value_int(second);
+    CHECK(native_syscall_process_stdin_close("sys.process.stdin.close", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(native_syscall_process_wait("sys.process.wait", args, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_INT && result.int_value == 0);
+
+    g_native_active_vm = NULL;
+    return 0;
+}
+#endif
+
 int main(void)
 {
     int i;
 #ifdef _WIN32
     int lifecycle_iterations = 4;
 #else
-    int lifecycle_iterations = (int)NATIVE_PROCESS_CAPACITY * 2;
+    int lifecycle_iterations = (int)NATIVE_PROCESS_INITIAL_CAPACITY * 2;
 #endif
     for (i = 0; i < lifecycle_iterations; i += 1) {
         if (spawn_and_wait_zero_exit() != 0) {
@@ -409,6 +632,20 @@ int main(void)
     if (wait_drains_child_output_without_deadlock() != 0) {
         return 1;
     }
+#ifndef _WIN32
+    if (read_start_streams_large_output_to_eof() != 0) {
+        return 1;
+    }
+    if (stdin_write_streams_through_filter() != 0) {
+        return 1;
+    }
+    if (process_table_grows_and_rejects_stale_handles() != 0) {
+        return 1;
+    }
+    if (spawn_honors_cwd_and_keeps_pipes_private() != 0) {
+        return 1;
+    }
+#endif
 
     return 0;
 }
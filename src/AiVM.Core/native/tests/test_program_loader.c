@@ -1,4 +1,6 @@
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "aivm_program.h"
 
@@ -7,6 +9,160 @@ static int expect(int condition)
     return condition ? 0 : 1;
 }
 
+static void put_u32_le(uint8_t* bytes, size_t offset, uint32_t value)
+{
+    bytes[offset] = (uint8_t)(value & 0xffU);
+    bytes[offset + 1U] = (uint8_t)((value >> 8U) & 0xffU);
+    bytes[offset + 2U] = (uint8_t)((value >> 16U) & 0xffU);
+    bytes[offset + 3U] = (uint8_t)((value >> 24U) & 0xffU);
+}
+
+/* Program storage is sized from the file, so images beyond the old fixed caps load. */
+static int test_large_program_storage(void)
+{
+    enum { INSTRUCTIONS = 40000, CONSTANTS = 3000, STRING_LENGTH = 15 };
+    size_t instruction_payload = 4U + (size_t)INSTRUCTIONS * 12U;
+    size_t constant_payload = 4U + (size_t)CONSTANTS * (1U + 4U + STRING_LENGTH);
+    size_t total = 16U + 8U + instruction_payload + 8U + constant_payload;
+    uint8_t* bytes = (uint8_t*)calloc(total, 1U);
+    AivmProgram program;
+    AivmProgramLoadResult result;
+    size_t cursor;
+    size_t i;
+    int failed = 0;
+
+    if (bytes == NULL) {
+        return 1;
+    }
+    memcpy(bytes, "AIBC", 4U);
+    put_u32_le(bytes, 4U, 2U);
+    put_u32_le(bytes, 12U, 2U);
+    put_u32_le(bytes, 16U, AIVM_PROGRAM_SECTION_INSTRUCTIONS);
+    put_u32_le(bytes, 20U, (uint32_t)instruction_payload);
+    put_u32_le(bytes, 24U, INSTRUCTIONS);
+    cursor = 28U;
+    for (i = 0U; i < INSTRUCTIONS; i += 1U) {
+        put_u32_le(bytes, cursor, (i + 1U == INSTRUCTIONS) ? (uint32_t)AIVM_OP_HALT : (uint32_t)AIVM_OP_NOP);
+        cursor += 12U;
+    }
+    put_u32_le(bytes, cursor, AIVM_PROGRAM_SECTION_CONSTANTS);
+    put_u32_le(bytes, cursor + 4U, (uint32_t)constant_payload);
+    put_u32_le(bytes, cursor + 8U, CONSTANTS);
+    cursor += 12U;
+    for (i = 0U; i < CONSTANTS; i += 1U) {
+        bytes[cursor] = 3U;
+        put_u32_le(bytes, cursor + 1U, STRING_LENGTH);
+        memset(&bytes[cursor + 5U], 'a' + (int)(i % 26U), STRING_LENGTH);
+        cursor += 5U + STRING_LENGTH;
+    }
+
+    result = aivm_program_load_aibc1(bytes, total, &program);
+    failed |= expect(result.status == AIVM_PROGRAM_OK);
+    failed |= expect(program.instruction_count == INSTRUCTIONS);
+    failed |= expect(program.instructions[INSTRUCTIONS - 1].opcode == AIVM_OP_HALT);
+    failed |= expect(program.constant_count == CONSTANTS);
+    failed |= expect(program.string_storage_used == (size_t)CONSTANTS * (STRING_LENGTH + 1U));
+    for (i = 0U; i < CONSTANTS && failed == 0; i += 1U) {
+        const char* text = program.constants[i].string_value;
+        failed |= expect(strlen(text) == STRING_LENGTH && text[0] == (char)('a' + (int)(i % 26U)));
+    }
+    aivm_program_free(&program);
+    failed |= expect(program.instruction_storage == NULL && program.instruction_count == 0U);
+
+    /* A constant count the section cannot hold is rejected before allocating, and the
+       instructions already loaded are released with the failure. */
+    put_u32_le(bytes, 28U + (size_t)INSTRUCTIONS * 12U + 8U, 0xffffffffU);
+    result = aivm_program_load_aibc1(bytes, total, &program);
+    failed |= expect(result.status == AIVM_PROGRAM_ERR_CONSTANT_LIMIT);
+    failed |= expect(program.instruction_storage == NULL && program.instruction_count == 0U);
+    free(bytes);
+    return failed;
+}
+
+/* Growing string storage rebases constants that already point into it. */
+static int test_reserve_rebases_constants(void)
+{
+    AivmProgram program;
+    int failed = 0;
+    aivm_program_init(&program, NULL, 0U);
+    failed |= expect(aivm_program_reserve_constants(&program, 2U));
+    failed |= expect(program.constants == program.constant_storage);
+    failed |= expect(aivm_program_reserve_string_bytes(&program, 4U));
+    memcpy(program.string_storage, "abc", 4U);
+    program.string_storage_used = 4U;
+    program.constant_storage[0] = aivm_value_string(program.string_storage);
+    program.constant_storage[1] = aivm_value_string("static");
+    program.constant_count = 2U;
+    failed |= expect(aivm_program_reserve_string_bytes(&program, 100000U));
+    failed |= expect(program.string_storage_capacity >= 100000U);
+    failed |= expect(program.constants[0].string_value == program.string_storage);
+    failed |= expect(strcmp(program.constants[0].string_value, "abc") == 0);
+    failed |= expect(strcmp(program.constants[1].string_value, "static") == 0);
+    failed |= expect(aivm_program_reserve_instructions(&program, 20000U));
+    failed |= expect(program.instructions == program.instruction_storage && program.instruction_capacity >= 20000U);
+    aivm_program_free(&program);
+    return failed;
+}
+
+/* The function-name section loads into a sorted table that maps any ip to its function. */
+static int test_function_names(void)
+{
+    static const uint8_t names_program[] = {
+        'A', 'I', 'B', 'C',
+        0x02, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x00,
+        0x1c, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x01, 0x00, 0x00, 0x00, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x05, 0x00, 0x00, 0x00,
+        0x1a, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 'a', 'd', 'd',
+        0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 'r', 'u', 'n'
+    };
+    uint8_t truncated[sizeof(names_program)];
+    AivmProgram program;
+    AivmProgramLoadResult result;
+    size_t index = 99U;
+    int failed = 0;
+
+    result = aivm_program_load_aibc1(names_program, sizeof(names_program), &program);
+    failed |= expect(result.status == AIVM_PROGRAM_OK);
+    failed |= expect(program.instruction_count == 2U && program.function_name_count == 2U);
+    failed |= expect(aivm_program_function_index_at(&program, 0U, &index) && index == 0U);
+    failed |= expect(strcmp(program.function_names[0].name, "run") == 0);
+    failed |= expect(aivm_program_function_index_at(&program, 7U, &index) && index == 1U);
+    failed |= expect(strcmp(program.function_names[1].name, "add") == 0);
+
+    /* Re-adding an entry renames it; new entries keep the table sorted. */
+    failed |= expect(aivm_program_add_function_name(&program, 1U, "sum"));
+    failed |= expect(aivm_program_add_function_name(&program, 0U, "[bootstrap]"));
+    failed |= expect(program.function_name_count == 2U && strcmp(program.function_names[1].name, "sum") == 0);
+    failed |= expect(aivm_program_add_function_name(&program, 5U, "tail"));
+    failed |= expect(aivm_program_function_index_at(&program, 4U, &index) && index == 1U);
+    failed |= expect(aivm_program_function_index_at(&program, 5U, &index) && index == 2U);
+    aivm_program_free(&program);
+    failed |= expect(program.function_names == NULL && program.function_name_count == 0U);
+    failed |= expect(!aivm_program_function_index_at(&program, 0U, &index));
+
+    /* A freed program loads again without keeping edits from its previous life. */
+    result = aivm_program_load_aibc1(names_program, sizeof(names_program), &program);
+    failed |= expect(result.status == AIVM_PROGRAM_OK && program.function_name_count == 2U);
+    failed |= expect(strcmp(program.function_names[1].name, "add") == 0);
+    aivm_program_free(&program);
+
+    /* A name running past its section is rejected. */
+    memcpy(truncated, names_program, sizeof(truncated));
+    put_u32_le(truncated, 68U, 0x40U);
+    result = aivm_program_load_aibc1(truncated, sizeof(truncated), &program);
+    failed |= expect(result.status == AIVM_PROGRAM_ERR_INVALID_SECTION);
+    failed |= expect(program.instruction_storage == NULL && program.function_names == NULL);
+    return failed;
+}
+
 int main(void)
 {
     AivmProgram program;
@@ -116,6 +272,52 @@ int main(void)
         1, 0, 0, 0,   /* constant count */
         6             /* null */
     };
+    static const union {
+        uint8_t bytes[85];
+        uint64_t align;
+    } aligned_program = { {
+        'A', 'I', 'B', 'C',
+        2, 0, 0, 0,
+        0, 0, 0, 0,
+        2, 0, 0, 0,
+        3, 0, 0, 0,   /* section type: aligned instructions */
+        40, 0, 0, 0,  /* section size */
+        2, 0, 0, 0,   /* instruction_count */
+        8, 0, 0, 0,   /* record offset (file offset 32) */
+        3, 0, 0, 0, 0, 0, 0, 0,   /* PUSH_INT */
+        42, 0, 0, 0, 0, 0, 0, 0,
+        1, 0, 0, 0, 0, 0, 0, 0,   /* HALT */
+        0, 0, 0, 0, 0, 0, 0, 0,
+        4, 0, 0, 0,   /* section type: aligned constants */
+        13, 0, 0, 0,  /* section size */
+        1, 0, 0, 0,   /* constant_count */
+        3,            /* string */
+        3, 0, 0, 0,
+        'f', 'o', 'o', 0
+    } };
+    static const uint8_t aligned_records_misaligned[44] = {
+        'A', 'I', 'B', 'C',
+        2, 0, 0, 0,
+        0, 0, 0, 0,
+        1, 0, 0, 0,
+        3, 0, 0, 0,   /* section type: aligned instructions */
+        12, 0, 0, 0,  /* section size */
+        0, 0, 0, 0,   /* instruction_count */
+        12, 0, 0, 0,  /* record offset (file offset 36) */
+        0, 0, 0, 0
+    };
+    static const uint8_t aligned_string_missing_nul[36] = {
+        'A', 'I', 'B', 'C',
+        2, 0, 0, 0,
+        0, 0, 0, 0,
+        1, 0, 0, 0,
+        4, 0, 0, 0,   /* section type: aligned constants */
+        12, 0, 0, 0,  /* section size */
+        1, 0, 0, 0,   /* constant_count */
+        3,            /* string */
+        3, 0, 0, 0,
+        'f', 'o', 'o'
+    };
     static const uint8_t section_limit_exceeded[16] = {
         'A', 'I', 'B', 'C',
         2, 0, 0, 0,
@@ -213,6 +415,7 @@ int main(void)
         return 1;
     }
 
+    aivm_program_free(&program);
     result = aivm_program_load_aibc1(valid_header, 16U, &program);
     if (expect(result.status == AIVM_PROGRAM_OK) != 0) {
         return 1;
@@ -242,6 +445,7 @@ int main(void)
         return 1;
     }
 
+    aivm_program_free(&program);
     result = aivm_program_load_aibc1(instruction_section_valid, 56U, &program);
     if (expect(result.status == AIVM_PROGRAM_OK) != 0) {
         return 1;
@@ -262,6 +466,7 @@ int main(void)
         return 1;
     }
 
+    aivm_program_free(&program);
     result = aivm_program_load_aibc1(instruction_section_bad_size, 44U, &program);
     if (expect(result.status == AIVM_PROGRAM_ERR_INVALID_SECTION) != 0) {
         return 1;
@@ -301,6 +506,7 @@ int main(void)
         return 1;
     }
 
+    aivm_program_free(&program);
     result = aivm_program_load_aibc1(constants_section_invalid_kind, 29U, &program);
     if (expect(result.status == AIVM_PROGRAM_ERR_INVALID_CONSTANT) != 0) {
         return 1;
@@ -338,6 +544,7 @@ int main(void)
         return 1;
     }
 
+    aivm_program_free(&program);
     result = aivm_program_load_aibc1(constants_section_with_null, sizeof(constants_section_with_null), &program);
     if (expect(result.status == AIVM_PROGRAM_OK) != 0) {
         return 1;
@@ -349,5 +556,88 @@ int main(void)
         return 1;
     }
 
+    aivm_program_free(&program);
+    result = aivm_program_load_aibc1(aligned_program.bytes, sizeof(aligned_program.bytes), &program);
+    if (expect(result.status == AIVM_PROGRAM_OK) != 0) {
+        return 1;
+    }
+    if (expect(program.instructions == program.instruction_storage) != 0) {
+        return 1;
+    }
+    if (expect(program.instruction_count == 2U) != 0) {
+        return 1;
+    }
+    if (expect(program.instructions[0].opcode == AIVM_OP_PUSH_INT && program.instructions[0].operand_int == 42) != 0) {
+        return 1;
+    }
+    if (expect(program.instructions[1].opcode == AIVM_OP_HALT) != 0) {
+        return 1;
+    }
+    if (expect(program.constant_count == 1U && program.constants[0].type == AIVM_VAL_STRING) != 0) {
+        return 1;
+    }
+    if (expect(program.constants[0].string_value == program.string_storage) != 0) {
+        return 1;
+    }
+
+    /* Borrowed loads reference aligned sections in place instead of copying them. */
+    aivm_program_free(&program);
+    result = aivm_program_load_aibc1_borrowed(aligned_program.bytes, sizeof(aligned_program.bytes), &program);
+    if (expect(result.status == AIVM_PROGRAM_OK) != 0) {
+        return 1;
+    }
+    if (aivm_program_host_layout_matches_aligned()) {
+        if (expect(program.instructions == (const AivmInstruction*)(const void*)&aligned_program.bytes[32]) != 0) {
+            return 1;
+        }
+    }
+    if (expect(program.instruction_count == 2U) != 0) {
+        return 1;
+    }
+    if (expect(program.instructions[0].opcode == AIVM_OP_PUSH_INT && program.instructions[0].operand_int == 42) != 0) {
+        return 1;
+    }
+    if (expect(program.constants[0].string_value == (const char*)&aligned_program.bytes[81]) != 0) {
+        return 1;
+    }
+    if (expect(program.constants[0].string_value[0] == 'f' && program.constants[0].string_value[3] == '\0') != 0) {
+        return 1;
+    }
+    if (expect(program.string_storage_used == 0U) != 0) {
+        return 1;
+    }
+
+    /* Borrowed loads of the legacy layout still copy. */
+    aivm_program_free(&program);
+    result = aivm_program_load_aibc1_borrowed(instruction_section_valid, 56U, &program);
+    if (expect(result.status == AIVM_PROGRAM_OK) != 0) {
+        return 1;
+    }
+    if (expect(program.instructions == program.instruction_storage && program.instruction_count == 2U) != 0) {
+        return 1;
+    }
+
+    aivm_program_free(&program);
+    result = aivm_program_load_aibc1_borrowed(aligned_records_misaligned, sizeof(aligned_records_misaligned), &program);
+    if (expect(result.status == AIVM_PROGRAM_ERR_INVALID_SECTION) != 0) {
+        return 1;
+    }
+
+    result = aivm_program_load_aibc1_borrowed(aligned_string_missing_nul, sizeof(aligned_string_missing_nul), &program);
+    if (expect(result.status == AIVM_PROGRAM_ERR_INVALID_SECTION) != 0) {
+        return 1;
+    }
+    aivm_program_free(&program);
+
+    if (test_large_program_storage() != 0) {
+        return 1;
+    }
+    if (test_reserve_rebases_constants() != 0) {
+        return 1;
+    }
+    if (test_function_names() != 0) {
+        return 1;
+    }
+
     return 0;
 }
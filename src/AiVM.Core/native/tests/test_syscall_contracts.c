@@ -35,7 +35,12 @@ int main(void)
     AivmValue two_bytes_args[2];
     AivmValue str_pair_args[2];
     AivmValue process_spawn_args[4];
+    AivmValue process_write_args[2];
+    AivmValue fs_handle_args[3];
     AivmValue image_decode_args[2];
+    AivmValue json_node_arg[1];
+    AivmValue http_parse_args[2];
+    AivmValue http_build_args[4];
     const uint8_t raw_bytes[3] = { 0x01U, 0x02U, 0x03U };
 
     draw_rect_args[0] = aivm_value_int(0);
@@ -229,6 +234,15 @@ int main(void)
     if (expect(return_type == AIVM_VAL_STRING) != 0) {
         return 1;
     }
+    if (expect(aivm_syscall_contract_validate("sys.image.decodeToRgba", image_decode_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(153U, image_decode_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_BYTES) != 0) {
+        return 1;
+    }
     int_arg[0] = aivm_value_int(1);
     if (expect(aivm_syscall_contract_validate("sys.time.nowUnixMs", NULL, 0U, &return_type) == AIVM_CONTRACT_OK) != 0) {
         return 1;
@@ -328,6 +342,129 @@ int main(void)
     if (expect(aivm_syscall_contract_validate_id(24U, fs_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
         return 1;
     }
+    if (expect(aivm_syscall_contract_validate("sys.fs.file.append", fs_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(142U, fs_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.fs.file.writeAtomic", fs_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(143U, fs_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_VOID) != 0) {
+        return 1;
+    }
+    fs_write_args[0] = aivm_value_int(1);
+    if (expect(aivm_syscall_contract_validate("sys.fs.writer.write", fs_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(145U, fs_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_BOOL) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.fs.writer.flush", fs_write_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(146U, fs_write_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.fs.writer.close", fs_write_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(147U, fs_write_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.fs.file.append", fs_write_args, 2U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+        return 1;
+    }
+    fs_handle_args[0] = aivm_value_string("p");
+    fs_handle_args[1] = aivm_value_string("r");
+    if (expect(aivm_syscall_contract_validate("sys.fs.file.open", fs_handle_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(135U, fs_handle_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_INT) != 0) {
+        return 1;
+    }
+    fs_handle_args[1] = aivm_value_int(0);
+    fs_handle_args[2] = aivm_value_int(16);
+    if (expect(aivm_syscall_contract_validate("sys.fs.file.readRange", fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(140U, fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_BYTES) != 0) {
+        return 1;
+    }
+    fs_handle_args[2] = aivm_value_string("*.aos");
+    if (expect(aivm_syscall_contract_validate("sys.fs.dir.entries", fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(141U, fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.fs.dir.entries", fs_handle_args, 2U, &return_type) == AIVM_CONTRACT_ERR_ARG_COUNT) != 0) {
+        return 1;
+    }
+    fs_handle_args[1] = aivm_value_string("a");
+    fs_handle_args[2] = aivm_value_int(4096);
+    if (expect(aivm_syscall_contract_validate("sys.fs.writer.open", fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(144U, fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_INT) != 0) {
+        return 1;
+    }
+    fs_handle_args[1] = aivm_value_int(0);
+    fs_handle_args[2] = aivm_value_int(16);
+    fs_handle_args[0] = aivm_value_int(1);
+    if (expect(aivm_syscall_contract_validate("sys.fs.file.readAt", fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(136U, fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_BYTES) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.fs.file.writeAt", fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+        return 1;
+    }
+    fs_handle_args[2] = aivm_value_bytes(raw_bytes, sizeof(raw_bytes));
+    if (expect(aivm_syscall_contract_validate_id(137U, fs_handle_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_INT) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(138U, fs_handle_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_INT) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.fs.file.close", fs_handle_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(139U, fs_handle_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_BOOL) != 0) {
+        return 1;
+    }
     if (expect(aivm_syscall_contract_validate("sys.fs.dir.create", console_write_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
         return 1;
     }
@@ -457,6 +594,31 @@ int main(void)
     if (expect(aivm_syscall_contract_validate("sys.net.tcp.write", net_int_string_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
         return 1;
     }
+    {
+        AivmValue net_writev_args[3];
+        net_writev_args[0] = aivm_value_int(1);
+        net_writev_args[1] = aivm_value_node(1);
+        net_writev_args[2] = aivm_value_bytes(raw_bytes, sizeof(raw_bytes));
+        if (expect(aivm_syscall_contract_validate("sys.net.tcp.writev", net_writev_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(return_type == AIVM_VAL_INT) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate("sys.net.tcp.writev", net_int_string_args, 2U, &return_type) == AIVM_CONTRACT_ERR_ARG_COUNT) != 0) {
+            return 1;
+        }
+        net_writev_args[1] = aivm_value_string("index.html");
+        if (expect(aivm_syscall_contract_validate("sys.net.tcp.sendFile", net_writev_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(return_type == AIVM_VAL_INT) != 0) {
+            return 1;
+        }
+    }
+    if (expect(aivm_syscall_contract_validate("sys.net.tcp.sendFile", net_int_string_args, 2U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+        return 1;
+    }
     if (expect(aivm_syscall_contract_validate("sys.net.tcp.connectTls", net_string_int_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
         return 1;
     }
@@ -701,6 +863,65 @@ int main(void)
     if (expect(aivm_syscall_contract_validate_id(58U, ui_window_id_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
         return 1;
     }
+    {
+        AivmValue ui_batch_args[2];
+        ui_batch_args[0] = aivm_value_int(1);
+        ui_batch_args[1] = aivm_value_node(1);
+        if (expect(aivm_syscall_contract_validate("sys.ui.drawBatch", ui_batch_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(return_type == AIVM_VAL_VOID) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate_id(148U, ui_batch_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate("sys.ui.drawBatch", ui_window_id_arg, 1U, &return_type) == AIVM_CONTRACT_ERR_ARG_COUNT) != 0) {
+            return 1;
+        }
+        ui_batch_args[1] = aivm_value_string("Rect");
+        if (expect(aivm_syscall_contract_validate("sys.ui.drawBatch", ui_batch_args, 2U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+            return 1;
+        }
+    }
+    {
+        AivmValue image_args[4];
+        image_args[0] = aivm_value_int(1);
+        image_args[1] = aivm_value_int(2);
+        image_args[2] = aivm_value_string("AQIDBA==");
+        if (expect(aivm_syscall_contract_validate("sys.image.fromRgbaBase64", image_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(return_type == AIVM_VAL_INT) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate_id(150U, image_args, 3U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate("sys.image.release", image_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(return_type == AIVM_VAL_VOID) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate_id(151U, image_args, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        image_args[2] = aivm_value_int(3);
+        image_args[3] = aivm_value_int(7);
+        if (expect(aivm_syscall_contract_validate("sys.ui.drawImageHandle", image_args, 4U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate_id(152U, image_args, 4U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate("sys.image.decode", image_args, 2U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+            return 1;
+        }
+        if (expect(aivm_syscall_contract_validate_id(149U, image_args, 2U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+            return 1;
+        }
+    }
 
     draw_text_args[0] = aivm_value_int(10);
     draw_text_args[1] = aivm_value_int(20);
@@ -858,6 +1079,107 @@ int main(void)
     if (expect(aivm_syscall_contract_validate_id(118U, console_write_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
         return 1;
     }
+    if (expect(aivm_syscall_contract_validate("sys.json.parse", console_write_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(126U, console_write_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.json.validate", console_write_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(154U, console_write_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    json_node_arg[0] = aivm_value_node(1);
+    if (expect(aivm_syscall_contract_validate("sys.json.encode", json_node_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_STRING) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(127U, json_node_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.json.encode", console_write_arg, 1U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+        return 1;
+    }
+    http_parse_args[0] = aivm_value_bytes(raw_bytes, 3U);
+    http_parse_args[1] = aivm_value_int(0);
+    if (expect(aivm_syscall_contract_validate("sys.http.parseRequest", http_parse_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(128U, http_parse_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(129U, http_parse_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.http.parseResponse", http_parse_args, 1U, &return_type) == AIVM_CONTRACT_ERR_ARG_COUNT) != 0) {
+        return 1;
+    }
+    http_build_args[0] = aivm_value_int(200);
+    http_build_args[1] = aivm_value_string("OK");
+    http_build_args[2] = aivm_value_node(1);
+    http_build_args[3] = aivm_value_bytes(raw_bytes, 3U);
+    if (expect(aivm_syscall_contract_validate("sys.http.buildResponse", http_build_args, 4U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_BYTES) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(130U, http_build_args, 4U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    http_build_args[3] = aivm_value_string("body");
+    if (expect(aivm_syscall_contract_validate("sys.http.buildResponse", http_build_args, 4U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.process.stdout.readStart", net_int_int_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_INT) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(131U, net_int_int_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(132U, net_int_int_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    process_write_args[0] = aivm_value_int(1);
+    process_write_args[1] = aivm_value_bytes(raw_bytes, 3U);
+    if (expect(aivm_syscall_contract_validate("sys.process.stdin.write", process_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_INT) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(133U, process_write_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    process_write_args[1] = aivm_value_string("ping");
+    if (expect(aivm_syscall_contract_validate("sys.process.stdin.write", process_write_args, 2U, &return_type) == AIVM_CONTRACT_ERR_ARG_TYPE) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate("sys.process.stdin.close", int_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(aivm_syscall_contract_validate_id(134U, int_arg, 1U, &return_type) == AIVM_CONTRACT_OK) != 0) {
+        return 1;
+    }
+    if (expect(return_type == AIVM_VAL_BOOL) != 0) {
+        return 1;
+    }
     bytes_int_args[0] = bytes_arg[0];
     bytes_int_args[1] = aivm_value_int(1);
     if (expect(aivm_syscall_contract_validate("sys.bytes.at", bytes_int_args, 2U, &return_type) == AIVM_CONTRACT_OK) != 0) {
@@ -15,6 +15,18 @@ static int g_last_draw_width = 0;
 static int g_last_draw_height = 0;
 static size_t g_last_draw_rgba_length = 0U;
 static uint8_t g_last_draw_rgba[16];
+static int g_frame_retained = 0;
+static int g_begin_frame_calls = 0;
+static int g_region_calls = 0;
+static int g_region_x = 0;
+static int g_region_y = 0;
+static int g_region_width = 0;
+static int g_region_height = 0;
+static int g_shape_draw_calls = 0;
+static char g_last_rect_color[32];
+static int g_cached_image_draws = 0;
+static int64_t g_last_cached_image_id = 0;
+static int g_released_images = 0;
 
 void native_host_ui_reset(void) {}
 void native_host_ui_shutdown(void) {}
@@ -32,7 +44,23 @@ int native_host_ui_create_window(const char* title, int width, int height, int64
 }
 
 int native_host_ui_close_window(int64_t handle) { (void)handle; return 1; }
-int native_host_ui_begin_frame(int64_t handle) { (void)handle; return 1; }
+int native_host_ui_begin_frame(int64_t handle)
+{
+    (void)handle;
+    g_begin_frame_calls += 1;
+    return 1;
+}
+int native_host_ui_frame_retained(int64_t handle) { (void)handle; return g_frame_retained; }
+int native_host_ui_begin_frame_region(int64_t handle, int x, int y, int width, int height)
+{
+    (void)handle;
+    g_region_calls += 1;
+    g_region_x = x;
+    g_region_y = y;
+    g_region_width = width;
+    g_region_height = height;
+    return 1;
+}
 int native_host_ui_end_frame(int64_t handle) { (void)handle; return 1; }
 int native_host_ui_present(int64_t handle) { (void)handle; return 1; }
 int native_host_ui_wait_frame(int64_t handle) { (void)handle; return 1; }
@@ -43,7 +71,8 @@ int native_host_ui_draw_rect(int64_t handle, int x, int y, int width, int height
     (void)y;
     (void)width;
     (void)height;
-    (void)color;
+    g_shape_draw_calls += 1;
+    (void)snprintf(g_last_rect_color, sizeof(g_last_rect_color), "%s", color);
     return 1;
 }
 int native_host_ui_draw_ellipse(int64_t handle, int x, int y, int width, int height, const char* color)
@@ -80,6 +109,30 @@ int native_host_ui_draw_image(
     }
     return 1;
 }
+int native_host_ui_draw_cached_image(
+    int64_t handle,
+    int x,
+    int y,
+    int64_t image_id,
+    const uint8_t* rgba,
+    int width,
+    int height)
+{
+    (void)handle;
+    (void)x;
+    (void)y;
+    (void)rgba;
+    (void)width;
+    (void)height;
+    g_cached_image_draws += 1;
+    g_last_cached_image_id = image_id;
+    return 1;
+}
+void native_host_ui_release_image(int64_t image_id)
+{
+    (void)image_id;
+    g_released_images += 1;
+}
 int native_host_ui_draw_text(int64_t handle, int x, int y, const char* text, const char* color, int font_size)
 {
     (void)handle;
@@ -88,6 +141,7 @@ int native_host_ui_draw_text(int64_t handle, int x, int y, const char* text, con
     (void)text;
     (void)color;
     (void)font_size;
+    g_shape_draw_calls += 1;
     return 1;
 }
 int native_host_ui_draw_line(int64_t handle, int x1, int y1, int x2, int y2, const char* color, int stroke_width)
@@ -142,6 +196,398 @@ int native_host_ui_get_window_size(int64_t handle, int* out_width, int* out_heig
         } \
     } while (0)
 
+static int ui_frame_call(const char* target, int64_t handle)
+{
+    AivmValue args[1];
+    AivmValue result;
+    args[0] = aivm_value_int(handle);
+    return native_syscall_ui_void_1(target, args, 1U, &result);
+}
+
+static int ui_rect(int64_t handle, int x, int y, int width, int height, const char* color)
+{
+    AivmValue args[6];
+    AivmValue result;
+    args[0] = aivm_value_int(handle);
+    args[1] = aivm_value_int(x);
+    args[2] = aivm_value_int(y);
+    args[3] = aivm_value_int(width);
+    args[4] = aivm_value_int(height);
+    args[5] = aivm_value_string(color);
+    return native_syscall_ui_draw_rect("sys.ui.drawRect", args, 6U, &result);
+}
+
+static int ui_text(int64_t handle, int x, int y, const char* text)
+{
+    AivmValue args[6];
+    AivmValue result;
+    args[0] = aivm_value_int(handle);
+    args[1] = aivm_value_int(x);
+    args[2] = aivm_value_int(y);
+    args[3] = aivm_value_string(text);
+    args[4] = aivm_value_string("#000000");
+    args[5] = aivm_value_int(8);
+    return native_syscall_ui_draw_text("sys.ui.drawText", args, 6U, &result);
+}
+
+/* Background, a small swatch at (8,8) and a label in the bottom-right corner. */
+static int ui_scene_frame(int64_t handle, const char* background, const char* swatch)
+{
+    if (ui_frame_call("sys.ui.beginFrame", handle) != AIVM_SYSCALL_OK ||
+        ui_rect(handle, 0, 0, 64, 64, background) != AIVM_SYSCALL_OK ||
+        ui_rect(handle, 8, 8, 6, 6, swatch) != AIVM_SYSCALL_OK ||
+        ui_text(handle, 48, 60, "ok") != AIVM_SYSCALL_OK ||
+        ui_frame_call("sys.ui.endFrame", handle) != AIVM_SYSCALL_OK) {
+        return 0;
+    }
+    return 1;
+}
+
+static int64_t ui_attr_node(AivmVm* vm, const char* kind, const AivmNodeAttr* attrs, size_t attr_count)
+{
+    int64_t handle = 0;
+    return aivm_node_create(vm, kind, "batch_item", attrs, attr_count, NULL, 0U, &handle) ? handle : 0;
+}
+
+static AivmNodeAttr ui_int_attr(const char* key, int64_t value)
+{
+    AivmNodeAttr attr;
+    attr.key = key;
+    attr.kind = AIVM_NODE_ATTR_INT;
+    attr.int_value = value;
+    return attr;
+}
+
+static AivmNodeAttr ui_string_attr(const char* key, const char* value)
+{
+    AivmNodeAttr attr;
+    attr.key = key;
+    attr.kind = AIVM_NODE_ATTR_STRING;
+    attr.string_value = value;
+    return attr;
+}
+
+/* Runtime-built Map field: Field(key) { Lit(value) }, as MakeFieldString produces. */
+static int64_t ui_map_field(AivmVm* vm, AivmNodeAttr value)
+{
+    AivmNodeAttr key = ui_string_attr("key", value.key);
+    int64_t lit = 0;
+    int64_t field = 0;
+    value.key = "value";
+    if (!aivm_node_create(vm, "Lit", "lit", &value, 1U, NULL, 0U, &lit) ||
+        !aivm_node_create(vm, "Field", "field", &key, 1U, &lit, 1U, &field)) {
+        return 0;
+    }
+    return field;
+}
+
+static int test_retained_display_list(AivmVm* vm, int64_t handle)
+{
+    AivmNodeAttr attrs[6];
+    AivmValue batch_args[2];
+    AivmValue result;
+    int64_t items[3];
+    int64_t fields[6];
+    int64_t batch = 0;
+    int64_t swatch = 0;
+    size_t i;
+
+    g_frame_retained = 1;
+    g_begin_frame_calls = 0;
+    g_region_calls = 0;
+    g_shape_draw_calls = 0;
+
+    /* First retained frame has nothing to diff against, so it paints fully and immediately. */
+    CHECK(ui_scene_frame(handle, "#ffffff", "#ff0000"));
+    CHECK(g_begin_frame_calls == 1);
+    CHECK(g_shape_draw_calls == 3);
+
+    /* An identical frame issues no host draws at all. */
+    CHECK(ui_scene_frame(handle, "#ffffff", "#ff0000"));
+    CHECK(g_begin_frame_calls == 1);
+    CHECK(g_region_calls == 0);
+    CHECK(g_shape_draw_calls == 3);
+
+    /* Changing the swatch repaints only its rectangle: background and swatch, not the label. */
+    CHECK(ui_scene_frame(handle, "#ffffff", "#00ff00"));
+    CHECK(g_begin_frame_calls == 1);
+    CHECK(g_region_calls == 1);
+    CHECK(g_region_x == 8 && g_region_y == 8 && g_region_width == 6 && g_region_height == 6);
+    CHECK(g_shape_draw_calls == 5);
+    CHECK(strcmp(g_last_rect_color, "#00ff00") == 0);
+
+    /* The same scene as one drawBatch (attribute-form and Map-form items) matches the last frame. */
+    attrs[0] = ui_int_attr("x", 0);
+    attrs[1] = ui_int_attr("y", 0);
+    attrs[2] = ui_int_attr("width", 64);
+    attrs[3] = ui_int_attr("height", 64);
+    attrs[4] = ui_string_attr("color", "#ffffff");
+    items[0] = ui_attr_node(vm, "Rect", attrs, 5U);
+    fields[0] = ui_map_field(vm, ui_string_attr("kind", "rect"));
+    fields[1] = ui_map_field(vm, ui_int_attr("x", 8));
+    fields[2] = ui_map_field(vm, ui_int_attr("y", 8));
+    fields[3] = ui_map_field(vm, ui_int_attr("width", 6));
+    fields[4] = ui_map_field(vm, ui_int_attr("height", 6));
+    fields[5] = ui_map_field(vm, ui_string_attr("color", "#00ff00"));
+    for (i = 0U; i < 6U; i += 1U) {
+        CHECK(fields[i] > 0);
+    }
+    CHECK(aivm_node_create(vm, "Map", "map", NULL, 0U, fields, 6U, &swatch));
+    items[1] = swatch;
+    attrs[0] = ui_int_attr("x", 48);
+    attrs[1] = ui_int_attr("y", 60);
+    attrs[2] = ui_string_attr("text", "ok");
+    attrs[3] = ui_string_attr("color", "#000000");
+    attrs[4] = ui_int_attr("fontSize", 8);
+    items[2] = ui_attr_node(vm, "Text", attrs, 5U);
+    CHECK(items[0] > 0 && items[2] > 0);
+    CHECK(aivm_node_create(vm, "Batch", "batch", NULL, 0U, items, 3U, &batch));
+    batch_args[0] = aivm_value_int(handle);
+    batch_args[1] = aivm_value_node(batch);
+    CHECK(ui_frame_call("sys.ui.beginFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(native_syscall_ui_draw_batch("sys.ui.drawBatch", batch_args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(ui_frame_call("sys.ui.endFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(g_begin_frame_calls == 1);
+    CHECK(g_region_calls == 1);
+    CHECK(g_shape_draw_calls == 5);
+
+    /* A background change damages most of the window and falls back to a full repaint. */
+    CHECK(ui_scene_frame(handle, "#000000", "#00ff00"));
+    CHECK(g_begin_frame_calls == 2);
+    CHECK(g_region_calls == 1);
+    CHECK(g_shape_draw_calls == 8);
+
+    /* Present without endFrame still flushes a deferred frame. */
+    CHECK(ui_frame_call("sys.ui.beginFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(ui_rect(handle, 0, 0, 64, 64, "#000000") == AIVM_SYSCALL_OK);
+    CHECK(ui_rect(handle, 8, 8, 6, 6, "#0000ff") == AIVM_SYSCALL_OK);
+    CHECK(ui_text(handle, 48, 60, "ok") == AIVM_SYSCALL_OK);
+    CHECK(g_shape_draw_calls == 8);
+    CHECK(ui_frame_call("sys.ui.present", handle) == AIVM_SYSCALL_OK);
+    CHECK(g_region_calls == 2);
+    CHECK(g_shape_draw_calls == 10);
+
+    /* Unknown item kinds fail the whole call. */
+    attrs[0] = ui_int_attr("x", 1);
+    items[0] = ui_attr_node(vm, "Star", attrs, 1U);
+    CHECK(aivm_node_create(vm, "Batch", "batch", NULL, 0U, items, 1U, &batch));
+    batch_args[1] = aivm_value_node(batch);
+    CHECK(native_syscall_ui_draw_batch("sys.ui.drawBatch", batch_args, 2U, &result) == AIVM_SYSCALL_ERR_INVALID);
+
+    /* Without a retained host every frame draws immediately. */
+    g_frame_retained = 0;
+    CHECK(ui_scene_frame(handle, "#000000", "#0000ff"));
+    CHECK(g_begin_frame_calls == 3);
+    CHECK(g_shape_draw_calls == 13);
+    return 0;
+}
+
+static int64_t image_from_rgba(const char* base64, int width, int height)
+{
+    AivmValue args[3];
+    AivmValue result;
+    args[0] = aivm_value_int(width);
+    args[1] = aivm_value_int(height);
+    args[2] = aivm_value_string(base64);
+    if (native_syscall_image_from_rgba_base64("sys.image.fromRgbaBase64", args, 3U, &result) != AIVM_SYSCALL_OK ||
+        result.type != AIVM_VAL_INT) {
+        return 0;
+    }
+    return result.int_value;
+}
+
+static int image_call(const char* target, int64_t window, int x, int y, int64_t image)
+{
+    AivmValue args[4];
+    AivmValue result;
+    if (strcmp(target, "sys.image.release") == 0) {
+        args[0] = aivm_value_int(image);
+        return native_syscall_image_release(target, args, 1U, &result);
+    }
+    args[0] = aivm_value_int(window);
+    args[1] = aivm_value_int(x);
+    args[2] = aivm_value_int(y);
+    args[3] = aivm_value_int(image);
+    return native_syscall_ui_draw_image_handle(target, args, 4U, &result);
+}
+
+static int test_image_cache(AivmVm* vm, int64_t handle)
+{
+    AivmNodeAttr attrs[3];
+    AivmValue batch_args[2];
+    AivmValue result;
+    int64_t item;
+    int64_t batch = 0;
+    int64_t image;
+    int64_t other;
+    const NativeImageCacheEntry* entry;
+
+    g_frame_retained = 1;
+    g_cached_image_draws = 0;
+    g_released_images = 0;
+
+    /* Identical pixels share one entry; a different image gets its own. */
+    image = image_from_rgba("AQIDBAUGBwg=", 2, 1);
+    CHECK(image > 0);
+    CHECK(image_from_rgba("AQIDBAUGBwg=", 2, 1) == image);
+    other = image_from_rgba("AQIDBAUGBwg=", 1, 2);
+    CHECK(other > 0 && other != image);
+    entry = native_image_cache_find(image);
+    CHECK(entry != NULL && entry->refs == 2 && entry->width == 2 && entry->height == 1);
+
+    /* The first frame draws the handle; an unchanged frame is skipped by the display list. */
+    CHECK(ui_frame_call("sys.ui.beginFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(image_call("sys.ui.drawImageHandle", handle, 5, 6, image) == AIVM_SYSCALL_OK);
+    CHECK(ui_frame_call("sys.ui.endFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(g_cached_image_draws == 1);
+    CHECK(g_last_cached_image_id == image);
+    CHECK(ui_frame_call("sys.ui.beginFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(image_call("sys.ui.drawImageHandle", handle, 5, 6, image) == AIVM_SYSCALL_OK);
+    CHECK(ui_frame_call("sys.ui.endFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(g_cached_image_draws == 1);
+
+    /* drawBatch image items can reference the handle instead of carrying pixels. */
+    attrs[0] = ui_int_attr("x", 5);
+    attrs[1] = ui_int_attr("y", 6);
+    attrs[2] = ui_int_attr("image", other);
+    item = ui_attr_node(vm, "Image", attrs, 3U);
+    CHECK(item > 0);
+    CHECK(aivm_node_create(vm, "Batch", "batch", NULL, 0U, &item, 1U, &batch));
+    batch_args[0] = aivm_value_int(handle);
+    batch_args[1] = aivm_value_node(batch);
+    CHECK(ui_frame_call("sys.ui.beginFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(native_syscall_ui_draw_batch("sys.ui.drawBatch", batch_args, 2U, &result) == AIVM_SYSCALL_OK);
+    CHECK(ui_frame_call("sys.ui.endFrame", handle) == AIVM_SYSCALL_OK);
+    CHECK(g_cached_image_draws == 2);
+    CHECK(g_last_cached_image_id == other);
+
+    /* The host copy goes away with the last reference, and stale handles are rejected. */
+    CHECK(image_call("sys.image.release", 0, 0, 0, image) == AIVM_SYSCALL_OK);
+    CHECK(g_released_images == 0);
+    CHECK(image_call("sys.image.release", 0, 0, 0, image) == AIVM_SYSCALL_OK);
+    CHECK(g_released_images == 1);
+    CHECK(native_image_cache_find(image) == NULL);
+    CHECK(image_call("sys.image.release", 0, 0, 0, image) == AIVM_SYSCALL_ERR_INVALID);
+    CHECK(image_call("sys.ui.drawImageHandle", handle, 0, 0, image) == AIVM_SYSCALL_ERR_INVALID);
+    CHECK(image_from_rgba("AQID", 1, 1) == 0);
+    CHECK(image_call("sys.image.release", 0, 0, 0, other) == AIVM_SYSCALL_OK);
+    CHECK(g_released_images == 2);
+    g_frame_retained = 0;
+    return 0;
+}
+
+static uint32_t headless_pixel(int64_t handle, int x, int y)
+{
+    NativeHeadlessUiWindow* window = native_headless_ui_find(handle);
+    return window == NULL ? 0U : window->pixels[(size_t)y * (size_t)window->width + (size_t)x];
+}
+
+static int headless_scene(int64_t handle, const char* swatch)
+{
+    AivmValue args[6];
+    AivmValue result;
+    args[0] = aivm_value_int(handle);
+    args[1] = aivm_value_int(20);
+    args[2] = aivm_value_int(2);
+    args[3] = aivm_value_int(10);
+    args[4] = aivm_value_int(8);
+    args[5] = aivm_value_string("#00ff00");
+    if (ui_frame_call("sys.ui.beginFrame", handle) != AIVM_SYSCALL_OK ||
+        ui_rect(handle, 2, 2, 4, 4, swatch) != AIVM_SYSCALL_OK ||
+        ui_rect(handle, 4, 4, 4, 4, "#0000ff80") != AIVM_SYSCALL_OK ||
+        native_syscall_ui_draw_ellipse("sys.ui.drawEllipse", args, 6U, &result) != AIVM_SYSCALL_OK ||
+        ui_text(handle, 10, 15, "I") != AIVM_SYSCALL_OK ||
+        ui_frame_call("sys.ui.endFrame", handle) != AIVM_SYSCALL_OK ||
+        ui_frame_call("sys.ui.present", handle) != AIVM_SYSCALL_OK) {
+        return 0;
+    }
+    return 1;
+}
+
+/* Renders through the CPU rasterizer and checks pixels, retained repaint and the PNG dump. */
+static int test_headless_backend(void)
+{
+    static const uint8_t png_signature[8] = { 0x89U, 'P', 'N', 'G', 0x0dU, 0x0aU, 0x1aU, 0x0aU };
+    static const uint8_t png_end[12] = { 0U, 0U, 0U, 0U, 'I', 'E', 'N', 'D', 0xaeU, 0x42U, 0x60U, 0x82U };
+    AivmValue create_args[3];
+    AivmValue result;
+    NativeHostUiEvent event;
+    NativeHeadlessUiWindow* first;
+    NativeHeadlessUiWindow* second;
+    int64_t handle;
+    int64_t fresh;
+    char path[128];
+    uint8_t bytes[64];
+    FILE* file;
+    long size;
+    int begin_calls = g_begin_frame_calls;
+
+    native_ui_runtime_reset_handles();
+    CHECK(native_ui_select_backend("headless"));
+    CHECK(!native_ui_select_backend("gpu"));
+    CHECK(native_headless_ui_configure(NULL, 2));
+    create_args[0] = aivm_value_string("Headless");
+    create_args[1] = aivm_value_int(32);
+    create_args[2] = aivm_value_int(16);
+    CHECK(native_syscall_ui_create_window("sys.ui.createWindow", create_args, 3U, &result) == AIVM_SYSCALL_OK);
+    handle = result.int_value;
+    CHECK(native_headless_ui_find(handle) != NULL);
+
+    CHECK(headless_scene(handle, "#ff0000"));
+    CHECK(g_begin_frame_calls == begin_calls);
+    CHECK(headless_pixel(handle, 0, 0) == native_headless_ui_pack(255U, 255U, 255U, 255U));
+    CHECK(headless_pixel(handle, 2, 2) == native_headless_ui_pack(255U, 0U, 0U, 255U));
+    /* 50% blue over red and over white. */
+    CHECK(headless_pixel(handle, 5, 5) == native_headless_ui_pack(127U, 0U, 128U, 255U));
+    CHECK(headless_pixel(handle, 7, 7) == native_headless_ui_pack(127U, 127U, 255U, 255U));
+    CHECK(headless_pixel(handle, 25, 6) == native_headless_ui_pack(0U, 255U, 0U, 255U));
+    CHECK(headless_pixel(handle, 20, 2) == native_headless_ui_pack(255U, 255U, 255U, 255U));
+    /* "I" at size 8: 5x7 glyph whose top row spans columns 1..3 above baseline 15. */
+    CHECK(headless_pixel(handle, 11, 8) == native_headless_ui_pack(0U, 0U, 0U, 255U));
+    CHECK(headless_pixel(handle, 10, 8) == native_headless_ui_pack(255U, 255U, 255U, 255U));
+    CHECK(headless_pixel(handle, 12, 14) == native_headless_ui_pack(0U, 0U, 0U, 255U));
+
+    /* A changed swatch repaints only its region and matches a full render in a new window. */
+    CHECK(headless_scene(handle, "#000000"));
+    CHECK(native_syscall_ui_create_window("sys.ui.createWindow", create_args, 3U, &result) == AIVM_SYSCALL_OK);
+    fresh = result.int_value;
+    CHECK(headless_scene(fresh, "#000000"));
+    first = native_headless_ui_find(handle);
+    second = native_headless_ui_find(fresh);
+    CHECK(first != NULL && second != NULL);
+    CHECK(memcmp(first->pixels, second->pixels, 32U * 16U * sizeof(uint32_t)) == 0);
+
+    /* --ui-frames: the window reports closed once it has presented enough frames. */
+    CHECK(native_headless_ui_poll_event(fresh, &event));
+    CHECK(strcmp(event.type, "none") == 0);
+    CHECK(native_headless_ui_poll_event(handle, &event));
+    CHECK(strcmp(event.type, "closed") == 0);
+
+    (void)snprintf(path, sizeof(path), "aivm_test_ui_headless_%ld.png", (long)time(NULL));
+    CHECK(native_headless_ui_write_png(path, first->pixels, first->width, first->height));
+    file = fopen(path, "rb");
+    CHECK(file != NULL);
+    CHECK(fread(bytes, 1U, 33U, file) == 33U);
+    CHECK(fseek(file, -12L, SEEK_END) == 0);
+    CHECK(fread(bytes + 33, 1U, 12U, file) == 12U);
+    size = ftell(file);
+    fclose(file);
+    (void)remove(path);
+    CHECK(memcmp(bytes, png_signature, sizeof(png_signature)) == 0);
+    CHECK(memcmp(bytes + 12, "IHDR", 4U) == 0);
+    CHECK(bytes[19] == 32U && bytes[23] == 16U && bytes[24] == 8U && bytes[25] == 6U);
+    CHECK(native_headless_ui_crc32(0U, bytes + 12, 17U) ==
+        ((uint32_t)bytes[29] << 24 | (uint32_t)bytes[30] << 16 | (uint32_t)bytes[31] << 8 | (uint32_t)bytes[32]));
+    CHECK(memcmp(bytes + 33, png_end, sizeof(png_end)) == 0);
+    /* Stored deflate: 16 rows of 129 bytes in one block plus zlib framing. */
+    CHECK(size == 8L + 25L + 12L + (2L + 16L * 129L + 5L + 4L) + 12L);
+
+    native_headless_ui_reset();
+    native_ui_runtime_reset_handles();
+    CHECK(native_ui_select_backend("native"));
+    return 0;
+}
+
 int main(void)
 {
     AivmProgram program;
@@ -211,5 +657,9 @@ int main(void)
     CHECK(vm.node_attrs[node->attr_start + NATIVE_UI_EVENT_ATTR_X].int_value == 12);
     CHECK(vm.node_attrs[node->attr_start + NATIVE_UI_EVENT_ATTR_Y].int_value == 34);
 
+    CHECK(test_retained_display_list(&vm, handle) == 0);
+    CHECK(test_image_cache(&vm, handle) == 0);
+    CHECK(test_headless_backend() == 0);
+
     return 0;
 }
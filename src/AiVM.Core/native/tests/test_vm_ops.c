@@ -110,6 +110,73 @@ static int host_bytes_large(
     return AIVM_SYSCALL_OK;
 }
 
+static int host_bytes_from_text(
+    const char* target,
+    const AivmValue* args,
+    size_t arg_count,
+    AivmValue* result)
+{
+    (void)target;
+    if (arg_count != 1U || args[0].type != AIVM_VAL_STRING) {
+        return AIVM_SYSCALL_ERR_INVALID;
+    }
+    *result = aivm_value_bytes((const uint8_t*)args[0].string_value, strlen(args[0].string_value));
+    return AIVM_SYSCALL_OK;
+}
+
+static const AivmSyscallBinding g_bytes_text_bindings[] = {
+    { "sys.bytes.fromUtf8String", host_bytes_from_text }
+};
+
+static AivmVm* g_pending_vm = NULL;
+static int64_t g_pending_countdown[8];
+static int64_t g_pending_completion_order[8];
+static size_t g_pending_completion_count = 0U;
+
+/* Pretends op N stays in flight for g_pending_countdown[N] polls, parking callers that can park. */
+static int host_pending_await(
+    const char* target,
+    const AivmValue* args,
+    size_t arg_count,
+    AivmValue* result)
+{
+    int64_t op;
+    (void)target;
+    if (arg_count != 1U || args[0].type != AIVM_VAL_INT || args[0].int_value <= 0 || args[0].int_value >= 8) {
+        return AIVM_SYSCALL_ERR_INVALID;
+    }
+    op = args[0].int_value;
+    while (g_pending_countdown[op] > 0) {
+        g_pending_countdown[op] -= 1;
+        if (aivm_task_can_suspend(g_pending_vm)) {
+            return AIVM_SYSCALL_PENDING;
+        }
+    }
+    g_pending_completion_order[g_pending_completion_count] = op;
+    g_pending_completion_count += 1U;
+    *result = aivm_value_int(op * 10);
+    return AIVM_SYSCALL_OK;
+}
+
+static int64_t g_task_write_connection = 0;
+static size_t g_task_write_length = 0U;
+
+static int host_record_tcp_write(
+    const char* target,
+    const AivmValue* args,
+    size_t arg_count,
+    AivmValue* result)
+{
+    (void)target;
+    if (arg_count != 2U || args[0].type != AIVM_VAL_INT || args[1].type != AIVM_VAL_BYTES) {
+        return AIVM_SYSCALL_ERR_INVALID;
+    }
+    g_task_write_connection = args[0].int_value;
+    g_task_write_length = args[1].bytes_value.length;
+    *result = aivm_value_int((int64_t)args[1].bytes_value.length);
+    return AIVM_SYSCALL_OK;
+}
+
 static int test_push_store_load_pop(void)
 {
     AivmVm vm;
@@ -608,11 +675,12 @@ static int test_recursive_loop_without_tail_call_reuse_sets_frame_overflow(void)
         { .opcode = AIVM_OP_CALL, .operand_int = 2 },
         { .opcode = AIVM_OP_HALT, .operand_int = 0 },
         { .opcode = AIVM_OP_CALL, .operand_int = 2 },
+        { .opcode = AIVM_OP_POP, .operand_int = 0 },
         { .opcode = AIVM_OP_RETURN, .operand_int = 0 }
     };
     static const AivmProgram program = {
         .instructions = instructions,
-        .instruction_count = 4U,
+        .instruction_count = 5U,
         .format_version = 0U,
         .format_flags = 0U,
         .section_count = 0U
@@ -637,6 +705,68 @@ static int test_recursive_loop_without_tail_call_reuse_sets_frame_overflow(void)
     return 0;
 }
 
+static int test_tail_call_reuses_current_frame(void)
+{
+    AivmVm vm;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 5000 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL, .operand_int = 4 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 1 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_EQ_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_JUMP_IF_FALSE, .operand_int = 12 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 1 },
+        { .opcode = AIVM_OP_RETURN, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = -1 },
+        { .opcode = AIVM_OP_ADD_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 1 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 2 },
+        { .opcode = AIVM_OP_ADD_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL, .operand_int = 4 },
+        { .opcode = AIVM_OP_RETURN, .operand_int = 0 }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 20U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+    AivmValue out;
+    size_t i;
+
+    /* Recursion deeper than the frame capacity runs in one frame when every call is in tail position. */
+    aivm_init(&vm, &program);
+    for (i = 0U; i < 1000U; i += 1U) {
+        aivm_step(&vm);
+    }
+    if (expect(vm.status == AIVM_VM_STATUS_RUNNING && vm.call_frame_count == 1U) != 0) {
+        return 1;
+    }
+    if (expect(vm.locals_count == 2U) != 0) {
+        return 1;
+    }
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    if (expect(vm.call_frame_count == 0U && vm.stack_count == 1U) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1) != 0) {
+        return 1;
+    }
+    if (expect(out.type == AIVM_VAL_INT && out.int_value == 10000) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
 static int test_negative_jump_operand_sets_error(void)
 {
     AivmVm vm;
@@ -1861,87 +1991,697 @@ static int test_call_sys_does_not_recover_non_syscall_string_target_from_args(vo
         .section_count = 0U
     };
 
-    aivm_init_with_syscalls(&vm, &program, NULL, 0U);
+    aivm_init_with_syscalls(&vm, &program, NULL, 0U);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_ERROR) != 0) {
+        return 1;
+    }
+    if (expect(vm.error == AIVM_VM_ERR_SYSCALL) != 0) {
+        return 1;
+    }
+    if (expect(strstr(aivm_vm_error_detail(&vm), "rawTarget=not_a_syscall") != NULL) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_nested_call_preserves_argument_without_tail_call_reuse(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 5 },
+        { .opcode = AIVM_OP_CALL, .operand_int = 3 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL, .operand_int = 7 },
+        { .opcode = AIVM_OP_RETURN, .operand_int = 0 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_RETURN, .operand_int = 0 },
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 10U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init(&vm, &program);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    if (expect(vm.stack_count == 1U) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1) != 0) {
+        return 1;
+    }
+    if (expect(out.type == AIVM_VAL_INT) != 0) {
+        return 1;
+    }
+    if (expect(out.int_value == 5) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_debug_task_reclaim_stats_intrinsic(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    const AivmNodeRecord* stats_node;
+    const AivmNodeAttr* attr0;
+    const AivmNodeAttr* attr1;
+    const AivmNodeAttr* attr2;
+    size_t i;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 4 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 0 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 5 },
+        { .opcode = AIVM_OP_RET, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.debug.taskReclaimStats" }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 6U,
+        .constants = constants,
+        .constant_count = 1U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init(&vm, &program);
+    vm.completed_task_count = AIVM_VM_TASK_CAPACITY;
+    vm.next_task_handle = (int64_t)AIVM_VM_TASK_CAPACITY + 1;
+    for (i = 0U; i < AIVM_VM_TASK_CAPACITY; i += 1U) {
+        vm.completed_tasks[i].state = AIVM_TASK_STATE_COMPLETED;
+        vm.completed_tasks[i].handle = (int64_t)i + 1;
+        vm.completed_tasks[i].result = aivm_value_int(-((int64_t)i + 1));
+    }
+
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1) != 0) {
+        return 1;
+    }
+    if (expect(out.type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    stats_node = &vm.nodes[(size_t)(out.node_handle - 1)];
+    if (expect(strcmp(stats_node->kind, "DebugTaskReclaimStats") == 0) != 0) {
+        return 1;
+    }
+    if (expect(strncmp(stats_node->id, "debug_task_reclaim_stats_", 25U) == 0) != 0) {
+        return 1;
+    }
+    if (expect(stats_node->attr_count == 3U) != 0) {
+        return 1;
+    }
+    attr0 = &vm.node_attrs[stats_node->attr_start];
+    attr1 = &vm.node_attrs[stats_node->attr_start + 1U];
+    attr2 = &vm.node_attrs[stats_node->attr_start + 2U];
+    if (expect(strcmp(attr0->key, "reclaimed") == 0 && attr0->kind == AIVM_NODE_ATTR_INT && attr0->int_value == 1) != 0) {
+        return 1;
+    }
+    if (expect(strcmp(attr1->key, "skipPinned") == 0 && attr1->kind == AIVM_NODE_ATTR_INT && attr1->int_value == 0) != 0) {
+        return 1;
+    }
+    if (expect(strcmp(attr2->key, "exhausted") == 0 && attr2->kind == AIVM_NODE_ATTR_INT && attr2->int_value == 0) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_debug_task_reclaim_stats_arity_error(void)
+{
+    AivmVm vm;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.debug.taskReclaimStats" },
+        { .type = AIVM_VAL_INT, .int_value = 7 }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 3U,
+        .constants = constants,
+        .constant_count = 2U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init(&vm, &program);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_ERROR) != 0) {
+        return 1;
+    }
+    if (expect(vm.error == AIVM_VM_ERR_SYSCALL) != 0) {
+        return 1;
+    }
+    if (expect(strcmp(aivm_vm_error_detail(&vm), "AIVMS004/AIVMC002: Syscall argument count was invalid.") == 0) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_json_parse_builds_tree(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    const AivmNodeRecord* root;
+    const AivmNodeRecord* field;
+    const AivmNodeRecord* key;
+    const AivmNodeRecord* array;
+    const AivmNodeRecord* text;
+    const AivmNodeAttr* decoded;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.json.parse" },
+        { .type = AIVM_VAL_STRING, .string_value = " {\"k\\u00e9\": [1, \"a\\nb\"], \"z\": null} " }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 4U,
+        .constants = constants,
+        .constant_count = 2U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init(&vm, &program);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    if (expect(vm.stack_count == 0U) != 0) {
+        return 1;
+    }
+    root = &vm.nodes[(size_t)(out.node_handle - 1)];
+    if (expect(strcmp(root->kind, "JsonObject") == 0 && root->child_count == 2U) != 0) {
+        return 1;
+    }
+    field = &vm.nodes[(size_t)(vm.node_children[root->child_start] - 1)];
+    if (expect(strcmp(field->kind, "JsonField") == 0 && field->child_count == 2U) != 0) {
+        return 1;
+    }
+    key = &vm.nodes[(size_t)(vm.node_children[field->child_start] - 1)];
+    decoded = &vm.node_attrs[key->attr_start];
+    if (expect(strcmp(key->id, "key") == 0 && strcmp(decoded->string_value, "k\xc3\xa9") == 0) != 0) {
+        return 1;
+    }
+    array = &vm.nodes[(size_t)(vm.node_children[field->child_start + 1U] - 1)];
+    if (expect(strcmp(array->kind, "JsonArray") == 0 && array->child_count == 2U) != 0) {
+        return 1;
+    }
+    text = &vm.nodes[(size_t)(vm.node_children[array->child_start + 1U] - 1)];
+    if (expect(strcmp(text->kind, "JsonString") == 0 && text->child_count == 2U) != 0) {
+        return 1;
+    }
+    decoded = &vm.node_attrs[vm.nodes[(size_t)(vm.node_children[text->child_start] - 1)].attr_start];
+    if (expect(strcmp(decoded->string_value, "a\nb") == 0) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_json_encode_round_trip(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 2 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.json.encode" },
+        { .type = AIVM_VAL_STRING, .string_value = "sys.json.parse" },
+        { .type = AIVM_VAL_STRING, .string_value = "{ \"b\" : [1, 2.5e3, true, null, \"x\\q\"], \"a\" : {} }" }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 6U,
+        .constants = constants,
+        .constant_count = 3U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init(&vm, &program);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_STRING) != 0) {
+        return 1;
+    }
+    if (expect(strcmp(out.string_value, "{\"b\":[1,2.5e3,true,null,\"x\\q\"],\"a\":{}}") == 0) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_json_parse_error_node(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    const AivmNodeRecord* err;
+    const AivmNodeAttr* code;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.json.parse" },
+        { .type = AIVM_VAL_STRING, .string_value = "[{\"a\" 1}]" }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 4U,
+        .constants = constants,
+        .constant_count = 2U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init(&vm, &program);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_NODE && vm.stack_count == 0U) != 0) {
+        return 1;
+    }
+    err = &vm.nodes[(size_t)(out.node_handle - 1)];
+    if (expect(strcmp(err->kind, "Err") == 0 && err->attr_count == 3U) != 0) {
+        return 1;
+    }
+    code = &vm.node_attrs[err->attr_start];
+    if (expect(strcmp(code->key, "code") == 0 && strcmp(code->string_value, "JSON_OBJECT_COLON") == 0) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_json_validate_returns_input_span(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    const AivmNodeRecord* text;
+    const AivmNodeAttr* value;
+    size_t node_count_before;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 2 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.json.validate" },
+        { .type = AIVM_VAL_STRING, .string_value = " \n{\"a\": [1, \"x\\u00e9\"], \"b\" : null}\t " },
+        { .type = AIVM_VAL_STRING, .string_value = "{\"a\": 1} x" }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 7U,
+        .constants = constants,
+        .constant_count = 3U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init(&vm, &program);
+    node_count_before = vm.node_count;
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED && vm.stack_count == 2U) != 0) {
+        return 1;
+    }
+    /* Valid input comes back verbatim minus the surrounding whitespace; no tree is built. */
+    out = vm.stack[0];
+    if (expect(out.type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    text = &vm.nodes[(size_t)(out.node_handle - 1)];
+    value = &vm.node_attrs[text->attr_start];
+    if (expect(strcmp(text->kind, "Lit") == 0 && text->attr_count == 1U) != 0) {
+        return 1;
+    }
+    if (expect(strcmp(value->string_value, "{\"a\": [1, \"x\\u00e9\"], \"b\" : null}") == 0) != 0) {
+        return 1;
+    }
+    out = vm.stack[1];
+    if (expect(out.type == AIVM_VAL_NODE && vm.node_count == node_count_before + 2U) != 0) {
+        return 1;
+    }
+    text = &vm.nodes[(size_t)(out.node_handle - 1)];
+    value = &vm.node_attrs[text->attr_start];
+    if (expect(strcmp(text->kind, "Err") == 0 && strcmp(value->string_value, "JSON_UNSUPPORTED") == 0) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_http_parse_request_builds_node(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    const AivmNodeRecord* request;
+    const AivmNodeRecord* query;
+    const AivmNodeRecord* field;
+    const AivmNodeAttr* attrs;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 2 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 2 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.http.parseRequest" },
+        { .type = AIVM_VAL_STRING, .string_value = "sys.bytes.fromUtf8String" },
+        { .type = AIVM_VAL_STRING, .string_value = "\r\nPOST /a?q=x+y%21 HTTP/1.1\r\nHost: h\r\nContent-Length: 3\r\n\r\nabcGET" }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 7U,
+        .constants = constants,
+        .constant_count = 3U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init_with_syscalls(&vm, &program, g_bytes_text_bindings, 1U);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_NODE && vm.stack_count == 0U) != 0) {
+        return 1;
+    }
+    request = &vm.nodes[(size_t)(out.node_handle - 1)];
+    if (expect(strcmp(request->kind, "HttpRequest") == 0 && request->attr_count == 11U && request->child_count == 3U) != 0) {
+        return 1;
+    }
+    attrs = &vm.node_attrs[request->attr_start];
+    if (expect(strcmp(attrs[0].string_value, "POST") == 0 && strcmp(attrs[1].string_value, "/a") == 0) != 0) {
+        return 1;
+    }
+    if (expect(attrs[4].int_value == 59 && attrs[5].int_value == 3 && attrs[6].int_value == 62) != 0) {
+        return 1;
+    }
+    if (expect(attrs[8].bool_value == 1 && attrs[9].bool_value == 1) != 0) {
+        return 1;
+    }
+    query = &vm.nodes[(size_t)(vm.node_children[request->child_start + 1U] - 1)];
+    if (expect(strcmp(query->kind, "Map") == 0 && query->child_count == 1U) != 0) {
+        return 1;
+    }
+    field = &vm.nodes[(size_t)(vm.node_children[query->child_start] - 1)];
+    if (expect(strcmp(vm.node_attrs[field->attr_start].string_value, "q") == 0) != 0) {
+        return 1;
+    }
+    if (expect(strcmp(vm.node_attrs[vm.nodes[(size_t)(vm.node_children[field->child_start] - 1)].attr_start].string_value, "x y!") == 0) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_http_parse_response_chunked(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    const AivmNodeRecord* response;
+    const AivmNodeRecord* chunks;
+    const AivmNodeRecord* chunk;
+    const AivmNodeAttr* attrs;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 2 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 2 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.http.parseResponse" },
+        { .type = AIVM_VAL_STRING, .string_value = "sys.bytes.fromUtf8String" },
+        { .type = AIVM_VAL_STRING, .string_value = "HTTP/1.0 200 OK\r\nTransfer-Encoding: gzip, chunked\r\n\r\n4\r\nWiki\r\n5;x=1\r\npedia\r\n0\r\n\r\n" }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 7U,
+        .constants = constants,
+        .constant_count = 3U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init_with_syscalls(&vm, &program, g_bytes_text_bindings, 1U);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    response = &vm.nodes[(size_t)(out.node_handle - 1)];
+    if (expect(strcmp(response->kind, "HttpResponse") == 0 && response->child_count == 2U) != 0) {
+        return 1;
+    }
+    attrs = &vm.node_attrs[response->attr_start];
+    if (expect(attrs[0].int_value == 200 && strcmp(attrs[1].string_value, "OK") == 0 && attrs[2].bool_value == 0) != 0) {
+        return 1;
+    }
+    if (expect(attrs[5].int_value == 9 && attrs[6].int_value == 81 && attrs[7].bool_value == 1 && attrs[8].bool_value == 0) != 0) {
+        return 1;
+    }
+    chunks = &vm.nodes[(size_t)(vm.node_children[response->child_start + 1U] - 1)];
+    if (expect(strcmp(chunks->kind, "HttpChunks") == 0 && chunks->child_count == 2U) != 0) {
+        return 1;
+    }
+    chunk = &vm.nodes[(size_t)(vm.node_children[chunks->child_start + 1U] - 1)];
+    if (expect(vm.node_attrs[chunk->attr_start].int_value == 69 && vm.node_attrs[chunk->attr_start + 1U].int_value == 5) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_http_parse_partial_and_error(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    const AivmNodeRecord* node;
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 2 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 10 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 2 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 3 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 2 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.http.parseRequest" },
+        { .type = AIVM_VAL_STRING, .string_value = "sys.bytes.fromUtf8String" },
+        { .type = AIVM_VAL_STRING, .string_value = "GET / HTTP/1.1\r\nHost: h\r\n" },
+        { .type = AIVM_VAL_STRING, .string_value = "GET / HTTP/1.1\r\nBad Name: h\r\n\r\n" }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 13U,
+        .constants = constants,
+        .constant_count = 4U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init_with_syscalls(&vm, &program, g_bytes_text_bindings, 1U);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED && vm.stack_count == 2U) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    node = &vm.nodes[(size_t)(out.node_handle - 1)];
+    if (expect(strcmp(node->kind, "Err") == 0 && strcmp(vm.node_attrs[node->attr_start].string_value, "HTTP_HEADER") == 0) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    node = &vm.nodes[(size_t)(out.node_handle - 1)];
+    if (expect(strcmp(node->kind, "HttpPartial") == 0 && node->attr_count == 0U) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+static int test_call_sys_http_build_response(void)
+{
+    AivmVm vm;
+    AivmValue out;
+    static const char expected[] = "HTTP/1.1 404 Not Found\r\nX-Id: 7\r\nContent-Length: 4\r\n\r\nnope";
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 404 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 2 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 7 },
+        { .opcode = AIVM_OP_MAKE_FIELD_STRING, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 1 },
+        { .opcode = AIVM_OP_MAKE_MAP, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 3 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 4 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 4 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
+    };
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.http.buildResponse" },
+        { .type = AIVM_VAL_STRING, .string_value = "Not Found" },
+        { .type = AIVM_VAL_STRING, .string_value = "X-Id" },
+        { .type = AIVM_VAL_STRING, .string_value = "sys.bytes.fromUtf8String" },
+        { .type = AIVM_VAL_STRING, .string_value = "nope" }
+    };
+    static const AivmProgram program = {
+        .instructions = instructions,
+        .instruction_count = 13U,
+        .constants = constants,
+        .constant_count = 5U,
+        .format_version = 0U,
+        .format_flags = 0U,
+        .section_count = 0U
+    };
+
+    aivm_init_with_syscalls(&vm, &program, g_bytes_text_bindings, 1U);
     aivm_run(&vm);
-    if (expect(vm.status == AIVM_VM_STATUS_ERROR) != 0) {
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
         return 1;
     }
-    if (expect(vm.error == AIVM_VM_ERR_SYSCALL) != 0) {
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_BYTES) != 0) {
         return 1;
     }
-    if (expect(strstr(aivm_vm_error_detail(&vm), "rawTarget=not_a_syscall") != NULL) != 0) {
+    if (expect(out.bytes_value.length == sizeof(expected) - 1U && memcmp(out.bytes_value.data, expected, sizeof(expected) - 1U) == 0) != 0) {
         return 1;
     }
     return 0;
 }
 
-static int test_nested_call_preserves_argument_without_tail_call_reuse(void)
+static int test_async_call_and_await_roundtrip(void)
 {
     AivmVm vm;
     AivmValue out;
     static const AivmInstruction instructions[] = {
-        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 5 },
-        { .opcode = AIVM_OP_CALL, .operand_int = 3 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 4 },
+        { .opcode = AIVM_OP_AWAIT, .operand_int = 0 },
         { .opcode = AIVM_OP_HALT, .operand_int = 0 },
-        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
-        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
-        { .opcode = AIVM_OP_CALL, .operand_int = 7 },
-        { .opcode = AIVM_OP_RETURN, .operand_int = 0 },
-        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
-        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
-        { .opcode = AIVM_OP_RETURN, .operand_int = 0 },
-    };
-    static const AivmProgram program = {
-        .instructions = instructions,
-        .instruction_count = 10U,
-        .format_version = 0U,
-        .format_flags = 0U,
-        .section_count = 0U
+        { .opcode = AIVM_OP_NOP, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 9 },
+        { .opcode = AIVM_OP_RET, .operand_int = 0 }
     };
-
+    AivmProgram program;
+    aivm_program_init(&program, &instructions[0], 6U);
     aivm_init(&vm, &program);
     aivm_run(&vm);
     if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
         return 1;
     }
-    if (expect(vm.stack_count == 1U) != 0) {
-        return 1;
-    }
     if (expect(aivm_stack_pop(&vm, &out) == 1) != 0) {
         return 1;
     }
-    if (expect(out.type == AIVM_VAL_INT) != 0) {
-        return 1;
-    }
-    if (expect(out.int_value == 5) != 0) {
+    if (expect(out.type == AIVM_VAL_INT && out.int_value == 9) != 0) {
         return 1;
     }
     return 0;
 }
 
-static int test_call_sys_debug_task_reclaim_stats_intrinsic(void)
+static int test_async_call_parks_pending_syscall_and_await_drives_tasks(void)
 {
-    AivmVm vm;
+    static AivmVm vm;
     AivmValue out;
-    const AivmNodeRecord* stats_node;
-    const AivmNodeAttr* attr0;
-    const AivmNodeAttr* attr1;
-    const AivmNodeAttr* attr2;
-    size_t i;
     static const AivmInstruction instructions[] = {
-        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 4 },
-        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
-        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 1 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 19 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 2 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 19 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 1 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 3 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 19 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 2 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_AWAIT, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 1 },
+        { .opcode = AIVM_OP_AWAIT, .operand_int = 0 },
+        { .opcode = AIVM_OP_ADD_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 2 },
+        { .opcode = AIVM_OP_AWAIT, .operand_int = 0 },
+        { .opcode = AIVM_OP_ADD_INT, .operand_int = 0 },
         { .opcode = AIVM_OP_HALT, .operand_int = 0 },
-        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 5 },
+        { .opcode = AIVM_OP_NOP, .operand_int = 0 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
         { .opcode = AIVM_OP_RET, .operand_int = 0 }
     };
     static const AivmValue constants[] = {
-        { .type = AIVM_VAL_STRING, .string_value = "sys.debug.taskReclaimStats" }
+        { .type = AIVM_VAL_STRING, .string_value = "sys.net.async.await" }
+    };
+    static const AivmSyscallBinding bindings[] = {
+        { "sys.net.async.await", host_pending_await }
     };
     static const AivmProgram program = {
         .instructions = instructions,
-        .instruction_count = 6U,
+        .instruction_count = 24U,
         .constants = constants,
         .constant_count = 1U,
         .format_version = 0U,
@@ -1949,110 +2689,162 @@ static int test_call_sys_debug_task_reclaim_stats_intrinsic(void)
         .section_count = 0U
     };
 
-    aivm_init(&vm, &program);
-    vm.completed_task_count = AIVM_VM_TASK_CAPACITY;
-    vm.next_task_handle = (int64_t)AIVM_VM_TASK_CAPACITY + 1;
-    for (i = 0U; i < AIVM_VM_TASK_CAPACITY; i += 1U) {
-        vm.completed_tasks[i].state = AIVM_TASK_STATE_COMPLETED;
-        vm.completed_tasks[i].handle = (int64_t)i + 1;
-        vm.completed_tasks[i].result = aivm_value_int(-((int64_t)i + 1));
-    }
-
+    memset(g_pending_countdown, 0, sizeof(g_pending_countdown));
+    g_pending_countdown[1] = 3;
+    g_pending_countdown[2] = 1;
+    g_pending_countdown[3] = 2;
+    g_pending_completion_count = 0U;
+    g_pending_vm = &vm;
+    aivm_init_with_syscalls(&vm, &program, bindings, 1U);
     aivm_run(&vm);
+    g_pending_vm = NULL;
     if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
         return 1;
     }
-    if (expect(aivm_stack_pop(&vm, &out) == 1) != 0) {
-        return 1;
-    }
-    if (expect(out.type == AIVM_VAL_NODE) != 0) {
-        return 1;
-    }
-    stats_node = &vm.nodes[(size_t)(out.node_handle - 1)];
-    if (expect(strcmp(stats_node->kind, "DebugTaskReclaimStats") == 0) != 0) {
-        return 1;
-    }
-    if (expect(strncmp(stats_node->id, "debug_task_reclaim_stats_", 25U) == 0) != 0) {
-        return 1;
-    }
-    if (expect(stats_node->attr_count == 3U) != 0) {
-        return 1;
-    }
-    attr0 = &vm.node_attrs[stats_node->attr_start];
-    attr1 = &vm.node_attrs[stats_node->attr_start + 1U];
-    attr2 = &vm.node_attrs[stats_node->attr_start + 2U];
-    if (expect(strcmp(attr0->key, "reclaimed") == 0 && attr0->kind == AIVM_NODE_ATTR_INT && attr0->int_value == 1) != 0) {
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_INT && out.int_value == 60) != 0) {
         return 1;
     }
-    if (expect(strcmp(attr1->key, "skipPinned") == 0 && attr1->kind == AIVM_NODE_ATTR_INT && attr1->int_value == 0) != 0) {
+    /* All three requests were outstanding at once; the shortest finished first. */
+    if (expect(g_pending_completion_count == 3U &&
+               g_pending_completion_order[0] == 2 &&
+               g_pending_completion_order[1] == 3 &&
+               g_pending_completion_order[2] == 1) != 0) {
         return 1;
     }
-    if (expect(strcmp(attr2->key, "exhausted") == 0 && attr2->kind == AIVM_NODE_ATTR_INT && attr2->int_value == 0) != 0) {
+    if (expect(vm.suspended_task_count == 0U && vm.suspended_stack_used == 0U && vm.running_task_count == 0U) != 0) {
         return 1;
     }
     return 0;
 }
 
-static int test_call_sys_debug_task_reclaim_stats_arity_error(void)
+static int test_async_call_awaiting_coroutine_parks_and_resumes(void)
 {
-    AivmVm vm;
+    static AivmVm vm;
+    AivmValue out;
     static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 4 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 11 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 5 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 5 },
+        { .opcode = AIVM_OP_JUMP, .operand_int = 16 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
         { .opcode = AIVM_OP_CONST, .operand_int = 0 },
-        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
-        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 }
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_RET, .operand_int = 0 },
+        { .opcode = AIVM_OP_NOP, .operand_int = 0 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 5 },
+        { .opcode = AIVM_OP_AWAIT, .operand_int = 0 },
+        { .opcode = AIVM_OP_RET, .operand_int = 0 },
+        { .opcode = AIVM_OP_AWAIT, .operand_int = 0 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_AWAIT, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_ADD_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
     };
     static const AivmValue constants[] = {
-        { .type = AIVM_VAL_STRING, .string_value = "sys.debug.taskReclaimStats" },
-        { .type = AIVM_VAL_INT, .int_value = 7 }
+        { .type = AIVM_VAL_STRING, .string_value = "sys.net.async.await" }
+    };
+    static const AivmSyscallBinding bindings[] = {
+        { "sys.net.async.await", host_pending_await }
     };
     static const AivmProgram program = {
         .instructions = instructions,
-        .instruction_count = 3U,
+        .instruction_count = 22U,
         .constants = constants,
-        .constant_count = 2U,
+        .constant_count = 1U,
         .format_version = 0U,
         .format_flags = 0U,
         .section_count = 0U
     };
 
-    aivm_init(&vm, &program);
+    memset(g_pending_countdown, 0, sizeof(g_pending_countdown));
+    g_pending_countdown[4] = 3;
+    g_pending_countdown[5] = 1;
+    g_pending_completion_count = 0U;
+    g_pending_vm = &vm;
+    aivm_init_with_syscalls(&vm, &program, bindings, 1U);
     aivm_run(&vm);
-    if (expect(vm.status == AIVM_VM_STATUS_ERROR) != 0) {
+    g_pending_vm = NULL;
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
         return 1;
     }
-    if (expect(vm.error == AIVM_VM_ERR_SYSCALL) != 0) {
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_INT && out.int_value == 90) != 0) {
         return 1;
     }
-    if (expect(strcmp(aivm_vm_error_detail(&vm), "AIVMS004/AIVMC002: Syscall argument count was invalid.") == 0) != 0) {
+    if (expect(g_pending_completion_count == 2U &&
+               g_pending_completion_order[0] == 5 &&
+               g_pending_completion_order[1] == 4) != 0) {
+        return 1;
+    }
+    if (expect(vm.suspended_task_count == 0U && vm.completed_task_count == 3U) != 0) {
         return 1;
     }
     return 0;
 }
 
-static int test_async_call_and_await_roundtrip(void)
+static int test_unawaited_task_finishes_before_halt(void)
 {
-    AivmVm vm;
-    AivmValue out;
-    static const AivmInstruction instructions[] = {
-        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 4 },
-        { .opcode = AIVM_OP_AWAIT, .operand_int = 0 },
-        { .opcode = AIVM_OP_HALT, .operand_int = 0 },
-        { .opcode = AIVM_OP_NOP, .operand_int = 0 },
-        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 9 },
-        { .opcode = AIVM_OP_RET, .operand_int = 0 }
+    static AivmVm vm;
+    static const AivmValue constants[] = {
+        { .type = AIVM_VAL_STRING, .string_value = "sys.net.async.await" },
+        { .type = AIVM_VAL_STRING, .string_value = "sys.net.tcp.write" },
+        { .type = AIVM_VAL_BYTES, .bytes_value = { (const uint8_t*)"DONE", 4U } }
+    };
+    static const AivmSyscallBinding bindings[] = {
+        { "sys.net.async.await", host_pending_await },
+        { "sys.net.tcp.write", host_record_tcp_write }
+    };
+    AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_JUMP, .operand_int = 11 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 1 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 1 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_CONST, .operand_int = 2 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 2 },
+        { .opcode = AIVM_OP_RET, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 6 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 1 },
+        { .opcode = AIVM_OP_POP, .operand_int = 0 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 }
     };
     AivmProgram program;
-    aivm_program_init(&program, &instructions[0], 6U);
-    aivm_init(&vm, &program);
-    aivm_run(&vm);
-    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
-        return 1;
-    }
-    if (expect(aivm_stack_pop(&vm, &out) == 1) != 0) {
-        return 1;
-    }
-    if (expect(out.type == AIVM_VAL_INT && out.int_value == 9) != 0) {
-        return 1;
+    int variant;
+
+    /* The task parks on its net await; main then stops via HALT, a frame-0 RET, or by running
+     * off the end of the program, and the write after the await must still happen. */
+    for (variant = 0; variant < 3; variant += 1) {
+        instructions[14].opcode = variant == 1 ? AIVM_OP_RET : AIVM_OP_HALT;
+        aivm_program_init(&program, instructions, variant == 2 ? 14U : 15U);
+        program.constants = constants;
+        program.constant_count = 3U;
+        memset(g_pending_countdown, 0, sizeof(g_pending_countdown));
+        g_pending_countdown[6] = 3;
+        g_pending_completion_count = 0U;
+        g_task_write_connection = 0;
+        g_task_write_length = 0U;
+        g_pending_vm = &vm;
+        aivm_init_with_syscalls(&vm, &program, bindings, 2U);
+        aivm_run(&vm);
+        g_pending_vm = NULL;
+        if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+            return 1;
+        }
+        if (expect(g_pending_completion_count == 1U &&
+                   g_task_write_connection == 60 &&
+                   g_task_write_length == 4U) != 0) {
+            return 1;
+        }
+        if (expect(vm.suspended_task_count == 0U && vm.suspended_stack_used == 0U) != 0) {
+            return 1;
+        }
     }
     return 0;
 }
@@ -2823,6 +3615,94 @@ static int test_parallel_join_resolves_completed_task_handles(void)
     return 0;
 }
 
+typedef struct {
+    size_t calls;
+    size_t branches;
+    AivmVm scratch;
+} TestParExecutor;
+
+static void test_par_executor_run(void* context, const AivmProgram* program, AivmParBranch* branches, size_t branch_count)
+{
+    TestParExecutor* executor = (TestParExecutor*)context;
+    size_t i;
+    executor->calls += 1U;
+    executor->branches += branch_count;
+    /* The last branch is left pending so the owner re-runs it, as a declining host would. */
+    for (i = 0U; i + 1U < branch_count; i += 1U) {
+        (void)aivm_par_branch_execute(program, &branches[i], &executor->scratch);
+    }
+}
+
+static int test_parallel_join_runs_pure_branches_through_executor(void)
+{
+    static AivmVm vm;
+    static TestParExecutor executor;
+    AivmValue out;
+    const AivmNodeRecord* block_node;
+    size_t i;
+    static const int64_t expected[] = { 10, 14, 3, 4 };
+    static const AivmInstruction instructions[] = {
+        { .opcode = AIVM_OP_PAR_BEGIN, .operand_int = 4 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 5 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 14 },
+        { .opcode = AIVM_OP_PAR_FORK, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 7 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 14 },
+        { .opcode = AIVM_OP_PAR_FORK, .operand_int = 0 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 19 },
+        { .opcode = AIVM_OP_PAR_FORK, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 2 },
+        { .opcode = AIVM_OP_ASYNC_CALL, .operand_int = 14 },
+        { .opcode = AIVM_OP_PAR_FORK, .operand_int = 0 },
+        { .opcode = AIVM_OP_PAR_JOIN, .operand_int = 4 },
+        { .opcode = AIVM_OP_HALT, .operand_int = 0 },
+        { .opcode = AIVM_OP_STORE_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_LOAD_LOCAL, .operand_int = 0 },
+        { .opcode = AIVM_OP_ADD_INT, .operand_int = 0 },
+        { .opcode = AIVM_OP_RET, .operand_int = 0 },
+        { .opcode = AIVM_OP_PUSH_BOOL, .operand_int = 1 },
+        { .opcode = AIVM_OP_JUMP_IF_FALSE, .operand_int = 23 },
+        { .opcode = AIVM_OP_PUSH_INT, .operand_int = 3 },
+        { .opcode = AIVM_OP_RET, .operand_int = 0 },
+        { .opcode = AIVM_OP_CALL_SYS, .operand_int = 0 },
+        { .opcode = AIVM_OP_RET, .operand_int = 0 }
+    };
+    AivmProgram program;
+
+    aivm_program_init(&program, instructions, 25U);
+    aivm_init(&vm, &program);
+    memset(&executor, 0, sizeof(executor));
+    aivm_init(&executor.scratch, &program);
+    aivm_set_par_executor(&vm, test_par_executor_run, &executor);
+    aivm_run(&vm);
+    if (expect(vm.status == AIVM_VM_STATUS_HALTED) != 0) {
+        return 1;
+    }
+    /* The branch that can reach CALL_SYS is not deferred; the other three are batched at join. */
+    if (expect(executor.calls == 1U && executor.branches == 3U) != 0) {
+        return 1;
+    }
+    if (expect(vm.par_branch_count == 0U) != 0) {
+        return 1;
+    }
+    if (expect(aivm_stack_pop(&vm, &out) == 1 && out.type == AIVM_VAL_NODE) != 0) {
+        return 1;
+    }
+    block_node = &vm.nodes[(size_t)(out.node_handle - 1)];
+    if (expect(block_node->child_count == 4U) != 0) {
+        return 1;
+    }
+    for (i = 0U; i < 4U; i += 1U) {
+        const AivmNodeRecord* child = &vm.nodes[(size_t)(vm.node_children[block_node->child_start + i] - 1)];
+        const AivmNodeAttr* attr = &vm.node_attrs[child->attr_start];
+        if (expect(attr->kind == AIVM_NODE_ATTR_INT && attr->int_value == expected[i]) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 static int test_parallel_fork_requires_context(void)
 {
     AivmVm vm;
@@ -3951,6 +4831,9 @@ int main(void)
     if (test_recursive_loop_without_tail_call_reuse_sets_frame_overflow() != 0) {
         return 1;
     }
+    if (test_tail_call_reuses_current_frame() != 0) {
+        return 1;
+    }
     if (test_negative_jump_operand_sets_error() != 0) {
         return 1;
     }
@@ -4032,9 +4915,42 @@ int main(void)
     if (test_call_sys_debug_task_reclaim_stats_arity_error() != 0) {
         return 1;
     }
+    if (test_call_sys_json_parse_builds_tree() != 0) {
+        return 1;
+    }
+    if (test_call_sys_json_encode_round_trip() != 0) {
+        return 1;
+    }
+    if (test_call_sys_json_parse_error_node() != 0) {
+        return 1;
+    }
+    if (test_call_sys_json_validate_returns_input_span() != 0) {
+        return 1;
+    }
+    if (test_call_sys_http_parse_request_builds_node() != 0) {
+        return 1;
+    }
+    if (test_call_sys_http_parse_response_chunked() != 0) {
+        return 1;
+    }
+    if (test_call_sys_http_parse_partial_and_error() != 0) {
+        return 1;
+    }
+    if (test_call_sys_http_build_response() != 0) {
+        return 1;
+    }
     if (test_async_call_and_await_roundtrip() != 0) {
         return 1;
     }
+    if (test_async_call_parks_pending_syscall_and_await_drives_tasks() != 0) {
+        return 1;
+    }
+    if (test_async_call_awaiting_coroutine_parks_and_resumes() != 0) {
+        return 1;
+    }
+    if (test_unawaited_task_finishes_before_halt() != 0) {
+        return 1;
+    }
     if (test_async_call_invalid_target_sets_error() != 0) {
         return 1;
     }
@@ -4092,6 +5008,9 @@ int main(void)
     if (test_parallel_join_failed_task_non_err_result_sets_error() != 0) {
         return 1;
     }
+    if (test_parallel_join_runs_pure_branches_through_executor() != 0) {
+        return 1;
+    }
     if (test_parallel_fork_requires_context() != 0) {
         return 1;
     }
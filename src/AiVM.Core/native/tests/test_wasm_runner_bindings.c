@@ -0,0 +1,100 @@
+#define main wasm_runner_main_for_test
+#include "../examples/wasm_runner.c"
+#undef main
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAIL line %d\n", __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static int has_binding(const AivmSyscallBinding* bindings, size_t binding_count, const char* target)
+{
+    size_t i;
+    for (i = 0U; i < binding_count; i += 1U) {
+        if (strcmp(bindings[i].target, target) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Every contract gets a binding, so growing the contract table cannot overflow the runner. */
+static int test_bindings_cover_contracts(void)
+{
+    static AivmSyscallBinding bindings[WASM_SYSCALL_BINDING_CAPACITY];
+    size_t binding_count = 0U;
+    size_t contract_count = 0U;
+    uint32_t syscall_id;
+
+    CHECK(build_wasm_syscall_bindings(bindings, &binding_count) == NULL);
+    for (syscall_id = 0U; syscall_id < WASM_SYSCALL_ID_LIMIT; syscall_id += 1U) {
+        const AivmSyscallContract* contract = aivm_syscall_contract_find_by_id(syscall_id);
+        if (contract == NULL) {
+            continue;
+        }
+        contract_count += 1U;
+        CHECK(has_binding(bindings, binding_count, contract->target));
+    }
+    CHECK(contract_count > 128U);
+    CHECK(binding_count >= contract_count && binding_count <= WASM_SYSCALL_BINDING_CAPACITY);
+    CHECK(aivm_syscall_contract_find_by_id(WASM_SYSCALL_ID_LIMIT) == NULL);
+    return 0;
+}
+
+/* Image decoding has no wasm host codec: both decode targets bind and report unavailable. */
+static int test_image_decode_bindings(void)
+{
+    static AivmSyscallBinding bindings[WASM_SYSCALL_BINDING_CAPACITY];
+    size_t binding_count = 0U;
+    size_t i;
+    int found = 0;
+
+    CHECK(build_wasm_syscall_bindings(bindings, &binding_count) == NULL);
+    for (i = 0U; i < binding_count; i += 1U) {
+        if (strcmp(bindings[i].target, "sys.image.decodeToRgba") == 0 ||
+            strcmp(bindings[i].target, "sys.image.decodeToRgbaBase64") == 0) {
+            CHECK(bindings[i].handler == native_syscall_unavailable);
+            found += 1;
+        }
+    }
+    CHECK(found == 2);
+    return 0;
+}
+
+/* The runner entry point binds and runs a program end to end. */
+static int test_runner_main_runs_program(void)
+{
+    static const uint8_t empty_program[16] = { 'A', 'I', 'B', 'C', 2, 0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 0 };
+    const char* path = "aivm_test_wasm_runner_empty.aibc1";
+    char* argv[3];
+    FILE* f = fopen(path, "wb");
+    int rc;
+
+    CHECK(f != NULL);
+    CHECK(fwrite(empty_program, 1U, sizeof(empty_program), f) == sizeof(empty_program));
+    CHECK(fclose(f) == 0);
+    argv[0] = "aivm-runtime-wasm32";
+    argv[1] = (char*)path;
+    argv[2] = NULL;
+    rc = wasm_runner_main_for_test(2, argv);
+    (void)remove(path);
+    CHECK(rc == 0);
+    return 0;
+}
+
+int main(void)
+{
+    if (test_bindings_cover_contracts() != 0) {
+        return 1;
+    }
+    if (test_image_decode_bindings() != 0) {
+        return 1;
+    }
+    if (test_runner_main_runs_program() != 0) {
+        return 1;
+    }
+    return 0;
+}
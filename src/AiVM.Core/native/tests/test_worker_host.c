@@ -0,0 +1,187 @@
+#define AIRUN_ALLOW_INTERNAL_UI_FALLBACK 1
+#define main airun_embedded_main_for_test
+#include "../../../AiCLI/native/airun.c"
+#undef main
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAIL line %d\n", __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static const char* k_worker_program =
+    "Program#wk_p1 {\n"
+    "  Let#wk_l1(name=hash) {\n"
+    "    Fn#wk_f1(params=text) {\n"
+    "      Block#wk_b1 {\n"
+    "        Return#wk_r1 { Call#wk_c1(target=sys.crypto.sha256) { Var#wk_v1(name=text) } }\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "  Let#wk_l2(name=spin) {\n"
+    "    Fn#wk_f2(params=text) {\n"
+    "      Block#wk_b2 {\n"
+    "        Loop#wk_lp1 { Block#wk_b3 { Continue#wk_k1 { } } }\n"
+    "        Return#wk_r2 { Var#wk_v2(name=text) }\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "  Let#wk_l3(name=noisy) {\n"
+    "    Fn#wk_f3() {\n"
+    "      Block#wk_b4 {\n"
+    "        Call#wk_c2(target=sys.stdout.writeLine) { Lit#wk_s1(value=\"not allowed\") }\n"
+    "        Return#wk_r3 { Lit#wk_i1(value=1) }\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "  Let#wk_l4(name=start) {\n"
+    "    Fn#wk_f4(params=argv) {\n"
+    "      Block#wk_b5 {\n"
+    "        Call#wk_c3(target=sys.worker.start) { Lit#wk_s2(value=\"hash\") Lit#wk_s3(value=\"\") }\n"
+    "        Call#wk_c4(target=sys.worker.start) { Lit#wk_s4(value=\"spin\") Lit#wk_s5(value=\"\") }\n"
+    "        Call#wk_c5(target=sys.worker.start) { Lit#wk_s6(value=\"noisy\") Lit#wk_s7(value=\"\") }\n"
+    "        Return#wk_r4 { Lit#wk_i2(value=0) }\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "  Export#wk_e1(name=start)\n"
+    "}\n";
+
+static int64_t start_worker(const char* task, const char* payload)
+{
+    AivmValue args[2];
+    AivmValue result;
+    args[0] = aivm_value_string(task);
+    args[1] = aivm_value_string(payload);
+    if (native_syscall_worker_start("sys.worker.start", args, 2U, &result) != AIVM_SYSCALL_OK ||
+        result.type != AIVM_VAL_INT) {
+        return -1;
+    }
+    return result.int_value;
+}
+
+static int64_t poll_worker_until_done(int64_t handle)
+{
+    AivmValue arg = aivm_value_int(handle);
+    AivmValue result;
+    int attempt;
+    for (attempt = 0; attempt < 5000; attempt += 1) {
+        if (native_syscall_worker_poll("sys.worker.poll", &arg, 1U, &result) != AIVM_SYSCALL_OK ||
+            result.type != AIVM_VAL_INT) {
+            return -99;
+        }
+        if (result.int_value != 0) {
+            return result.int_value;
+        }
+#ifdef _WIN32
+        Sleep(1);
+#else
+        usleep(1000);
+#endif
+    }
+    return 0;
+}
+
+static const char* worker_text(int64_t handle, int want_error)
+{
+    AivmValue arg = aivm_value_int(handle);
+    AivmValue result;
+    int status = want_error
+        ? native_syscall_worker_error("sys.worker.error", &arg, 1U, &result)
+        : native_syscall_worker_result("sys.worker.result", &arg, 1U, &result);
+    if (status != AIVM_SYSCALL_OK || result.type != AIVM_VAL_STRING) {
+        return NULL;
+    }
+    return result.string_value;
+}
+
+int main(void)
+{
+    const char* path = "aivm_test_worker_host.aos";
+    AivmProgram* program = (AivmProgram*)malloc(sizeof(AivmProgram));
+    AivmVm* owner = (AivmVm*)malloc(sizeof(AivmVm));
+    size_t entry_ip = 0U;
+    size_t param_count = 0U;
+    int64_t hashes[4];
+    int64_t spin;
+    int64_t noisy;
+    int64_t legacy;
+    AivmValue arg;
+    AivmValue result;
+    const char* text;
+    size_t i;
+
+    CHECK(program != NULL && owner != NULL);
+    CHECK(write_text_file(path, k_worker_program));
+    CHECK(parse_simple_program_aos_to_program_file(path, program));
+    (void)remove(path);
+
+    /* Worker-only entries are compiled and listed even though nothing calls them. */
+    CHECK(native_worker_find_entry(program, "hash", &entry_ip, &param_count));
+    CHECK(param_count == 1U && entry_ip < program->instruction_count);
+    CHECK(native_worker_find_entry(program, "noisy", &entry_ip, &param_count));
+    CHECK(param_count == 0U);
+    CHECK(!native_worker_find_entry(program, "start", &entry_ip, &param_count));
+
+    aivm_init(owner, program);
+    g_native_active_vm = owner;
+
+    hashes[0] = start_worker("hash", "abc");
+    hashes[1] = start_worker("hash", "");
+    hashes[2] = start_worker("hash", "abc");
+    hashes[3] = start_worker("hash", "worker");
+    noisy = start_worker("noisy", "");
+    legacy = start_worker("echo", "legacy");
+    for (i = 0U; i < 4U; i += 1U) {
+        CHECK(hashes[i] > 0);
+    }
+    CHECK(noisy > 0 && legacy > 0);
+
+    CHECK(poll_worker_until_done(hashes[0]) == 1);
+    text = worker_text(hashes[0], 0);
+    CHECK(text != NULL && strcmp(text, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") == 0);
+    CHECK(poll_worker_until_done(hashes[1]) == 1);
+    text = worker_text(hashes[1], 0);
+    CHECK(text != NULL && strcmp(text, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855") == 0);
+    CHECK(poll_worker_until_done(hashes[2]) == 1);
+    CHECK(strcmp(worker_text(hashes[2], 0), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") == 0);
+    CHECK(poll_worker_until_done(hashes[3]) == 1);
+    CHECK(strlen(worker_text(hashes[3], 0)) == 64U);
+
+    /* Worker VMs only bind pure syscalls. */
+    CHECK(poll_worker_until_done(noisy) == -1);
+    text = worker_text(noisy, 1);
+    CHECK(text != NULL && text[0] != '\0');
+    CHECK(strcmp(worker_text(noisy, 0), "") == 0);
+
+    /* Legacy simulated tasks keep their poll-counted completion. */
+    arg = aivm_value_int(legacy);
+    CHECK(native_syscall_worker_poll("sys.worker.poll", &arg, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.int_value == 0);
+    CHECK(poll_worker_until_done(legacy) == 1);
+    CHECK(strcmp(worker_text(legacy, 0), "legacy") == 0);
+
+    /* A running job stays pending until canceled by the owner. */
+    spin = start_worker("spin", "forever");
+    CHECK(spin > 0);
+    arg = aivm_value_int(spin);
+    CHECK(native_syscall_worker_poll("sys.worker.poll", &arg, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.int_value == 0);
+    CHECK(native_syscall_worker_cancel("sys.worker.cancel", &arg, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.type == AIVM_VAL_BOOL && result.bool_value == 1);
+    CHECK(native_syscall_worker_poll("sys.worker.poll", &arg, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.int_value == -2);
+    CHECK(strcmp(worker_text(spin, 1), "canceled") == 0);
+
+    native_worker_reset();
+    arg = aivm_value_int(hashes[0]);
+    CHECK(native_syscall_worker_poll("sys.worker.poll", &arg, 1U, &result) == AIVM_SYSCALL_OK);
+    CHECK(result.int_value == -3);
+
+    g_native_active_vm = NULL;
+    free(owner);
+    free(program);
+    return 0;
+}